@@ -0,0 +1,112 @@
+using UnityEngine;
+using UnityEditor;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Editor
+{
+    /// <summary>
+    /// Splits a single-file offline dictionary into the per-language shards loaded by LanguageManager
+    /// </summary>
+    public static class DictionaryShardBuilder
+    {
+        private const string OutputDirectory = "Assets/Resources/Dictionary";
+
+        [MenuItem("ARLinguaSphere/Tools/Build Dictionary Shards")]
+        public static void BuildShards()
+        {
+            string sourcePath = EditorUtility.OpenFilePanel("Select offline dictionary JSON", Application.dataPath, "json");
+            if (string.IsNullOrEmpty(sourcePath))
+            {
+                return;
+            }
+
+            var index = new JsonIndex();
+            if (!index.Load(File.ReadAllText(sourcePath, Encoding.UTF8)) || !index.Root.IsObject)
+            {
+                EditorUtility.DisplayDialog("Error", "Could not parse the selected dictionary JSON.", "OK");
+                return;
+            }
+
+            // language code -> (label key -> translation), preserving source order
+            var shards = new Dictionary<string, List<KeyValuePair<string, string>>>();
+            var languages = new List<string>();
+            int entryCount = 0;
+            var entries = index.Root.GetObject();
+            while (entries.MoveNext())
+            {
+                entryCount++;
+                if (!entries.Value.IsObject) continue;
+                string key = entries.Key;
+                var translations = entries.Value.GetObject();
+                while (translations.MoveNext())
+                {
+                    string language = translations.Key;
+                    if (!shards.TryGetValue(language, out var shard))
+                    {
+                        shard = new List<KeyValuePair<string, string>>();
+                        shards[language] = shard;
+                        languages.Add(language);
+                    }
+                    shard.Add(new KeyValuePair<string, string>(key, translations.Value.GetString() ?? string.Empty));
+                }
+            }
+
+            Directory.CreateDirectory(OutputDirectory);
+            foreach (var language in languages)
+            {
+                var sb = new StringBuilder();
+                sb.Append("{\n");
+                var shard = shards[language];
+                for (int i = 0; i < shard.Count; i++)
+                {
+                    sb.Append("  ");
+                    AppendJsonString(sb, shard[i].Key);
+                    sb.Append(": ");
+                    AppendJsonString(sb, shard[i].Value);
+                    sb.Append(i < shard.Count - 1 ? ",\n" : "\n");
+                }
+                sb.Append("}\n");
+                File.WriteAllText(Path.Combine(OutputDirectory, language + ".json"), sb.ToString(), new UTF8Encoding(false));
+            }
+
+            var manifest = new StringBuilder();
+            manifest.Append("{\n  \"version\": 1,\n");
+            manifest.Append($"  \"entryCount\": {entryCount},\n");
+            manifest.Append("  \"languages\": [");
+            for (int i = 0; i < languages.Count; i++)
+            {
+                if (i > 0) manifest.Append(", ");
+                AppendJsonString(manifest, languages[i]);
+            }
+            manifest.Append("]\n}\n");
+            File.WriteAllText(Path.Combine(OutputDirectory, "manifest.json"), manifest.ToString(), new UTF8Encoding(false));
+
+            AssetDatabase.Refresh();
+            Debug.Log($"DictionaryShardBuilder: Wrote {languages.Count} shards ({entryCount} entries) to {OutputDirectory}");
+        }
+
+        private static void AppendJsonString(StringBuilder sb, string value)
+        {
+            sb.Append('"');
+            foreach (char c in value)
+            {
+                switch (c)
+                {
+                    case '"': sb.Append("\\\""); break;
+                    case '\\': sb.Append("\\\\"); break;
+                    case '\n': sb.Append("\\n"); break;
+                    case '\r': sb.Append("\\r"); break;
+                    case '\t': sb.Append("\\t"); break;
+                    default:
+                        if (c < 0x20) sb.Append("\\u").Append(((int)c).ToString("x4"));
+                        else sb.Append(c);
+                        break;
+                }
+            }
+            sb.Append('"');
+        }
+    }
+}
@@ -1,8 +1,10 @@
 package com.arlinguasphere;
 
 import android.content.Context;
+import android.os.SystemClock;
 import android.util.Log;
-import com.unity3d.player.UnityPlayer;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Random;
 
 /**
@@ -13,7 +15,6 @@ public class MediaPipeHandsPlugin {
     private static final String TAG = "MediaPipeHandsPlugin";
     
     private Context context;
-    private String unityCallbackObject;
     
     private boolean initialized = false;
     private int maxHands = 1;
@@ -21,6 +22,18 @@ public class MediaPipeHandsPlugin {
     private float minDetectionConfidence = 0.5f;
     private float minTrackingConfidence = 0.5f;
     
+    private ByteBuffer frameBuffer; // direct buffer over Unity's native frame memory
+    
+    // Landmarks go to Unity through a ring of fixed-layout records in Unity's native memory, drained every
+    // frame (layout in LandmarkRing.cs). This side is the only writer.
+    private static final int RING_HEADER_BYTES = 64;
+    private static final int RING_RECORD_BYTES = 280;
+    private static final int KEYPOINT_VALUES = 21 * 3;
+    private ByteBuffer landmarkRing;
+    private int ringCapacity;
+    private int ringSequence; // last published record
+    private volatile int ringFence;
+    
     private Random random = new Random();
     private long lastDetectionTime = 0;
     private static final long DETECTION_INTERVAL = 2000; // 2 seconds
@@ -48,13 +61,39 @@ public class MediaPipeHandsPlugin {
     }
     
     /**
-     * Process a camera frame for hand detection (mock implementation)
+     * Share the buffer Unity writes camera frames into. It stays owned by Unity and is reused for every frame.
+     */
+    public void setFrameBuffer(ByteBuffer buffer) {
+        this.frameBuffer = buffer;
+        Log.d(TAG, "Frame buffer set: " + (buffer != null ? buffer.capacity() : 0) + " bytes");
+    }
+    
+    /**
+     * Share the ring landmarks are published into. It stays owned by Unity; records continue from the
+     * sequence in its header.
+     */
+    public void setLandmarkRing(ByteBuffer ring) {
+        if (ring != null) ring.order(ByteOrder.nativeOrder());
+        this.landmarkRing = ring;
+        this.ringCapacity = ring != null ? (ring.capacity() - RING_HEADER_BYTES) / RING_RECORD_BYTES : 0;
+        this.ringSequence = ring != null ? ring.getInt(0) : 0;
+        Log.d(TAG, "Landmark ring set: " + ringCapacity + " records");
+    }
+    
+    /**
+     * Process the frame now in the shared buffer: RGBA8888, rows packed, already scaled to the model's input
+     * resolution (mock implementation). The buffer is rewritten after this returns, so a real pipeline wraps it
+     * (e.g. ByteBufferImageBuilder) for a synchronous detect call, or copies it before handing it to another thread.
      */
-    public void processFrame(byte[] imageBytes, int width, int height) {
+    public void processFrameBuffer(int width, int height) {
         if (!initialized) {
             Log.w(TAG, "Mock MediaPipe not initialized");
             return;
         }
+        if (frameBuffer == null || width <= 0 || height <= 0 || frameBuffer.capacity() < width * height * 4) {
+            Log.w(TAG, "Frame buffer missing or too small for " + width + "x" + height);
+            return;
+        }
         
         try {
             // Simulate processing delay
@@ -66,7 +105,7 @@ public class MediaPipeHandsPlugin {
             lastDetectionTime = currentTime;
             
             // Generate mock hand landmarks
-            generateMockHandLandmarks();
+            generateMockHandLandmarks((float) width / height);
             
         } catch (Exception e) {
             Log.e(TAG, "Error processing frame", e);
@@ -76,13 +115,15 @@ public class MediaPipeHandsPlugin {
     /**
      * Generate mock hand landmarks for testing
      */
-    private void generateMockHandLandmarks() {
+    private void generateMockHandLandmarks(float aspect) {
         try {
             // Generate 21 hand landmarks (MediaPipe standard)
             HandLandmarksData landmarksData = new HandLandmarksData();
             landmarksData.keypoints = new float[21 * 3]; // 21 landmarks, 3 coordinates each
             landmarksData.confidence = 0.8f + random.nextFloat() * 0.2f; // 0.8-1.0
             landmarksData.isRight = random.nextBoolean();
+            landmarksData.timestampNanos = SystemClock.elapsedRealtimeNanos();
+            landmarksData.aspect = aspect;
             
             // Generate realistic hand landmark positions
             for (int i = 0; i < 21; i++) {
@@ -94,12 +135,7 @@ public class MediaPipeHandsPlugin {
                 landmarksData.keypoints[baseIndex + 2] = random.nextFloat() * 0.1f; // z (depth)
             }
             
-            String json = convertToJson(landmarksData);
-            
-            // Send landmarks to Unity
-            if (unityCallbackObject != null) {
-                UnityPlayer.UnitySendMessage(unityCallbackObject, "OnHandLandmarksReceived", json);
-            }
+            publishLandmarks(landmarksData);
             
         } catch (Exception e) {
             Log.e(TAG, "Error generating mock hand landmarks", e);
@@ -107,35 +143,39 @@ public class MediaPipeHandsPlugin {
     }
     
     /**
-     * Convert landmarks data to JSON string
+     * Write one record into the landmark ring. Its sequence stamp is cleared while the payload is rewritten,
+     * and the header's head is only advanced once the stamp is back, so Unity never takes a half-written
+     * record. The oldest record is overwritten if Unity has not drained it yet.
      */
-    private String convertToJson(HandLandmarksData data) {
-        StringBuilder json = new StringBuilder();
-        json.append("{");
-        json.append("\"keypoints\":[");
+    private void publishLandmarks(HandLandmarksData data) {
+        ByteBuffer ring = landmarkRing;
+        if (ring == null || ringCapacity <= 0) return;
         
-        for (int i = 0; i < data.keypoints.length; i += 3) {
-            if (i > 0) json.append(",");
-            json.append("{\"x\":").append(data.keypoints[i])
-                .append(",\"y\":").append(data.keypoints[i + 1])
-                .append(",\"z\":").append(data.keypoints[i + 2])
-                .append("}");
+        int sequence = ringSequence + 1;
+        int base = RING_HEADER_BYTES + (sequence - 1) % ringCapacity * RING_RECORD_BYTES;
+        ring.putInt(base, 0);
+        storeFence(sequence);
+        ring.putInt(base + 4, data.isRight ? 1 : 0);
+        ring.putLong(base + 8, data.timestampNanos);
+        ring.putFloat(base + 16, data.confidence);
+        for (int i = 0; i < KEYPOINT_VALUES; i++) {
+            ring.putFloat(base + 20 + i * 4, data.keypoints[i]);
         }
-        
-        json.append("],");
-        json.append("\"confidence\":").append(data.confidence).append(",");
-        json.append("\"isRight\":").append(data.isRight);
-        json.append("}");
-        
-        return json.toString();
+        ring.putFloat(base + 272, data.aspect);
+        storeFence(sequence);
+        ring.putInt(base, sequence);
+        storeFence(sequence);
+        ring.putInt(0, sequence);
+        ringSequence = sequence;
     }
     
     /**
-     * Set the Unity callback object name
+     * Keep the ring stores before and after this call in that order as Unity sees them. A volatile store
+     * followed by a volatile load is a full barrier on ART (VarHandle fences need API 33).
      */
-    public void setLandmarksCallback(String objectName) {
-        this.unityCallbackObject = objectName;
-        Log.d(TAG, "Unity callback object set to: " + objectName);
+    private int storeFence(int value) {
+        ringFence = value;
+        return ringFence;
     }
     
     /**
@@ -168,6 +208,7 @@ public class MediaPipeHandsPlugin {
     public void cleanup() {
         try {
             initialized = false;
+            landmarkRing = null;
             Log.d(TAG, "Mock MediaPipe Hands cleaned up");
             
         } catch (Exception e) {
@@ -182,5 +223,7 @@ public class MediaPipeHandsPlugin {
         public float[] keypoints; // Array of x, y, z coordinates
         public float confidence;
         public boolean isRight;
+        public long timestampNanos; // SystemClock.elapsedRealtimeNanos of the frame
+        public float aspect; // frame width / height: x is normalised by width, y by height
     }
 }
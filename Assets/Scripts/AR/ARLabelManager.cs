@@ -37,6 +37,7 @@ namespace ARLinguaSphere.AR
         private List<ARLabel> activeLabels = new List<ARLabel>();
         private Dictionary<string, ARLabel> objectLabels = new Dictionary<string, ARLabel>();
         private Dictionary<string, ARLabel> anchorIdToLabel = new Dictionary<string, ARLabel>();
+        private readonly List<string> movingAnchorIds = new List<string>(); // remote anchors still playing back updates
         private float lastPlacementTime = 0f;
         
         // Events
@@ -64,12 +65,16 @@ namespace ARLinguaSphere.AR
             if (languageManager != null)
             {
                 languageManager.OnLanguageChanged += OnLanguageChanged;
+                languageManager.OnDictionaryUpdated += OnDictionaryUpdated;
             }
             
             // Subscribe to network anchors
             if (networkManager != null)
             {
                 networkManager.OnAnchorReceived += OnAnchorReceived;
+                networkManager.OnAnchorUpdated += OnAnchorUpdated;
+                networkManager.OnAnchorEvicted += RemoveLabelForAnchor;
+                networkManager.OnAnchorRemoved += RemoveLabelForAnchor;
             }
             
             Debug.Log("ARLabelManager: Initialized");
@@ -231,7 +236,20 @@ namespace ARLinguaSphere.AR
             }
         }
         
+        private void OnDictionaryUpdated()
+        {
+            // Hot-reloaded corrections: re-translate labels in the current language
+            string language = languageManager?.currentLanguage ?? "en";
+            OnLanguageChanged(language, language);
+        }
+        
         private void OnLabelDestroyed(ARLabel label)
+        {
+            ForgetLabel(label);
+            OnLabelRemoved?.Invoke(label);
+        }
+        
+        private void ForgetLabel(ARLabel label)
         {
             activeLabels.Remove(label);
             
@@ -248,8 +266,6 @@ namespace ARLinguaSphere.AR
             {
                 anchorIdToLabel.Remove(anchorKey);
             }
-            
-            OnLabelRemoved?.Invoke(label);
         }
         
         public void PlaceLabelAtPosition(string objectLabel, Vector3 worldPosition)
@@ -340,11 +356,15 @@ namespace ARLinguaSphere.AR
             if (languageManager != null)
             {
                 languageManager.OnLanguageChanged -= OnLanguageChanged;
+                languageManager.OnDictionaryUpdated -= OnDictionaryUpdated;
             }
             
             if (networkManager != null)
             {
                 networkManager.OnAnchorReceived -= OnAnchorReceived;
+                networkManager.OnAnchorUpdated -= OnAnchorUpdated;
+                networkManager.OnAnchorEvicted -= RemoveLabelForAnchor;
+                networkManager.OnAnchorRemoved -= RemoveLabelForAnchor;
             }
         }
 
@@ -356,6 +376,53 @@ namespace ARLinguaSphere.AR
             PlaceLabelFromAnchor(anchor);
         }
 
+        private void OnAnchorUpdated(ARLinguaSphere.Network.AnchorData anchor)
+        {
+            if (anchor == null || !anchorIdToLabel.TryGetValue(anchor.id, out var label)) return;
+            
+            // With smoothing on, Update plays the move back from the jitter buffer; otherwise it snaps
+            if (networkManager.smoothRemoteMotion)
+            {
+                if (!movingAnchorIds.Contains(anchor.id)) movingAnchorIds.Add(anchor.id);
+            }
+            else if (label != null)
+            {
+                label.transform.SetPositionAndRotation(anchor.position + Vector3.up * labelOffset, anchor.rotation);
+            }
+        }
+        
+        private void Update()
+        {
+            for (int i = movingAnchorIds.Count - 1; i >= 0; i--)
+            {
+                string id = movingAnchorIds[i];
+                bool settled = true;
+                if (anchorIdToLabel.TryGetValue(id, out var label) && label != null &&
+                    networkManager.TryGetAnchorPose(id, out var position, out var rotation, out settled))
+                {
+                    label.transform.SetPositionAndRotation(position + Vector3.up * labelOffset, rotation);
+                }
+                if (settled)
+                {
+                    movingAnchorIds[i] = movingAnchorIds[movingAnchorIds.Count - 1];
+                    movingAnchorIds.RemoveAt(movingAnchorIds.Count - 1);
+                }
+            }
+        }
+
+        private void RemoveLabelForAnchor(ARLinguaSphere.Network.AnchorData anchor)
+        {
+            // The anchor was removed from the room, or its cell left the interest radius (bounds scene objects).
+            // Not a user removal, so the label goes without raising OnLabelRemoved.
+            if (anchor == null || !anchorIdToLabel.TryGetValue(anchor.id, out var label)) return;
+            label.OnLabelDestroyed -= OnLabelDestroyed;
+            ForgetLabel(label);
+            if (label != null)
+            {
+                Destroy(label.gameObject);
+            }
+        }
+
         public void PlaceLabelFromAnchor(ARLinguaSphere.Network.AnchorData anchor)
         {
             if (anchor == null) return;
@@ -114,13 +114,7 @@ namespace ARLinguaSphere.AR
             using (cpuImage)
             {
                 // Set up conversion params
-                conversionParams = new XRCpuImage.ConversionParams
-                {
-                    inputRect = new RectInt(0, 0, cpuImage.width, cpuImage.height),
-                    outputDimensions = new Vector2Int(cpuImage.width, cpuImage.height),
-                    outputFormat = TextureFormat.RGBA32,
-                    transformation = XRCpuImage.Transformation.MirrorY
-                };
+                conversionParams = CreateConversionParams(cpuImage, new Vector2Int(cpuImage.width, cpuImage.height));
 
                 int size = cpuImage.GetConvertedDataSize(conversionParams);
                 var buffer = new NativeArray<byte>(size, Allocator.Temp);
@@ -152,6 +146,53 @@ namespace ARLinguaSphere.AR
             }
         }
         
+        /// <summary>
+        /// Convert the latest camera CPU image straight into <paramref name="destination"/> as RGBA32 with packed
+        /// rows. The image is downscaled natively so neither side exceeds <paramref name="maxSize"/>. The conversion
+        /// matches GetLatestCameraTexture, but nothing is uploaded to a texture or copied through managed memory.
+        /// Returns false if there is no image newer than <paramref name="lastTimestamp"/> or it does not fit.
+        /// </summary>
+        public bool TryConvertLatestCameraImage(NativeArray<byte> destination, int maxSize, ref double lastTimestamp, out Vector2Int dimensions)
+        {
+            dimensions = Vector2Int.zero;
+            if (arCameraManager == null || !destination.IsCreated) return false;
+            if (!arCameraManager.TryAcquireLatestCpuImage(out var cpuImage))
+            {
+                return false;
+            }
+
+            using (cpuImage)
+            {
+                if (cpuImage.timestamp == lastTimestamp) return false;
+
+                float scale = Mathf.Min(1f, (float)maxSize / Mathf.Max(cpuImage.width, cpuImage.height));
+                var output = new Vector2Int(Mathf.Max(1, Mathf.RoundToInt(cpuImage.width * scale)), Mathf.Max(1, Mathf.RoundToInt(cpuImage.height * scale)));
+                var parameters = CreateConversionParams(cpuImage, output);
+                int size = cpuImage.GetConvertedDataSize(parameters);
+                if (size > destination.Length)
+                {
+                    Debug.LogWarning($"ARManager: Camera image needs {size} bytes, buffer has {destination.Length}");
+                    return false;
+                }
+
+                cpuImage.Convert(parameters, destination.GetSubArray(0, size));
+                lastTimestamp = cpuImage.timestamp;
+                dimensions = output;
+                return true;
+            }
+        }
+
+        private static XRCpuImage.ConversionParams CreateConversionParams(XRCpuImage cpuImage, Vector2Int outputDimensions)
+        {
+            return new XRCpuImage.ConversionParams
+            {
+                inputRect = new RectInt(0, 0, cpuImage.width, cpuImage.height),
+                outputDimensions = outputDimensions,
+                outputFormat = TextureFormat.RGBA32,
+                transformation = XRCpuImage.Transformation.MirrorY
+            };
+        }
+        
         public bool TryPlaceAnchor(Vector2 screenPosition, out ARAnchor anchor)
         {
             anchor = null;
@@ -2,6 +2,8 @@ using UnityEngine;
 using System;
 using System.Collections.Generic;
 using System.IO;
+using System.Threading.Tasks;
+using ARLinguaSphere.Core;
 
 namespace ARLinguaSphere.Analytics
 {
@@ -13,18 +15,43 @@ namespace ARLinguaSphere.Analytics
         [Header("Analytics Settings")]
         public bool enableAnalytics = true;
         public bool enableLocalLogging = true;
+        public string localLogDirectory = ""; // interaction log; defaults to persistentDataPath/analytics
         public bool enableCloudSync = true;
         public float syncInterval = 30f;
+        public string cloudSyncUrl = ""; // endpoint accepting gzipped JSON batches of logged interactions (needs enableLocalLogging)
+        public int maxRetries = 3;
+        public int syncBatchKB = 64; // compressed size limit per upload
         
         [Header("Adaptive Learning Settings")]
         public float difficultyAdjustmentRate = 0.1f;
         public int minSamplesForAdaptation = 5;
         public float errorRateThreshold = 0.3f;
+        public int adaptationWindowDays = 30; // error rate is taken over this many recent days
+        
+        [Header("Spaced Repetition")]
+        public float desiredRetention = 0.9f; // recall probability at which a word comes due
+        public float relearnDelaySeconds = 600f; // a missed word is asked again this soon
+        public float hardAnswerSeconds = 8f; // correct but slower than this: graded Hard
+        public float easyAnswerSeconds = 2f; // faster than this: graded Easy
+        
+        private const string ScheduleFile = "schedule.bin";
         
         private bool isInitialized = false;
-        private List<InteractionData> localInteractions;
         private Dictionary<string, WordStats> wordStatistics;
+        private InteractionLog interactionLog;
+        private readonly QuizCandidateIndex quizIndex = new QuizCandidateIndex();
+        private InteractionRollups rollups = new InteractionRollups();
+        private readonly ReviewScheduler scheduler = new ReviewScheduler();
+        private long scheduleThrough; // log position the loaded schedule snapshot covers
+        private byte[] scheduleBuffer;
+        private Task scheduleSaveTask = Task.CompletedTask;
         private string userId;
+        private AnalyticsUploader uploader;
+        
+        /// <summary>
+        /// Windowed totals and response-time quantiles, overall, per word and per session
+        /// </summary>
+        public InteractionRollups Rollups => rollups;
         
         // Events
         public event Action<InteractionData> OnInteractionLogged;
@@ -34,24 +61,72 @@ namespace ARLinguaSphere.Analytics
         {
             Debug.Log("AnalyticsManager: Initializing analytics systems...");
             
-            localInteractions = new List<InteractionData>();
             wordStatistics = new Dictionary<string, WordStats>();
+            rollups = new InteractionRollups(adaptationWindowDays);
             userId = SystemInfo.deviceUniqueIdentifier;
+            scheduler.DesiredRetention = desiredRetention;
+            scheduler.RelearnDelaySeconds = relearnDelaySeconds;
+            scheduler.HardSeconds = hardAnswerSeconds;
+            scheduler.EasySeconds = easyAnswerSeconds;
             
             // Load existing data
             LoadLocalData();
+            ScheduleKnownWords();
+            RebuildQuizIndex();
+            DeleteLegacyOutbox();
             
-            // Initialize Firebase Analytics
-            InitializeFirebaseAnalytics();
+            StartCloudSync();
             
             isInitialized = true;
             Debug.Log("AnalyticsManager: Analytics systems initialized!");
         }
         
-        private void InitializeFirebaseAnalytics()
+        /// <summary>
+        /// Uploads read the interaction log from a checkpoint on a background thread, so LogInteraction only appends
+        /// </summary>
+        private void StartCloudSync()
+        {
+            if (!enableCloudSync || interactionLog == null || string.IsNullOrEmpty(cloudSyncUrl))
+            {
+                return;
+            }
+            try
+            {
+                uploader = new AnalyticsUploader(interactionLog, cloudSyncUrl, userId, syncBatchKB * 1024)
+                {
+                    IntervalSeconds = syncInterval,
+                    MaxRetries = maxRetries
+                };
+                uploader.Start();
+                Debug.Log($"AnalyticsManager: Cloud sync from interaction {uploader.Checkpoint} of {interactionLog.EndPosition}");
+            }
+            catch (Exception e)
+            {
+                Debug.LogWarning($"AnalyticsManager: Cloud sync unavailable: {e.Message}");
+                uploader = null;
+            }
+        }
+        
+        private void StopCloudSync()
+        {
+            uploader?.Dispose();
+            uploader = null;
+        }
+        
+        /// <summary>
+        /// Older versions queued each interaction a second time in an outbox; the uploader reads the log instead
+        /// </summary>
+        private static void DeleteLegacyOutbox()
         {
-            // TODO: Initialize Firebase Analytics
-            Debug.Log("AnalyticsManager: Firebase Analytics initialized (placeholder)");
+            string path = Path.Combine(Application.persistentDataPath, "outbox", "analytics.log");
+            try
+            {
+                if (File.Exists(path)) File.Delete(path);
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                Debug.LogWarning($"AnalyticsManager: Failed to delete legacy outbox: {e.Message}");
+            }
         }
         
         private void LoadLocalData()
@@ -60,28 +135,50 @@ namespace ARLinguaSphere.Analytics
             {
                 return;
             }
+            var timer = System.Diagnostics.Stopwatch.StartNew();
+            LoadLegacyStats();
+            try
+            {
+                string directory = string.IsNullOrEmpty(localLogDirectory) ? Path.Combine(Application.persistentDataPath, "analytics") : localLogDirectory;
+                interactionLog = InteractionLog.Open(directory);
+                LoadSchedule();
+                int replayed = ReplayInteractionLog();
+                Debug.Log($"AnalyticsManager: Rebuilt stats for {wordStatistics.Count} words and the schedule of {scheduler.Count} from {replayed} logged interactions in {timer.Elapsed.TotalMilliseconds:F1}ms");
+            }
+            catch (Exception e)
+            {
+                Debug.LogWarning($"AnalyticsManager: Interaction log unavailable, stats will not persist: {e.Message}");
+                interactionLog = null;
+            }
+        }
+        
+        /// <summary>
+        /// Word stats that older versions saved as JSON in PlayerPrefs. No longer written; they are the baseline the
+        /// interaction log replays onto.
+        /// </summary>
+        private void LoadLegacyStats()
+        {
             try
             {
-                // Lightweight JSON persistence using PlayerPrefs for demo
                 string json = PlayerPrefs.GetString("ALS_Analytics_Local", string.Empty);
                 if (!string.IsNullOrEmpty(json))
                 {
-                    var parsed = ARLinguaSphere.Core.ThirdParty.MiniJSON.Deserialize(json) as Dictionary<string, object>;
-                    if (parsed != null && parsed.ContainsKey("wordStats"))
+                    var index = new JsonIndex();
+                    if (index.Load(json) && index.Root.TryGetField("wordStats", out var statsNode))
                     {
-                        var statsMap = parsed["wordStats"] as Dictionary<string, object>;
-                        foreach (var kv in statsMap)
+                        var statsMap = statsNode.GetObject();
+                        while (statsMap.MoveNext())
                         {
-                            var m = kv.Value as Dictionary<string, object>;
-                            var ws = new WordStats
+                            var ws = new WordStats { wordKey = statsMap.Key, difficultyLevel = 1f };
+                            var fields = statsMap.Value.GetObject();
+                            while (fields.MoveNext())
                             {
-                                wordKey = kv.Key,
-                                totalInteractions = m.ContainsKey("totalInteractions") ? System.Convert.ToInt32(m["totalInteractions"]) : 0,
-                                successfulInteractions = m.ContainsKey("successfulInteractions") ? System.Convert.ToInt32(m["successfulInteractions"]) : 0,
-                                averageResponseTime = m.ContainsKey("averageResponseTime") ? System.Convert.ToSingle(m["averageResponseTime"]) : 0f,
-                                difficultyLevel = m.ContainsKey("difficultyLevel") ? System.Convert.ToSingle(m["difficultyLevel"]) : 1f,
-                                lastSeen = m.ContainsKey("lastSeen") ? System.Convert.ToInt64(m["lastSeen"]) : 0
-                            };
+                                if (fields.KeyEquals("totalInteractions")) ws.totalInteractions = fields.Value.GetInt32();
+                                else if (fields.KeyEquals("successfulInteractions")) ws.successfulInteractions = fields.Value.GetInt32();
+                                else if (fields.KeyEquals("averageResponseTime")) ws.averageResponseTime = fields.Value.GetSingle();
+                                else if (fields.KeyEquals("difficultyLevel")) ws.difficultyLevel = fields.Value.GetSingle(1f);
+                                else if (fields.KeyEquals("lastSeen")) ws.lastSeen = fields.Value.GetInt64();
+                            }
                             wordStatistics[ws.wordKey] = ws;
                         }
                     }
@@ -91,7 +188,131 @@ namespace ARLinguaSphere.Analytics
             {
                 Debug.LogWarning($"AnalyticsManager: Failed to load local data: {e.Message}");
             }
-            Debug.Log("AnalyticsManager: Local data loaded");
+        }
+        
+        /// <summary>
+        /// The review schedule saved with the log position it covers; interactions after that are replayed into it.
+        /// A snapshot ahead of the log (the log was lost or cleared) is dropped and the whole log replayed instead.
+        /// </summary>
+        private void LoadSchedule()
+        {
+            scheduleThrough = 0;
+            string path = Path.Combine(interactionLog.DirectoryPath, ScheduleFile);
+            try
+            {
+                if (!File.Exists(path)) return;
+                var data = File.ReadAllBytes(path);
+                if (!scheduler.Load(data, data.Length, out long through) || through > interactionLog.EndPosition)
+                {
+                    Debug.LogWarning("AnalyticsManager: Review schedule does not match the interaction log, rebuilding it");
+                    scheduler.Clear();
+                    return;
+                }
+                scheduleThrough = through;
+            }
+            catch (IOException e)
+            {
+                Debug.LogWarning($"AnalyticsManager: Failed to load review schedule: {e.Message}");
+                scheduler.Clear();
+            }
+        }
+        
+        /// <summary>
+        /// Encode the schedule here and write it in the background, tagged with the log position it covers
+        /// </summary>
+        private void SaveSchedule()
+        {
+            if (interactionLog == null || !scheduler.IsDirty) return;
+            int length = scheduler.Encode(ref scheduleBuffer, interactionLog.EndPosition);
+            var data = new byte[length];
+            Buffer.BlockCopy(scheduleBuffer, 0, data, 0, length);
+            string path = Path.Combine(interactionLog.DirectoryPath, ScheduleFile);
+            scheduler.MarkSaved();
+            
+            // Chained so two saves never race on the temp file
+            scheduleSaveTask = scheduleSaveTask.ContinueWith(_ =>
+            {
+                string tempPath = path + ".tmp";
+                File.WriteAllBytes(tempPath, data);
+                if (File.Exists(path)) File.Delete(path);
+                File.Move(tempPath, path);
+            }, TaskScheduler.Default);
+            scheduleSaveTask.ContinueWith(t => Debug.LogWarning($"AnalyticsManager: Failed to save review schedule: {t.Exception?.GetBaseException().Message}"),
+                TaskContinuationOptions.OnlyOnFaulted);
+        }
+        
+        private void WaitForScheduleSave()
+        {
+            try
+            {
+                scheduleSaveTask.Wait(5000);
+            }
+            catch (AggregateException)
+            {
+                // Already logged
+            }
+        }
+        
+        /// <summary>
+        /// Words known only from legacy stats get a card, due when they were last seen
+        /// </summary>
+        private void ScheduleKnownWords()
+        {
+            foreach (var stats in wordStatistics.Values)
+            {
+                scheduler.Introduce(stats.wordKey, stats.lastSeen);
+            }
+        }
+        
+        /// <summary>
+        /// Quiz answers are reviews; any other interaction with a word puts it on the schedule, due now
+        /// </summary>
+        private void Schedule(string wordKey, InteractionType action, bool success, float duration, long timestamp)
+        {
+            if (action == InteractionType.QuizAnswered)
+            {
+                scheduler.Review(wordKey, scheduler.Grade(success, duration), timestamp);
+            }
+            else
+            {
+                scheduler.Introduce(wordKey, timestamp);
+            }
+        }
+        
+        /// <summary>
+        /// Folds every logged interaction into wordStatistics, and those after the schedule snapshot into the schedule.
+        /// Stats are looked up by string id rather than by key, so replay costs one array index per record.
+        /// </summary>
+        private int ReplayInteractionLog()
+        {
+            var batch = new InteractionRecord[1024];
+            var byLabelId = new List<WordStats>();
+            long position = 0;
+            int replayed = 0;
+            int read;
+            while ((read = interactionLog.Read(position, batch, out position)) > 0)
+            {
+                for (int i = 0; i < read; i++)
+                {
+                    var record = batch[i];
+                    if (record.labelId < 0) continue;
+                    while (byLabelId.Count <= record.labelId) byLabelId.Add(null);
+                    var stats = byLabelId[record.labelId];
+                    if (stats == null)
+                    {
+                        string key = interactionLog.GetString(record.labelId);
+                        if (key == null) continue;
+                        stats = GetOrAddWordStats(key, record.timestamp);
+                        byLabelId[record.labelId] = stats;
+                    }
+                    ApplyInteraction(stats, record.success, record.duration, record.timestamp);
+                    rollups.Record(stats.wordKey, record.success, record.duration, record.timestamp);
+                    AdjustDifficulty(stats, record.timestamp);
+                    if (record.position >= scheduleThrough) Schedule(stats.wordKey, record.action, record.success, record.duration, record.timestamp);
+                }
+                replayed += read;
+            }
+            return replayed;
         }
         
         public void LogInteraction(string anchorId, string labelKey, InteractionType action, bool success, float duration = 0f)
@@ -101,19 +322,21 @@ namespace ARLinguaSphere.Analytics
                 return;
             }
             
+            long timestamp = System.DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
+            long position = interactionLog != null ? interactionLog.Append(action, labelKey, anchorId, success, duration, timestamp) : -1;
             var interaction = new InteractionData
             {
-                id = System.Guid.NewGuid().ToString(),
+                // Log positions are unique on this device and survive restarts
+                id = position >= 0 ? position.ToString(System.Globalization.CultureInfo.InvariantCulture) : System.Guid.NewGuid().ToString(),
                 userId = userId,
                 anchorId = anchorId,
                 labelKey = labelKey,
                 action = action,
                 success = success,
                 duration = duration,
-                timestamp = System.DateTimeOffset.UtcNow.ToUnixTimeMilliseconds()
+                timestamp = timestamp
             };
             
-            localInteractions.Add(interaction);
             OnInteractionLogged?.Invoke(interaction);
             
             // Update word statistics
@@ -121,95 +344,151 @@ namespace ARLinguaSphere.Analytics
             
             // Check for adaptive learning opportunities
             CheckAdaptiveLearning(interaction);
+            Schedule(labelKey, action, success, duration, timestamp);
             
             Debug.Log($"AnalyticsManager: Logged interaction - {action} for {labelKey} (success: {success})");
         }
         
         private void UpdateWordStatistics(InteractionData interaction)
         {
-            if (!wordStatistics.ContainsKey(interaction.labelKey))
+            var stats = GetOrAddWordStats(interaction.labelKey, interaction.timestamp);
+            ApplyInteraction(stats, interaction.success, interaction.duration, interaction.timestamp);
+            rollups.Record(interaction.labelKey, interaction.success, interaction.duration, interaction.timestamp);
+        }
+        
+        private WordStats GetOrAddWordStats(string wordKey, long timestamp)
+        {
+            if (!wordStatistics.TryGetValue(wordKey, out var stats))
             {
-                wordStatistics[interaction.labelKey] = new WordStats
+                stats = new WordStats
                 {
-                    wordKey = interaction.labelKey,
+                    wordKey = wordKey,
                     totalInteractions = 0,
                     successfulInteractions = 0,
                     averageResponseTime = 0f,
                     difficultyLevel = 1f,
-                    lastSeen = interaction.timestamp
+                    lastSeen = timestamp
                 };
+                wordStatistics[wordKey] = stats;
             }
-            
-            var stats = wordStatistics[interaction.labelKey];
+            return stats;
+        }
+        
+        private static void ApplyInteraction(WordStats stats, bool success, float duration, long timestamp)
+        {
             stats.totalInteractions++;
-            stats.lastSeen = interaction.timestamp;
+            stats.lastSeen = timestamp;
             
-            if (interaction.success)
+            if (success)
             {
                 stats.successfulInteractions++;
             }
             
             // Update average response time
-            if (interaction.duration > 0)
+            if (duration > 0)
             {
-                stats.averageResponseTime = (stats.averageResponseTime * (stats.totalInteractions - 1) + interaction.duration) / stats.totalInteractions;
+                stats.averageResponseTime = (stats.averageResponseTime * (stats.totalInteractions - 1) + duration) / stats.totalInteractions;
             }
         }
         
         private void CheckAdaptiveLearning(InteractionData interaction)
         {
-            if (!wordStatistics.ContainsKey(interaction.labelKey))
+            if (!wordStatistics.TryGetValue(interaction.labelKey, out var stats))
             {
                 return;
             }
             
-            var stats = wordStatistics[interaction.labelKey];
+            int direction = AdjustDifficulty(stats, interaction.timestamp);
+            quizIndex.Update(interaction.labelKey, QuizScore(stats));
+            if (direction > 0)
+            {
+                OnDifficultyAdjusted?.Invoke(interaction.labelKey, stats.difficultyLevel);
+                Debug.Log($"AnalyticsManager: Increased difficulty for '{interaction.labelKey}' to {stats.difficultyLevel:F2}");
+            }
+            else if (direction < 0)
+            {
+                OnDifficultyAdjusted?.Invoke(interaction.labelKey, stats.difficultyLevel);
+                Debug.Log($"AnalyticsManager: Decreased difficulty for '{interaction.labelKey}' to {stats.difficultyLevel:F2}");
+            }
+        }
+        
+        /// <summary>
+        /// Moves the word's difficulty one step by its error rate: 1 raised, -1 lowered, 0 unchanged. Replay runs the same
+        /// rule over the log, so difficulty is derived rather than stored. The error rate is the word's over the last
+        /// adaptationWindowDays up to <paramref name="now"/>, so old mistakes stop counting against it.
+        /// </summary>
+        private int AdjustDifficulty(WordStats stats, long now)
+        {
+            var recent = rollups.QueryWord(stats.wordKey, adaptationWindowDays * InteractionRollups.Day, now);
             
             // Only adapt if we have enough samples
-            if (stats.totalInteractions < minSamplesForAdaptation)
+            if (recent.count < minSamplesForAdaptation)
             {
-                return;
+                return 0;
             }
             
-            float errorRate = 1f - (float)stats.successfulInteractions / stats.totalInteractions;
+            float errorRate = recent.ErrorRate;
             
             if (errorRate > errorRateThreshold)
             {
                 // Increase difficulty for this word
                 stats.difficultyLevel = Mathf.Min(3f, stats.difficultyLevel + difficultyAdjustmentRate);
-                OnDifficultyAdjusted?.Invoke(interaction.labelKey, stats.difficultyLevel);
-                Debug.Log($"AnalyticsManager: Increased difficulty for '{interaction.labelKey}' to {stats.difficultyLevel:F2}");
+                return 1;
             }
-            else if (errorRate < errorRateThreshold * 0.5f)
+            if (errorRate < errorRateThreshold * 0.5f)
             {
                 // Decrease difficulty for this word
                 stats.difficultyLevel = Mathf.Max(0.5f, stats.difficultyLevel - difficultyAdjustmentRate);
-                OnDifficultyAdjusted?.Invoke(interaction.labelKey, stats.difficultyLevel);
-                Debug.Log($"AnalyticsManager: Decreased difficulty for '{interaction.labelKey}' to {stats.difficultyLevel:F2}");
+                return -1;
             }
+            return 0;
         }
         
+        /// <summary>
+        /// The words most in need of practice: highest difficulty times error rate first. Read from quizIndex, which is
+        /// kept current as interactions are logged, so this costs O(count log count) whatever the vocabulary size.
+        /// </summary>
         public List<string> GetWordsForQuiz(int count = 5)
         {
-            var quizWords = new List<string>();
-            
-            // Sort words by difficulty and recent performance
-            var sortedWords = new List<KeyValuePair<string, WordStats>>(wordStatistics);
-            sortedWords.Sort((a, b) => 
-            {
-                // Prioritize words with higher difficulty and lower success rate
-                float scoreA = a.Value.difficultyLevel * (1f - (float)a.Value.successfulInteractions / a.Value.totalInteractions);
-                float scoreB = b.Value.difficultyLevel * (1f - (float)b.Value.successfulInteractions / b.Value.totalInteractions);
-                return scoreB.CompareTo(scoreA);
-            });
-            
-            // Select top words for quiz
-            for (int i = 0; i < Mathf.Min(count, sortedWords.Count); i++)
+            var quizWords = new List<string>(Mathf.Max(0, count));
+            quizIndex.Top(count, quizWords);
+            return quizWords;
+        }
+        
+        /// <summary>
+        /// Words whose review is due, most overdue first
+        /// </summary>
+        public List<string> GetDueWords(int count = 5)
+        {
+            var dueWords = new List<string>(Mathf.Max(0, count));
+            scheduler.GetDue(DateTimeOffset.UtcNow.ToUnixTimeMilliseconds(), count, dueWords);
+            return dueWords;
+        }
+        
+        public bool TryGetReviewCard(string wordKey, out ReviewCard card)
+        {
+            return scheduler.TryGetCard(wordKey, out card);
+        }
+        
+        /// <summary>
+        /// Prioritize words with higher difficulty and lower success rate; words never answered score 0
+        /// </summary>
+        public static float QuizScore(WordStats stats)
+        {
+            if (stats.totalInteractions <= 0)
             {
-                quizWords.Add(sortedWords[i].Key);
+                return 0f;
+            }
+            return stats.difficultyLevel * (1f - (float)stats.successfulInteractions / stats.totalInteractions);
+        }
+        
+        private void RebuildQuizIndex()
+        {
+            quizIndex.Clear();
+            foreach (var stats in wordStatistics.Values)
+            {
+                quizIndex.Update(stats.wordKey, QuizScore(stats));
             }
-            
-            return quizWords;
         }
         
         public WordStats GetWordStats(string wordKey)
@@ -225,20 +504,9 @@ namespace ARLinguaSphere.Analytics
             }
             try
             {
-                // Persist word stats only (compact)
-                var root = new System.Text.StringBuilder();
-                root.Append("{\"wordStats\":{");
-                bool first = true;
-                foreach (var kv in wordStatistics)
-                {
-                    if (!first) root.Append(",");
-                    first = false;
-                    var ws = kv.Value;
-                    root.Append($"\"{ws.wordKey}\":{{\"totalInteractions\":{ws.totalInteractions},\"successfulInteractions\":{ws.successfulInteractions},\"averageResponseTime\":{ws.averageResponseTime},\"difficultyLevel\":{ws.difficultyLevel},\"lastSeen\":{ws.lastSeen}}}");
-                }
-                root.Append("}}");
-                PlayerPrefs.SetString("ALS_Analytics_Local", root.ToString());
-                PlayerPrefs.Save();
+                // Every interaction is already in the log; make sure it reaches the disk before the app is suspended
+                interactionLog?.Flush();
+                SaveSchedule();
             }
             catch (System.Exception e)
             {
@@ -247,28 +515,67 @@ namespace ARLinguaSphere.Analytics
             Debug.Log("AnalyticsManager: Session data saved");
         }
         
+        /// <summary>
+        /// Upload what has been logged now rather than at the next syncInterval
+        /// </summary>
         public void SyncToCloud()
         {
             if (!enableCloudSync || !isInitialized)
             {
                 return;
             }
-            
-            // TODO: Sync data to Firebase Analytics
-            Debug.Log("AnalyticsManager: Syncing data to cloud...");
+            uploader?.Wake();
         }
         
-        public void ExportUserData()
+        /// <summary>
+        /// Writes every logged interaction as a columnar file (see ColumnarExport) under persistentDataPath/exports, in
+        /// the background. <paramref name="onComplete"/> receives the file's path, or null on failure, on a worker thread.
+        /// </summary>
+        public void ExportUserData(Action<string> onComplete = null)
         {
-            // TODO: Export user data for GDPR compliance
-            Debug.Log("AnalyticsManager: User data exported");
+            var log = interactionLog;
+            if (log == null)
+            {
+                Debug.LogWarning("AnalyticsManager: Nothing to export, the interaction log is unavailable");
+                onComplete?.Invoke(null);
+                return;
+            }
+            string path = Path.Combine(Application.persistentDataPath, "exports", $"interactions-{DateTime.UtcNow:yyyyMMdd-HHmmss}.alsc");
+            Task.Run(() =>
+            {
+                try
+                {
+                    var timer = System.Diagnostics.Stopwatch.StartNew();
+                    Directory.CreateDirectory(Path.GetDirectoryName(path));
+                    long exported;
+                    using (var file = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, 1 << 16))
+                    {
+                        exported = new ColumnarExport().Export(log, file);
+                    }
+                    Debug.Log($"AnalyticsManager: Exported {exported} interactions to {path} in {timer.Elapsed.TotalMilliseconds:F0}ms");
+                    onComplete?.Invoke(path);
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException || e is ObjectDisposedException)
+                {
+                    Debug.LogWarning($"AnalyticsManager: User data export failed: {e.Message}");
+                    onComplete?.Invoke(null);
+                }
+            });
         }
         
         public void DeleteUserData()
         {
             // TODO: Delete user data for GDPR compliance
-            localInteractions.Clear();
             wordStatistics.Clear();
+            quizIndex.Clear();
+            rollups.Clear();
+            WaitForScheduleSave();
+            scheduler.Clear();
+            scheduleThrough = 0;
+            StopCloudSync();
+            interactionLog?.Clear();
+            PlayerPrefs.DeleteKey("ALS_Analytics_Local");
+            StartCloudSync();
             Debug.Log("AnalyticsManager: User data deleted");
         }
         
@@ -287,6 +594,14 @@ namespace ARLinguaSphere.Analytics
                 SaveSessionData();
             }
         }
+        
+        private void OnDestroy()
+        {
+            SaveSchedule();
+            WaitForScheduleSave();
+            StopCloudSync();
+            interactionLog?.Dispose();
+        }
     }
     
     /// <summary>
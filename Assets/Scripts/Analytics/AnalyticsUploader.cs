@@ -0,0 +1,456 @@
+using System;
+using System.Buffers.Text;
+using System.IO;
+using System.IO.Compression;
+using System.Text;
+using System.Threading;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Uploads the interaction log from a background thread. Records are read from a persisted checkpoint, encoded as
+    /// JSON into a reused buffer and sent as gzipped POSTs of at most MaxBatchBytes. The checkpoint advances only once
+    /// the endpoint accepts a batch, so every interaction arrives at least once and in order (event ids are log
+    /// positions, for deduplication). Backpressure: one batch in flight, Retry-After honoured on 429 and 503, 413 halves
+    /// the batch size, other failures back off exponentially with jitter. The log on disk holds any backlog, so
+    /// LogInteraction never waits on the network.
+    /// </summary>
+    public sealed class AnalyticsUploader : IDisposable
+    {
+        public const int DefaultMaxBatchBytes = 64 * 1024;
+        public const string CheckpointFile = "upload.checkpoint";
+
+        public string Endpoint { get; }
+        public int MaxBatchBytes => maxBatchBytes;
+        public float IntervalSeconds { get; set; } = 30f;
+        public float BaseBackoffSeconds { get; set; } = 1f;
+        public float MaxBackoffSeconds { get; set; } = 300f;
+        public int MaxRetries { get; set; } = 3; // consecutive failures before a warning; the batch is retried regardless
+        public long Checkpoint => Interlocked.Read(ref checkpoint);
+        public AnalyticsUploadMetrics Metrics => metrics;
+
+        private const int MinBatchBytes = 1024;
+        private const int StopPollMs = 50; // how often a worker waiting on a response checks for Dispose
+
+        private readonly InteractionLog log;
+        private readonly RestClient rest = new RestClient(1);
+        private readonly InteractionBatchEncoder encoder;
+        private readonly InteractionRecord[] records = new InteractionRecord[256];
+        private readonly MemoryStream compressed = new MemoryStream(DefaultMaxBatchBytes);
+        private readonly AutoResetEvent wake = new AutoResetEvent(false);
+        private readonly System.Random jitter = new System.Random();
+        private readonly FileStream checkpointFile;
+        private readonly byte[] checkpointBytes = new byte[8];
+        private Thread thread;
+        private volatile bool stopping;
+        private int maxBatchBytes;
+        private long checkpoint;
+        private long readPosition; // next position to read from the log
+        private int recordIndex; // records[recordIndex..recordCount) are read but not yet in a batch
+        private int recordCount;
+        private double compressionRatio = 4.0; // uncompressed / compressed, learned from sent batches
+        private int failures;
+        private AnalyticsUploadMetrics metrics;
+
+        /// <summary>
+        /// Resumes from the checkpoint kept next to <paramref name="log"/>'s segments. Call Start to begin uploading.
+        /// </summary>
+        public AnalyticsUploader(InteractionLog log, string endpoint, string userId, int maxBatchBytes = DefaultMaxBatchBytes)
+        {
+            this.log = log;
+            Endpoint = endpoint;
+            this.maxBatchBytes = Math.Max(MinBatchBytes, maxBatchBytes);
+            encoder = new InteractionBatchEncoder(userId);
+            checkpointFile = new FileStream(Path.Combine(log.DirectoryPath, CheckpointFile), FileMode.OpenOrCreate, FileAccess.ReadWrite, FileShare.Read);
+            if (checkpointFile.Read(checkpointBytes, 0, 8) == 8) checkpoint = BitConverter.ToInt64(checkpointBytes, 0);
+            checkpoint = Math.Max(log.StartPosition, Math.Min(checkpoint, log.EndPosition));
+            readPosition = checkpoint;
+        }
+
+        public void Start()
+        {
+            if (thread != null) return;
+            thread = new Thread(Run) { IsBackground = true, Name = "AnalyticsUploader" };
+            thread.Start();
+        }
+
+        /// <summary>
+        /// Upload what is logged now instead of at the next interval (still after any backoff in progress).
+        /// </summary>
+        public void Wake()
+        {
+            wake.Set();
+        }
+
+        /// <summary>
+        /// Stop uploading. A batch still waiting for its response is abandoned (it is re-sent by the next uploader,
+        /// as the checkpoint has not moved), so this returns promptly and the worker never touches the checkpoint
+        /// file once it is closed.
+        /// </summary>
+        public void Dispose()
+        {
+            stopping = true;
+            wake.Set();
+            thread?.Join();
+            rest.Dispose();
+            checkpointFile.Dispose();
+            wake.Dispose();
+        }
+
+        private void Run()
+        {
+            int delayMs = 0;
+            while (!stopping)
+            {
+                wake.WaitOne(delayMs);
+                delayMs = (int)(IntervalSeconds * 1000f);
+                while (!stopping)
+                {
+                    int sent = SendBatch(out int retryMs);
+                    if (retryMs > 0)
+                    {
+                        delayMs = retryMs;
+                        break;
+                    }
+                    if (sent == 0) break;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Encode, compress and send one batch from the checkpoint. Returns the events sent (0 when caught up) and, on
+        /// failure, how long to wait before trying again.
+        /// </summary>
+        private int SendBatch(out int retryMs)
+        {
+            retryMs = 0;
+            int maxEvents = int.MaxValue;
+            int events;
+            while (true)
+            {
+                events = Encode(maxEvents);
+                if (events == 0) return 0;
+                Compress();
+                if (compressed.Length <= maxBatchBytes || events == 1) break;
+                // The ratio guess was optimistic: retry with fewer events
+                Rewind();
+                maxEvents = events / 2;
+            }
+
+            var request = new RestRequest("POST", Endpoint, compressed.GetBuffer(), (int)compressed.Length, "application/json");
+            request.SetRequestHeader("Content-Encoding", "gzip");
+            rest.Send(request);
+            if (!AwaitResponse(request, (int)(rest.TimeoutSeconds * 2000f)))
+            {
+                Rewind();
+                if (!stopping) retryMs = Backoff("timed out");
+                return 0;
+            }
+            if (request.Success)
+            {
+                compressionRatio = Math.Max(1.0, Math.Min(20.0, (double)encoder.Length / compressed.Length));
+                Commit(encoder.LastPosition + 1);
+                failures = 0;
+                metrics.batches++;
+                metrics.events += events;
+                metrics.bytesUncompressed += encoder.Length;
+                metrics.bytesSent += compressed.Length;
+                return events;
+            }
+
+            Rewind();
+            metrics.failures++;
+            if (request.StatusCode == 413 && maxBatchBytes > MinBatchBytes)
+            {
+                maxBatchBytes = Math.Max(MinBatchBytes, maxBatchBytes / 2);
+                retryMs = 1;
+                return 0;
+            }
+            if (request.StatusCode == 429 || request.StatusCode == 503)
+            {
+                string retryAfter = request.GetResponseHeader("Retry-After");
+                if (int.TryParse(retryAfter, out int seconds) && seconds >= 0)
+                {
+                    retryMs = Math.Max(1, (int)Math.Min(seconds * 1000L, (long)(MaxBackoffSeconds * 1000f)));
+                    return 0;
+                }
+            }
+            retryMs = Backoff(request.Error);
+            return 0;
+        }
+
+        /// <summary>
+        /// Wait up to <paramref name="timeoutMs"/> for the response, giving up early once Dispose has been called
+        /// </summary>
+        private bool AwaitResponse(RestRequest request, int timeoutMs)
+        {
+            for (int waited = 0; waited < timeoutMs && !stopping; waited += StopPollMs)
+            {
+                if (request.Wait(Math.Min(StopPollMs, timeoutMs - waited))) return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Encode up to <paramref name="maxEvents"/> records after the checkpoint, stopping when the uncompressed size
+        /// should compress to about MaxBatchBytes. Returns the number of events encoded. The batch ends before a gap that
+        /// skips a whole segment, since every sealed segment holds at least one interaction, so the checkpoint never
+        /// moves past records the log failed to return; the next batch reads from the gap again.
+        /// </summary>
+        private int Encode(int maxEvents)
+        {
+            int target = (int)Math.Min(int.MaxValue / 2, maxBatchBytes * compressionRatio * 0.9);
+            long expected = Interlocked.Read(ref checkpoint);
+            encoder.Begin();
+            int events = 0;
+            while (events < maxEvents && encoder.Length < target)
+            {
+                if (recordIndex == recordCount)
+                {
+                    recordIndex = 0;
+                    recordCount = log.Read(readPosition, records, out readPosition);
+                    if (recordCount == 0) break;
+                }
+                long position = records[recordIndex].position;
+                long segmentStart = (expected + log.SegmentRecords - 1) / log.SegmentRecords * log.SegmentRecords;
+                if (segmentStart + log.SegmentRecords <= position)
+                {
+                    if (events == 0) UnityEngine.Debug.LogWarning($"AnalyticsUploader: Interactions {expected} to {position} missing from the log, holding the checkpoint");
+                    readPosition = expected;
+                    recordIndex = 0;
+                    recordCount = 0;
+                    break;
+                }
+                encoder.Add(records[recordIndex], log);
+                expected = position + 1;
+                recordIndex++;
+                events++;
+            }
+            encoder.End();
+            return events;
+        }
+
+        private void Compress()
+        {
+            compressed.SetLength(0);
+            using (var gzip = new GZipStream(compressed, CompressionLevel.Optimal, true))
+            {
+                gzip.Write(encoder.Buffer, 0, encoder.Length);
+            }
+        }
+
+        /// <summary>
+        /// Forget what was read past the checkpoint; the next batch re-reads it
+        /// </summary>
+        private void Rewind()
+        {
+            readPosition = Interlocked.Read(ref checkpoint);
+            recordIndex = 0;
+            recordCount = 0;
+        }
+
+        private void Commit(long position)
+        {
+            Interlocked.Exchange(ref checkpoint, position);
+            long value = position;
+            for (int i = 0; i < 8; i++)
+            {
+                checkpointBytes[i] = (byte)value;
+                value >>= 8;
+            }
+            checkpointFile.Position = 0;
+            checkpointFile.Write(checkpointBytes, 0, 8);
+            checkpointFile.Flush(true);
+        }
+
+        private int Backoff(string error)
+        {
+            failures++;
+            if (failures == MaxRetries) UnityEngine.Debug.LogWarning($"AnalyticsUploader: Upload failing ({error}) after {failures} attempts, {log.EndPosition - Checkpoint} interactions waiting");
+            double seconds = Math.Min(MaxBackoffSeconds, BaseBackoffSeconds * Math.Pow(2, Math.Min(failures - 1, 16)));
+            seconds *= 0.5 + jitter.NextDouble() * 0.5;
+            return Math.Max(1, (int)(seconds * 1000));
+        }
+    }
+
+    /// <summary>
+    /// Writes interaction records as a JSON batch, {"userId":..,"events":[{"id":..,"action":..,..},..]}, into a reused
+    /// UTF-8 buffer. Numbers are formatted in place and strings copied from the log's string table, so adding an event
+    /// allocates nothing once the buffer has grown to batch size.
+    /// </summary>
+    public sealed class InteractionBatchEncoder
+    {
+        public byte[] Buffer => buffer;
+        public int Length => length;
+        public int Count => count;
+        public long LastPosition { get; private set; } = -1;
+
+        private static readonly byte[][] ActionNames = BuildActionNames();
+        private readonly byte[] prefix;
+        private byte[] buffer = new byte[4096];
+        private int length;
+        private int count;
+
+        public InteractionBatchEncoder(string userId)
+        {
+            var builder = new StringBuilder("{\"userId\":");
+            AppendQuoted(builder, userId);
+            builder.Append(",\"events\":[");
+            prefix = Encoding.UTF8.GetBytes(builder.ToString());
+        }
+
+        public void Begin()
+        {
+            length = 0;
+            count = 0;
+            LastPosition = -1;
+            WriteRaw(prefix);
+        }
+
+        public void Add(in InteractionRecord record, InteractionLog log)
+        {
+            if (count > 0) WriteByte((byte)',');
+            WriteAscii("{\"id\":");
+            WriteNumber(record.position);
+            WriteAscii(",\"action\":");
+            int action = (int)record.action;
+            if (action >= 0 && action < ActionNames.Length) WriteRaw(ActionNames[action]);
+            else WriteNumber(action);
+            WriteAscii(",\"label\":");
+            WriteString(log.GetString(record.labelId));
+            WriteAscii(",\"anchor\":");
+            WriteString(log.GetString(record.anchorId));
+            WriteAscii(record.success ? ",\"success\":true,\"duration\":" : ",\"success\":false,\"duration\":");
+            Reserve(32);
+            Utf8Formatter.TryFormat(record.duration, new Span<byte>(buffer, length, buffer.Length - length), out int written);
+            length += written;
+            WriteAscii(",\"timestamp\":");
+            WriteNumber(record.timestamp);
+            WriteByte((byte)'}');
+            count++;
+            LastPosition = record.position;
+        }
+
+        public void End()
+        {
+            WriteAscii("]}");
+        }
+
+        private void WriteNumber(long value)
+        {
+            Reserve(24);
+            Utf8Formatter.TryFormat(value, new Span<byte>(buffer, length, buffer.Length - length), out int written);
+            length += written;
+        }
+
+        /// <summary>
+        /// JSON string or null. Runs of plain characters are encoded straight into the buffer; only quotes, backslashes
+        /// and control characters are escaped, and those are ASCII, so surrogate pairs are never split.
+        /// </summary>
+        private void WriteString(string value)
+        {
+            if (value == null)
+            {
+                WriteAscii("null");
+                return;
+            }
+            Reserve(Encoding.UTF8.GetMaxByteCount(value.Length) + 2);
+            buffer[length++] = (byte)'"';
+            int run = 0;
+            for (int i = 0; i < value.Length; i++)
+            {
+                char c = value[i];
+                if (c != '"' && c != '\\' && c >= ' ') continue;
+                length += Encoding.UTF8.GetBytes(value, run, i - run, buffer, length);
+                run = i + 1;
+                Reserve(6 + Encoding.UTF8.GetMaxByteCount(value.Length - i));
+                buffer[length++] = (byte)'\\';
+                if (c == '"' || c == '\\')
+                {
+                    buffer[length++] = (byte)c;
+                    continue;
+                }
+                buffer[length++] = (byte)'u';
+                buffer[length++] = (byte)'0';
+                buffer[length++] = (byte)'0';
+                buffer[length++] = (byte)"0123456789abcdef"[c >> 4];
+                buffer[length++] = (byte)"0123456789abcdef"[c & 0xF];
+            }
+            length += Encoding.UTF8.GetBytes(value, run, value.Length - run, buffer, length);
+            buffer[length++] = (byte)'"';
+        }
+
+        private void WriteAscii(string text)
+        {
+            Reserve(text.Length);
+            for (int i = 0; i < text.Length; i++)
+            {
+                buffer[length++] = (byte)text[i];
+            }
+        }
+
+        private void WriteRaw(byte[] bytes)
+        {
+            Reserve(bytes.Length);
+            System.Buffer.BlockCopy(bytes, 0, buffer, length, bytes.Length);
+            length += bytes.Length;
+        }
+
+        private void WriteByte(byte value)
+        {
+            Reserve(1);
+            buffer[length++] = value;
+        }
+
+        private void Reserve(int bytes)
+        {
+            if (length + bytes <= buffer.Length) return;
+            int size = buffer.Length;
+            while (size < length + bytes) size *= 2;
+            Array.Resize(ref buffer, size);
+        }
+
+        private static byte[][] BuildActionNames()
+        {
+            var values = (InteractionType[])Enum.GetValues(typeof(InteractionType));
+            int max = 0;
+            foreach (var value in values) max = Math.Max(max, (int)value);
+            var names = new byte[max + 1][];
+            foreach (var value in values)
+            {
+                names[(int)value] = Encoding.ASCII.GetBytes("\"" + value + "\"");
+            }
+            return names;
+        }
+
+        private static void AppendQuoted(StringBuilder builder, string value)
+        {
+            if (value == null)
+            {
+                builder.Append("null");
+                return;
+            }
+            builder.Append('"');
+            foreach (char c in value)
+            {
+                if (c == '"' || c == '\\') builder.Append('\\').Append(c);
+                else if (c < ' ') builder.Append("\\u").Append(((int)c).ToString("x4"));
+                else builder.Append(c);
+            }
+            builder.Append('"');
+        }
+    }
+
+    /// <summary>
+    /// Running totals of AnalyticsUploader
+    /// </summary>
+    public struct AnalyticsUploadMetrics
+    {
+        public long batches;
+        public long events;
+        public long bytesUncompressed;
+        public long bytesSent;
+        public long failures;
+    }
+}
@@ -0,0 +1,369 @@
+using System;
+using System.Buffers.Binary;
+using System.IO;
+using System.IO.Compression;
+using System.Text;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Converts the interaction log into a columnar file for offline analysis, streaming block by block so memory stays
+    /// flat whatever the log size. Layout (little-endian):
+    /// <code>
+    /// header  "ALSC" int32 version, int32 block records
+    /// block   int32 records, int64 first position, int32 raw length, int32 compressed length, deflate(raw)
+    ///         raw = int32 x4 lengths of the varint columns, then the columns:
+    ///           position  varint delta - 1 from the previous record (first: 0)
+    ///           action    byte per record
+    ///           success   bit per record, LSB first
+    ///           label     varint string id + 1 (0 = none)
+    ///           anchor    varint string id + 1 (0 = none)
+    ///           duration  float32 per record
+    ///           timestamp zigzag varint delta from the previous record (first: from 0)
+    /// footer  varint string count, per string varint length + UTF-8; int64 records, int32 blocks, int64 offset per
+    ///         block; then int64 footer offset, "ALSC"
+    /// </code>
+    /// Label keys and anchor ids are dictionary-encoded with the log's own string ids.
+    /// </summary>
+    public sealed class ColumnarExport
+    {
+        public const int Version = 1;
+        public const int DefaultBlockRecords = 65536;
+        public const int Magic = 0x43534C41; // "ALSC"
+        public const int HeaderSize = 12;
+        public const int BlockHeaderSize = 20;
+
+        private readonly InteractionRecord[] records; // one block
+        private readonly InteractionRecord[] chunk; // one log read
+        private readonly CompressionLevel level;
+        private readonly MemoryStream compressed = new MemoryStream();
+        private readonly byte[] header = new byte[BlockHeaderSize];
+        private byte[] raw = new byte[1 << 16];
+        private byte[] varints = new byte[1 << 16];
+
+        public ColumnarExport(int blockRecords = DefaultBlockRecords, CompressionLevel level = CompressionLevel.Fastest)
+        {
+            records = new InteractionRecord[Math.Max(1, blockRecords)];
+            chunk = new InteractionRecord[Math.Min(records.Length, 4096)];
+            this.level = level;
+        }
+
+        /// <summary>
+        /// Write records [<paramref name="from"/>, the log's end when called) to <paramref name="output"/>, which need
+        /// not be seekable. Safe to run off the main thread while interactions are logged. Returns the record count.
+        /// </summary>
+        public long Export(InteractionLog log, Stream output, long from = 0)
+        {
+            long end = log.EndPosition;
+            long written = 0;
+            long total = 0;
+            var blockOffsets = new MemoryStream();
+
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 0, 4), Magic);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 4, 4), Version);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 8, 4), records.Length);
+            output.Write(header, 0, HeaderSize);
+            written += HeaderSize;
+
+            long position = from;
+            int blocks = 0;
+            while (position < end)
+            {
+                int count = Fill(log, ref position, end);
+                if (count == 0) break;
+                WriteLong(blockOffsets, written);
+                written += WriteBlock(output, count);
+                total += count;
+                blocks++;
+            }
+
+            // Footer: the string table as it stands now covers every id the blocks use
+            long footerOffset = written;
+            var footer = new MemoryStream();
+            int strings = log.StringCount;
+            WriteVarint(footer, (uint)strings);
+            for (int id = 0; id < strings; id++)
+            {
+                var bytes = Encoding.UTF8.GetBytes(log.GetString(id) ?? string.Empty);
+                WriteVarint(footer, (uint)bytes.Length);
+                footer.Write(bytes, 0, bytes.Length);
+            }
+            WriteLong(footer, total);
+            WriteInt(footer, blocks);
+            blockOffsets.Position = 0;
+            blockOffsets.CopyTo(footer);
+            WriteLong(footer, footerOffset);
+            WriteInt(footer, Magic);
+            footer.Position = 0;
+            footer.CopyTo(output);
+            output.Flush();
+            return total;
+        }
+
+        /// <summary>
+        /// Read up to one block of records from the log, never past <paramref name="end"/>
+        /// </summary>
+        private int Fill(InteractionLog log, ref long position, long end)
+        {
+            int count = 0;
+            while (count < records.Length && position < end)
+            {
+                int read = log.Read(position, chunk, out long next);
+                if (read == 0) break;
+                // Stop at a full block, and leave records appended after the export started for the next export
+                int take = 0;
+                while (take < read && count + take < records.Length && chunk[take].position < end) take++;
+                Array.Copy(chunk, 0, records, count, take);
+                count += take;
+                if (take == read) position = next;
+                else position = take > 0 ? chunk[take - 1].position + 1 : end;
+            }
+            return count;
+        }
+
+        private int WriteBlock(Stream output, int count)
+        {
+            // Varint columns go to their own buffer first so their lengths can lead the block
+            int varintLength = 0;
+            int positionsStart = varintLength;
+            long previous = records[0].position - 1;
+            for (int i = 0; i < count; i++)
+            {
+                PutVarint(ref varints, ref varintLength, (ulong)(records[i].position - previous - 1));
+                previous = records[i].position;
+            }
+            int labelsStart = varintLength;
+            for (int i = 0; i < count; i++) PutVarint(ref varints, ref varintLength, (ulong)(records[i].labelId + 1));
+            int anchorsStart = varintLength;
+            for (int i = 0; i < count; i++) PutVarint(ref varints, ref varintLength, (ulong)(records[i].anchorId + 1));
+            int timestampsStart = varintLength;
+            long last = 0;
+            for (int i = 0; i < count; i++)
+            {
+                long delta = records[i].timestamp - last;
+                PutVarint(ref varints, ref varintLength, (ulong)((delta << 1) ^ (delta >> 63)));
+                last = records[i].timestamp;
+            }
+
+            int successBytes = (count + 7) / 8;
+            int rawLength = 16 + varintLength + count + successBytes + count * 4;
+            if (raw.Length < rawLength) raw = new byte[Math.Max(rawLength, raw.Length * 2)];
+            var span = new Span<byte>(raw, 0, rawLength);
+            BinaryPrimitives.WriteInt32LittleEndian(span, labelsStart - positionsStart);
+            BinaryPrimitives.WriteInt32LittleEndian(span.Slice(4), anchorsStart - labelsStart);
+            BinaryPrimitives.WriteInt32LittleEndian(span.Slice(8), timestampsStart - anchorsStart);
+            BinaryPrimitives.WriteInt32LittleEndian(span.Slice(12), varintLength - timestampsStart);
+            int at = 16;
+            Buffer.BlockCopy(varints, positionsStart, raw, at, labelsStart - positionsStart);
+            at += labelsStart - positionsStart;
+            for (int i = 0; i < count; i++) raw[at + i] = (byte)records[i].action;
+            at += count;
+            Array.Clear(raw, at, successBytes);
+            for (int i = 0; i < count; i++)
+            {
+                if (records[i].success) raw[at + (i >> 3)] |= (byte)(1 << (i & 7));
+            }
+            at += successBytes;
+            Buffer.BlockCopy(varints, labelsStart, raw, at, timestampsStart - labelsStart);
+            at += timestampsStart - labelsStart;
+            for (int i = 0; i < count; i++)
+            {
+                BinaryPrimitives.WriteInt32LittleEndian(span.Slice(at), BitConverter.SingleToInt32Bits(records[i].duration));
+                at += 4;
+            }
+            Buffer.BlockCopy(varints, timestampsStart, raw, at, varintLength - timestampsStart);
+
+            compressed.SetLength(0);
+            using (var deflate = new DeflateStream(compressed, level, true))
+            {
+                deflate.Write(raw, 0, rawLength);
+            }
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 0, 4), count);
+            BinaryPrimitives.WriteInt64LittleEndian(new Span<byte>(header, 4, 8), records[0].position);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 12, 4), rawLength);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 16, 4), (int)compressed.Length);
+            output.Write(header, 0, BlockHeaderSize);
+            output.Write(compressed.GetBuffer(), 0, (int)compressed.Length);
+            return BlockHeaderSize + (int)compressed.Length;
+        }
+
+        private static void PutVarint(ref byte[] buffer, ref int length, ulong value)
+        {
+            if (length + 10 > buffer.Length) Array.Resize(ref buffer, buffer.Length * 2);
+            while (value >= 0x80)
+            {
+                buffer[length++] = (byte)(value | 0x80);
+                value >>= 7;
+            }
+            buffer[length++] = (byte)value;
+        }
+
+        private static void WriteVarint(Stream stream, uint value)
+        {
+            while (value >= 0x80)
+            {
+                stream.WriteByte((byte)(value | 0x80));
+                value >>= 7;
+            }
+            stream.WriteByte((byte)value);
+        }
+
+        private void WriteInt(Stream stream, int value)
+        {
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(header, 0, 4), value);
+            stream.Write(header, 0, 4);
+        }
+
+        private void WriteLong(Stream stream, long value)
+        {
+            BinaryPrimitives.WriteInt64LittleEndian(new Span<byte>(header, 0, 8), value);
+            stream.Write(header, 0, 8);
+        }
+    }
+
+    /// <summary>
+    /// Reads a file written by ColumnarExport, one block at a time, from a seekable stream
+    /// </summary>
+    public sealed class ColumnarExportReader
+    {
+        public long RecordCount { get; }
+        public int BlockCount => blockOffsets.Length;
+        public int BlockRecords { get; }
+        public int StringCount => strings.Length;
+
+        private readonly Stream stream;
+        private readonly long[] blockOffsets;
+        private readonly string[] strings;
+        private readonly byte[] header = new byte[ColumnarExport.BlockHeaderSize];
+        private byte[] compressed = new byte[0];
+        private byte[] raw = new byte[0];
+
+        public ColumnarExportReader(Stream stream)
+        {
+            this.stream = stream;
+            var bytes = ReadAt(0, ColumnarExport.HeaderSize);
+            if (BinaryPrimitives.ReadInt32LittleEndian(bytes) != ColumnarExport.Magic ||
+                BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(bytes, 4, 4)) != ColumnarExport.Version)
+            {
+                throw new InvalidDataException("Not a columnar interaction export");
+            }
+            BlockRecords = BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(bytes, 8, 4));
+
+            var trailer = ReadAt(stream.Length - 12, 12);
+            if (BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(trailer, 8, 4)) != ColumnarExport.Magic)
+            {
+                throw new InvalidDataException("Columnar export is truncated");
+            }
+            long footerOffset = BinaryPrimitives.ReadInt64LittleEndian(trailer);
+            var footer = ReadAt(footerOffset, (int)(stream.Length - 12 - footerOffset));
+            int at = 0;
+            strings = new string[ReadVarint(footer, ref at)];
+            for (int i = 0; i < strings.Length; i++)
+            {
+                int length = (int)ReadVarint(footer, ref at);
+                strings[i] = Encoding.UTF8.GetString(footer, at, length);
+                at += length;
+            }
+            RecordCount = BinaryPrimitives.ReadInt64LittleEndian(new ReadOnlySpan<byte>(footer, at, 8));
+            blockOffsets = new long[BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(footer, at + 8, 4))];
+            at += 12;
+            for (int i = 0; i < blockOffsets.Length; i++, at += 8)
+            {
+                blockOffsets[i] = BinaryPrimitives.ReadInt64LittleEndian(new ReadOnlySpan<byte>(footer, at, 8));
+            }
+        }
+
+        /// <summary>
+        /// Label key or anchor id for a string id in the records, null for -1
+        /// </summary>
+        public string GetString(int id)
+        {
+            return id >= 0 && id < strings.Length ? strings[id] : null;
+        }
+
+        /// <summary>
+        /// Decode block <paramref name="block"/> into <paramref name="buffer"/> (at least BlockRecords long). Returns the
+        /// record count.
+        /// </summary>
+        public int ReadBlock(int block, InteractionRecord[] buffer)
+        {
+            stream.Position = blockOffsets[block];
+            ReadExactly(header, ColumnarExport.BlockHeaderSize);
+            int count = BinaryPrimitives.ReadInt32LittleEndian(header);
+            long position = BinaryPrimitives.ReadInt64LittleEndian(new ReadOnlySpan<byte>(header, 4, 8));
+            int rawLength = BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(header, 12, 4));
+            int compressedLength = BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(header, 16, 4));
+            if (compressed.Length < compressedLength) compressed = new byte[compressedLength];
+            if (raw.Length < rawLength) raw = new byte[rawLength];
+            ReadExactly(compressed, compressedLength);
+            using (var inflate = new DeflateStream(new MemoryStream(compressed, 0, compressedLength), CompressionMode.Decompress))
+            {
+                int filled = 0;
+                int read;
+                while (filled < rawLength && (read = inflate.Read(raw, filled, rawLength - filled)) > 0) filled += read;
+            }
+
+            int positionsLength = BinaryPrimitives.ReadInt32LittleEndian(raw);
+            int labelsLength = BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(raw, 4, 4));
+            int anchorsLength = BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(raw, 8, 4));
+            int positions = 16;
+            int actions = positions + positionsLength;
+            int successes = actions + count;
+            int labels = successes + (count + 7) / 8;
+            int anchors = labels + labelsLength;
+            int durations = anchors + anchorsLength;
+            int timestamps = durations + count * 4;
+            long timestamp = 0;
+            position--;
+            for (int i = 0; i < count; i++)
+            {
+                position += (long)ReadVarint(raw, ref positions) + 1;
+                ulong zigzag = ReadVarint(raw, ref timestamps);
+                timestamp += (long)(zigzag >> 1) ^ -(long)(zigzag & 1);
+                buffer[i] = new InteractionRecord
+                {
+                    position = position,
+                    action = (InteractionType)raw[actions + i],
+                    success = (raw[successes + (i >> 3)] & (1 << (i & 7))) != 0,
+                    labelId = (int)ReadVarint(raw, ref labels) - 1,
+                    anchorId = (int)ReadVarint(raw, ref anchors) - 1,
+                    duration = BitConverter.Int32BitsToSingle(BinaryPrimitives.ReadInt32LittleEndian(new ReadOnlySpan<byte>(raw, durations + i * 4, 4))),
+                    timestamp = timestamp
+                };
+            }
+            return count;
+        }
+
+        private byte[] ReadAt(long offset, int length)
+        {
+            var bytes = new byte[length];
+            stream.Position = offset;
+            ReadExactly(bytes, length);
+            return bytes;
+        }
+
+        private void ReadExactly(byte[] buffer, int length)
+        {
+            int filled = 0;
+            while (filled < length)
+            {
+                int read = stream.Read(buffer, filled, length - filled);
+                if (read == 0) throw new EndOfStreamException();
+                filled += read;
+            }
+        }
+
+        private static ulong ReadVarint(byte[] data, ref int at)
+        {
+            ulong value = 0;
+            int shift = 0;
+            while (true)
+            {
+                byte b = data[at++];
+                value |= (ulong)(b & 0x7F) << shift;
+                if (b < 0x80) return value;
+                shift += 7;
+            }
+        }
+    }
+}
@@ -0,0 +1,616 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.IO.Compression;
+using System.IO.MemoryMappedFiles;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Append-only log of interactions as fixed-size binary records in memory-mapped segment files, with label keys and
+    /// anchor ids interned into a side table of strings. Append is safe from any thread without locks: a writer claims
+    /// its slot with one Interlocked increment and fills it in place, writing the header word last so a reader never
+    /// sees half a record. Only rolling to the next segment takes a lock; full segments are gzipped in the background.
+    /// Records are addressed by position, a per-device sequence that survives restarts.
+    /// </summary>
+    /// <remarks>
+    /// Record (24 bytes, little-endian): int32 header (0xA15E in the high half once committed, bit 8 success, low byte
+    /// action), int32 label string id, int32 anchor string id (-1 for none), float32 duration, int64 unix ms.
+    /// Segment files are 00000000.seg, 00000001.seg, ... with a 16 byte header (magic, version, record size, records
+    /// per segment); sealed ones become .seg.gz. Strings are strings.bin: int32 length then UTF-8, id = order written.
+    /// </remarks>
+    public sealed class InteractionLog : IDisposable
+    {
+        public const int RecordSize = 24;
+        public const int DefaultSegmentRecords = 16384; // 384 KiB mapped
+
+        public string DirectoryPath { get; }
+        public int SegmentRecords { get; }
+        public long StartPosition => (long)firstSegment * SegmentRecords;
+        public int StringCount => Volatile.Read(ref stringCount);
+
+        /// <summary>
+        /// One past the newest position handed out; records just below it may still be being written.
+        /// </summary>
+        public long EndPosition
+        {
+            get
+            {
+                var segment = current;
+                return segment.basePosition + Math.Min(Interlocked.Read(ref segment.reserved), SegmentRecords);
+            }
+        }
+
+        private const int HeaderSize = 16;
+        private const int Magic = 0x47534C41; // "ALSG"
+        private const short Version = 1;
+        private const int CommitMask = unchecked((int)0xFFFF0000);
+        private const int Committed = unchecked((int)0xA15E0000);
+        private const int SuccessBit = 0x100;
+        private const int SkipAction = 0xFF; // slot a crash left empty
+        private const string SegmentExtension = ".seg";
+        private const string CompressedExtension = ".seg.gz";
+        private const string StringsFile = "strings.bin";
+
+        private readonly ConcurrentDictionary<string, int> stringIds = new ConcurrentDictionary<string, int>(StringComparer.Ordinal);
+        private readonly object stringGate = new object();
+        private readonly object rollGate = new object();
+        private readonly List<Task> sealing = new List<Task>();
+        private string[] strings = new string[64];
+        private int stringCount;
+        private FileStream stringFile;
+        private volatile Segment current;
+        private volatile bool disposed;
+        private int firstSegment;
+        private int cachedSegment = -1; // last sealed segment decompressed for Read
+        private byte[] cachedBytes;
+
+        private InteractionLog(string directory, int segmentRecords)
+        {
+            DirectoryPath = directory;
+            SegmentRecords = segmentRecords;
+        }
+
+        /// <summary>
+        /// Open (or create) the log in <paramref name="directory"/>. An existing log keeps the segment size it was
+        /// created with. A segment left uncompressed by a crash is compressed before this returns.
+        /// </summary>
+        public static InteractionLog Open(string directory, int segmentRecords = DefaultSegmentRecords)
+        {
+            Directory.CreateDirectory(directory);
+            var segments = ListSegments(directory);
+            int records = Math.Max(1, segmentRecords);
+            if (segments.Count > 0) records = ReadSegmentRecords(directory, segments.Keys[0], segments.Values[0], records);
+
+            var log = new InteractionLog(directory, records);
+            log.LoadStrings();
+            int last = segments.Count > 0 ? segments.Keys[segments.Count - 1] : -1;
+            bool resume = last >= 0 && !segments.Values[segments.Count - 1];
+            foreach (var segment in segments)
+            {
+                if (!segment.Value && segment.Key != last) log.Compress(segment.Key);
+            }
+            log.current = log.MapSegment(resume ? last : last + 1, resume);
+            log.firstSegment = segments.Count > 0 ? segments.Keys[0] : log.current.index;
+            return log;
+        }
+
+        /// <summary>
+        /// Append one interaction from any thread and return its position, or -1 once the log is disposed.
+        /// </summary>
+        public long Append(InteractionType action, string labelKey, string anchorId, bool success, float duration, long timestamp)
+        {
+            int label = Intern(labelKey);
+            int anchor = Intern(anchorId);
+            int header = Committed | (success ? SuccessBit : 0) | ((int)action & 0xFF);
+            while (true)
+            {
+                var segment = current;
+                Interlocked.Increment(ref segment.users);
+                if (disposed)
+                {
+                    Interlocked.Decrement(ref segment.users);
+                    return -1;
+                }
+                long slot = Interlocked.Increment(ref segment.reserved) - 1;
+                if (slot < SegmentRecords)
+                {
+                    long offset = Offset(slot);
+                    var view = segment.view;
+                    view.Write(offset + 4, label);
+                    view.Write(offset + 8, anchor);
+                    view.Write(offset + 12, duration);
+                    view.Write(offset + 16, timestamp);
+                    Thread.MemoryBarrier(); // the fields are visible before the header that commits them
+                    view.Write(offset, header);
+                    Interlocked.Decrement(ref segment.users);
+                    return segment.basePosition + slot;
+                }
+                Interlocked.Decrement(ref segment.users);
+                Roll(segment);
+            }
+        }
+
+        /// <summary>
+        /// Copy committed records from <paramref name="position"/> on into <paramref name="buffer"/> and return how many;
+        /// <paramref name="next"/> is where to continue. Stops early at a record another thread is still writing.
+        /// </summary>
+        public int Read(long position, InteractionRecord[] buffer, out long next)
+        {
+            position = Math.Max(position, StartPosition);
+            int count = 0;
+            while (count < buffer.Length && !disposed)
+            {
+                int index = (int)(position / SegmentRecords);
+                var live = current;
+                if (index > live.index) break;
+                if (index == live.index)
+                {
+                    Interlocked.Increment(ref live.users);
+                    bool rolled = live != current || disposed;
+                    if (!rolled) ReadMapped(live, ref position, buffer, ref count);
+                    Interlocked.Decrement(ref live.users);
+                    if (rolled) continue; // sealed meanwhile: read it from its file
+                    break;
+                }
+                if (!LoadSealed(index, out bool final))
+                {
+                    if (index >= firstSegment) break; // missing from disk but not trimmed: never skip past it
+                    position = (long)(index + 1) * SegmentRecords; // deleted: nothing to read there
+                    continue;
+                }
+                if (ReadSealed(index, final, ref position, buffer, ref count)) break;
+            }
+            next = position;
+            return count;
+        }
+
+        /// <summary>
+        /// The interned string for an id from an InteractionRecord, or null for -1.
+        /// </summary>
+        public string GetString(int id)
+        {
+            int count = Volatile.Read(ref stringCount);
+            var table = Volatile.Read(ref strings);
+            return id >= 0 && id < count ? table[id] : null;
+        }
+
+        /// <summary>
+        /// Write dirty pages of the live segment to disk, e.g. when the app is paused.
+        /// </summary>
+        public void Flush()
+        {
+            var segment = current;
+            Interlocked.Increment(ref segment.users);
+            if (segment == current && !disposed) segment.view.Flush();
+            Interlocked.Decrement(ref segment.users);
+        }
+
+        /// <summary>
+        /// Delete every record and string and start again from position 0. No other thread may append meanwhile.
+        /// </summary>
+        public void Clear()
+        {
+            lock (rollGate)
+            {
+                WaitForSealing();
+                Unmap(current);
+                lock (stringGate)
+                {
+                    stringFile.Dispose();
+                    foreach (var file in Directory.GetFiles(DirectoryPath))
+                    {
+                        File.Delete(file);
+                    }
+                    stringIds.Clear();
+                    Volatile.Write(ref stringCount, 0);
+                    stringFile = new FileStream(Path.Combine(DirectoryPath, StringsFile), FileMode.Create, FileAccess.Write, FileShare.Read);
+                }
+                cachedSegment = -1;
+                cachedBytes = null;
+                firstSegment = 0;
+                current = MapSegment(0, false);
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (rollGate)
+            {
+                if (disposed) return;
+                disposed = true;
+            }
+            var segment = current;
+            var wait = new SpinWait();
+            while (Volatile.Read(ref segment.users) > 0) wait.SpinOnce();
+            Unmap(segment);
+            WaitForSealing();
+            lock (stringGate)
+            {
+                stringFile?.Dispose();
+            }
+        }
+
+        private int Intern(string value)
+        {
+            if (value == null) return -1;
+            if (stringIds.TryGetValue(value, out int id)) return id;
+            lock (stringGate)
+            {
+                if (stringIds.TryGetValue(value, out id)) return id;
+                // Durable before any record can refer to it
+                byte[] bytes = Encoding.UTF8.GetBytes(value);
+                stringFile.Write(BitConverter.GetBytes(bytes.Length), 0, 4);
+                stringFile.Write(bytes, 0, bytes.Length);
+                stringFile.Flush();
+                Publish(value);
+                return stringCount - 1;
+            }
+        }
+
+        /// <summary>
+        /// Table first, then count: a reader that sees the new count also sees a table holding the string. Under stringGate.
+        /// </summary>
+        private void Publish(string value)
+        {
+            int id = stringCount;
+            var table = strings;
+            if (id == table.Length)
+            {
+                var grown = new string[table.Length * 2];
+                Array.Copy(table, grown, id);
+                table = grown;
+            }
+            table[id] = value;
+            Volatile.Write(ref strings, table);
+            Volatile.Write(ref stringCount, id + 1);
+            stringIds[value] = id;
+        }
+
+        private void LoadStrings()
+        {
+            string path = Path.Combine(DirectoryPath, StringsFile);
+            byte[] data = File.Exists(path) ? File.ReadAllBytes(path) : Array.Empty<byte>();
+            int pos = 0;
+            while (pos + 4 <= data.Length)
+            {
+                int length = BitConverter.ToInt32(data, pos);
+                if (length < 0 || pos + 4 + length > data.Length) break; // torn tail
+                Publish(Encoding.UTF8.GetString(data, pos + 4, length));
+                pos += 4 + length;
+            }
+            stringFile = new FileStream(path, FileMode.OpenOrCreate, FileAccess.Write, FileShare.Read);
+            stringFile.SetLength(pos);
+            stringFile.Position = pos;
+        }
+
+        private void Roll(Segment full)
+        {
+            lock (rollGate)
+            {
+                if (current != full || disposed) return;
+                current = MapSegment(full.index + 1, false);
+                sealing.RemoveAll(task => task.IsCompleted);
+                sealing.Add(Task.Run(() => Seal(full)));
+            }
+        }
+
+        /// <summary>
+        /// Waits out the writers that claimed the segment's last slots, then compresses it
+        /// </summary>
+        private void Seal(Segment segment)
+        {
+            var wait = new SpinWait();
+            while (Volatile.Read(ref segment.users) > 0) wait.SpinOnce();
+            Unmap(segment);
+            Compress(segment.index);
+        }
+
+        private void WaitForSealing()
+        {
+            Task[] pending;
+            lock (rollGate)
+            {
+                pending = sealing.ToArray();
+                sealing.Clear();
+            }
+            Task.WaitAll(pending);
+        }
+
+        private Segment MapSegment(int index, bool resume)
+        {
+            long size = HeaderSize + (long)SegmentRecords * RecordSize;
+            var file = new FileStream(SegmentPath(index, false), FileMode.OpenOrCreate, FileAccess.ReadWrite, FileShare.ReadWrite | FileShare.Delete);
+            if (file.Length < size) file.SetLength(size);
+            var map = MemoryMappedFile.CreateFromFile(file, null, size, MemoryMappedFileAccess.ReadWrite, HandleInheritability.None, false);
+            var segment = new Segment
+            {
+                index = index,
+                basePosition = (long)index * SegmentRecords,
+                map = map,
+                view = map.CreateViewAccessor(0, size)
+            };
+            if (!resume)
+            {
+                segment.view.Write(0, Magic);
+                segment.view.Write(4, Version);
+                segment.view.Write(6, (short)RecordSize);
+                segment.view.Write(8, SegmentRecords);
+                return segment;
+            }
+
+            // Continue after the newest committed record; earlier slots a crash left empty are marked skipped
+            long end = 0;
+            for (long slot = SegmentRecords - 1; slot >= 0; slot--)
+            {
+                if (IsCommitted(segment.view.ReadInt32(Offset(slot))))
+                {
+                    end = slot + 1;
+                    break;
+                }
+            }
+            for (long slot = 0; slot < end; slot++)
+            {
+                if (!IsCommitted(segment.view.ReadInt32(Offset(slot)))) segment.view.Write(Offset(slot), Committed | SkipAction);
+            }
+            segment.reserved = end;
+            return segment;
+        }
+
+        private static void Unmap(Segment segment)
+        {
+            segment.view.Flush();
+            segment.view.Dispose();
+            segment.map.Dispose(); // closes the file too
+        }
+
+        /// <summary>
+        /// Gzip a sealed segment up to its last record and delete the raw file. Left as is on failure; the next Open retries.
+        /// </summary>
+        private void Compress(int index)
+        {
+            string raw = SegmentPath(index, false);
+            string compressed = SegmentPath(index, true);
+            string temp = compressed + ".tmp";
+            try
+            {
+                byte[] data = File.ReadAllBytes(raw);
+                int length = data.Length;
+                while (length > HeaderSize && !IsCommitted(BitConverter.ToInt32(data, length - RecordSize))) length -= RecordSize;
+                using (var output = new FileStream(temp, FileMode.Create, FileAccess.Write))
+                using (var gzip = new GZipStream(output, CompressionLevel.Optimal))
+                {
+                    gzip.Write(data, 0, length);
+                }
+                if (File.Exists(compressed)) File.Delete(compressed);
+                File.Move(temp, compressed);
+                File.Delete(raw);
+            }
+            catch (IOException)
+            {
+            }
+        }
+
+        /// <summary>
+        /// Reads slots of a mapped segment up to the first one still being written
+        /// </summary>
+        private void ReadMapped(Segment segment, ref long position, InteractionRecord[] buffer, ref int count)
+        {
+            long end = Math.Min(Interlocked.Read(ref segment.reserved), SegmentRecords);
+            long slot = position - segment.basePosition;
+            var view = segment.view;
+            while (slot < end && count < buffer.Length)
+            {
+                long offset = Offset(slot);
+                int header = view.ReadInt32(offset);
+                if (!IsCommitted(header)) break;
+                Thread.MemoryBarrier(); // fields after the header that committed them
+                if ((header & 0xFF) != SkipAction)
+                {
+                    buffer[count++] = new InteractionRecord
+                    {
+                        position = segment.basePosition + slot,
+                        action = (InteractionType)(header & 0xFF),
+                        success = (header & SuccessBit) != 0,
+                        labelId = view.ReadInt32(offset + 4),
+                        anchorId = view.ReadInt32(offset + 8),
+                        duration = view.ReadSingle(offset + 12),
+                        timestamp = view.ReadInt64(offset + 16)
+                    };
+                }
+                slot++;
+            }
+            position = segment.basePosition + slot;
+        }
+
+        /// <summary>
+        /// Reads from the loaded copy of a sealed segment. Until it is compressed (final) an empty slot may still be being
+        /// written, so reading stops there and returns true; afterwards empty slots are gaps and are skipped.
+        /// </summary>
+        private bool ReadSealed(int index, bool final, ref long position, InteractionRecord[] buffer, ref int count)
+        {
+            long basePosition = (long)index * SegmentRecords;
+            long slots = (cachedBytes.Length - HeaderSize) / RecordSize;
+            long slot = position - basePosition;
+            while (slot < SegmentRecords && count < buffer.Length)
+            {
+                if (slot >= slots)
+                {
+                    if (final) slot = SegmentRecords; // trimmed at compression
+                    break;
+                }
+                int offset = (int)Offset(slot);
+                int header = BitConverter.ToInt32(cachedBytes, offset);
+                if (!IsCommitted(header) && !final) break;
+                if (IsCommitted(header) && (header & 0xFF) != SkipAction)
+                {
+                    buffer[count++] = new InteractionRecord
+                    {
+                        position = basePosition + slot,
+                        action = (InteractionType)(header & 0xFF),
+                        success = (header & SuccessBit) != 0,
+                        labelId = BitConverter.ToInt32(cachedBytes, offset + 4),
+                        anchorId = BitConverter.ToInt32(cachedBytes, offset + 8),
+                        duration = BitConverter.ToSingle(cachedBytes, offset + 12),
+                        timestamp = BitConverter.ToInt64(cachedBytes, offset + 16)
+                    };
+                }
+                slot++;
+            }
+            position = basePosition + slot;
+            if (!final) cachedSegment = -1; // a raw copy is stale as soon as the writers finish
+            return slot < SegmentRecords && count < buffer.Length;
+        }
+
+        /// <summary>
+        /// Loads a sealed segment into cachedBytes: the .gz once compressed (final), else the raw file being sealed.
+        /// Returns false if neither exists. Compress moves the .gz into place before deleting the raw file, so a raw
+        /// file that vanished between the checks means the .gz is there now.
+        /// </summary>
+        private bool LoadSealed(int index, out bool final)
+        {
+            final = true;
+            if (cachedSegment == index) return true;
+            string compressed = SegmentPath(index, true);
+            string raw = SegmentPath(index, false);
+            for (int attempt = 0; ; attempt++)
+            {
+                try
+                {
+                    if (File.Exists(compressed))
+                    {
+                        using (var input = new GZipStream(new FileStream(compressed, FileMode.Open, FileAccess.Read, FileShare.Read | FileShare.Delete), CompressionMode.Decompress))
+                        using (var output = new MemoryStream(HeaderSize + SegmentRecords * RecordSize))
+                        {
+                            input.CopyTo(output);
+                            cachedBytes = output.ToArray();
+                        }
+                        final = true;
+                        cachedSegment = index;
+                        return true;
+                    }
+                    if (!File.Exists(raw))
+                    {
+                        if (attempt < 2 && File.Exists(compressed)) continue;
+                        return false;
+                    }
+                    using (var input = new FileStream(raw, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete))
+                    {
+                        var bytes = new byte[input.Length];
+                        int read = 0;
+                        while (read < bytes.Length)
+                        {
+                            int n = input.Read(bytes, read, bytes.Length - read);
+                            if (n <= 0) break;
+                            read += n;
+                        }
+                        cachedBytes = bytes;
+                    }
+                    final = false;
+                    cachedSegment = index;
+                    return true;
+                }
+                catch (IOException) when (attempt < 2)
+                {
+                    // The raw file was deleted while opening it; the .gz is there now
+                }
+            }
+        }
+
+        private static long Offset(long slot)
+        {
+            return HeaderSize + slot * RecordSize;
+        }
+
+        private static bool IsCommitted(int header)
+        {
+            return (header & CommitMask) == Committed;
+        }
+
+        private string SegmentPath(int index, bool compressed)
+        {
+            return Path.Combine(DirectoryPath, index.ToString("D8", CultureInfo.InvariantCulture) + (compressed ? CompressedExtension : SegmentExtension));
+        }
+
+        /// <summary>
+        /// Segment index -> compressed, from the file names in <paramref name="directory"/>; stray temp files are removed.
+        /// </summary>
+        private static SortedList<int, bool> ListSegments(string directory)
+        {
+            var segments = new SortedList<int, bool>();
+            foreach (var path in Directory.GetFiles(directory))
+            {
+                string name = Path.GetFileName(path);
+                if (name.EndsWith(".tmp", StringComparison.Ordinal))
+                {
+                    File.Delete(path);
+                    continue;
+                }
+                bool compressed = name.EndsWith(CompressedExtension, StringComparison.Ordinal);
+                if (!compressed && !name.EndsWith(SegmentExtension, StringComparison.Ordinal)) continue;
+                string stem = name.Substring(0, name.Length - (compressed ? CompressedExtension.Length : SegmentExtension.Length));
+                if (!int.TryParse(stem, NumberStyles.None, CultureInfo.InvariantCulture, out int index)) continue;
+                // A crash between writing the .gz and deleting the raw file leaves both; the .gz is complete
+                if (segments.ContainsKey(index)) segments[index] = true;
+                else segments.Add(index, compressed);
+            }
+            return segments;
+        }
+
+        private static int ReadSegmentRecords(string directory, int index, bool compressed, int fallback)
+        {
+            string path = Path.Combine(directory, index.ToString("D8", CultureInfo.InvariantCulture) + (compressed ? CompressedExtension : SegmentExtension));
+            var header = new byte[HeaderSize];
+            try
+            {
+                using (Stream file = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.ReadWrite | FileShare.Delete))
+                using (Stream input = compressed ? new GZipStream(file, CompressionMode.Decompress) : file)
+                {
+                    int read = 0;
+                    while (read < HeaderSize)
+                    {
+                        int n = input.Read(header, read, HeaderSize - read);
+                        if (n <= 0) return fallback;
+                        read += n;
+                    }
+                }
+            }
+            catch (IOException)
+            {
+                return fallback;
+            }
+            if (BitConverter.ToInt32(header, 0) != Magic || BitConverter.ToInt16(header, 6) != RecordSize) return fallback;
+            int records = BitConverter.ToInt32(header, 8);
+            return records > 0 ? records : fallback;
+        }
+
+        private sealed class Segment
+        {
+            public int index;
+            public long basePosition;
+            public long reserved; // slots handed out; runs past the capacity while a roll is pending
+            public int users; // writers and readers inside the mapping
+            public MemoryMappedFile map;
+            public MemoryMappedViewAccessor view;
+        }
+    }
+
+    /// <summary>
+    /// One interaction read back from InteractionLog; strings are ids into its string table
+    /// </summary>
+    public struct InteractionRecord
+    {
+        public long position;
+        public InteractionType action;
+        public bool success;
+        public int labelId;
+        public int anchorId;
+        public float duration;
+        public long timestamp;
+    }
+}
@@ -0,0 +1,285 @@
+using System;
+using System.Collections.Generic;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Rolling aggregates of interactions in fixed rings of time buckets, so memory stays constant however long the
+    /// app is used and a windowed query ("error rate over the last 7 days") reads at most one ring. Overall activity
+    /// is kept per minute (last hour), per hour (last two days) and per day (last 90 days), each bucket with a
+    /// response-time sketch; each word per day over WordDays; the current session per minute and hour with one
+    /// sketch. A session ends after SessionGapMs without interactions. Windows are rounded out to whole buckets of the
+    /// finest ring that spans them. Interactions must arrive roughly in time order: ones older than a ring's span are
+    /// dropped from it. Main-thread only.
+    /// </summary>
+    public sealed class InteractionRollups
+    {
+        public const long Minute = 60_000L;
+        public const long Hour = 60 * Minute;
+        public const long Day = 24 * Hour;
+
+        public int WordDays { get; }
+        public long SessionGapMs { get; set; } = 30 * Minute;
+        public long SessionStart => sessionStart; // Unix ms of the current session's first interaction, 0 if none
+        public RollupTotals SessionTotals => sessionTotals;
+        public int WordCount => words.Count;
+
+        private readonly RollupRing[] overall =
+        {
+            new RollupRing(Minute, 60, true),
+            new RollupRing(Hour, 48, true),
+            new RollupRing(Day, 90, true)
+        };
+        private readonly RollupRing[] session =
+        {
+            new RollupRing(Minute, 60, false),
+            new RollupRing(Hour, 24, false)
+        };
+        private readonly Dictionary<string, RollupRing> words = new Dictionary<string, RollupRing>();
+        private readonly QuantileSketch sessionSketch = new QuantileSketch();
+        private readonly QuantileSketch scratch = new QuantileSketch();
+        private RollupTotals sessionTotals;
+        private long sessionStart;
+        private long lastInteraction = long.MinValue;
+
+        public InteractionRollups(int wordDays = 30)
+        {
+            WordDays = Math.Max(1, wordDays);
+        }
+
+        /// <summary>
+        /// Add one interaction. <paramref name="duration"/> is the response time in seconds, 0 if untimed.
+        /// </summary>
+        public void Record(string wordKey, bool success, float duration, long timestamp)
+        {
+            if (lastInteraction == long.MinValue || timestamp - lastInteraction > SessionGapMs)
+            {
+                foreach (var ring in session) ring.Clear();
+                sessionSketch.Clear();
+                sessionTotals = default;
+                sessionStart = timestamp;
+            }
+            lastInteraction = Math.Max(lastInteraction, timestamp);
+
+            foreach (var ring in overall) ring.Add(timestamp, success, duration);
+            foreach (var ring in session) ring.Add(timestamp, success, duration);
+            sessionTotals.Add(success, duration);
+            if (duration > 0f) sessionSketch.Add(duration);
+
+            if (wordKey == null) return;
+            if (!words.TryGetValue(wordKey, out var wordRing))
+            {
+                wordRing = new RollupRing(Day, WordDays, false);
+                words[wordKey] = wordRing;
+            }
+            wordRing.Add(timestamp, success, duration);
+        }
+
+        /// <summary>
+        /// Totals over all words for the <paramref name="windowMs"/> ending at <paramref name="now"/>
+        /// </summary>
+        public RollupTotals Query(long windowMs, long now)
+        {
+            var totals = default(RollupTotals);
+            Pick(overall, windowMs).Accumulate(now - windowMs, now, ref totals, null);
+            return totals;
+        }
+
+        public RollupTotals QueryWord(string wordKey, long windowMs, long now)
+        {
+            var totals = default(RollupTotals);
+            if (wordKey != null && words.TryGetValue(wordKey, out var ring)) ring.Accumulate(now - windowMs, now, ref totals, null);
+            return totals;
+        }
+
+        /// <summary>
+        /// Totals for the part of the current session inside the window; empty if the session has ended by
+        /// <paramref name="now"/>
+        /// </summary>
+        public RollupTotals QuerySession(long windowMs, long now)
+        {
+            var totals = default(RollupTotals);
+            if (lastInteraction != long.MinValue && now - lastInteraction <= SessionGapMs)
+            {
+                Pick(session, windowMs).Accumulate(Math.Max(sessionStart, now - windowMs), now, ref totals, null);
+            }
+            return totals;
+        }
+
+        /// <summary>
+        /// Response time (seconds) at quantile <paramref name="q"/> over the window, 0 if no timed interactions
+        /// </summary>
+        public float ResponseTimeQuantile(double q, long windowMs, long now)
+        {
+            var totals = default(RollupTotals);
+            scratch.Clear();
+            Pick(overall, windowMs).Accumulate(now - windowMs, now, ref totals, scratch);
+            return scratch.Quantile(q);
+        }
+
+        public float SessionResponseTimeQuantile(double q)
+        {
+            return sessionSketch.Quantile(q);
+        }
+
+        public bool RemoveWord(string wordKey)
+        {
+            return words.Remove(wordKey);
+        }
+
+        public void Clear()
+        {
+            foreach (var ring in overall) ring.Clear();
+            foreach (var ring in session) ring.Clear();
+            words.Clear();
+            sessionSketch.Clear();
+            sessionTotals = default;
+            sessionStart = 0;
+            lastInteraction = long.MinValue;
+        }
+
+        /// <summary>
+        /// The finest ring spanning <paramref name="windowMs"/>, else the coarsest
+        /// </summary>
+        private static RollupRing Pick(RollupRing[] rings, long windowMs)
+        {
+            foreach (var ring in rings)
+            {
+                if (ring.SpanMs >= windowMs) return ring;
+            }
+            return rings[rings.Length - 1];
+        }
+
+        /// <summary>
+        /// Buckets of WidthMs covering the latest Length widths. Bucket i holds the interactions whose
+        /// timestamp / WidthMs == i; moving to a later bucket clears the ones it laps.
+        /// </summary>
+        private sealed class RollupRing
+        {
+            public readonly long WidthMs;
+            public readonly int Length;
+            public long SpanMs => WidthMs * Length;
+
+            private readonly int[] counts;
+            private readonly int[] successes;
+            private readonly int[] timed;
+            private readonly float[] durations;
+            private readonly int[] sketches; // Length * QuantileSketch.Bins, or null
+            private long latest = long.MinValue; // index of the newest bucket
+
+            public RollupRing(long widthMs, int length, bool withSketches)
+            {
+                WidthMs = widthMs;
+                Length = length;
+                counts = new int[length];
+                successes = new int[length];
+                timed = new int[length];
+                durations = new float[length];
+                if (withSketches) sketches = new int[length * QuantileSketch.Bins];
+            }
+
+            public void Add(long timestamp, bool success, float duration)
+            {
+                long index = FloorDiv(timestamp, WidthMs);
+                if (latest == long.MinValue || index > latest)
+                {
+                    long lapped = latest == long.MinValue ? Length : Math.Min(index - latest, Length);
+                    for (long i = index - lapped + 1; i <= index; i++)
+                    {
+                        ClearSlot(Slot(i));
+                    }
+                    latest = index;
+                }
+                else if (index <= latest - Length)
+                {
+                    return;
+                }
+
+                int slot = Slot(index);
+                counts[slot]++;
+                if (success) successes[slot]++;
+                if (duration > 0f)
+                {
+                    timed[slot]++;
+                    durations[slot] += duration;
+                    if (sketches != null) sketches[slot * QuantileSketch.Bins + QuantileSketch.BinOf(duration)]++;
+                }
+            }
+
+            /// <summary>
+            /// Add the buckets overlapping [from, now] to <paramref name="totals"/> and, if given, <paramref name="sketch"/>
+            /// </summary>
+            public void Accumulate(long from, long now, ref RollupTotals totals, QuantileSketch sketch)
+            {
+                if (latest == long.MinValue) return;
+                long first = Math.Max(FloorDiv(from, WidthMs), latest - Length + 1);
+                long last = Math.Min(FloorDiv(now, WidthMs), latest);
+                for (long i = first; i <= last; i++)
+                {
+                    int slot = Slot(i);
+                    totals.count += counts[slot];
+                    totals.successes += successes[slot];
+                    totals.timed += timed[slot];
+                    totals.durationSum += durations[slot];
+                    if (sketch != null && sketches != null) sketch.Merge(sketches, slot * QuantileSketch.Bins);
+                }
+            }
+
+            public void Clear()
+            {
+                Array.Clear(counts, 0, Length);
+                Array.Clear(successes, 0, Length);
+                Array.Clear(timed, 0, Length);
+                Array.Clear(durations, 0, Length);
+                if (sketches != null) Array.Clear(sketches, 0, sketches.Length);
+                latest = long.MinValue;
+            }
+
+            private void ClearSlot(int slot)
+            {
+                counts[slot] = 0;
+                successes[slot] = 0;
+                timed[slot] = 0;
+                durations[slot] = 0f;
+                if (sketches != null) Array.Clear(sketches, slot * QuantileSketch.Bins, QuantileSketch.Bins);
+            }
+
+            private int Slot(long index)
+            {
+                long slot = index % Length;
+                return (int)(slot < 0 ? slot + Length : slot);
+            }
+
+            private static long FloorDiv(long value, long divisor)
+            {
+                long quotient = value / divisor;
+                return value % divisor < 0 ? quotient - 1 : quotient;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Interaction counts and response-time sum over a window
+    /// </summary>
+    public struct RollupTotals
+    {
+        public int count;
+        public int successes;
+        public int timed; // interactions with a response time
+        public double durationSum;
+
+        public float ErrorRate => count > 0 ? 1f - (float)successes / count : 0f;
+        public float MeanDuration => timed > 0 ? (float)(durationSum / timed) : 0f;
+
+        public void Add(bool success, float duration)
+        {
+            count++;
+            if (success) successes++;
+            if (duration > 0f)
+            {
+                timed++;
+                durationSum += duration;
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+using System;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Streaming quantiles of positive values (response times in seconds) in a fixed-size log-binned histogram, as in
+    /// DDSketch: bin i holds values in [gamma^i, gamma^(i+1)) above MinValue, so any quantile comes back within
+    /// RelativeAccuracy of a value actually recorded. Sketches merge by adding bins, which is how time buckets are
+    /// combined for a window. Values outside [MinValue, MaxValue] are clamped into the end bins.
+    /// </summary>
+    public sealed class QuantileSketch
+    {
+        public const float MinValue = 0.05f;
+        public const float MaxValue = 600f;
+        public const double RelativeAccuracy = 0.05;
+
+        // Declared before Bins: static initializers run in order
+        private static readonly double Gamma = (1 + RelativeAccuracy) / (1 - RelativeAccuracy);
+        private static readonly double LogGamma = Math.Log(Gamma);
+
+        public static readonly int Bins = BinOf(MaxValue) + 1;
+
+        public long Count => count;
+
+        private readonly int[] bins = new int[Bins];
+        private long count;
+
+        public void Add(float value)
+        {
+            bins[BinOf(value)]++;
+            count++;
+        }
+
+        /// <summary>
+        /// Add the counts in <paramref name="source"/>[offset..offset + Bins)
+        /// </summary>
+        public void Merge(int[] source, int offset)
+        {
+            for (int i = 0; i < Bins; i++)
+            {
+                int n = source[offset + i];
+                bins[i] += n;
+                count += n;
+            }
+        }
+
+        /// <summary>
+        /// The value at quantile <paramref name="q"/> (0.5 = median), or 0 if nothing was recorded
+        /// </summary>
+        public float Quantile(double q)
+        {
+            if (count == 0) return 0f;
+            long rank = (long)Math.Floor(Math.Max(0, Math.Min(1, q)) * (count - 1));
+            long seen = 0;
+            for (int i = 0; i < Bins; i++)
+            {
+                seen += bins[i];
+                if (seen > rank) return ValueOf(i);
+            }
+            return ValueOf(Bins - 1);
+        }
+
+        public void Clear()
+        {
+            Array.Clear(bins, 0, Bins);
+            count = 0;
+        }
+
+        public static int BinOf(float value)
+        {
+            if (!(value > MinValue)) return 0;
+            if (value >= MaxValue) value = MaxValue;
+            return (int)(Math.Log(value / MinValue) / LogGamma);
+        }
+
+        /// <summary>
+        /// Representative value of bin <paramref name="bin"/>: the one whose relative error to either edge is equal
+        /// </summary>
+        public static float ValueOf(int bin)
+        {
+            return (float)(MinValue * Math.Pow(Gamma, bin) * 2 / (1 + 1 / Gamma));
+        }
+    }
+}
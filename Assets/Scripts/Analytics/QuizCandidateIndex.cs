@@ -0,0 +1,208 @@
+using System;
+using System.Collections.Generic;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Words ranked by quiz score in an indexed 4-ary max-heap. Each word's heap position is tracked, so a changed
+    /// score moves in O(log n) and the top k are read in O(k log k) without touching the rest of the vocabulary.
+    /// Equal scores rank in the order words were first added.
+    /// </summary>
+    public sealed class QuizCandidateIndex
+    {
+        public int Count => count;
+
+        private const int Arity = 4;
+
+        private readonly Dictionary<string, int> slots = new Dictionary<string, int>();
+        private readonly Stack<int> freeSlots = new Stack<int>();
+        private string[] keys = new string[16]; // by slot
+        private float[] scores = new float[16]; // by slot
+        private long[] order = new long[16]; // by slot: when the word was added, for ties
+        private int[] positions = new int[16]; // by slot: index into heap
+        private int[] heap = new int[16]; // slots, best first
+        private int[] frontier = new int[16]; // heap indices still to visit during Top
+        private int count;
+        private int slotCount;
+        private long added;
+
+        /// <summary>
+        /// Add <paramref name="key"/> or move it to its new <paramref name="score"/>
+        /// </summary>
+        public void Update(string key, float score)
+        {
+            if (float.IsNaN(score)) score = 0f;
+            if (slots.TryGetValue(key, out int slot))
+            {
+                float old = scores[slot];
+                scores[slot] = score;
+                if (score > old) SiftUp(positions[slot]);
+                else if (score < old) SiftDown(positions[slot]);
+                return;
+            }
+
+            slot = freeSlots.Count > 0 ? freeSlots.Pop() : slotCount++;
+            if (slot == keys.Length)
+            {
+                int size = keys.Length * 2;
+                Array.Resize(ref keys, size);
+                Array.Resize(ref scores, size);
+                Array.Resize(ref order, size);
+                Array.Resize(ref positions, size);
+                Array.Resize(ref heap, size);
+            }
+            slots[key] = slot;
+            keys[slot] = key;
+            scores[slot] = score;
+            order[slot] = added++;
+            heap[count] = slot;
+            positions[slot] = count;
+            count++;
+            SiftUp(count - 1);
+        }
+
+        public bool Remove(string key)
+        {
+            if (!slots.TryGetValue(key, out int slot)) return false;
+            slots.Remove(key);
+            int position = positions[slot];
+            count--;
+            if (position != count)
+            {
+                int moved = heap[count];
+                Place(position, moved);
+                SiftUp(position);
+                SiftDown(positions[moved]);
+            }
+            keys[slot] = null;
+            freeSlots.Push(slot);
+            return true;
+        }
+
+        public bool TryGetScore(string key, out float score)
+        {
+            if (slots.TryGetValue(key, out int slot))
+            {
+                score = scores[slot];
+                return true;
+            }
+            score = 0f;
+            return false;
+        }
+
+        /// <summary>
+        /// Append the <paramref name="k"/> best words to <paramref name="results"/>, best first. Walks the heap from the
+        /// root, always expanding the best node not yet taken, so only the top k nodes and their children are compared.
+        /// </summary>
+        public void Top(int k, List<string> results)
+        {
+            k = Math.Min(k, count);
+            if (k <= 0) return;
+            int needed = k * (Arity - 1) + 1;
+            if (frontier.Length < needed) frontier = new int[Math.Max(needed, frontier.Length * 2)];
+
+            int size = 0;
+            frontier[size++] = 0;
+            for (int taken = 0; taken < k; taken++)
+            {
+                int best = frontier[0];
+                results.Add(keys[heap[best]]);
+                frontier[0] = frontier[--size];
+                FrontierDown(0, size);
+                int first = best * Arity + 1;
+                for (int child = first; child < first + Arity && child < count; child++)
+                {
+                    frontier[size] = child;
+                    FrontierUp(size++);
+                }
+            }
+        }
+
+        public void Clear()
+        {
+            slots.Clear();
+            freeSlots.Clear();
+            Array.Clear(keys, 0, slotCount);
+            count = 0;
+            slotCount = 0;
+            added = 0;
+        }
+
+        private bool Better(int slotA, int slotB)
+        {
+            float a = scores[slotA];
+            float b = scores[slotB];
+            return a > b || (a == b && order[slotA] < order[slotB]);
+        }
+
+        private void Place(int position, int slot)
+        {
+            heap[position] = slot;
+            positions[slot] = position;
+        }
+
+        private void SiftUp(int position)
+        {
+            int slot = heap[position];
+            while (position > 0)
+            {
+                int parent = (position - 1) / Arity;
+                if (!Better(slot, heap[parent])) break;
+                Place(position, heap[parent]);
+                position = parent;
+            }
+            Place(position, slot);
+        }
+
+        private void SiftDown(int position)
+        {
+            int slot = heap[position];
+            while (true)
+            {
+                int first = position * Arity + 1;
+                if (first >= count) break;
+                int best = first;
+                int last = Math.Min(first + Arity, count);
+                for (int child = first + 1; child < last; child++)
+                {
+                    if (Better(heap[child], heap[best])) best = child;
+                }
+                if (!Better(heap[best], slot)) break;
+                Place(position, heap[best]);
+                position = best;
+            }
+            Place(position, slot);
+        }
+
+        // The frontier is a binary max-heap of heap indices, ordered by the words at those indices
+
+        private void FrontierUp(int i)
+        {
+            int item = frontier[i];
+            while (i > 0)
+            {
+                int parent = (i - 1) / 2;
+                if (!Better(heap[item], heap[frontier[parent]])) break;
+                frontier[i] = frontier[parent];
+                i = parent;
+            }
+            frontier[i] = item;
+        }
+
+        private void FrontierDown(int i, int size)
+        {
+            if (size == 0) return;
+            int item = frontier[i];
+            while (true)
+            {
+                int child = i * 2 + 1;
+                if (child >= size) break;
+                if (child + 1 < size && Better(heap[frontier[child + 1]], heap[frontier[child]])) child++;
+                if (!Better(heap[frontier[child]], heap[item])) break;
+                frontier[i] = frontier[child];
+                i = child;
+            }
+            frontier[i] = item;
+        }
+    }
+}
@@ -4,7 +4,8 @@ using System.Collections.Generic;
 namespace ARLinguaSphere.Analytics
 {
 	/// <summary>
-	/// Simple adaptive quiz engine backed by AnalyticsManager word stats
+	/// Adaptive quiz engine: words due for review come first, the rest of the set is filled with the words
+	/// AnalyticsManager rates hardest
 	/// </summary>
 	public class QuizEngine : MonoBehaviour
 	{
@@ -21,7 +22,17 @@ namespace ARLinguaSphere.Analytics
 			{
 				return new List<string>();
 			}
-			return analyticsManager.GetWordsForQuiz(count);
+			var quizSet = analyticsManager.GetDueWords(count);
+			if (quizSet.Count < count)
+			{
+				// Enough extra to cover any that are already in the set as due
+				foreach (var word in analyticsManager.GetWordsForQuiz(count + quizSet.Count))
+				{
+					if (quizSet.Count == count) break;
+					if (!quizSet.Contains(word)) quizSet.Add(word);
+				}
+			}
+			return quizSet;
 		}
 
 		public void RecordAnswer(string wordKey, bool correct, float responseTimeSec = 0f)
@@ -0,0 +1,413 @@
+using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.Text;
+
+namespace ARLinguaSphere.Analytics
+{
+    /// <summary>
+    /// Spaced-repetition schedule for the user's words, using the FSRS (v4.5) memory model: each card has a stability
+    /// (days until recall probability falls to 90%) and a difficulty (1-10), updated from the grade and from how much
+    /// the card had been forgotten when it was reviewed. The next review is set for when recall probability falls to
+    /// DesiredRetention. Cards sit in an indexed 4-ary min-heap on due time, so a review is O(log n) and the k most
+    /// overdue cards are read in O(k log k). Times are Unix ms. Main-thread only.
+    /// </summary>
+    public sealed class ReviewScheduler
+    {
+        public const int Version = 1;
+
+        public float DesiredRetention { get; set; } = 0.9f;
+        public float RelearnDelaySeconds { get; set; } = 600f; // a forgotten card comes back this soon, then follows its stability
+        public float MaximumIntervalDays { get; set; } = 36500f;
+        public float HardSeconds { get; set; } = 8f; // a correct answer slower than this is graded Hard
+        public float EasySeconds { get; set; } = 2f; // and faster than this Easy
+        public int Count => count;
+        public bool IsDirty => dirty;
+
+        private const int Arity = 4;
+        private const int Magic = 0x52534C41; // "ALSR"
+        private const double MsPerDay = 86400000.0;
+        private const double Decay = -0.5;
+        private const double Factor = 19.0 / 81.0; // R(S, S) = 0.9
+
+        // FSRS v4.5 default weights
+        private static readonly double[] W =
+        {
+            0.4872, 1.4003, 3.7145, 13.8206, 5.1618, 1.2298, 0.8975, 0.031, 1.6474,
+            0.1367, 1.0461, 2.1072, 0.0793, 0.3246, 1.587, 0.2272, 2.8755
+        };
+
+        private readonly Dictionary<string, int> ids = new Dictionary<string, int>();
+        private string[] keys = new string[64]; // by card id
+        private ReviewCard[] cards = new ReviewCard[64]; // by card id
+        private int[] positions = new int[64]; // by card id: index into heap
+        private int[] heap = new int[64]; // card ids, soonest due first
+        private int[] frontier = new int[16]; // heap indices still to visit during GetDue
+        private int count;
+        private bool dirty;
+
+        /// <summary>
+        /// Start scheduling <paramref name="key"/>, due at once. Returns false if it is already scheduled.
+        /// </summary>
+        public bool Introduce(string key, long now)
+        {
+            if (ids.ContainsKey(key)) return false;
+            Add(key, new ReviewCard { due = now });
+            return true;
+        }
+
+        public ReviewGrade Grade(bool success, float durationSeconds)
+        {
+            if (!success) return ReviewGrade.Again;
+            if (durationSeconds <= 0f) return ReviewGrade.Good; // untimed
+            if (durationSeconds > HardSeconds) return ReviewGrade.Hard;
+            return durationSeconds < EasySeconds ? ReviewGrade.Easy : ReviewGrade.Good;
+        }
+
+        /// <summary>
+        /// Record a review of <paramref name="key"/> at <paramref name="now"/> and schedule the next one
+        /// </summary>
+        public void Review(string key, ReviewGrade grade, long now)
+        {
+            if (!ids.TryGetValue(key, out int id))
+            {
+                id = Add(key, new ReviewCard { due = now });
+            }
+            ref var card = ref cards[id];
+            int g = Math.Max(1, Math.Min(4, (int)grade));
+
+            if (card.reps == 0)
+            {
+                card.stability = (float)W[g - 1];
+                card.difficulty = (float)InitialDifficulty(g);
+            }
+            else
+            {
+                double elapsedDays = Math.Max(0, now - card.lastReview) / MsPerDay;
+                double s = card.stability;
+                double d = card.difficulty;
+                double r = Math.Pow(1 + Factor * elapsedDays / s, Decay);
+                if (g == 1)
+                {
+                    double forget = W[11] * Math.Pow(d, -W[12]) * (Math.Pow(s + 1, W[13]) - 1) * Math.Exp(W[14] * (1 - r));
+                    card.stability = (float)Math.Min(s, forget);
+                }
+                else
+                {
+                    double bonus = g == 2 ? W[15] : g == 4 ? W[16] : 1.0;
+                    card.stability = (float)(s * (1 + Math.Exp(W[8]) * (11 - d) * Math.Pow(s, -W[9]) * (Math.Exp(W[10] * (1 - r)) - 1) * bonus));
+                }
+                // Move difficulty by the grade, then revert slightly towards that of a new card answered Good
+                double next = d - W[6] * (g - 3);
+                card.difficulty = (float)Clamp(W[7] * InitialDifficulty(3) + (1 - W[7]) * next, 1, 10);
+            }
+            card.stability = Math.Max(0.01f, card.stability);
+
+            if (g == 1)
+            {
+                if (card.reps > 0) card.lapses++;
+                card.due = now + (long)(RelearnDelaySeconds * 1000f);
+            }
+            else
+            {
+                double days = card.stability / Factor * (Math.Pow(DesiredRetention, 1 / Decay) - 1);
+                days = Clamp(Math.Round(days), 1, MaximumIntervalDays);
+                card.due = now + (long)(days * MsPerDay);
+            }
+            card.reps++;
+            card.lastReview = now;
+            dirty = true;
+            SiftUp(positions[id]);
+            SiftDown(positions[id]);
+        }
+
+        public bool TryGetCard(string key, out ReviewCard card)
+        {
+            if (ids.TryGetValue(key, out int id))
+            {
+                card = cards[id];
+                return true;
+            }
+            card = default;
+            return false;
+        }
+
+        /// <summary>
+        /// Append up to <paramref name="max"/> cards due by <paramref name="now"/> to <paramref name="results"/>, most
+        /// overdue first. Walks the heap from the root and stops at the first card not yet due.
+        /// </summary>
+        public int GetDue(long now, int max, List<string> results)
+        {
+            max = Math.Min(max, count);
+            if (max <= 0 || cards[heap[0]].due > now) return 0;
+            int needed = max * (Arity - 1) + 1;
+            if (frontier.Length < needed) frontier = new int[Math.Max(needed, frontier.Length * 2)];
+
+            int size = 0;
+            int taken = 0;
+            frontier[size++] = 0;
+            while (taken < max && size > 0)
+            {
+                int best = frontier[0];
+                results.Add(keys[heap[best]]);
+                taken++;
+                frontier[0] = frontier[--size];
+                FrontierDown(0, size);
+                int first = best * Arity + 1;
+                for (int child = first; child < first + Arity && child < count; child++)
+                {
+                    // A child not due has no due descendants
+                    if (cards[heap[child]].due > now) continue;
+                    frontier[size] = child;
+                    FrontierUp(size++);
+                }
+            }
+            return taken;
+        }
+
+        public void Clear()
+        {
+            ids.Clear();
+            Array.Clear(keys, 0, count);
+            count = 0;
+            dirty = true;
+        }
+
+        public void MarkSaved()
+        {
+            dirty = false;
+        }
+
+        /// <summary>
+        /// Serialize every card into <paramref name="buffer"/> (grown as needed), tagged with <paramref name="through"/>,
+        /// the interaction log position the schedule covers. Returns the encoded length, about 30 bytes per card plus
+        /// its key.
+        /// </summary>
+        public int Encode(ref byte[] buffer, long through)
+        {
+            Reserve(ref buffer, 20);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(buffer, 0, 4), Magic);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(buffer, 4, 4), Version);
+            BinaryPrimitives.WriteInt32LittleEndian(new Span<byte>(buffer, 8, 4), count);
+            BinaryPrimitives.WriteInt64LittleEndian(new Span<byte>(buffer, 12, 8), through);
+            int length = 20;
+            for (int id = 0; id < count; id++)
+            {
+                string key = keys[id];
+                Reserve(ref buffer, length + 2 + Encoding.UTF8.GetMaxByteCount(key.Length) + 28);
+                int keyBytes = Encoding.UTF8.GetBytes(key, 0, key.Length, buffer, length + 2);
+                BinaryPrimitives.WriteUInt16LittleEndian(new Span<byte>(buffer, length, 2), (ushort)keyBytes);
+                length += 2 + keyBytes;
+                var card = cards[id];
+                var span = new Span<byte>(buffer, length, 28);
+                BinaryPrimitives.WriteInt32LittleEndian(span, BitConverter.SingleToInt32Bits(card.stability));
+                BinaryPrimitives.WriteInt32LittleEndian(span.Slice(4), BitConverter.SingleToInt32Bits(card.difficulty));
+                BinaryPrimitives.WriteInt64LittleEndian(span.Slice(8), card.lastReview);
+                BinaryPrimitives.WriteInt64LittleEndian(span.Slice(16), card.due);
+                BinaryPrimitives.WriteUInt16LittleEndian(span.Slice(24), (ushort)Math.Min(card.reps, ushort.MaxValue));
+                BinaryPrimitives.WriteUInt16LittleEndian(span.Slice(26), (ushort)Math.Min(card.lapses, ushort.MaxValue));
+                length += 28;
+            }
+            return length;
+        }
+
+        /// <summary>
+        /// Replace the schedule with one written by Encode. Returns false, leaving the schedule empty, if the data is
+        /// not a complete schedule of this version.
+        /// </summary>
+        public bool Load(byte[] data, int length, out long through)
+        {
+            Clear();
+            through = 0;
+            if (length < 20) return false;
+            var header = new ReadOnlySpan<byte>(data, 0, 20);
+            if (BinaryPrimitives.ReadInt32LittleEndian(header) != Magic || BinaryPrimitives.ReadInt32LittleEndian(header.Slice(4)) != Version)
+            {
+                return false;
+            }
+            int total = BinaryPrimitives.ReadInt32LittleEndian(header.Slice(8));
+            long coverage = BinaryPrimitives.ReadInt64LittleEndian(header.Slice(12));
+            int offset = 20;
+            for (int i = 0; i < total; i++)
+            {
+                if (offset + 2 > length) break;
+                int keyBytes = BinaryPrimitives.ReadUInt16LittleEndian(new ReadOnlySpan<byte>(data, offset, 2));
+                if (offset + 2 + keyBytes + 28 > length) break;
+                string key = Encoding.UTF8.GetString(data, offset + 2, keyBytes);
+                offset += 2 + keyBytes;
+                var span = new ReadOnlySpan<byte>(data, offset, 28);
+                offset += 28;
+                if (ids.ContainsKey(key)) continue;
+                var card = new ReviewCard
+                {
+                    stability = BitConverter.Int32BitsToSingle(BinaryPrimitives.ReadInt32LittleEndian(span)),
+                    difficulty = BitConverter.Int32BitsToSingle(BinaryPrimitives.ReadInt32LittleEndian(span.Slice(4))),
+                    lastReview = BinaryPrimitives.ReadInt64LittleEndian(span.Slice(8)),
+                    due = BinaryPrimitives.ReadInt64LittleEndian(span.Slice(16)),
+                    reps = BinaryPrimitives.ReadUInt16LittleEndian(span.Slice(24)),
+                    lapses = BinaryPrimitives.ReadUInt16LittleEndian(span.Slice(26))
+                };
+                Append(key, card);
+            }
+            if (count != total)
+            {
+                Clear();
+                return false;
+            }
+            // Bottom-up heapify: O(n) rather than n sifts
+            for (int position = (count - 2) / Arity; position >= 0; position--)
+            {
+                SiftDown(position);
+            }
+            through = coverage;
+            dirty = false;
+            return true;
+        }
+
+        private static double InitialDifficulty(int grade)
+        {
+            return Clamp(W[4] - (grade - 3) * W[5], 1, 10);
+        }
+
+        private static double Clamp(double value, double min, double max)
+        {
+            return value < min ? min : value > max ? max : value;
+        }
+
+        private static void Reserve(ref byte[] buffer, int bytes)
+        {
+            if (buffer != null && buffer.Length >= bytes) return;
+            int size = buffer != null && buffer.Length > 0 ? buffer.Length : 4096;
+            while (size < bytes) size *= 2;
+            Array.Resize(ref buffer, size);
+        }
+
+        private int Add(string key, ReviewCard card)
+        {
+            int id = Append(key, card);
+            SiftUp(positions[id]);
+            dirty = true;
+            return id;
+        }
+
+        /// <summary>
+        /// Store a card at the end of the heap without restoring heap order
+        /// </summary>
+        private int Append(string key, ReviewCard card)
+        {
+            if (count == keys.Length)
+            {
+                int size = keys.Length * 2;
+                Array.Resize(ref keys, size);
+                Array.Resize(ref cards, size);
+                Array.Resize(ref positions, size);
+                Array.Resize(ref heap, size);
+            }
+            int id = count++;
+            ids[key] = id;
+            keys[id] = key;
+            cards[id] = card;
+            heap[id] = id;
+            positions[id] = id;
+            return id;
+        }
+
+        private bool Sooner(int idA, int idB)
+        {
+            long a = cards[idA].due;
+            long b = cards[idB].due;
+            return a < b || (a == b && idA < idB);
+        }
+
+        private void Place(int position, int id)
+        {
+            heap[position] = id;
+            positions[id] = position;
+        }
+
+        private void SiftUp(int position)
+        {
+            int id = heap[position];
+            while (position > 0)
+            {
+                int parent = (position - 1) / Arity;
+                if (!Sooner(id, heap[parent])) break;
+                Place(position, heap[parent]);
+                position = parent;
+            }
+            Place(position, id);
+        }
+
+        private void SiftDown(int position)
+        {
+            int id = heap[position];
+            while (true)
+            {
+                int first = position * Arity + 1;
+                if (first >= count) break;
+                int best = first;
+                int last = Math.Min(first + Arity, count);
+                for (int child = first + 1; child < last; child++)
+                {
+                    if (Sooner(heap[child], heap[best])) best = child;
+                }
+                if (!Sooner(heap[best], id)) break;
+                Place(position, heap[best]);
+                position = best;
+            }
+            Place(position, id);
+        }
+
+        // The frontier is a binary min-heap of heap indices, ordered by the cards at those indices
+
+        private void FrontierUp(int i)
+        {
+            int item = frontier[i];
+            while (i > 0)
+            {
+                int parent = (i - 1) / 2;
+                if (!Sooner(heap[item], heap[frontier[parent]])) break;
+                frontier[i] = frontier[parent];
+                i = parent;
+            }
+            frontier[i] = item;
+        }
+
+        private void FrontierDown(int i, int size)
+        {
+            if (size == 0) return;
+            int item = frontier[i];
+            while (true)
+            {
+                int child = i * 2 + 1;
+                if (child >= size) break;
+                if (child + 1 < size && Sooner(heap[frontier[child + 1]], heap[frontier[child]])) child++;
+                if (!Sooner(heap[frontier[child]], heap[item])) break;
+                frontier[i] = frontier[child];
+                i = child;
+            }
+            frontier[i] = item;
+        }
+    }
+
+    public enum ReviewGrade
+    {
+        Again = 1,
+        Hard = 2,
+        Good = 3,
+        Easy = 4
+    }
+
+    /// <summary>
+    /// One word's memory state
+    /// </summary>
+    public struct ReviewCard
+    {
+        public float stability; // days for recall probability to fall to 90%
+        public float difficulty; // 1 (easy) to 10
+        public long lastReview; // Unix ms, 0 before the first review
+        public long due; // Unix ms
+        public int reps;
+        public int lapses; // reviews graded Again after the first
+    }
+}
@@ -366,57 +366,46 @@ namespace ARLinguaSphere.Core
             Debug.Log($"ARLinguaSphereController: Speech recognized: {speechText}");
             
             if (voiceManager == null) return;
-            voiceManager.ProcessVoiceCommand(speechText);
-            var cmd = speechText.ToLowerInvariant();
-            if (cmd.Contains("translate to "))
+            var command = voiceManager.ProcessVoiceCommand(speechText);
+            switch (command)
             {
-                // naive language extraction
-                var parts = cmd.Split(new string[] {"translate to "}, System.StringSplitOptions.None);
-                if (parts.Length > 1)
-                {
-                    string langWord = parts[1].Trim().Split(' ')[0];
-                    // Map a few common language names to codes
-                    string code = MapLanguageToCode(langWord);
+                case VoiceCommand.Translate:
+                case VoiceCommand.ChangeLanguage:
+                    // "translate to spanish" / "translate to español" / "change language to french"
+                    string code = languageManager?.ResolveLanguageCode(speechText);
                     if (!string.IsNullOrEmpty(code))
                     {
-                        languageManager?.SetCurrentLanguage(code);
+                        languageManager.SetCurrentLanguage(code);
                     }
-                }
-            }
-            else if (cmd.Contains("quiz"))
-            {
-                uiManager?.ShowQuizPanel();
-            }
-            else if (cmd.Contains("remove"))
-            {
-                labelManager?.RemoveAllLabels();
-            }
-            else if (cmd.Contains("what is this") || cmd.Contains("identify"))
-            {
-                // Trigger a single detection cycle (already flowing via frames)
-                // Optionally speak last placed label
-                var labels = labelManager?.GetActiveLabels();
-                if (labels != null && labels.Count > 0)
-                {
-                    voiceManager?.Speak(labels[labels.Count - 1].GetLabelText());
-                }
-            }
-        }
-
-        private string MapLanguageToCode(string word)
-        {
-            switch (word)
-            {
-                case "spanish": return "es";
-                case "french": return "fr";
-                case "german": return "de";
-                case "hindi": return "hi";
-                case "japanese": return "ja";
-                case "korean": return "ko";
-                case "chinese": return "zh";
-                case "italian": return "it";
-                case "portuguese": return "pt";
-                default: return null;
+                    else if (command == VoiceCommand.ChangeLanguage)
+                    {
+                        // No language named: move on to the next one, as the thumbs-up gesture does
+                        OnThumbsUpGesture();
+                    }
+                    break;
+                case VoiceCommand.Quiz:
+                    uiManager?.ShowQuizPanel();
+                    break;
+                case VoiceCommand.Remove:
+                    labelManager?.RemoveAllLabels();
+                    break;
+                case VoiceCommand.Identify:
+                    // Trigger a single detection cycle (already flowing via frames)
+                    // Optionally speak last placed label
+                    var labels = labelManager?.GetActiveLabels();
+                    if (labels != null && labels.Count > 0)
+                    {
+                        voiceManager.Speak(labels[labels.Count - 1].GetLabelText());
+                    }
+                    break;
+                case VoiceCommand.None:
+                    // A spoken dictionary word in any language: answer with its current-language translation
+                    if (languageManager != null && languageManager.TryResolveSpokenWord(speechText, out var match))
+                    {
+                        Debug.Log($"ARLinguaSphereController: '{speechText}' resolved to '{match.key}' ({match.language})");
+                        voiceManager.Speak(languageManager.GetTranslation(match.key));
+                    }
+                    break;
             }
         }
         
@@ -0,0 +1,207 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+
+namespace ARLinguaSphere.Core
+{
+    /// <summary>
+    /// A single dictionary correction. A null value removes the entry.
+    /// </summary>
+    [Serializable]
+    public class DictionaryPatch
+    {
+        public string key;
+        public string lang;
+        public string value;
+        public long version;
+        public long seq; // order among records sharing a version
+    }
+
+    /// <summary>
+    /// Delta format for hot-reloading dictionary corrections on top of the base shards:
+    /// { "version": N, "patches": [ { "key": "...", "lang": "..", "value": "...", "version": n, "seq": s }, ... ] }
+    /// Records are ordered by (version, seq). A record without "seq" is numbered by its position among the
+    /// document's records of the same version. Parsing and serialization touch no Unity APIs and are safe to run
+    /// off the main thread.
+    /// </summary>
+    public static class DictionaryDelta
+    {
+        public static List<DictionaryPatch> Parse(string json)
+        {
+            // A fresh index per call keeps Parse safe on worker threads
+            var index = new JsonIndex();
+            if (!index.Load(json) || !index.Root.TryGetField("patches", out var records) || !records.IsArray)
+            {
+                return null;
+            }
+
+            var patches = new List<DictionaryPatch>();
+            Dictionary<long, long> numbered = null; // version -> records seen, for records without "seq"
+            bool ordered = true;
+            var cursor = records.GetArray();
+            while (cursor.MoveNext())
+            {
+                var patch = new DictionaryPatch();
+                bool hasVersion = false;
+                bool hasSeq = false;
+                var fields = cursor.Current.GetObject();
+                while (fields.MoveNext())
+                {
+                    if (fields.KeyEquals("key")) patch.key = fields.Value.GetString();
+                    else if (fields.KeyEquals("lang")) patch.lang = fields.Value.GetString();
+                    else if (fields.KeyEquals("value")) patch.value = fields.Value.GetString();
+                    else if (fields.KeyEquals("version"))
+                    {
+                        patch.version = fields.Value.GetInt64();
+                        hasVersion = fields.Value.IsNumber;
+                    }
+                    else if (fields.KeyEquals("seq"))
+                    {
+                        patch.seq = fields.Value.GetInt64();
+                        hasSeq = fields.Value.IsNumber;
+                    }
+                }
+                if (!hasVersion || string.IsNullOrEmpty(patch.key) || string.IsNullOrEmpty(patch.lang)) continue;
+                if (!hasSeq)
+                {
+                    if (numbered == null) numbered = new Dictionary<long, long>();
+                    numbered.TryGetValue(patch.version, out long seen);
+                    patch.seq = numbered[patch.version] = seen + 1;
+                }
+                if (patches.Count > 0 && Compare(patches[patches.Count - 1], patch) > 0) ordered = false;
+                patches.Add(patch);
+            }
+
+            if (!ordered)
+            {
+                // Stable, so records that tie keep publication order
+                var indexed = new KeyValuePair<DictionaryPatch, int>[patches.Count];
+                for (int i = 0; i < patches.Count; i++) indexed[i] = new KeyValuePair<DictionaryPatch, int>(patches[i], i);
+                Array.Sort(indexed, (a, b) =>
+                {
+                    int order = Compare(a.Key, b.Key);
+                    return order != 0 ? order : a.Value.CompareTo(b.Value);
+                });
+                var sorted = new List<DictionaryPatch>(patches.Count);
+                foreach (var entry in indexed) sorted.Add(entry.Key);
+                patches = sorted;
+            }
+            return patches;
+        }
+
+        /// <summary>
+        /// Order of two records: by version, then by seq
+        /// </summary>
+        public static int Compare(DictionaryPatch a, DictionaryPatch b)
+        {
+            return a.version != b.version ? a.version.CompareTo(b.version) : a.seq.CompareTo(b.seq);
+        }
+
+        public static string Serialize(long version, IEnumerable<DictionaryPatch> patches)
+        {
+            var sb = new StringBuilder();
+            sb.Append("{\"version\":").Append(version.ToString(CultureInfo.InvariantCulture)).Append(",\"patches\":[");
+            bool first = true;
+            foreach (var patch in patches)
+            {
+                if (!first) sb.Append(',');
+                first = false;
+                sb.Append("{\"key\":");
+                AppendJsonString(sb, patch.key);
+                sb.Append(",\"lang\":");
+                AppendJsonString(sb, patch.lang);
+                sb.Append(",\"value\":");
+                if (patch.value == null) sb.Append("null");
+                else AppendJsonString(sb, patch.value);
+                sb.Append(",\"version\":").Append(patch.version.ToString(CultureInfo.InvariantCulture));
+                sb.Append(",\"seq\":").Append(patch.seq.ToString(CultureInfo.InvariantCulture)).Append('}');
+            }
+            sb.Append("]}");
+            return sb.ToString();
+        }
+
+        private static void AppendJsonString(StringBuilder sb, string value)
+        {
+            sb.Append('"');
+            foreach (char c in value)
+            {
+                switch (c)
+                {
+                    case '"': sb.Append("\\\""); break;
+                    case '\\': sb.Append("\\\\"); break;
+                    case '\n': sb.Append("\\n"); break;
+                    case '\r': sb.Append("\\r"); break;
+                    case '\t': sb.Append("\\t"); break;
+                    default:
+                        if (c < 0x20) sb.Append("\\u").Append(((int)c).ToString("x4"));
+                        else sb.Append(c);
+                        break;
+                }
+            }
+            sb.Append('"');
+        }
+    }
+
+    /// <summary>
+    /// Every applied patch per language, the latest per key, and the (version, seq) cursor of the last one applied.
+    /// Records at or before the cursor were applied already: a delta fetched twice, or the persisted log replayed.
+    /// </summary>
+    public sealed class DictionaryOverlay
+    {
+        private readonly Dictionary<string, Dictionary<string, DictionaryPatch>> patches =
+            new Dictionary<string, Dictionary<string, DictionaryPatch>>();
+
+        public long Version { get; private set; }
+        public long Sequence { get; private set; }
+
+        /// <summary>
+        /// Apply a patch after the cursor; false (and nothing changes) for one at or before it
+        /// </summary>
+        public bool Apply(DictionaryPatch patch)
+        {
+            if (patch.version < Version || (patch.version == Version && patch.seq <= Sequence))
+            {
+                return false;
+            }
+            if (!patches.TryGetValue(patch.lang, out var byKey))
+            {
+                byKey = new Dictionary<string, DictionaryPatch>();
+                patches[patch.lang] = byKey;
+            }
+            byKey[patch.key] = patch;
+            Version = patch.version;
+            Sequence = patch.seq;
+            return true;
+        }
+
+        /// <summary>
+        /// Overwrite or remove the patched entries of a freshly loaded shard
+        /// </summary>
+        public void ApplyTo(string language, Dictionary<string, string> shard)
+        {
+            if (!patches.TryGetValue(language, out var byKey))
+            {
+                return;
+            }
+            foreach (var patch in byKey.Values)
+            {
+                if (patch.value == null) shard.Remove(patch.key);
+                else shard[patch.key] = patch.value;
+            }
+        }
+
+        /// <summary>
+        /// The compacted patch set: one record per (key, lang), superseded records dropped
+        /// </summary>
+        public List<DictionaryPatch> Snapshot()
+        {
+            var snapshot = new List<DictionaryPatch>();
+            foreach (var byKey in patches.Values)
+            {
+                snapshot.AddRange(byKey.Values);
+            }
+            return snapshot;
+        }
+    }
+}
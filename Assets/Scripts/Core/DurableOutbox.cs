@@ -0,0 +1,296 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace ARLinguaSphere.Core
+{
+    /// <summary>
+    /// Persistent queue of pending writes backed by an append-only log, so writes survive app restarts.
+    /// A newer write to the same key supersedes the pending one; entries are handed out in enqueue order,
+    /// never two for the same key at once, and failed sends back off exponentially with jitter.
+    /// Log records are length-prefixed and CRC-checked; a torn tail from a crash is truncated on open.
+    /// Main-thread only.
+    /// </summary>
+    public sealed class DurableOutbox : IDisposable
+    {
+        public int MaxRetries { get; set; }
+        public float BaseBackoffSeconds { get; set; } = 1f;
+        public float MaxBackoffSeconds { get; set; } = 60f;
+        public long CompactThresholdBytes { get; set; } = 256 * 1024;
+        public int Count => byKey.Count;
+        public string Path { get; }
+
+        private const byte OpPut = 1;
+        private const byte OpAck = 2;
+        private const int HeaderSize = 8; // int32 length + uint32 crc
+
+        private readonly Dictionary<string, OutboxEntry> byKey = new Dictionary<string, OutboxEntry>();
+        private readonly SortedDictionary<long, OutboxEntry> bySequence = new SortedDictionary<long, OutboxEntry>();
+        private readonly HashSet<string> inFlightKeys = new HashSet<string>();
+        private readonly Random jitter = new Random();
+        private readonly MemoryStream recordBuffer = new MemoryStream(256);
+        private FileStream log;
+        private long nextSequence = 1;
+        private int deadRecords;
+
+        private static readonly uint[] CrcTable = BuildCrcTable();
+
+        private DurableOutbox(string path, int maxRetries)
+        {
+            Path = path;
+            MaxRetries = Math.Max(0, maxRetries);
+        }
+
+        /// <summary>
+        /// Open (or create) the outbox at <paramref name="path"/> and replay its pending writes.
+        /// </summary>
+        public static DurableOutbox Open(string path, int maxRetries)
+        {
+            var outbox = new DurableOutbox(path, maxRetries);
+            Directory.CreateDirectory(System.IO.Path.GetDirectoryName(path));
+            outbox.Replay();
+            outbox.Compact();
+            return outbox;
+        }
+
+        /// <summary>
+        /// Queue <paramref name="payload"/> (null is a valid payload, e.g. a delete) for <paramref name="key"/>.
+        /// </summary>
+        public OutboxEntry Enqueue(string key, string payload)
+        {
+            var entry = new OutboxEntry { sequence = nextSequence++, key = key, payload = payload };
+            if (byKey.TryGetValue(key, out var superseded))
+            {
+                bySequence.Remove(superseded.sequence);
+                deadRecords++;
+            }
+            byKey[key] = entry;
+            bySequence[entry.sequence] = entry;
+            AppendRecord(OpPut, entry.sequence, key, payload);
+            return entry;
+        }
+
+        /// <summary>
+        /// Move up to <paramref name="max"/> entries whose backoff has elapsed into <paramref name="ready"/> and mark them in flight.
+        /// </summary>
+        public int TakeReady(float now, int max, List<OutboxEntry> ready)
+        {
+            int taken = 0;
+            foreach (var entry in bySequence.Values)
+            {
+                if (taken >= max) break;
+                if (entry.inFlight || entry.nextAttemptAt > now || inFlightKeys.Contains(entry.key)) continue;
+                entry.inFlight = true;
+                inFlightKeys.Add(entry.key);
+                ready.Add(entry);
+                taken++;
+            }
+            return taken;
+        }
+
+        /// <summary>
+        /// The write was delivered; drop it unless a newer write to the same key has been queued meanwhile.
+        /// Returns true if the key has nothing left pending.
+        /// </summary>
+        public bool Ack(OutboxEntry entry)
+        {
+            entry.inFlight = false;
+            inFlightKeys.Remove(entry.key);
+            if (byKey.TryGetValue(entry.key, out var current) && current.sequence == entry.sequence)
+            {
+                byKey.Remove(entry.key);
+                bySequence.Remove(entry.sequence);
+                AppendRecord(OpAck, entry.sequence, null, null);
+                deadRecords += 2;
+                if (log.Length > CompactThresholdBytes && deadRecords > 2 * byKey.Count) Compact();
+                return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// The write failed; schedule a retry. Returns true exactly once, when the failure count reaches MaxRetries
+        /// (the entry stays queued and keeps retrying at the capped backoff).
+        /// </summary>
+        public bool Fail(OutboxEntry entry, float now)
+        {
+            entry.inFlight = false;
+            inFlightKeys.Remove(entry.key);
+            entry.attempts++;
+            double backoff = Math.Min(MaxBackoffSeconds, BaseBackoffSeconds * Math.Pow(2, Math.Min(entry.attempts - 1, 30)));
+            entry.nextAttemptAt = now + (float)(backoff * (0.5 + 0.5 * jitter.NextDouble()));
+            return entry.attempts == Math.Max(1, MaxRetries);
+        }
+
+        /// <summary>
+        /// Make every queued entry eligible immediately, e.g. when connectivity returns.
+        /// </summary>
+        public void RetryNow()
+        {
+            foreach (var entry in bySequence.Values)
+            {
+                entry.nextAttemptAt = 0f;
+            }
+        }
+
+        public void Clear()
+        {
+            byKey.Clear();
+            bySequence.Clear();
+            inFlightKeys.Clear();
+            Compact();
+        }
+
+        /// <summary>
+        /// Rewrite the log with only the pending writes.
+        /// </summary>
+        public void Compact()
+        {
+            log?.Dispose();
+            string tempPath = Path + ".tmp";
+            using (log = new FileStream(tempPath, FileMode.Create, FileAccess.Write, FileShare.Read))
+            {
+                foreach (var entry in bySequence.Values)
+                {
+                    AppendRecord(OpPut, entry.sequence, entry.key, entry.payload);
+                }
+            }
+            if (File.Exists(Path)) File.Delete(Path);
+            File.Move(tempPath, Path);
+            log = new FileStream(Path, FileMode.Append, FileAccess.Write, FileShare.Read);
+            deadRecords = 0;
+        }
+
+        public void Dispose()
+        {
+            log?.Dispose();
+            log = null;
+        }
+
+        private void Replay()
+        {
+            if (!File.Exists(Path)) return;
+            byte[] data = File.ReadAllBytes(Path);
+            int pos = 0;
+            while (pos + HeaderSize <= data.Length)
+            {
+                int length = BitConverter.ToInt32(data, pos);
+                uint crc = BitConverter.ToUInt32(data, pos + 4);
+                if (length < 9 || length > data.Length - pos - HeaderSize || Crc32(data, pos + HeaderSize, length) != crc) break;
+                ApplyRecord(data, pos + HeaderSize, length);
+                pos += HeaderSize + length;
+            }
+            if (pos < data.Length) UnityEngine.Debug.LogWarning($"DurableOutbox: Dropped {data.Length - pos} bytes of torn log tail in {Path}");
+        }
+
+        private void ApplyRecord(byte[] data, int offset, int length)
+        {
+            int pos = offset;
+            int end = offset + length;
+            byte op = data[pos++];
+            long sequence = BitConverter.ToInt64(data, pos);
+            pos += 8;
+            if (sequence >= nextSequence) nextSequence = sequence + 1;
+
+            if (op == OpAck)
+            {
+                // Acks for superseded writes find nothing: the newer write is still pending
+                if (bySequence.TryGetValue(sequence, out var acked))
+                {
+                    byKey.Remove(acked.key);
+                    bySequence.Remove(sequence);
+                }
+                return;
+            }
+            if (op != OpPut) return;
+
+            string key = ReadString(data, ref pos, end);
+            string payload = ReadString(data, ref pos, end);
+            if (key == null) return;
+            if (byKey.TryGetValue(key, out var superseded)) bySequence.Remove(superseded.sequence);
+            var replayed = new OutboxEntry { sequence = sequence, key = key, payload = payload };
+            byKey[key] = replayed;
+            bySequence[sequence] = replayed;
+        }
+
+        private void AppendRecord(byte op, long sequence, string key, string payload)
+        {
+            var body = recordBuffer;
+            body.SetLength(0);
+            body.WriteByte(op);
+            body.Write(BitConverter.GetBytes(sequence), 0, 8);
+            if (op == OpPut)
+            {
+                WriteString(body, key);
+                WriteString(body, payload);
+            }
+
+            byte[] bytes = body.GetBuffer();
+            int length = (int)body.Length;
+            log.Write(BitConverter.GetBytes(length), 0, 4);
+            log.Write(BitConverter.GetBytes(Crc32(bytes, 0, length)), 0, 4);
+            log.Write(bytes, 0, length);
+            log.Flush();
+        }
+
+        private static void WriteString(Stream stream, string value)
+        {
+            // int32 byte length, -1 for null
+            if (value == null)
+            {
+                stream.Write(BitConverter.GetBytes(-1), 0, 4);
+                return;
+            }
+            byte[] bytes = Encoding.UTF8.GetBytes(value);
+            stream.Write(BitConverter.GetBytes(bytes.Length), 0, 4);
+            stream.Write(bytes, 0, bytes.Length);
+        }
+
+        private static string ReadString(byte[] data, ref int pos, int end)
+        {
+            if (end - pos < 4) return null;
+            int length = BitConverter.ToInt32(data, pos);
+            pos += 4;
+            if (length < 0 || length > end - pos) return null;
+            string value = Encoding.UTF8.GetString(data, pos, length);
+            pos += length;
+            return value;
+        }
+
+        private static uint Crc32(byte[] data, int offset, int count)
+        {
+            uint crc = 0xFFFFFFFF;
+            for (int i = offset; i < offset + count; i++)
+            {
+                crc = CrcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        private static uint[] BuildCrcTable()
+        {
+            var table = new uint[256];
+            for (uint n = 0; n < 256; n++)
+            {
+                uint c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) != 0 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            return table;
+        }
+    }
+
+    /// <summary>
+    /// A pending outbox write
+    /// </summary>
+    public class OutboxEntry
+    {
+        public long sequence;
+        public string key;
+        public string payload;
+        public int attempts;
+        public float nextAttemptAt;
+        public bool inFlight;
+    }
+}
@@ -0,0 +1,473 @@
+using System;
+using System.Globalization;
+using System.Text;
+
+namespace ARLinguaSphere.Core
+{
+    /// <summary>
+    /// Two-stage JSON reader in the style of simdjson: Load() builds a structural index (token offsets plus
+    /// matching-bracket links) in one pass, then JsonNode cursors pull typed fields on demand without
+    /// materialising an object graph or boxing numbers. Only values that are read are decoded.
+    /// An index (and every node taken from it) is valid until the next Load; use one instance per thread.
+    /// </summary>
+    public sealed class JsonIndex
+    {
+        private string source;
+        private int[] tokens = new int[256];   // source offset of every structural char and scalar start
+        private int[] partners = new int[256]; // for '{' / '[' tokens: token index of the matching close
+        private int[] stack = new int[32];
+        private int tokenCount;
+        private readonly StringBuilder unescapeBuffer = new StringBuilder(64);
+
+        private static readonly double[] PowersOf10 =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        public string Source => source;
+        public int TokenCount => tokenCount;
+        public JsonNode Root => tokenCount > 0 ? new JsonNode(this, 0) : default;
+
+        /// <summary>
+        /// Stage 1: index the structure of a document. Returns false for empty or structurally malformed input.
+        /// </summary>
+        public bool Load(string json)
+        {
+            source = json;
+            tokenCount = 0;
+            if (string.IsNullOrEmpty(json)) return false;
+
+            int depth = 0;
+            int length = json.Length;
+            int i = 0;
+            while (i < length)
+            {
+                char c = json[i];
+                switch (c)
+                {
+                    case ' ':
+                    case '\t':
+                    case '\r':
+                    case '\n':
+                        i++;
+                        continue;
+                    case '{':
+                    case '[':
+                        if (depth == stack.Length) Array.Resize(ref stack, depth * 2);
+                        stack[depth++] = tokenCount;
+                        AddToken(i);
+                        i++;
+                        continue;
+                    case '}':
+                    case ']':
+                    {
+                        if (depth == 0) return false;
+                        int open = stack[--depth];
+                        if (json[tokens[open]] != (c == '}' ? '{' : '[')) return false;
+                        partners[open] = tokenCount;
+                        AddToken(i);
+                        i++;
+                        continue;
+                    }
+                    case ':':
+                    case ',':
+                        AddToken(i);
+                        i++;
+                        continue;
+                    case '"':
+                        AddToken(i);
+                        i++;
+                        while (i < length)
+                        {
+                            char s = json[i];
+                            if (s == '"') break;
+                            i += s == '\\' ? 2 : 1;
+                        }
+                        if (i >= length) return false; // unterminated string
+                        i++;
+                        continue;
+                    default:
+                        // number / true / false / null: runs to the next delimiter
+                        AddToken(i);
+                        while (i < length && !IsDelimiter(json[i])) i++;
+                        continue;
+                }
+            }
+            return depth == 0 && tokenCount > 0;
+        }
+
+        /// <summary>
+        /// Drop the reference to the last document so large sources can be collected.
+        /// </summary>
+        public void Clear()
+        {
+            source = null;
+            tokenCount = 0;
+        }
+
+        private void AddToken(int offset)
+        {
+            if (tokenCount == tokens.Length)
+            {
+                Array.Resize(ref tokens, tokenCount * 2);
+                Array.Resize(ref partners, tokenCount * 2);
+            }
+            tokens[tokenCount] = offset;
+            partners[tokenCount] = -1;
+            tokenCount++;
+        }
+
+        private static bool IsDelimiter(char c)
+        {
+            return c == ',' || c == ':' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        internal char CharAt(int token) => token < tokenCount ? source[tokens[token]] : '\0';
+
+        internal int Offset(int token) => tokens[token];
+
+        /// <summary>
+        /// Token index just past the value starting at <paramref name="token"/>.
+        /// </summary>
+        internal int Skip(int token)
+        {
+            char c = source[tokens[token]];
+            return c == '{' || c == '[' ? partners[token] + 1 : token + 1;
+        }
+
+        internal int StringEnd(int offset)
+        {
+            // offset points at the opening quote; returns offset of the closing quote
+            int i = offset + 1;
+            while (source[i] != '"') i += source[i] == '\\' ? 2 : 1;
+            return i;
+        }
+
+        internal string DecodeString(int offset)
+        {
+            int start = offset + 1;
+            int end = StringEnd(offset);
+            int escape = source.IndexOf('\\', start, end - start);
+            if (escape < 0) return source.Substring(start, end - start);
+
+            var sb = unescapeBuffer;
+            sb.Length = 0;
+            sb.Append(source, start, escape - start);
+            for (int i = escape; i < end; i++)
+            {
+                char c = source[i];
+                if (c != '\\')
+                {
+                    sb.Append(c);
+                    continue;
+                }
+                char e = source[++i];
+                switch (e)
+                {
+                    case 'b': sb.Append('\b'); break;
+                    case 'f': sb.Append('\f'); break;
+                    case 'n': sb.Append('\n'); break;
+                    case 'r': sb.Append('\r'); break;
+                    case 't': sb.Append('\t'); break;
+                    case 'u':
+                        sb.Append((char)ParseHex4(i + 1));
+                        i += 4;
+                        break;
+                    default: sb.Append(e); break; // '"', '\\', '/'
+                }
+            }
+            return sb.ToString();
+        }
+
+        internal bool StringEquals(int offset, string value)
+        {
+            int start = offset + 1;
+            int end = StringEnd(offset);
+            int length = end - start;
+            if (source.IndexOf('\\', start, length) >= 0) return DecodeString(offset) == value;
+            return length == value.Length && string.CompareOrdinal(source, start, value, 0, length) == 0;
+        }
+
+        private int ParseHex4(int offset)
+        {
+            int value = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                char h = source[offset + i];
+                int digit = h >= '0' && h <= '9' ? h - '0' : h >= 'a' && h <= 'f' ? h - 'a' + 10 : h >= 'A' && h <= 'F' ? h - 'A' + 10 : 0;
+                value = (value << 4) | digit;
+            }
+            return value;
+        }
+
+        internal double ParseDouble(int offset)
+        {
+            int i = offset;
+            int length = source.Length;
+            bool negative = false;
+            if (source[i] == '-') { negative = true; i++; }
+
+            // Clinger fast path: exact when the mantissa fits 53 bits and |exponent| <= 22
+            ulong mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            for (; i < length && (uint)(source[i] - '0') <= 9; i++)
+            {
+                if (digits < 19) { mantissa = mantissa * 10 + (ulong)(source[i] - '0'); if (mantissa != 0) digits++; }
+                else exponent++;
+            }
+            if (i < length && source[i] == '.')
+            {
+                for (i++; i < length && (uint)(source[i] - '0') <= 9; i++)
+                {
+                    if (digits < 19) { mantissa = mantissa * 10 + (ulong)(source[i] - '0'); if (mantissa != 0) digits++; exponent--; }
+                }
+            }
+            if (i < length && (source[i] == 'e' || source[i] == 'E'))
+            {
+                i++;
+                bool negativeExponent = false;
+                if (i < length && (source[i] == '+' || source[i] == '-')) { negativeExponent = source[i] == '-'; i++; }
+                int e = 0;
+                for (; i < length && (uint)(source[i] - '0') <= 9; i++)
+                {
+                    if (e < 10000) e = e * 10 + (source[i] - '0');
+                }
+                exponent += negativeExponent ? -e : e;
+            }
+
+            double value;
+            if (mantissa <= (1UL << 53) && exponent >= -22 && exponent <= 22)
+            {
+                value = exponent >= 0 ? mantissa * PowersOf10[exponent] : mantissa / PowersOf10[-exponent];
+            }
+            else
+            {
+                int end = offset;
+                while (end < length && !IsDelimiter(source[end])) end++;
+                value = double.Parse(source.Substring(offset, end - offset), NumberStyles.Float, CultureInfo.InvariantCulture);
+                return value;
+            }
+            return negative ? -value : value;
+        }
+
+        internal long ParseInt64(int offset)
+        {
+            int i = offset;
+            int length = source.Length;
+            bool negative = false;
+            if (source[i] == '-') { negative = true; i++; }
+            long value = 0;
+            for (; i < length && (uint)(source[i] - '0') <= 9; i++)
+            {
+                value = value * 10 + (source[i] - '0');
+            }
+            if (i < length && (source[i] == '.' || source[i] == 'e' || source[i] == 'E'))
+            {
+                return (long)ParseDouble(offset);
+            }
+            return negative ? -value : value;
+        }
+    }
+
+    public enum JsonKind
+    {
+        None,
+        Object,
+        Array,
+        String,
+        Number,
+        True,
+        False,
+        Null
+    }
+
+    /// <summary>
+    /// On-demand cursor over one value in a JsonIndex
+    /// </summary>
+    public readonly struct JsonNode
+    {
+        private readonly JsonIndex index;
+        private readonly int token;
+
+        internal JsonNode(JsonIndex index, int token)
+        {
+            this.index = index;
+            this.token = token;
+        }
+
+        internal int Token => token;
+
+        public JsonKind Kind
+        {
+            get
+            {
+                if (index == null) return JsonKind.None;
+                switch (index.CharAt(token))
+                {
+                    case '{': return JsonKind.Object;
+                    case '[': return JsonKind.Array;
+                    case '"': return JsonKind.String;
+                    case 't': return JsonKind.True;
+                    case 'f': return JsonKind.False;
+                    case 'n': return JsonKind.Null;
+                    case '\0': return JsonKind.None;
+                    default: return JsonKind.Number;
+                }
+            }
+        }
+
+        public bool IsObject => Kind == JsonKind.Object;
+        public bool IsArray => Kind == JsonKind.Array;
+        public bool IsString => Kind == JsonKind.String;
+        public bool IsNumber => Kind == JsonKind.Number;
+        public bool IsNull => Kind == JsonKind.Null || Kind == JsonKind.None;
+
+        public JsonObjectCursor GetObject() => new JsonObjectCursor(IsObject ? index : null, token);
+        public JsonArrayCursor GetArray() => new JsonArrayCursor(IsArray ? index : null, token);
+
+        /// <summary>
+        /// Linear scan of an object for a field; fine for the small records we exchange.
+        /// </summary>
+        public bool TryGetField(string name, out JsonNode value)
+        {
+            var fields = GetObject();
+            while (fields.MoveNext())
+            {
+                if (fields.KeyEquals(name))
+                {
+                    value = fields.Value;
+                    return true;
+                }
+            }
+            value = default;
+            return false;
+        }
+
+        public string GetString()
+        {
+            switch (Kind)
+            {
+                case JsonKind.String: return index.DecodeString(index.Offset(token));
+                case JsonKind.Number:
+                case JsonKind.True:
+                case JsonKind.False:
+                {
+                    // Match MiniJSON's ToString() leniency for scalar fields read as strings
+                    int start = index.Offset(token);
+                    int end = start;
+                    string src = index.Source;
+                    while (end < src.Length && src[end] != ',' && src[end] != '}' && src[end] != ']' && !char.IsWhiteSpace(src[end])) end++;
+                    return src.Substring(start, end - start);
+                }
+                default: return null;
+            }
+        }
+
+        public bool StringEquals(string value)
+        {
+            return IsString && value != null && index.StringEquals(index.Offset(token), value);
+        }
+
+        public long GetInt64(long fallback = 0)
+        {
+            return IsNumber ? index.ParseInt64(index.Offset(token)) : fallback;
+        }
+
+        public int GetInt32(int fallback = 0)
+        {
+            return IsNumber ? (int)index.ParseInt64(index.Offset(token)) : fallback;
+        }
+
+        public double GetDouble(double fallback = 0)
+        {
+            return IsNumber ? index.ParseDouble(index.Offset(token)) : fallback;
+        }
+
+        public float GetSingle(float fallback = 0f)
+        {
+            return IsNumber ? (float)index.ParseDouble(index.Offset(token)) : fallback;
+        }
+
+        public bool GetBoolean(bool fallback = false)
+        {
+            var kind = Kind;
+            return kind == JsonKind.True || (kind != JsonKind.False && fallback);
+        }
+    }
+
+    /// <summary>
+    /// Iterates the fields of an object: while (cursor.MoveNext()) { cursor.KeyEquals(..) / cursor.Value }
+    /// </summary>
+    public struct JsonObjectCursor
+    {
+        private readonly JsonIndex index;
+        private readonly int open;
+        private int key;
+        private bool done;
+
+        internal JsonObjectCursor(JsonIndex index, int open)
+        {
+            this.index = index;
+            this.open = open;
+            key = -1;
+            done = index == null;
+        }
+
+        public bool MoveNext()
+        {
+            if (done) return false;
+            int next = key < 0 ? open + 1 : index.Skip(key + 2);
+            char c = index.CharAt(next);
+            if (c == ',') c = index.CharAt(++next);
+            if (c != '"')
+            {
+                done = true;
+                return false;
+            }
+            key = next;
+            return true;
+        }
+
+        public string Key => index.DecodeString(index.Offset(key));
+        public bool KeyEquals(string name) => index.StringEquals(index.Offset(key), name);
+        public JsonNode Value => new JsonNode(index, key + 2);
+    }
+
+    /// <summary>
+    /// Iterates the elements of an array
+    /// </summary>
+    public struct JsonArrayCursor
+    {
+        private readonly JsonIndex index;
+        private readonly int open;
+        private int current;
+        private bool done;
+
+        internal JsonArrayCursor(JsonIndex index, int open)
+        {
+            this.index = index;
+            this.open = open;
+            current = -1;
+            done = index == null;
+        }
+
+        public bool MoveNext()
+        {
+            if (done) return false;
+            int next = current < 0 ? open + 1 : index.Skip(current);
+            char c = index.CharAt(next);
+            if (c == ',') c = index.CharAt(++next);
+            if (c == ']' || c == '\0' || c == '}')
+            {
+                done = true;
+                return false;
+            }
+            current = next;
+            return true;
+        }
+
+        public JsonNode Current => new JsonNode(index, current);
+    }
+}
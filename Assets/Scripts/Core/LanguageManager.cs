@@ -1,8 +1,9 @@
 using UnityEngine;
+using UnityEngine.Networking;
+using System.Collections;
 using System.Collections.Generic;
 using System.IO;
 using System.Threading.Tasks;
-using ARLinguaSphere.Core.ThirdParty;
 
 namespace ARLinguaSphere.Core
 {
@@ -17,66 +18,546 @@ namespace ARLinguaSphere.Core
         public bool enableOnlineTranslation = true;
         
         [Header("Dictionary Settings")]
-        public string dictionaryPath = "offline_dictionary";
+        public string shardDirectory = "Dictionary";
+        public int maxResidentShards = 3;
         
-        private Dictionary<string, Dictionary<string, string>> offlineDictionary;
+        [Header("Lexicon Settings")]
+        public int lexiconMaxEditDistance = 2;
+        
+        [Header("Delta Settings")]
+        public string deltaUrl = "";
+        public int deltaRecordsPerFrame = 256;
+        public float deltaMergeIdleSeconds = 2f;
+        
+        // Per-language shards: language code -> (label key -> translation). Only resident shards are present.
+        private Dictionary<string, Dictionary<string, string>> loadedShards;
+        private LinkedList<string> shardUsage; // most recently used first
+        private Dictionary<string, Dictionary<string, string>> customTranslations;
+        private DictionaryManifest manifest;
+        private LexiconIndex lexicon; // built on first spoken-word lookup
+        private LexiconIndex languageNameIndex;
+        private readonly JsonIndex jsonIndex = new JsonIndex(); // main-thread parser, reused across shards
         private bool isInitialized = false;
         
+        // Delta overlay: every applied patch per language (re-applied to shards as they load),
+        // plus the subset not yet folded into resident shards, which lookups consult first.
+        private DictionaryOverlay deltaOverlay;
+        private Dictionary<string, Dictionary<string, string>> unmergedPatches;
+        private Queue<Task<List<DictionaryPatch>>> pendingDeltas;
+        private readonly List<string> mergedLanguages = new List<string>();
+        private Coroutine deltaCoroutine;
+        private Task deltaSaveTask = Task.CompletedTask;
+        private float lastDeltaActivityTime;
+        private bool deltaLogDirty;
+        private const string DeltaLogFileName = "dictionary_deltas.json";
+        
         // Events
         public System.Action<string, string> OnLanguageChanged;
         public System.Action<string, string, string> OnTranslationCompleted;
+        public System.Action OnDictionaryUpdated;
+        
+        public long DictionaryDeltaVersion => deltaOverlay != null ? deltaOverlay.Version : 0;
+        public int ResidentShardCount => loadedShards != null ? loadedShards.Count : 0;
+        
+        public bool IsShardResident(string language)
+        {
+            return loadedShards != null && !string.IsNullOrEmpty(language) && loadedShards.ContainsKey(language);
+        }
         
         public void Initialize()
         {
             Debug.Log("LanguageManager: Initializing language systems...");
             
-            offlineDictionary = new Dictionary<string, Dictionary<string, string>>();
+            loadedShards = new Dictionary<string, Dictionary<string, string>>();
+            shardUsage = new LinkedList<string>();
+            customTranslations = new Dictionary<string, Dictionary<string, string>>();
+            deltaOverlay = new DictionaryOverlay();
+            unmergedPatches = new Dictionary<string, Dictionary<string, string>>();
+            pendingDeltas = new Queue<Task<List<DictionaryPatch>>>();
+            manifest = null;
             isInitialized = true;
             
+            Application.lowMemory -= OnLowMemory;
+            Application.lowMemory += OnLowMemory;
+            
             Debug.Log("LanguageManager: Language systems initialized!");
             LoadOfflineDictionary();
+            LoadDeltaLog();
+            if (!string.IsNullOrEmpty(deltaUrl))
+            {
+                CheckForDictionaryUpdates();
+            }
         }
         
         public void LoadOfflineDictionary()
         {
+            if (!isInitialized)
+            {
+                Debug.LogWarning("LanguageManager: Not initialized yet");
+                return;
+            }
+            
             try
             {
-                TextAsset dictionaryAsset = Resources.Load<TextAsset>(dictionaryPath);
-                if (dictionaryAsset != null)
+                loadedShards.Clear();
+                shardUsage.Clear();
+                unmergedPatches.Clear(); // reloaded shards get every applied patch
+                lexicon = null;
+                
+                manifest = LoadManifest();
+                if (manifest != null)
+                {
+                    // Only the active and fallback languages are made resident up front
+                    EnsureShardLoaded(fallbackLanguage);
+                    EnsureShardLoaded(currentLanguage);
+                    Debug.Log($"LanguageManager: Loaded dictionary manifest with {manifest.entryCount} entries in {manifest.languages.Count} languages");
+                }
+                else
+                {
+                    Debug.LogError($"LanguageManager: Could not load dictionary manifest from Resources/{shardDirectory}");
+                }
+                BuildLanguageNameIndex();
+            }
+            catch (System.Exception e)
+            {
+                Debug.LogError($"LanguageManager: Error loading offline dictionary: {e.Message}");
+            }
+        }
+        
+        private DictionaryManifest LoadManifest()
+        {
+            TextAsset manifestAsset = Resources.Load<TextAsset>($"{shardDirectory}/manifest");
+            if (manifestAsset == null)
+            {
+                return null;
+            }
+            
+            if (!jsonIndex.Load(manifestAsset.text) || !jsonIndex.Root.IsObject)
+            {
+                Resources.UnloadAsset(manifestAsset);
+                Debug.LogError("LanguageManager: Failed to parse dictionary manifest JSON");
+                return null;
+            }
+            
+            var result = new DictionaryManifest();
+            var fields = jsonIndex.Root.GetObject();
+            while (fields.MoveNext())
+            {
+                if (fields.KeyEquals("version"))
+                {
+                    result.version = fields.Value.GetInt32(1);
+                }
+                else if (fields.KeyEquals("entryCount"))
                 {
-                    string jsonContent = dictionaryAsset.text;
-                    var parsed = MiniJSON.Deserialize(jsonContent) as Dictionary<string, object>;
-                    if (parsed == null)
+                    result.entryCount = fields.Value.GetInt32();
+                }
+                else if (fields.KeyEquals("languages"))
+                {
+                    var languages = fields.Value.GetArray();
+                    while (languages.MoveNext())
                     {
-                        Debug.LogError("LanguageManager: Failed to parse offline dictionary JSON");
+                        if (languages.Current.IsString) result.languages.Add(languages.Current.GetString());
                     }
-                    else
+                }
+                else if (fields.KeyEquals("languageNames"))
+                {
+                    var byLanguage = fields.Value.GetObject();
+                    while (byLanguage.MoveNext())
                     {
-                        var dict = new Dictionary<string, Dictionary<string, string>>();
-                        foreach (var kvp in parsed)
+                        var names = new List<string>();
+                        var nameList = byLanguage.Value.GetArray();
+                        while (nameList.MoveNext())
                         {
-                            var inner = kvp.Value as Dictionary<string, object>;
-                            if (inner == null) continue;
-                            var innerDict = new Dictionary<string, string>();
-                            foreach (var langKvp in inner)
-                            {
-                                innerDict[langKvp.Key] = langKvp.Value != null ? langKvp.Value.ToString() : string.Empty;
-                            }
-                            dict[kvp.Key] = innerDict;
+                            if (nameList.Current.IsString) names.Add(nameList.Current.GetString());
                         }
-                        offlineDictionary = dict;
-                        Debug.Log($"LanguageManager: Loaded offline dictionary with {offlineDictionary.Count} entries");
+                        result.languageNames[byLanguage.Key] = names;
                     }
                 }
-                else
+            }
+            jsonIndex.Clear();
+            Resources.UnloadAsset(manifestAsset);
+            return result;
+        }
+        
+        private Dictionary<string, string> EnsureShardLoaded(string language)
+        {
+            if (string.IsNullOrEmpty(language) || manifest == null)
+            {
+                return null;
+            }
+            
+            if (loadedShards.TryGetValue(language, out var shard))
+            {
+                if (shardUsage.First.Value != language)
                 {
-                    Debug.LogError($"LanguageManager: Could not load dictionary from {dictionaryPath}");
+                    shardUsage.Remove(language);
+                    shardUsage.AddFirst(language);
                 }
+                return shard;
             }
-            catch (System.Exception e)
+            
+            if (!manifest.languages.Contains(language))
             {
-                Debug.LogError($"LanguageManager: Error loading offline dictionary: {e.Message}");
+                return null;
+            }
+            
+            shard = LoadShard(language);
+            if (shard == null)
+            {
+                return null;
+            }
+            
+            loadedShards[language] = shard;
+            shardUsage.AddFirst(language);
+            TrimShards(Mathf.Max(1, maxResidentShards));
+            return shard;
+        }
+        
+        private Dictionary<string, string> LoadShard(string language)
+        {
+            TextAsset shardAsset = Resources.Load<TextAsset>($"{shardDirectory}/{language}");
+            if (shardAsset == null)
+            {
+                Debug.LogWarning($"LanguageManager: Dictionary shard '{language}' listed in manifest but not found");
+                return null;
+            }
+            
+            if (!jsonIndex.Load(shardAsset.text) || !jsonIndex.Root.IsObject)
+            {
+                Resources.UnloadAsset(shardAsset);
+                Debug.LogError($"LanguageManager: Failed to parse dictionary shard '{language}'");
+                return null;
+            }
+            
+            var shard = new Dictionary<string, string>();
+            var entries = jsonIndex.Root.GetObject();
+            while (entries.MoveNext())
+            {
+                shard[entries.Key] = entries.Value.GetString() ?? string.Empty;
+            }
+            jsonIndex.Clear();
+            Resources.UnloadAsset(shardAsset);
+            ApplyPatchesToShard(language, shard);
+            Debug.Log($"LanguageManager: Loaded dictionary shard '{language}' ({shard.Count} entries)");
+            return shard;
+        }
+        
+        private void TrimShards(int maxShards)
+        {
+            if (manifest == null)
+            {
+                return;
+            }
+            
+            var node = shardUsage.Last;
+            while (node != null && loadedShards.Count > maxShards)
+            {
+                var previous = node.Previous;
+                if (node.Value != currentLanguage && node.Value != fallbackLanguage)
+                {
+                    loadedShards.Remove(node.Value);
+                    shardUsage.Remove(node);
+                    Debug.Log($"LanguageManager: Unloaded dictionary shard '{node.Value}'");
+                }
+                node = previous;
+            }
+        }
+        
+        private void BuildLanguageNameIndex()
+        {
+            languageNameIndex = new LexiconIndex(1);
+            if (manifest == null) return;
+            
+            // Names only: bare codes are ordinary words in a phrase ("translate it to spanish" is not Italian)
+            foreach (var language in manifest.languages)
+            {
+                if (manifest.languageNames.TryGetValue(language, out var names))
+                {
+                    foreach (var name in names) languageNameIndex.Add(name, language, language);
+                }
+            }
+        }
+        
+        private void EnsureLexicon()
+        {
+            if (lexicon != null) return;
+            
+            lexicon = new LexiconIndex(lexiconMaxEditDistance);
+            if (manifest != null)
+            {
+                foreach (var language in manifest.languages)
+                {
+                    // Non-resident shards are indexed transiently so the lexicon does not pin them
+                    Dictionary<string, string> shard;
+                    if (!loadedShards.TryGetValue(language, out shard))
+                    {
+                        shard = LoadShard(language);
+                    }
+                    if (shard == null) continue;
+                    foreach (var kvp in shard)
+                    {
+                        lexicon.Add(kvp.Value, kvp.Key, language);
+                    }
+                }
+            }
+            foreach (var custom in customTranslations)
+            {
+                foreach (var kvp in custom.Value)
+                {
+                    lexicon.Add(kvp.Value, kvp.Key, custom.Key);
+                }
+            }
+            Debug.Log($"LanguageManager: Built lexicon index with {lexicon.TermCount} terms");
+        }
+        
+        /// <summary>
+        /// Map recognised speech in any dictionary language back to a dictionary key
+        /// </summary>
+        public bool TryResolveSpokenWord(string spoken, out LexiconMatch match)
+        {
+            match = default;
+            if (!isInitialized || string.IsNullOrEmpty(spoken))
+            {
+                return false;
+            }
+            
+            EnsureLexicon();
+            return lexicon.TryResolveInPhrase(spoken, out match, currentLanguage);
+        }
+        
+        /// <summary>
+        /// Map a spoken language name ("spanish", "español") within a phrase, or a code said on its own, to a
+        /// dictionary language code
+        /// </summary>
+        public string ResolveLanguageCode(string spoken)
+        {
+            if (!isInitialized || languageNameIndex == null || string.IsNullOrEmpty(spoken))
+            {
+                return null;
+            }
+            
+            string trimmed = spoken.Trim().ToLowerInvariant();
+            if (manifest != null && manifest.languages.Contains(trimmed)) return trimmed;
+            return languageNameIndex.TryResolveInPhrase(spoken, out var match) ? match.key : null;
+        }
+        
+        /// <summary>
+        /// Queue a delta document for background parsing and incremental, version-ordered application
+        /// </summary>
+        public void ApplyDelta(string deltaJson)
+        {
+            if (!isInitialized || string.IsNullOrEmpty(deltaJson))
+            {
+                return;
+            }
+            
+            pendingDeltas.Enqueue(Task.Run(() => DictionaryDelta.Parse(deltaJson)));
+            if (deltaCoroutine == null)
+            {
+                deltaCoroutine = StartCoroutine(ProcessPendingDeltas());
+            }
+        }
+        
+        public void CheckForDictionaryUpdates()
+        {
+            if (!isInitialized || string.IsNullOrEmpty(deltaUrl))
+            {
+                return;
+            }
+            StartCoroutine(FetchDictionaryDelta(deltaUrl));
+        }
+        
+        private IEnumerator FetchDictionaryDelta(string url)
+        {
+            // Let queued deltas (e.g. the persisted log) settle so 'since' is accurate
+            while (deltaCoroutine != null)
+            {
+                yield return null;
+            }
+            
+            string requestUrl = $"{url}{(url.Contains("?") ? "&" : "?")}since={deltaOverlay.Version}&seq={deltaOverlay.Sequence}";
+            using (var request = UnityWebRequest.Get(requestUrl))
+            {
+                yield return request.SendWebRequest();
+                if (request.result != UnityWebRequest.Result.Success)
+                {
+                    Debug.LogWarning($"LanguageManager: Dictionary delta fetch failed {request.responseCode} {request.error}");
+                    yield break;
+                }
+                ApplyDelta(request.downloadHandler.text);
+            }
+        }
+        
+        private IEnumerator ProcessPendingDeltas()
+        {
+            while (pendingDeltas.Count > 0)
+            {
+                var parseTask = pendingDeltas.Peek();
+                while (!parseTask.IsCompleted)
+                {
+                    yield return null;
+                }
+                pendingDeltas.Dequeue();
+                
+                if (parseTask.IsFaulted || parseTask.Result == null)
+                {
+                    Debug.LogWarning($"LanguageManager: Failed to parse dictionary delta: {parseTask.Exception?.GetBaseException().Message}");
+                    continue;
+                }
+                
+                int applied = 0;
+                int appliedThisFrame = 0;
+                foreach (var patch in parseTask.Result)
+                {
+                    if (!deltaOverlay.Apply(patch)) continue; // applied already
+                    OnPatchApplied(patch);
+                    applied++;
+                    if (++appliedThisFrame >= deltaRecordsPerFrame)
+                    {
+                        appliedThisFrame = 0;
+                        lastDeltaActivityTime = Time.unscaledTime;
+                        yield return null;
+                    }
+                }
+                lastDeltaActivityTime = Time.unscaledTime;
+                
+                if (applied > 0)
+                {
+                    Debug.Log($"LanguageManager: Applied {applied} dictionary patches (version {deltaOverlay.Version})");
+                    OnDictionaryUpdated?.Invoke();
+                }
+            }
+            deltaCoroutine = null;
+        }
+        
+        private void OnPatchApplied(DictionaryPatch patch)
+        {
+            if (!unmergedPatches.TryGetValue(patch.lang, out var unmerged))
+            {
+                unmerged = new Dictionary<string, string>();
+                unmergedPatches[patch.lang] = unmerged;
+            }
+            unmerged[patch.key] = patch.value;
+            
+            if (patch.value != null)
+            {
+                lexicon?.Add(patch.value, patch.key, patch.lang);
+            }
+            deltaLogDirty = true;
+        }
+        
+        private void ApplyPatchesToShard(string language, Dictionary<string, string> shard)
+        {
+            deltaOverlay?.ApplyTo(language, shard);
+        }
+        
+        private void Update()
+        {
+            if (!isInitialized || deltaCoroutine != null)
+            {
+                return;
+            }
+            if (Time.unscaledTime - lastDeltaActivityTime < deltaMergeIdleSeconds)
+            {
+                return;
+            }
+            
+            if (MergeUnmergedPatches() == 0 && deltaLogDirty)
+            {
+                SaveDeltaLog();
+            }
+        }
+        
+        /// <summary>
+        /// Fold overlay entries into resident shards, a bounded number per frame
+        /// </summary>
+        private int MergeUnmergedPatches()
+        {
+            if (unmergedPatches.Count == 0)
+            {
+                return 0;
             }
+            
+            int budget = deltaRecordsPerFrame;
+            mergedLanguages.Clear();
+            foreach (var entry in unmergedPatches)
+            {
+                bool resident = loadedShards.TryGetValue(entry.Key, out var shard);
+                bool reloadable = manifest != null && manifest.languages.Contains(entry.Key);
+                if (!resident && !reloadable)
+                {
+                    continue; // no base shard: keep serving this language from the overlay
+                }
+                
+                if (resident)
+                {
+                    foreach (var patch in entry.Value)
+                    {
+                        if (patch.Value == null) shard.Remove(patch.Key);
+                        else shard[patch.Key] = patch.Value;
+                    }
+                    budget -= entry.Value.Count;
+                }
+                mergedLanguages.Add(entry.Key);
+                if (budget <= 0) break;
+            }
+            
+            foreach (var language in mergedLanguages)
+            {
+                unmergedPatches.Remove(language);
+            }
+            return mergedLanguages.Count;
+        }
+        
+        private string DeltaLogPath => Path.Combine(Application.persistentDataPath, DeltaLogFileName);
+        
+        private void LoadDeltaLog()
+        {
+            string path = DeltaLogPath;
+            if (!File.Exists(path))
+            {
+                return;
+            }
+            
+            pendingDeltas.Enqueue(Task.Run(() => DictionaryDelta.Parse(File.ReadAllText(path))));
+            if (deltaCoroutine == null)
+            {
+                deltaCoroutine = StartCoroutine(ProcessPendingDeltas());
+            }
+        }
+        
+        private void SaveDeltaLog()
+        {
+            var snapshot = deltaOverlay.Snapshot();
+            long version = deltaOverlay.Version;
+            string path = DeltaLogPath;
+            deltaLogDirty = false;
+            
+            // Chained so two saves never race on the temp file
+            deltaSaveTask = deltaSaveTask.ContinueWith(_ =>
+            {
+                string json = DictionaryDelta.Serialize(version, snapshot);
+                string tempPath = path + ".tmp";
+                File.WriteAllText(tempPath, json);
+                if (File.Exists(path)) File.Delete(path);
+                File.Move(tempPath, path);
+            }, TaskScheduler.Default);
+            deltaSaveTask.ContinueWith(t => Debug.LogWarning($"LanguageManager: Failed to save dictionary deltas: {t.Exception?.GetBaseException().Message}"),
+                TaskContinuationOptions.OnlyOnFaulted);
+        }
+        
+        /// <summary>
+        /// Unload every dictionary shard but the current and fallback languages'; the rest reload on next use
+        /// </summary>
+        public void UnloadInactiveShards()
+        {
+            if (!isInitialized) return;
+            TrimShards(0);
+        }
+        
+        private void OnLowMemory()
+        {
+            UnloadInactiveShards();
         }
         
         public string GetTranslation(string key, string targetLanguage = null)
@@ -92,11 +573,28 @@ namespace ARLinguaSphere.Core
                 targetLanguage = currentLanguage;
             }
             
-            // Try offline dictionary first
-            if (offlineDictionary.ContainsKey(key) && 
-                offlineDictionary[key].ContainsKey(targetLanguage))
+            if (string.IsNullOrEmpty(key))
+            {
+                return key;
+            }
+            
+            // Custom translations take precedence over the offline dictionary
+            string translation = null;
+            bool found = customTranslations.TryGetValue(targetLanguage, out var custom) && custom.TryGetValue(key, out translation);
+            bool patched = false;
+            if (!found && unmergedPatches.TryGetValue(targetLanguage, out var pending) && pending.TryGetValue(key, out translation))
+            {
+                patched = true; // a null value means the entry was removed
+                found = translation != null;
+            }
+            if (!found && !patched)
+            {
+                var shard = EnsureShardLoaded(targetLanguage);
+                found = shard != null && shard.TryGetValue(key, out translation);
+            }
+            
+            if (found)
             {
-                string translation = offlineDictionary[key][targetLanguage];
                 OnTranslationCompleted?.Invoke(key, targetLanguage, translation);
                 return translation;
             }
@@ -129,6 +627,10 @@ namespace ARLinguaSphere.Core
             {
                 string previousLanguage = currentLanguage;
                 currentLanguage = languageCode;
+                if (isInitialized)
+                {
+                    EnsureShardLoaded(currentLanguage);
+                }
                 OnLanguageChanged?.Invoke(previousLanguage, currentLanguage);
                 Debug.Log($"LanguageManager: Language changed from {previousLanguage} to {currentLanguage}");
             }
@@ -138,12 +640,16 @@ namespace ARLinguaSphere.Core
         {
             var languages = new List<string>();
             
-            if (offlineDictionary.Count > 0)
+            if (manifest != null)
             {
-                var firstEntry = offlineDictionary.Values.GetEnumerator();
-                if (firstEntry.MoveNext())
+                languages.AddRange(manifest.languages);
+            }
+            
+            if (customTranslations != null)
+            {
+                foreach (var language in customTranslations.Keys)
                 {
-                    languages.AddRange(firstEntry.Current.Keys);
+                    if (!languages.Contains(language)) languages.Add(language);
                 }
             }
             
@@ -158,12 +664,14 @@ namespace ARLinguaSphere.Core
         
         public void AddCustomTranslation(string key, string language, string translation)
         {
-            if (!offlineDictionary.ContainsKey(key))
+            if (!customTranslations.TryGetValue(language, out var custom))
             {
-                offlineDictionary[key] = new Dictionary<string, string>();
+                custom = new Dictionary<string, string>();
+                customTranslations[language] = custom;
             }
             
-            offlineDictionary[key][language] = translation;
+            custom[key] = translation;
+            lexicon?.Add(translation, key, language);
             Debug.Log($"LanguageManager: Added custom translation: {key} -> {translation} ({language})");
         }
         
@@ -172,7 +680,22 @@ namespace ARLinguaSphere.Core
             // TODO: Implement saving custom translations to persistent storage
             Debug.Log("LanguageManager: Custom translations saved");
         }
+        
+        private void OnDestroy()
+        {
+            Application.lowMemory -= OnLowMemory;
+        }
     }
     
-    
+    /// <summary>
+    /// Index of the sharded offline dictionary (Resources/Dictionary/manifest.json)
+    /// </summary>
+    [System.Serializable]
+    public class DictionaryManifest
+    {
+        public int version = 1;
+        public int entryCount;
+        public List<string> languages = new List<string>();
+        public Dictionary<string, List<string>> languageNames = new Dictionary<string, List<string>>();
+    }
 }
@@ -0,0 +1,323 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+
+namespace ARLinguaSphere.Core
+{
+    /// <summary>
+    /// Fuzzy word index (SymSpell-style symmetric deletes) mapping spoken words to dictionary keys.
+    /// Lookups reuse internal scratch buffers, so an index must only be queried from one thread.
+    /// </summary>
+    public class LexiconIndex
+    {
+        public int MaxEditDistance { get; }
+        public int PrefixLength { get; }
+        public int TermCount => terms.Count;
+
+        // Normalized term -> term id
+        private readonly Dictionary<string, int> termIds = new Dictionary<string, int>();
+        private readonly List<string> terms = new List<string>();
+        private readonly List<int> termSenseHead = new List<int>();
+
+        // Senses (key, language) per term as singly linked chains
+        private readonly List<string> senseKeys = new List<string>();
+        private readonly List<string> senseLanguages = new List<string>();
+        private readonly List<int> senseNext = new List<int>();
+
+        // Delete variant -> posting chain of term ids
+        private readonly Dictionary<string, int> deleteHead = new Dictionary<string, int>();
+        private readonly List<int> postingTerm = new List<int>();
+        private readonly List<int> postingNext = new List<int>();
+
+        // Lookup scratch
+        private readonly HashSet<string> deleteScratch = new HashSet<string>();
+        private readonly StringBuilder normalizeBuffer = new StringBuilder(64);
+        private readonly List<int> visitStamp = new List<int>();
+        private int visitGeneration;
+        private int[] row0 = new int[32];
+        private int[] row1 = new int[32];
+        private int[] row2 = new int[32];
+
+        public LexiconIndex(int maxEditDistance = 2, int prefixLength = 7)
+        {
+            MaxEditDistance = Math.Max(0, maxEditDistance);
+            PrefixLength = Math.Max(MaxEditDistance + 1, prefixLength);
+        }
+
+        public void Add(string word, string key, string language)
+        {
+            string term = Normalize(word);
+            if (term.Length == 0 || string.IsNullOrEmpty(key)) return;
+
+            if (!termIds.TryGetValue(term, out int termId))
+            {
+                termId = terms.Count;
+                termIds[term] = termId;
+                terms.Add(term);
+                termSenseHead.Add(-1);
+                visitStamp.Add(0);
+                IndexDeletes(term, termId);
+            }
+
+            // Skip duplicate senses; chains are short (one per language at most)
+            for (int s = termSenseHead[termId]; s != -1; s = senseNext[s])
+            {
+                if (senseKeys[s] == key && senseLanguages[s] == language) return;
+            }
+            senseKeys.Add(key);
+            senseLanguages.Add(language);
+            senseNext.Add(termSenseHead[termId]);
+            termSenseHead[termId] = senseKeys.Count - 1;
+        }
+
+        public void Clear()
+        {
+            termIds.Clear();
+            terms.Clear();
+            termSenseHead.Clear();
+            senseKeys.Clear();
+            senseLanguages.Clear();
+            senseNext.Clear();
+            deleteHead.Clear();
+            postingTerm.Clear();
+            postingNext.Clear();
+            visitStamp.Clear();
+        }
+
+        /// <summary>
+        /// Resolve a single word or phrase to the closest indexed term.
+        /// </summary>
+        public bool TryResolve(string spoken, out LexiconMatch match, string preferredLanguage = null)
+        {
+            match = default;
+            if (string.IsNullOrEmpty(spoken)) return false;
+            return ResolveNormalized(Normalize(spoken), preferredLanguage, out match);
+        }
+
+        /// <summary>
+        /// Scan the n-grams of a phrase (longest first) and return the best match.
+        /// Lower edit distance wins; on ties the longer, earlier n-gram wins.
+        /// </summary>
+        public bool TryResolveInPhrase(string phrase, out LexiconMatch match, string preferredLanguage = null, int maxWords = 3)
+        {
+            match = default;
+            if (string.IsNullOrEmpty(phrase)) return false;
+
+            string[] words = Normalize(phrase).Split(' ');
+            bool found = false;
+            for (int n = Math.Min(maxWords, words.Length); n >= 1; n--)
+            {
+                for (int start = 0; start + n <= words.Length; start++)
+                {
+                    string gram = n == 1 ? words[start] : string.Join(" ", words, start, n);
+                    if (ResolveNormalized(gram, preferredLanguage, out var candidate) &&
+                        (!found || candidate.distance < match.distance))
+                    {
+                        match = candidate;
+                        found = true;
+                        if (match.distance == 0) return true;
+                    }
+                }
+            }
+            return found;
+        }
+
+        private bool ResolveNormalized(string input, string preferredLanguage, out LexiconMatch match)
+        {
+            match = default;
+            if (input.Length == 0) return false;
+
+            int maxDistance = AllowedDistance(input.Length);
+            if (termIds.TryGetValue(input, out int exactId))
+            {
+                match = BuildMatch(exactId, 0, preferredLanguage);
+                return true;
+            }
+            if (maxDistance == 0) return false;
+
+            if (++visitGeneration == int.MaxValue)
+            {
+                visitGeneration = 1;
+                for (int i = 0; i < visitStamp.Count; i++) visitStamp[i] = 0;
+            }
+
+            string prefix = input.Length > PrefixLength ? input.Substring(0, PrefixLength) : input;
+            deleteScratch.Clear();
+            deleteScratch.Add(prefix);
+            CollectDeletes(prefix, maxDistance, deleteScratch);
+
+            int bestTerm = -1;
+            int bestDistance = maxDistance + 1;
+            foreach (var variant in deleteScratch)
+            {
+                if (!deleteHead.TryGetValue(variant, out int p)) continue;
+                for (; p != -1; p = postingNext[p])
+                {
+                    int termId = postingTerm[p];
+                    if (visitStamp[termId] == visitGeneration) continue;
+                    visitStamp[termId] = visitGeneration;
+
+                    string term = terms[termId];
+                    int limit = Math.Min(Math.Min(bestDistance, maxDistance), AllowedDistance(term.Length));
+                    int distance = Distance(input, term, limit);
+                    if (distance > limit) continue;
+                    if (distance < bestDistance || termId < bestTerm)
+                    {
+                        bestDistance = distance;
+                        bestTerm = termId;
+                    }
+                }
+            }
+
+            if (bestTerm < 0 || bestDistance > maxDistance) return false;
+            match = BuildMatch(bestTerm, bestDistance, preferredLanguage);
+            return true;
+        }
+
+        private LexiconMatch BuildMatch(int termId, int distance, string preferredLanguage)
+        {
+            // Chains are newest-first; pick the preferred language, else the oldest sense
+            int chosen = -1;
+            for (int s = termSenseHead[termId]; s != -1; s = senseNext[s])
+            {
+                if (preferredLanguage != null && senseLanguages[s] == preferredLanguage)
+                {
+                    chosen = s;
+                    break;
+                }
+                chosen = s;
+            }
+            return new LexiconMatch
+            {
+                key = senseKeys[chosen],
+                language = senseLanguages[chosen],
+                term = terms[termId],
+                distance = distance
+            };
+        }
+
+        private int AllowedDistance(int length)
+        {
+            // Short words have too many neighbours to correct safely
+            if (length <= 3) return 0;
+            if (length <= 5) return Math.Min(1, MaxEditDistance);
+            return MaxEditDistance;
+        }
+
+        private void IndexDeletes(string term, int termId)
+        {
+            string prefix = term.Length > PrefixLength ? term.Substring(0, PrefixLength) : term;
+            deleteScratch.Clear();
+            deleteScratch.Add(prefix);
+            CollectDeletes(prefix, AllowedDistance(term.Length), deleteScratch);
+            foreach (var variant in deleteScratch)
+            {
+                postingTerm.Add(termId);
+                postingNext.Add(deleteHead.TryGetValue(variant, out int head) ? head : -1);
+                deleteHead[variant] = postingTerm.Count - 1;
+            }
+        }
+
+        private static void CollectDeletes(string word, int remaining, HashSet<string> output)
+        {
+            if (remaining <= 0 || word.Length <= 1) return;
+            for (int i = 0; i < word.Length; i++)
+            {
+                string variant = word.Remove(i, 1);
+                if (output.Add(variant))
+                {
+                    CollectDeletes(variant, remaining - 1, output);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Optimal string alignment distance with early exit once every cell in a row exceeds max.
+        /// </summary>
+        private int Distance(string a, string b, int max)
+        {
+            int la = a.Length, lb = b.Length;
+            if (Math.Abs(la - lb) > max) return max + 1;
+            if (row0.Length <= lb)
+            {
+                int size = Math.Max(lb + 1, row0.Length * 2);
+                row0 = new int[size];
+                row1 = new int[size];
+                row2 = new int[size];
+            }
+
+            int[] prev2 = row0, prev = row1, cur = row2;
+            for (int j = 0; j <= lb; j++) prev[j] = j;
+            for (int i = 1; i <= la; i++)
+            {
+                cur[0] = i;
+                int rowMin = i;
+                char ca = a[i - 1];
+                for (int j = 1; j <= lb; j++)
+                {
+                    int cost = ca == b[j - 1] ? 0 : 1;
+                    int v = Math.Min(Math.Min(prev[j] + 1, cur[j - 1] + 1), prev[j - 1] + cost);
+                    if (i > 1 && j > 1 && ca == b[j - 2] && a[i - 2] == b[j - 1])
+                    {
+                        v = Math.Min(v, prev2[j - 2] + 1);
+                    }
+                    cur[j] = v;
+                    if (v < rowMin) rowMin = v;
+                }
+                if (rowMin > max) return max + 1;
+                var t = prev2; prev2 = prev; prev = cur; cur = t;
+            }
+            return prev[lb];
+        }
+
+        /// <summary>
+        /// Lower-case, strip Latin diacritics and collapse punctuation/whitespace to single spaces.
+        /// Marks on non-Latin scripts (e.g. Devanagari vowel signs) are kept.
+        /// </summary>
+        public string Normalize(string text)
+        {
+            if (string.IsNullOrEmpty(text)) return string.Empty;
+
+            string decomposed = text.Normalize(NormalizationForm.FormD);
+            var sb = normalizeBuffer;
+            sb.Length = 0;
+            char lastBase = ' ';
+            bool pendingSpace = false;
+            foreach (char raw in decomposed)
+            {
+                var category = CharUnicodeInfo.GetUnicodeCategory(raw);
+                if (category == UnicodeCategory.NonSpacingMark)
+                {
+                    if (lastBase < '\u0250') continue;
+                    sb.Append(raw);
+                    continue;
+                }
+                if (char.IsLetterOrDigit(raw) || category == UnicodeCategory.SpacingCombiningMark)
+                {
+                    if (pendingSpace && sb.Length > 0) sb.Append(' ');
+                    pendingSpace = false;
+                    char c = char.ToLowerInvariant(raw);
+                    sb.Append(c);
+                    lastBase = c;
+                }
+                else if (raw != '\'')
+                {
+                    pendingSpace = true;
+                }
+            }
+            return sb.ToString().Normalize(NormalizationForm.FormC);
+        }
+    }
+
+    /// <summary>
+    /// Result of a lexicon lookup
+    /// </summary>
+    public struct LexiconMatch
+    {
+        public string key;
+        public string language;
+        public string term;
+        public int distance;
+    }
+}
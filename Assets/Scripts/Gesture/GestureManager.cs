@@ -27,6 +27,8 @@ namespace ARLinguaSphere.Gesture
         
         // Hand tracking
         private IMediaPipeHands hands;
+        private HandMotionRecognizer handMotion;
+        private double handTimeOrigin = double.NaN; // detector clock at the first landmarks
         private float lastHandGestureTime;
         public float handGestureCooldown = 0.8f;
         
@@ -56,7 +58,9 @@ namespace ARLinguaSphere.Gesture
                 handsComponent = go.AddComponent<MediaPipeHands>();
             }
             hands = handsComponent;
-            hands.Initialize(1, true);
+            hands.Initialize(2, true);
+            handsComponent.OnGestureClassified += OnHandGesture;
+            handMotion = new HandMotionRecognizer(swipeTimeThreshold);
             hands.OnHandLandmarks += OnHandLandmarks;
             
             Debug.Log("GestureManager: Hand gesture recognition initialized");
@@ -67,7 +71,7 @@ namespace ARLinguaSphere.Gesture
             if (!isInitialized) return;
             
             HandleTouchInput();
-            // Hand gestures are event-driven via OnHandLandmarks
+            // Hand gestures are event-driven via OnGestureClassified and OnHandLandmarks
         }
         
         private void HandleTouchInput()
@@ -174,36 +178,29 @@ namespace ARLinguaSphere.Gesture
             }
         }
         
-        private void OnHandLandmarks(HandLandmarks landmarks)
+        private void OnHandGesture(GestureType gesture, HandLandmarks landmarks)
         {
             if (!enableHandGestures) return;
             if (Time.time - lastHandGestureTime < handGestureCooldown) return;
-            if (landmarks == null || landmarks.keypoints == null || landmarks.keypoints.Length == 0) return;
             
-            var gesture = ClassifyHandGesture(landmarks);
-            if (gesture.HasValue)
-            {
-                lastHandGestureTime = Time.time;
-                OnGestureDetected?.Invoke(gesture.Value, new Vector2(Screen.width * 0.5f, Screen.height * 0.5f));
-            }
+            lastHandGestureTime = Time.time;
+            OnGestureDetected?.Invoke(gesture, new Vector2(Screen.width * 0.5f, Screen.height * 0.5f));
         }
         
-        private GestureType? ClassifyHandGesture(HandLandmarks landmarks)
+        private void OnHandLandmarks(HandLandmarks landmarks)
         {
-            // NOTE: This is a naive heuristic placeholder. Replace with a trained classifier.
-            // Use confidence as a proxy to toggle between gestures for demo.
-            if (landmarks.confidence > 0.85f)
-            {
-                return GestureType.ThumbsUp;
-            }
+            if (!enableHandGestures || landmarks == null) return;
+            
+            // Frames are timed by the detector, since several may arrive in one Unity frame
+            if (double.IsNaN(handTimeOrigin)) handTimeOrigin = landmarks.timestamp;
+            float time = (float)(landmarks.timestamp - handTimeOrigin);
             
-            // If lower confidence, treat as open palm
-            if (landmarks.confidence > 0.6f)
+            // Motions are reported once each by the recognizer, so they skip the pose cooldown but restart it
+            if (handMotion.AddFrame(landmarks.keypoints, landmarks.isRight, time, landmarks.aspect, out var gesture))
             {
-                return GestureType.OpenPalm;
+                lastHandGestureTime = Time.time;
+                OnGestureDetected?.Invoke(gesture, new Vector2(Screen.width * 0.5f, Screen.height * 0.5f));
             }
-            
-            return null;
         }
         
         public void SetGestureEnabled(GestureType gestureType, bool enabled)
@@ -233,6 +230,8 @@ namespace ARLinguaSphere.Gesture
         SwipeDown,
         ThumbsUp,
         OpenPalm,
-        TwoFingerRotate
+        TwoFingerRotate,
+        Wave,
+        HandRotate
     }
 }
@@ -0,0 +1,346 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+
+namespace ARLinguaSphere.Gesture
+{
+    /// <summary>
+    /// Streaming recognizer of dynamic hand gestures (swipes, wave, rotate). Each hand keeps a ring of its last
+    /// FrameCapacity frames; every new frame becomes one motion sample: palm velocity in palm lengths per second and
+    /// roll rate, both saturated so any brisk movement looks alike. Samples are matched against every template with
+    /// incremental subsequence DTW (as in SPRING): one column of costs per template is advanced per step, a path
+    /// whose cost passes the template's tolerance is abandoned, and each template element must take at least one
+    /// step. Steps are taken at most once per SampleInterval and their cost is weighted by the time they cover, so
+    /// a motion matches the same way at any camera frame rate, and work per frame is fixed by the template lengths.
+    /// A match is reported once it stops improving, at most MaxReportDelay after it ends. One that may be part of a
+    /// longer template's match (a swipe inside a wave) waits while that path is still within its share of the
+    /// tolerance. Keypoints are normalized image coordinates with y down; x is scaled by the frame aspect first, so
+    /// speeds and roll rates do not depend on direction in a non-square frame. Main-thread only.
+    /// </summary>
+    public sealed class HandMotionRecognizer
+    {
+        public const int FrameCapacity = 32;
+        public const float DefaultTolerance = 0.4f;
+
+        public float SaturationSpeed { get; set; } = 2f; // palm lengths per second
+        public float SaturationTurnRate { get; set; } = 4f; // radians per second
+        public float VelocityWindow { get; set; } = 0.06f; // seconds between the frames a velocity is taken over
+        public float SampleInterval { get; set; } = 1f / 30f; // seconds per DTW step; tolerances are per step of this length
+        public float MaxFrameGap { get; set; } = 0.3f; // a longer gap restarts the hand
+        public float MaxReportDelay { get; set; } = 0.15f;
+        public int TemplateCount => templates.Count;
+
+        private readonly List<MotionTemplate> templates = new List<MotionTemplate>();
+        private readonly HandTrack[] hands = { new HandTrack(), new HandTrack() }; // left, right
+        private int cellCount;
+
+        public HandMotionRecognizer(float maxSwipeSeconds = 0.5f)
+        {
+            var right = new Vector3(1f, 0f, 0f);
+            var left = new Vector3(-1f, 0f, 0f);
+            var clockwise = new Vector3(0f, 0f, 1f);
+            AddTemplate(GestureType.SwipeRight, new[] { right, right, right, right }, maxSwipeSeconds);
+            AddTemplate(GestureType.SwipeLeft, new[] { left, left, left, left }, maxSwipeSeconds);
+            AddTemplate(GestureType.SwipeUp, Repeat(new Vector3(0f, -1f, 0f), 4), maxSwipeSeconds);
+            AddTemplate(GestureType.SwipeDown, Repeat(new Vector3(0f, 1f, 0f), 4), maxSwipeSeconds);
+            AddTemplate(GestureType.Wave, new[] { right, right, left, left, right, right, left, left }, 2f);
+            AddTemplate(GestureType.HandRotate, Repeat(clockwise, 4), 1.5f);
+            AddTemplate(GestureType.HandRotate, Repeat(-clockwise, 4), 1.5f);
+        }
+
+        /// <summary>
+        /// Add a template: per-step samples of (x velocity, y velocity, roll rate), each in -1..1 once saturated.
+        /// <paramref name="tolerance"/> is the mean squared error allowed per element. Restarts both hands.
+        /// </summary>
+        public void AddTemplate(GestureType gesture, Vector3[] samples, float maxSeconds, float tolerance = DefaultTolerance)
+        {
+            if (samples == null || samples.Length == 0) throw new ArgumentException("Template needs at least one sample", nameof(samples));
+            templates.Add(new MotionTemplate
+            {
+                gesture = gesture,
+                samples = (Vector3[])samples.Clone(),
+                offset = cellCount,
+                maxSeconds = maxSeconds,
+                maxCost = tolerance * samples.Length
+            });
+            cellCount += samples.Length;
+            foreach (var hand in hands) hand.Resize(cellCount, templates.Count);
+        }
+
+        /// <summary>
+        /// Feed one frame of a hand's 21 keypoints at <paramref name="time"/> seconds, normalised to a frame of width /
+        /// height <paramref name="aspect"/>. Returns true with the gesture when a motion completes on this frame.
+        /// </summary>
+        public bool AddFrame(Vector3[] keypoints, bool isRight, float time, float aspect, out GestureType gesture)
+        {
+            gesture = default;
+            if (keypoints == null || keypoints.Length < HandPoseClassifier.Keypoints) return false;
+            if (!(aspect > 0f)) aspect = 1f;
+
+            // x is normalised by the frame width and y by its height; stretch x so both are in units of the height
+            var stretch = new Vector3(aspect, 1f, aspect);
+            Vector2 up = Vector3.Scale(keypoints[9] - keypoints[0], stretch);
+            var frame = new HandFrame
+            {
+                time = time,
+                center = (Vector2)Vector3.Scale(keypoints[0] + keypoints[5] + keypoints[9] + keypoints[13] + keypoints[17], stretch) / 5f,
+                scale = up.magnitude,
+                roll = Mathf.Atan2(up.y, up.x)
+            };
+            if (frame.scale < 1e-6f) return false;
+
+            var hand = hands[isRight ? 1 : 0];
+            if (hand.count > 0)
+            {
+                float last = hand.Frame(0).time;
+                if (time <= last) return false;
+                if (time - last > MaxFrameGap) hand.Reset();
+            }
+
+            // Faster cameras step every few frames; a frame a little early still takes the step
+            bool recognized = false;
+            if (hand.count == 0)
+            {
+                hand.lastStep = time;
+            }
+            else if (time - hand.lastStep >= SampleInterval * 0.75f && TrySample(hand, frame, out var sample))
+            {
+                recognized = Step(hand, sample, time, (time - hand.lastStep) / SampleInterval, out gesture);
+                hand.lastStep = time;
+            }
+            hand.Push(frame);
+            return recognized;
+        }
+
+        public int FrameCount(bool isRight)
+        {
+            return hands[isRight ? 1 : 0].count;
+        }
+
+        /// <summary>
+        /// A buffered frame; age 0 is the latest
+        /// </summary>
+        public HandFrame GetFrame(bool isRight, int age)
+        {
+            var hand = hands[isRight ? 1 : 0];
+            if ((uint)age >= (uint)hand.count) throw new ArgumentOutOfRangeException(nameof(age));
+            return hand.Frame(age);
+        }
+
+        public void Reset()
+        {
+            foreach (var hand in hands) hand.Reset();
+        }
+
+        /// <summary>
+        /// Saturated palm velocity and roll rate, taken against the latest frame at least VelocityWindow older.
+        /// False until the hand has that much history; a shorter baseline is mostly landmark jitter.
+        /// </summary>
+        private bool TrySample(HandTrack hand, HandFrame frame, out Vector3 sample)
+        {
+            for (int age = 0; age < hand.count; age++)
+            {
+                var reference = hand.Frame(age);
+                float dt = frame.time - reference.time;
+                if (dt < VelocityWindow) continue;
+
+                Vector2 velocity = (frame.center - reference.center) / (dt * (frame.scale + reference.scale) * 0.5f);
+                velocity /= Mathf.Max(velocity.magnitude, SaturationSpeed);
+                float turn = Mathf.DeltaAngle(reference.roll * Mathf.Rad2Deg, frame.roll * Mathf.Rad2Deg) * Mathf.Deg2Rad / dt;
+                turn /= Mathf.Max(Mathf.Abs(turn), SaturationTurnRate);
+                sample = new Vector3(velocity.x, velocity.y, turn);
+                return true;
+            }
+            sample = default;
+            return false;
+        }
+
+        /// <summary>
+        /// Advance the DTW cells by one sample; <paramref name="weight"/> is the step's length in SampleIntervals
+        /// </summary>
+        private bool Step(HandTrack hand, Vector3 sample, float now, float weight, out GestureType gesture)
+        {
+            gesture = default;
+            var cost = hand.cost;
+            var start = hand.start;
+
+            // Advance every template's column. Cells are updated last to first so each still sees its
+            // predecessor's previous value.
+            for (int t = 0; t < templates.Count; t++)
+            {
+                var template = templates[t];
+                int offset = template.offset;
+                for (int i = template.samples.Length - 1; i >= 0; i--)
+                {
+                    int cell = offset + i;
+                    float best = cost[cell];
+                    float bestStart = start[cell];
+                    float advance = i == 0 ? 0f : cost[cell - 1];
+                    if (advance < best)
+                    {
+                        best = advance;
+                        bestStart = i == 0 ? now : start[cell - 1];
+                    }
+                    if (best == float.PositiveInfinity) continue;
+
+                    best += (sample - template.samples[i]).sqrMagnitude * weight;
+                    if (best > template.maxCost || now - bestStart > template.maxSeconds) best = float.PositiveInfinity;
+                    cost[cell] = best;
+                    start[cell] = bestStart;
+                }
+
+                // A completed path extends the pending match it overlaps, or becomes the pending match
+                int last = offset + template.samples.Length - 1;
+                hand.extended[t] = false;
+                if (cost[last] == float.PositiveInfinity) continue;
+                if (hand.matchCost[t] == float.PositiveInfinity || start[last] <= hand.matchEnd[t])
+                {
+                    hand.matchStart[t] = hand.matchCost[t] == float.PositiveInfinity ? start[last] : Mathf.Min(start[last], hand.matchStart[t]);
+                    hand.matchCost[t] = cost[last];
+                    hand.matchEnd[t] = now;
+                    hand.extended[t] = true;
+                }
+            }
+
+            // Report the longest match that has settled and is not part of a longer one still in progress
+            int report = -1;
+            for (int t = 0; t < templates.Count; t++)
+            {
+                if (hand.matchCost[t] == float.PositiveInfinity || hand.extended[t]) continue;
+                float end = hand.matchEnd[t];
+                if (now - end < MaxReportDelay && HasLivePath(hand, t, end)) continue;
+                if (IsHeldByLongerTemplate(hand, t, end)) continue;
+
+                if (report < 0
+                    || templates[t].samples.Length > templates[report].samples.Length
+                    || (templates[t].samples.Length == templates[report].samples.Length && hand.matchCost[t] < hand.matchCost[report]))
+                {
+                    report = t;
+                }
+            }
+            if (report < 0) return false;
+
+            // Everything overlapping the reported motion is consumed by it
+            float reportedEnd = hand.matchEnd[report];
+            for (int cell = 0; cell < cellCount; cell++)
+            {
+                if (start[cell] <= reportedEnd) cost[cell] = float.PositiveInfinity;
+            }
+            for (int t = 0; t < templates.Count; t++)
+            {
+                if (hand.matchStart[t] <= reportedEnd) hand.matchCost[t] = float.PositiveInfinity;
+            }
+            gesture = templates[report].gesture;
+            return true;
+        }
+
+        private bool HasLivePath(HandTrack hand, int t, float end)
+        {
+            var template = templates[t];
+            for (int i = 0; i < template.samples.Length; i++)
+            {
+                int cell = template.offset + i;
+                if (hand.cost[cell] < float.PositiveInfinity && hand.start[cell] <= end) return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// True while a longer template may still complete a match that contains this one. Only paths within their
+        /// share of the tolerance count: one that has already paid for a pause (a swipe, a rest, then a return
+        /// stroke) would otherwise hold the match until it ran out of time, long after MaxReportDelay.
+        /// </summary>
+        private bool IsHeldByLongerTemplate(HandTrack hand, int t, float end)
+        {
+            int length = templates[t].samples.Length;
+            for (int other = 0; other < templates.Count; other++)
+            {
+                var template = templates[other];
+                if (template.samples.Length <= length) continue;
+                if (hand.matchCost[other] < float.PositiveInfinity && hand.matchStart[other] <= end) return true;
+
+                float share = template.maxCost / template.samples.Length;
+                for (int i = 0; i < template.samples.Length; i++)
+                {
+                    int cell = template.offset + i;
+                    if (hand.cost[cell] <= share * (i + 1) && hand.start[cell] <= end) return true;
+                }
+            }
+            return false;
+        }
+
+        private static Vector3[] Repeat(Vector3 sample, int count)
+        {
+            var samples = new Vector3[count];
+            for (int i = 0; i < count; i++) samples[i] = sample;
+            return samples;
+        }
+
+        private sealed class MotionTemplate
+        {
+            public GestureType gesture;
+            public Vector3[] samples;
+            public int offset; // first DTW cell
+            public float maxSeconds;
+            public float maxCost;
+        }
+
+        /// <summary>
+        /// One hand's frame ring, DTW cells for every template, and each template's pending match
+        /// </summary>
+        private sealed class HandTrack
+        {
+            public readonly HandFrame[] frames = new HandFrame[FrameCapacity];
+            public int head; // slot of the latest frame
+            public int count;
+            public float lastStep; // time of the last DTW step
+            public float[] cost = Array.Empty<float>();
+            public float[] start = Array.Empty<float>(); // time each cell's path started
+            public float[] matchCost = Array.Empty<float>(); // by template; infinity if none pending
+            public float[] matchStart = Array.Empty<float>();
+            public float[] matchEnd = Array.Empty<float>();
+            public bool[] extended = Array.Empty<bool>();
+
+            public HandFrame Frame(int age)
+            {
+                return frames[(head - age + FrameCapacity) % FrameCapacity];
+            }
+
+            public void Push(HandFrame frame)
+            {
+                head = (head + 1) % FrameCapacity;
+                frames[head] = frame;
+                if (count < FrameCapacity) count++;
+            }
+
+            public void Resize(int cells, int templateCount)
+            {
+                cost = new float[cells];
+                start = new float[cells];
+                matchCost = new float[templateCount];
+                matchStart = new float[templateCount];
+                matchEnd = new float[templateCount];
+                extended = new bool[templateCount];
+                Reset();
+            }
+
+            public void Reset()
+            {
+                count = 0;
+                for (int i = 0; i < cost.Length; i++) cost[i] = float.PositiveInfinity;
+                for (int i = 0; i < matchCost.Length; i++) matchCost[i] = float.PositiveInfinity;
+            }
+        }
+    }
+
+    /// <summary>
+    /// A hand's palm in one frame
+    /// </summary>
+    public struct HandFrame
+    {
+        public float time;
+        public Vector2 center; // mean of the wrist and knuckles, image coordinates in units of the frame height
+        public float scale; // wrist to middle knuckle
+        public float roll; // radians, direction from the wrist to the middle knuckle
+    }
+}
@@ -0,0 +1,293 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using SimdVector = System.Numerics.Vector<float>;
+
+namespace ARLinguaSphere.Gesture
+{
+    /// <summary>
+    /// Nearest-neighbour classifier of static hand poses over the 21 MediaPipe keypoints. Each hand is mapped into
+    /// its own palm frame: origin at the wrist, y towards the middle-finger knuckle, x across the knuckles towards
+    /// the index finger, z out of the palm, scaled so the wrist to middle knuckle is 1. That makes features
+    /// independent of where the hand is, how big it appears and how it is turned; left hands are mirrored into
+    /// right hands so one set of samples covers both. MediaPipe normalises x (and z) by the frame width and y by
+    /// its height, so x and z are first scaled by the frame aspect; otherwise a turned hand in a non-square frame
+    /// would be sheared. Distances are computed with System.Numerics vectors, which map to NEON/SSE where the
+    /// runtime accelerates them. New poses are added from recorded samples.
+    /// </summary>
+    public sealed class HandPoseClassifier
+    {
+        public const int Keypoints = 21;
+        public const int FeatureLength = 64; // 20 keypoints x 3, padded to a whole number of SIMD vectors
+        public const float DefaultThreshold = 0.75f;
+
+        public int SampleCount => count;
+        public int GestureCount => names.Count;
+        public float MatchRadius { get; set; } = 0.5f; // RMS keypoint error, in palm lengths, at which similarity reaches 0
+
+        private readonly List<string> names = new List<string>();
+        private readonly List<float> thresholds = new List<float>();
+        private readonly Dictionary<string, int> ids = new Dictionary<string, int>();
+        private readonly float[] query = new float[FeatureLength];
+        private float[] samples = new float[16 * FeatureLength];
+        private int[] labels = new int[16];
+        private int count;
+
+        /// <summary>
+        /// Minimum similarity (0..1) for <paramref name="gesture"/> to be reported
+        /// </summary>
+        public void SetThreshold(string gesture, float threshold)
+        {
+            thresholds[Id(gesture)] = Mathf.Clamp01(threshold);
+        }
+
+        /// <summary>
+        /// Add one example of <paramref name="gesture"/>. Returns false if the keypoints are degenerate.
+        /// <paramref name="aspect"/> is the width / height of the frame the keypoints were normalised to.
+        /// </summary>
+        public bool AddSample(string gesture, Vector3[] keypoints, bool isRight, float aspect = 1f)
+        {
+            if (count * FeatureLength == samples.Length)
+            {
+                Array.Resize(ref samples, samples.Length * 2);
+                Array.Resize(ref labels, labels.Length * 2);
+            }
+            if (!ExtractFeatures(keypoints, isRight, aspect, samples, count * FeatureLength)) return false;
+            labels[count++] = Id(gesture);
+            return true;
+        }
+
+        /// <summary>
+        /// Drop every sample of <paramref name="gesture"/>; returns how many were removed
+        /// </summary>
+        public int RemoveGesture(string gesture)
+        {
+            if (!ids.TryGetValue(gesture, out int id)) return 0;
+            int kept = 0;
+            for (int i = 0; i < count; i++)
+            {
+                if (labels[i] == id) continue;
+                if (kept != i)
+                {
+                    Array.Copy(samples, i * FeatureLength, samples, kept * FeatureLength, FeatureLength);
+                    labels[kept] = labels[i];
+                }
+                kept++;
+            }
+            int removed = count - kept;
+            count = kept;
+            return removed;
+        }
+
+        /// <summary>
+        /// The gesture of the nearest sample, if its similarity clears that gesture's threshold. Allocation-free.
+        /// </summary>
+        public bool Classify(Vector3[] keypoints, bool isRight, out string gesture, out float similarity)
+        {
+            return Classify(keypoints, isRight, 1f, out gesture, out similarity);
+        }
+
+        /// <summary>
+        /// Classify keypoints normalised to a frame of width / height <paramref name="aspect"/>
+        /// </summary>
+        public bool Classify(Vector3[] keypoints, bool isRight, float aspect, out string gesture, out float similarity)
+        {
+            gesture = null;
+            similarity = 0f;
+            if (count == 0 || !ExtractFeatures(keypoints, isRight, aspect, query, 0)) return false;
+
+            int best = -1;
+            float bestDistance = float.MaxValue;
+            for (int i = 0; i < count; i++)
+            {
+                float distance = SquaredDistance(query, samples, i * FeatureLength);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    best = i;
+                }
+            }
+
+            float rms = Mathf.Sqrt(bestDistance / (Keypoints - 1));
+            similarity = Mathf.Max(0f, 1f - rms / MatchRadius);
+            int id = labels[best];
+            if (similarity < thresholds[id]) return false;
+            gesture = names[id];
+            return true;
+        }
+
+        /// <summary>
+        /// Write the samples from index <paramref name="from"/> on, with their gestures' thresholds
+        /// </summary>
+        public void WriteSamples(BinaryWriter writer, int from = 0)
+        {
+            from = Mathf.Clamp(from, 0, count);
+            writer.Write(count - from);
+            for (int i = from; i < count; i++)
+            {
+                writer.Write(names[labels[i]]);
+                writer.Write(thresholds[labels[i]]);
+                for (int f = 0; f < FeatureLength; f++)
+                {
+                    writer.Write(samples[i * FeatureLength + f]);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Add samples written by WriteSamples; returns how many were read
+        /// </summary>
+        public int ReadSamples(BinaryReader reader)
+        {
+            int read = reader.ReadInt32();
+            for (int i = 0; i < read; i++)
+            {
+                string gesture = reader.ReadString();
+                float threshold = reader.ReadSingle();
+                if (count * FeatureLength == samples.Length)
+                {
+                    Array.Resize(ref samples, samples.Length * 2);
+                    Array.Resize(ref labels, labels.Length * 2);
+                }
+                for (int f = 0; f < FeatureLength; f++)
+                {
+                    samples[count * FeatureLength + f] = reader.ReadSingle();
+                }
+                int id = Id(gesture);
+                thresholds[id] = threshold;
+                labels[count++] = id;
+            }
+            return read;
+        }
+
+        /// <summary>
+        /// Map <paramref name="keypoints"/> into the palm frame and write FeatureLength floats at
+        /// <paramref name="offset"/>. x and z are scaled by <paramref name="aspect"/> (frame width / height) first,
+        /// so all three axes share one unit. Returns false if there are too few keypoints or the palm is degenerate.
+        /// </summary>
+        public static bool ExtractFeatures(Vector3[] keypoints, bool isRight, float aspect, float[] features, int offset)
+        {
+            if (keypoints == null || keypoints.Length < Keypoints) return false;
+            if (!(aspect > 0f)) aspect = 1f;
+            var stretch = new Vector3(aspect, 1f, aspect);
+
+            Vector3 wrist = Vector3.Scale(keypoints[0], stretch);
+            Vector3 up = Vector3.Scale(keypoints[9], stretch) - wrist;
+            float scale = up.magnitude;
+            if (scale < 1e-6f) return false;
+            up /= scale;
+
+            Vector3 across = Vector3.Scale(keypoints[5] - keypoints[17], stretch);
+            across -= Vector3.Dot(across, up) * up;
+            if (across.sqrMagnitude < 1e-12f) return false;
+            across.Normalize();
+            Vector3 normal = Vector3.Cross(across, up);
+
+            // A left hand is a mirrored right hand: its frame comes out with the normal reversed
+            float flip = isRight ? 1f : -1f;
+            float inverse = 1f / scale;
+            for (int i = 1; i < Keypoints; i++)
+            {
+                Vector3 v = Vector3.Scale(keypoints[i], stretch) - wrist;
+                int f = offset + (i - 1) * 3;
+                features[f] = Vector3.Dot(v, across) * inverse;
+                features[f + 1] = Vector3.Dot(v, up) * inverse;
+                features[f + 2] = Vector3.Dot(v, normal) * inverse * flip;
+            }
+            Array.Clear(features, offset + (Keypoints - 1) * 3, FeatureLength - (Keypoints - 1) * 3);
+            return true;
+        }
+
+        /// <summary>
+        /// A right-hand reference pose in palm-frame coordinates, or null if <paramref name="gesture"/> is not a
+        /// static hand pose
+        /// </summary>
+        public static Vector3[] ReferencePose(GestureType gesture)
+        {
+            switch (gesture)
+            {
+                case GestureType.ThumbsUp:
+                    return BuildPose(new Vector3(1f, 0.25f, 0f), 1f, 1f, 1f, 1f);
+                case GestureType.OpenPalm:
+                    return BuildPose(new Vector3(0.8f, 0.6f, 0f), 0f, 0f, 0f, 0f);
+                case GestureType.PinchIn:
+                {
+                    var pose = BuildPose(Vector3.zero, 0.45f, 0.15f, 0.15f, 0.15f);
+                    // Thumb bowed out from its base to meet the index fingertip
+                    Vector3 tip = pose[8];
+                    pose[2] = Vector3.Lerp(pose[1], tip, 0.4f) + new Vector3(0.08f, 0f, 0.04f);
+                    pose[3] = Vector3.Lerp(pose[1], tip, 0.72f) + new Vector3(0.05f, 0f, 0.03f);
+                    pose[4] = tip + new Vector3(0.02f, 0f, 0f);
+                    return pose;
+                }
+                default:
+                    return null;
+            }
+        }
+
+        private int Id(string gesture)
+        {
+            if (!ids.TryGetValue(gesture, out int id))
+            {
+                id = names.Count;
+                ids[gesture] = id;
+                names.Add(gesture);
+                thresholds.Add(DefaultThreshold);
+            }
+            return id;
+        }
+
+        private static float SquaredDistance(float[] a, float[] b, int offset)
+        {
+            var left = MemoryMarshal.Cast<float, SimdVector>(new ReadOnlySpan<float>(a, 0, FeatureLength));
+            var right = MemoryMarshal.Cast<float, SimdVector>(new ReadOnlySpan<float>(b, offset, FeatureLength));
+            var sum = SimdVector.Zero;
+            for (int i = 0; i < left.Length; i++)
+            {
+                var d = left[i] - right[i];
+                sum += d * d;
+            }
+            return System.Numerics.Vector.Dot(sum, SimdVector.One);
+        }
+
+        // Knuckle positions (index to pinky) and segment lengths of a right hand, in palm lengths
+        private static readonly Vector3[] Knuckles =
+        {
+            new Vector3(0.32f, 0.92f, 0f), new Vector3(0f, 1f, 0f), new Vector3(-0.26f, 0.94f, 0f), new Vector3(-0.48f, 0.84f, 0f)
+        };
+        private static readonly float[] Segments = { 0.42f, 0.26f, 0.22f, 0.48f, 0.3f, 0.24f, 0.44f, 0.28f, 0.22f, 0.34f, 0.2f, 0.2f };
+        private static readonly float[] JointBends = { 80f, 100f, 60f }; // degrees at full curl
+
+        /// <summary>
+        /// Keypoints with the thumb pointing along <paramref name="thumb"/> and each finger curled towards the
+        /// palm by 0 (straight) to 1 (fist)
+        /// </summary>
+        private static Vector3[] BuildPose(Vector3 thumb, float index, float middle, float ring, float pinky)
+        {
+            var pose = new Vector3[Keypoints];
+            pose[1] = new Vector3(0.22f, 0.28f, 0.05f);
+            Vector3 direction = thumb.sqrMagnitude > 0f ? thumb.normalized : Vector3.up;
+            pose[2] = pose[1] + direction * 0.32f;
+            pose[3] = pose[2] + direction * 0.28f;
+            pose[4] = pose[3] + direction * 0.24f;
+
+            float[] curls = { index, middle, ring, pinky };
+            for (int finger = 0; finger < 4; finger++)
+            {
+                int first = 5 + finger * 4;
+                Vector3 joint = Knuckles[finger];
+                pose[first] = joint;
+                float angle = 0f;
+                for (int segment = 0; segment < 3; segment++)
+                {
+                    angle += curls[finger] * JointBends[segment] * Mathf.Deg2Rad;
+                    joint += new Vector3(0f, Mathf.Cos(angle), Mathf.Sin(angle)) * Segments[finger * 3 + segment];
+                    pose[first + segment + 1] = joint;
+                }
+            }
+            return pose;
+        }
+    }
+}
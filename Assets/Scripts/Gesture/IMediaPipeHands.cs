@@ -17,6 +17,8 @@ namespace ARLinguaSphere.Gesture
 		public Vector3[] keypoints; // 21 keypoints
 		public float confidence;
 		public bool isRight;
+		public double timestamp; // seconds on the detector's clock
+		public float aspect = 1f; // width / height of the frame: x and z are normalised by width, y by height
 	}
 }
 
@@ -0,0 +1,150 @@
+using UnityEngine;
+using System;
+using System.Threading;
+using Unity.Collections;
+
+namespace ARLinguaSphere.Gesture
+{
+    /// <summary>
+    /// Single-producer, single-consumer ring of fixed-layout hand landmark records in native memory. The Android
+    /// plugin writes into it through a direct ByteBuffer over the same bytes (MediaPipeHandsPlugin.publishLandmarks
+    /// mirrors Write) and Unity drains it every frame, so there is no string building, no parsing and no
+    /// UnitySendMessage hop. The producer never waits: when the consumer falls behind, the oldest records are
+    /// overwritten and counted in Dropped. Each slot carries its sequence number, which is cleared while the
+    /// slot is rewritten and re-checked after reading, so a record overwritten mid-read is dropped instead of
+    /// delivered torn.
+    ///
+    /// Layout, little-endian:
+    ///   header (64 bytes): int head = sequence of the latest published record (records count from 1)
+    ///   record (280 bytes): int sequence, int flags (bit 0 = right hand), long timestamp (ns),
+    ///                       float confidence, float[63] keypoints (x, y, z for each of the 21 landmarks),
+    ///                       float aspect (frame width / height), 4 bytes padding
+    /// </summary>
+    public sealed class LandmarkRing : IDisposable
+    {
+        public const int HeaderBytes = 64;
+        public const int RecordBytes = 280;
+        private const int Keypoints = 21;
+        private const int SequenceWord = 0;
+        private const int FlagsWord = 1;
+        private const int TimestampByte = 8;
+        private const int ConfidenceWord = 4;
+        private const int KeypointsWord = 5;
+        private const int AspectWord = 68;
+
+        public int Capacity { get; }
+        public NativeArray<byte> Buffer => buffer;
+        public long Dropped => dropped;
+        public int LastSequence => lastRead;
+
+        private NativeArray<byte> buffer;
+        private NativeArray<int> words; // views over buffer
+        private NativeArray<float> floats;
+        private readonly HandLandmarks[] received = new HandLandmarks[2]; // reused, by hand
+        private int lastRead;
+        private int lastWritten;
+        private long dropped;
+
+        public LandmarkRing(int capacity)
+        {
+            Capacity = Math.Max(1, capacity);
+            buffer = new NativeArray<byte>(HeaderBytes + Capacity * RecordBytes, Allocator.Persistent);
+            words = buffer.Reinterpret<int>(1);
+            floats = buffer.Reinterpret<float>(1);
+            for (int hand = 0; hand < received.Length; hand++)
+            {
+                received[hand] = new HandLandmarks { keypoints = new Vector3[Keypoints], isRight = hand == 1 };
+            }
+        }
+
+        /// <summary>
+        /// Publish one record. Producer side: the plugin does this in Java; Unity uses it for simulated hands.
+        /// </summary>
+        public void Write(Vector3[] keypoints, bool isRight, float confidence, long timestampNanos, float aspect = 1f)
+        {
+            int sequence = lastWritten + 1;
+            int word = WordOf(sequence);
+
+            words[word + SequenceWord] = 0;
+            Thread.MemoryBarrier(); // the slot reads as being rewritten before any of its payload changes
+            words[word + FlagsWord] = isRight ? 1 : 0;
+            buffer.ReinterpretStore(word * 4 + TimestampByte, timestampNanos);
+            floats[word + ConfidenceWord] = confidence;
+            int count = keypoints == null ? 0 : Mathf.Min(keypoints.Length, Keypoints);
+            for (int i = 0; i < Keypoints; i++)
+            {
+                Vector3 point = i < count ? keypoints[i] : Vector3.zero;
+                int f = word + KeypointsWord + i * 3;
+                floats[f] = point.x;
+                floats[f + 1] = point.y;
+                floats[f + 2] = point.z;
+            }
+            floats[word + AspectWord] = aspect;
+            Thread.MemoryBarrier(); // payload before the stamp, stamp before the head
+            words[word + SequenceWord] = sequence;
+            Thread.MemoryBarrier();
+            words[0] = sequence;
+            lastWritten = sequence;
+        }
+
+        /// <summary>
+        /// Deliver every record published since the last drain, oldest first. Consumer side. The HandLandmarks
+        /// passed to <paramref name="onLandmarks"/> is reused and only valid during the call.
+        /// </summary>
+        public int Drain(Action<HandLandmarks> onLandmarks)
+        {
+            int head = words[0];
+            Thread.MemoryBarrier(); // records up to head were complete before head was published
+            if (head - lastRead > Capacity)
+            {
+                dropped += head - lastRead - Capacity;
+                lastRead = head - Capacity;
+            }
+
+            int delivered = 0;
+            while (lastRead - head < 0)
+            {
+                int sequence = ++lastRead;
+                int word = WordOf(sequence);
+                if (words[word + SequenceWord] != sequence)
+                {
+                    dropped++;
+                    continue;
+                }
+
+                int hand = words[word + FlagsWord] & 1;
+                var landmarks = received[hand];
+                landmarks.isRight = hand == 1;
+                landmarks.timestamp = buffer.ReinterpretLoad<long>(word * 4 + TimestampByte) * 1e-9;
+                landmarks.confidence = floats[word + ConfidenceWord];
+                landmarks.aspect = floats[word + AspectWord];
+                var keypoints = landmarks.keypoints;
+                for (int i = 0; i < Keypoints; i++)
+                {
+                    int f = word + KeypointsWord + i * 3;
+                    keypoints[i] = new Vector3(floats[f], floats[f + 1], floats[f + 2]);
+                }
+
+                Thread.MemoryBarrier();
+                if (words[word + SequenceWord] != sequence)
+                {
+                    dropped++; // overwritten while it was being read
+                    continue;
+                }
+                onLandmarks(landmarks);
+                delivered++;
+            }
+            return delivered;
+        }
+
+        public void Dispose()
+        {
+            if (buffer.IsCreated) buffer.Dispose();
+        }
+
+        private int WordOf(int sequence)
+        {
+            return (HeaderBytes + (sequence - 1) % Capacity * RecordBytes) / 4;
+        }
+    }
+}
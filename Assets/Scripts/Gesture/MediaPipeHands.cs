@@ -1,7 +1,9 @@
 using UnityEngine;
 using System;
-using System.Collections;
 using System.Collections.Generic;
+using System.IO;
+using Unity.Collections;
+using ARLinguaSphere.AR;
 
 namespace ARLinguaSphere.Gesture
 {
@@ -16,6 +18,7 @@ namespace ARLinguaSphere.Gesture
         [SerializeField] private bool useGPU = true;
         [SerializeField] private float minDetectionConfidence = 0.5f;
         [SerializeField] private float minTrackingConfidence = 0.5f;
+        [SerializeField] private int inputResolution = 256; // longest side of the frames handed to the plugin
         
         [Header("Simulation Settings")]
         [SerializeField] private bool simulateInEditor = true;
@@ -25,16 +28,31 @@ namespace ARLinguaSphere.Gesture
         private bool initialized;
         private float lastSimTime;
         private AndroidJavaObject mediaPipePlugin;
-        private Texture2D currentFrame;
-        private Camera arCamera;
+        private ARManager arManager;
+        
+        // Frames are written into frameBuffer, which the plugin reads in place as a direct ByteBuffer
+        private NativeArray<byte> frameBuffer;
+        private double lastFrameTimestamp = double.NaN;
+        private IntPtr processFrameMethod;
+        private readonly jvalue[] processFrameArgs = new jvalue[2];
+        
+        // Landmarks come back through a ring the plugin writes and Update drains, in the frame they are detected
+        private const int LANDMARK_RING_RECORDS = 16;
+        private LandmarkRing landmarkRing;
+        private Action<HandLandmarks> handleLandmarks;
         
         // Hand gesture classification
         private Dictionary<GestureType, HandGesturePattern> gesturePatterns;
-        private float lastGestureTime;
+        private readonly Dictionary<string, GestureType> gestureNames = new Dictionary<string, GestureType>();
+        private HandPoseClassifier poseClassifier;
+        private int referenceSamples; // samples from gesturePatterns; the rest were recorded
+        private readonly float[] lastGestureTimes = new float[2]; // left, right
         private const float GESTURE_COOLDOWN = 0.8f;
+        private const string RECORDED_SAMPLES_FILE = "hand_poses.bin";
         
         public event Action<HandLandmarks> OnHandLandmarks;
         public event Action<GestureType, HandLandmarks> OnGestureClassified;
+        public event Action<string, HandLandmarks> OnHandPoseClassified; // every classified pose, recorded ones included
         
         public bool IsInitialized => initialized;
         
@@ -48,12 +66,12 @@ namespace ARLinguaSphere.Gesture
             // Initialize gesture patterns
             InitializeGesturePatterns();
             
-            // Get AR camera reference
-            arCamera = Camera.main;
-            if (arCamera == null)
-            {
-                arCamera = FindFirstObjectByType<Camera>();
-            }
+            // Camera frames come from the AR camera's CPU image
+            arManager = FindFirstObjectByType<ARManager>();
+            
+            // Kept across re-initialization: the plugin may still be writing into it
+            if (landmarkRing == null) landmarkRing = new LandmarkRing(LANDMARK_RING_RECORDS);
+            handleLandmarks = HandleLandmarks;
             
 #if UNITY_ANDROID && !UNITY_EDITOR
             InitializeAndroidPlugin();
@@ -73,6 +91,72 @@ namespace ARLinguaSphere.Gesture
                 { GestureType.OpenPalm, new HandGesturePattern { name = "OpenPalm", confidenceThreshold = 0.7f } },
                 { GestureType.PinchIn, new HandGesturePattern { name = "Pinch", confidenceThreshold = 0.75f } }
             };
+            
+            poseClassifier = new HandPoseClassifier();
+            gestureNames.Clear();
+            foreach (var pair in gesturePatterns)
+            {
+                var pattern = pair.Value;
+                pattern.referenceKeypoints = HandPoseClassifier.ReferencePose(pair.Key);
+                poseClassifier.AddSample(pattern.name, pattern.referenceKeypoints, true);
+                poseClassifier.SetThreshold(pattern.name, pattern.confidenceThreshold);
+                gestureNames[pattern.name] = pair.Key;
+            }
+            referenceSamples = poseClassifier.SampleCount;
+            
+            LoadRecordedSamples();
+        }
+        
+        /// <summary>
+        /// Teach the classifier another example of <paramref name="gestureName"/>, which may be a new gesture.
+        /// Names of the built-in patterns ("ThumbsUp", "OpenPalm", "Pinch") refine those; recorded samples are kept
+        /// across sessions.
+        /// </summary>
+        public bool RecordGestureSample(string gestureName, HandLandmarks landmarks)
+        {
+            if (poseClassifier == null || string.IsNullOrEmpty(gestureName) || landmarks == null) return false;
+            if (!poseClassifier.AddSample(gestureName, landmarks.keypoints, landmarks.isRight, landmarks.aspect)) return false;
+            
+            SaveRecordedSamples();
+            Debug.Log($"MediaPipeHands: Recorded sample of {gestureName} ({poseClassifier.SampleCount} samples)");
+            return true;
+        }
+        
+        private void LoadRecordedSamples()
+        {
+            string path = Path.Combine(Application.persistentDataPath, RECORDED_SAMPLES_FILE);
+            if (!File.Exists(path)) return;
+            
+            try
+            {
+                using (var reader = new BinaryReader(File.OpenRead(path)))
+                {
+                    int loaded = poseClassifier.ReadSamples(reader);
+                    Debug.Log($"MediaPipeHands: Loaded {loaded} recorded gesture samples");
+                }
+            }
+            catch (Exception e)
+            {
+                Debug.LogError($"MediaPipeHands: Error loading recorded gesture samples: {e.Message}");
+            }
+        }
+        
+        private void SaveRecordedSamples()
+        {
+            string path = Path.Combine(Application.persistentDataPath, RECORDED_SAMPLES_FILE);
+            try
+            {
+                using (var writer = new BinaryWriter(File.Create(path + ".tmp")))
+                {
+                    poseClassifier.WriteSamples(writer, referenceSamples);
+                }
+                if (File.Exists(path)) File.Delete(path);
+                File.Move(path + ".tmp", path);
+            }
+            catch (Exception e)
+            {
+                Debug.LogError($"MediaPipeHands: Error saving recorded gesture samples: {e.Message}");
+            }
         }
         
 #if UNITY_ANDROID && !UNITY_EDITOR
@@ -91,8 +175,8 @@ namespace ARLinguaSphere.Gesture
                     if (success)
                     {
                         Debug.Log("MediaPipeHands: Android plugin initialized successfully");
-                        // Set callback for receiving landmarks
-                        mediaPipePlugin.Call("setLandmarksCallback", gameObject.name);
+                        ShareLandmarkRing();
+                        ShareFrameBuffer(inputResolution * inputResolution * 4);
                     }
                     else
                     {
@@ -109,22 +193,86 @@ namespace ARLinguaSphere.Gesture
         }
 #endif
         
+#if UNITY_ANDROID && !UNITY_EDITOR
+        /// <summary>
+        /// (Re)allocate the frame buffer and hand it to the plugin as a direct ByteBuffer over the same memory
+        /// </summary>
+        private void ShareFrameBuffer(int bytes)
+        {
+            if (frameBuffer.IsCreated) frameBuffer.Dispose();
+            frameBuffer = new NativeArray<byte>(bytes, Allocator.Persistent, NativeArrayOptions.UninitializedMemory);
+            
+            IntPtr byteBuffer = AndroidJNI.NewDirectByteBuffer(frameBuffer);
+            try
+            {
+                IntPtr setFrameBuffer = AndroidJNIHelper.GetMethodID(mediaPipePlugin.GetRawClass(), "setFrameBuffer", "(Ljava/nio/ByteBuffer;)V");
+                AndroidJNI.CallVoidMethod(mediaPipePlugin.GetRawObject(), setFrameBuffer, new[] { new jvalue { l = byteBuffer } });
+            }
+            finally
+            {
+                AndroidJNI.DeleteLocalRef(byteBuffer);
+            }
+            processFrameMethod = AndroidJNIHelper.GetMethodID(mediaPipePlugin.GetRawClass(), "processFrameBuffer", "(II)V");
+        }
+        
+        /// <summary>
+        /// Hand the plugin a direct ByteBuffer over the landmark ring's memory
+        /// </summary>
+        private void ShareLandmarkRing()
+        {
+            IntPtr byteBuffer = AndroidJNI.NewDirectByteBuffer(landmarkRing.Buffer);
+            try
+            {
+                IntPtr setLandmarkRing = AndroidJNIHelper.GetMethodID(mediaPipePlugin.GetRawClass(), "setLandmarkRing", "(Ljava/nio/ByteBuffer;)V");
+                AndroidJNI.CallVoidMethod(mediaPipePlugin.GetRawObject(), setLandmarkRing, new[] { new jvalue { l = byteBuffer } });
+            }
+            finally
+            {
+                AndroidJNI.DeleteLocalRef(byteBuffer);
+            }
+        }
+        
+        /// <summary>
+        /// Have the plugin process the RGBA32 frame now in frameBuffer. No allocation: the method id and
+        /// argument array are reused.
+        /// </summary>
+        private void SubmitFrameBuffer(int width, int height)
+        {
+            processFrameArgs[0].i = width;
+            processFrameArgs[1].i = height;
+            AndroidJNI.CallVoidMethod(mediaPipePlugin.GetRawObject(), processFrameMethod, processFrameArgs);
+            if (AndroidJNI.ExceptionOccurred() != IntPtr.Zero)
+            {
+                AndroidJNI.ExceptionClear();
+                Debug.LogError("MediaPipeHands: Error processing frame");
+            }
+        }
+#endif
+        
+        /// <summary>
+        /// Process an RGBA32 texture. Its raw pixels are copied into the shared frame buffer; camera frames
+        /// are better left to Update, which converts them straight into that buffer at the model's resolution.
+        /// </summary>
         public void ProcessFrame(Texture2D frameTexture)
         {
             if (!initialized || frameTexture == null) return;
             
-            currentFrame = frameTexture;
-            
 #if UNITY_ANDROID && !UNITY_EDITOR
             if (mediaPipePlugin != null)
             {
+                if (frameTexture.format != TextureFormat.RGBA32)
+                {
+                    Debug.LogWarning($"MediaPipeHands: Expected an RGBA32 frame, got {frameTexture.format}");
+                    return;
+                }
+                
                 try
                 {
-                    // Convert texture to byte array
-                    byte[] imageBytes = frameTexture.EncodeToJPG(75);
-                    
-                    // Send frame to MediaPipe for processing
-                    mediaPipePlugin.Call("processFrame", imageBytes, frameTexture.width, frameTexture.height);
+                    var pixels = frameTexture.GetRawTextureData<byte>();
+                    int size = frameTexture.width * frameTexture.height * 4;
+                    if (size > frameBuffer.Length) ShareFrameBuffer(size);
+                    NativeArray<byte>.Copy(pixels, frameBuffer, size);
+                    SubmitFrameBuffer(frameTexture.width, frameTexture.height);
                 }
                 catch (Exception e)
                 {
@@ -148,241 +296,79 @@ namespace ARLinguaSphere.Gesture
                 }
             }
             
-            // Auto-process camera frames if available
-            if (arCamera != null && currentFrame == null)
+#if UNITY_ANDROID && !UNITY_EDITOR
+            // Each new camera image is converted and downscaled natively into the shared buffer
+            if (mediaPipePlugin != null && arManager != null
+                && arManager.TryConvertLatestCameraImage(frameBuffer, inputResolution, ref lastFrameTimestamp, out var size))
             {
-                StartCoroutine(CaptureAndProcessFrame());
+                SubmitFrameBuffer(size.x, size.y);
             }
-        }
-        
-        private IEnumerator CaptureAndProcessFrame()
-        {
-            // This would typically be handled by the AR camera manager
-            // For now, we'll simulate frame processing
-            yield return new WaitForSeconds(0.1f);
+#endif
+            
+            // Whatever the plugin (or the simulation) published since the last frame, this frame's included
+            landmarkRing.Drain(handleLandmarks);
         }
         
         private void SimulateHandDetection()
         {
-            // Generate realistic hand landmarks for testing
+            // Generate realistic hand landmarks for testing; they go through the ring like the plugin's
             var landmarks = GenerateSimulatedLandmarks();
             
             if (landmarks != null)
             {
-                OnHandLandmarks?.Invoke(landmarks);
-                
-                // Classify gesture
-                var gesture = ClassifyGesture(landmarks);
-                if (gesture.HasValue && Time.time - lastGestureTime > GESTURE_COOLDOWN)
-                {
-                    lastGestureTime = Time.time;
-                    OnGestureClassified?.Invoke(gesture.Value, landmarks);
-                }
+                landmarkRing.Write(landmarks.keypoints, landmarks.isRight, landmarks.confidence, (long)(landmarks.timestamp * 1e9), landmarks.aspect);
             }
         }
         
         private HandLandmarks GenerateSimulatedLandmarks()
         {
-            // Generate 21 hand keypoints in normalized coordinates
-            var keypoints = new Vector3[21];
-            
             // Simulate different hand poses
             float gestureVariant = UnityEngine.Random.Range(0f, 1f);
-            
-            if (gestureVariant > 0.7f)
+            GestureType gesture = gestureVariant > 0.7f ? GestureType.ThumbsUp
+                : gestureVariant > 0.4f ? GestureType.OpenPalm
+                : GestureType.PinchIn;
+            bool isRight = UnityEngine.Random.Range(0f, 1f) > 0.5f;
+            
+            // Place the reference pose in normalized image coordinates: turned, sized and jittered like a real hand
+            var keypoints = HandPoseClassifier.ReferencePose(gesture);
+            var rotation = Quaternion.Euler(UnityEngine.Random.Range(-20f, 20f), UnityEngine.Random.Range(-30f, 30f), 180f + UnityEngine.Random.Range(-30f, 30f));
+            float scale = UnityEngine.Random.Range(0.12f, 0.2f);
+            var center = new Vector3(UnityEngine.Random.Range(0.35f, 0.65f), 0.7f, 0f);
+            for (int i = 0; i < keypoints.Length; i++)
             {
-                // Thumbs up pose
-                GenerateThumbsUpPose(keypoints);
-            }
-            else if (gestureVariant > 0.4f)
-            {
-                // Open palm pose
-                GenerateOpenPalmPose(keypoints);
-            }
-            else
-            {
-                // Pinch pose
-                GeneratePinchPose(keypoints);
+                Vector3 point = keypoints[i];
+                if (!isRight) point.x = -point.x;
+                keypoints[i] = center + rotation * point * scale + UnityEngine.Random.insideUnitSphere * 0.004f;
             }
             
             return new HandLandmarks
             {
                 keypoints = keypoints,
                 confidence = UnityEngine.Random.Range(0.6f, 0.95f),
-                isRight = UnityEngine.Random.Range(0f, 1f) > 0.5f
+                isRight = isRight,
+                timestamp = Time.realtimeSinceStartupAsDouble
             };
         }
         
-        private void GenerateThumbsUpPose(Vector3[] keypoints)
-        {
-            // Simulate thumbs up landmarks (simplified)
-            // In a real implementation, these would be actual MediaPipe keypoint indices
-            
-            // Wrist
-            keypoints[0] = new Vector3(0.5f, 0.7f, 0f);
-            
-            // Thumb (extended up)
-            keypoints[1] = new Vector3(0.45f, 0.6f, 0f);
-            keypoints[2] = new Vector3(0.43f, 0.5f, 0f);
-            keypoints[3] = new Vector3(0.42f, 0.4f, 0f);
-            keypoints[4] = new Vector3(0.41f, 0.35f, 0f); // Thumb tip
-            
-            // Index finger (folded)
-            keypoints[5] = new Vector3(0.52f, 0.65f, 0f);
-            keypoints[6] = new Vector3(0.54f, 0.68f, 0f);
-            keypoints[7] = new Vector3(0.55f, 0.7f, 0f);
-            keypoints[8] = new Vector3(0.56f, 0.72f, 0f);
-            
-            // Fill remaining keypoints for other fingers (folded)
-            for (int i = 9; i < 21; i++)
-            {
-                keypoints[i] = new Vector3(
-                    0.5f + UnityEngine.Random.Range(-0.05f, 0.05f),
-                    0.7f + UnityEngine.Random.Range(-0.02f, 0.02f),
-                    0f
-                );
-            }
-        }
-        
-        private void GenerateOpenPalmPose(Vector3[] keypoints)
-        {
-            // Simulate open palm landmarks
-            keypoints[0] = new Vector3(0.5f, 0.7f, 0f); // Wrist
-            
-            // Spread fingers
-            for (int i = 1; i < 21; i++)
-            {
-                float angle = (i - 1) * 18f * Mathf.Deg2Rad; // Spread fingers
-                float radius = 0.15f;
-                keypoints[i] = new Vector3(
-                    0.5f + Mathf.Sin(angle) * radius,
-                    0.7f - Mathf.Cos(angle) * radius,
-                    0f
-                );
-            }
-        }
-        
-        private void GeneratePinchPose(Vector3[] keypoints)
-        {
-            // Simulate pinch gesture (thumb and index finger close)
-            keypoints[0] = new Vector3(0.5f, 0.7f, 0f); // Wrist
-            
-            // Thumb tip
-            keypoints[4] = new Vector3(0.48f, 0.6f, 0f);
-            // Index finger tip
-            keypoints[8] = new Vector3(0.52f, 0.6f, 0f);
-            
-            // Fill other keypoints
-            for (int i = 1; i < 21; i++)
-            {
-                if (i != 4 && i != 8)
-                {
-                    keypoints[i] = new Vector3(
-                        0.5f + UnityEngine.Random.Range(-0.08f, 0.08f),
-                        0.65f + UnityEngine.Random.Range(-0.05f, 0.05f),
-                        0f
-                    );
-                }
-            }
-        }
-        
-        private GestureType? ClassifyGesture(HandLandmarks landmarks)
-        {
-            if (landmarks == null || landmarks.keypoints == null) return null;
-            
-            // Simple heuristic classification
-            // In production, use a trained ML model
-            
-            // Check for thumbs up
-            if (IsThumbsUp(landmarks))
-            {
-                return GestureType.ThumbsUp;
-            }
-            
-            // Check for pinch
-            if (IsPinch(landmarks))
-            {
-                return GestureType.PinchIn;
-            }
-            
-            // Check for open palm
-            if (IsOpenPalm(landmarks))
-            {
-                return GestureType.OpenPalm;
-            }
-            
-            return null;
-        }
-        
-        private bool IsThumbsUp(HandLandmarks landmarks)
-        {
-            if (landmarks.keypoints.Length < 5) return false;
-            
-            // Simple heuristic: thumb tip is above wrist and other fingers are below
-            Vector3 wrist = landmarks.keypoints[0];
-            Vector3 thumbTip = landmarks.keypoints[4];
-            
-            return thumbTip.y < wrist.y - 0.1f && landmarks.confidence > 0.8f;
-        }
-        
-        private bool IsPinch(HandLandmarks landmarks)
-        {
-            if (landmarks.keypoints.Length < 9) return false;
-            
-            // Distance between thumb tip and index finger tip
-            Vector3 thumbTip = landmarks.keypoints[4];
-            Vector3 indexTip = landmarks.keypoints[8];
-            
-            float distance = Vector3.Distance(thumbTip, indexTip);
-            return distance < 0.05f && landmarks.confidence > 0.75f;
-        }
-        
-        private bool IsOpenPalm(HandLandmarks landmarks)
+        /// <summary>
+        /// Raise the landmark event, then the gesture events if the pose is recognized, at most once per
+        /// GESTURE_COOLDOWN for each hand. The landmarks object is reused for the next record, so handlers
+        /// copy what they keep.
+        /// </summary>
+        private void HandleLandmarks(HandLandmarks landmarks)
         {
-            if (landmarks.keypoints.Length < 21) return false;
+            OnHandLandmarks?.Invoke(landmarks);
             
-            // Check if fingers are spread (simplified)
-            Vector3 wrist = landmarks.keypoints[0];
-            float avgDistance = 0f;
-            int fingerTips = 0;
+            if (poseClassifier == null || !poseClassifier.Classify(landmarks.keypoints, landmarks.isRight, landmarks.aspect, out string pose, out _)) return;
             
-            // Check finger tips (4, 8, 12, 16, 20)
-            int[] tipIndices = { 4, 8, 12, 16, 20 };
-            foreach (int tipIndex in tipIndices)
-            {
-                if (tipIndex < landmarks.keypoints.Length)
-                {
-                    avgDistance += Vector3.Distance(wrist, landmarks.keypoints[tipIndex]);
-                    fingerTips++;
-                }
-            }
+            int hand = landmarks.isRight ? 1 : 0;
+            if (Time.time - lastGestureTimes[hand] <= GESTURE_COOLDOWN) return;
+            lastGestureTimes[hand] = Time.time;
             
-            avgDistance /= fingerTips;
-            return avgDistance > 0.12f && landmarks.confidence > 0.7f;
-        }
-        
-        // Called by Android plugin via UnitySendMessage
-        public void OnHandLandmarksReceived(string landmarksJson)
-        {
-            try
-            {
-                var landmarks = JsonUtility.FromJson<HandLandmarks>(landmarksJson);
-                if (landmarks != null)
-                {
-                    OnHandLandmarks?.Invoke(landmarks);
-                    
-                    // Classify gesture
-                    var gesture = ClassifyGesture(landmarks);
-                    if (gesture.HasValue && Time.time - lastGestureTime > GESTURE_COOLDOWN)
-                    {
-                        lastGestureTime = Time.time;
-                        OnGestureClassified?.Invoke(gesture.Value, landmarks);
-                    }
-                }
-            }
-            catch (Exception e)
+            OnHandPoseClassified?.Invoke(pose, landmarks);
+            if (gestureNames.TryGetValue(pose, out var gesture))
             {
-                Debug.LogError($"MediaPipeHands: Error parsing landmarks JSON: {e.Message}");
+                OnGestureClassified?.Invoke(gesture, landmarks);
             }
         }
         
@@ -417,12 +403,14 @@ namespace ARLinguaSphere.Gesture
             {
                 mediaPipePlugin?.Call("cleanup");
                 mediaPipePlugin?.Dispose();
+                if (frameBuffer.IsCreated) frameBuffer.Dispose();
             }
             catch (Exception e)
             {
                 Debug.LogError($"MediaPipeHands: Error during cleanup: {e.Message}");
             }
 #endif
+            landmarkRing?.Dispose();
             Debug.Log("MediaPipeHands: Destroyed");
         }
         
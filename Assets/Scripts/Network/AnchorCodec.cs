@@ -0,0 +1,518 @@
+using UnityEngine;
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Versioned binary encoding for anchors. Single records carry their own version byte; batches share one
+    /// header and a string table. All encode/decode paths write into caller-owned buffers and reuse internal
+    /// scratch, so a codec instance must only be used from one thread.
+    ///
+    /// Record (version 1):
+    ///   byte    version
+    ///   byte    flags            bit0: id is a UTF-8 string instead of a 16-byte GUID
+    ///   id      16 bytes | string
+    ///   varint  x, y, z          zigzag, quantised to PositionResolution relative to RoomOrigin
+    ///   uint32  rotation         smallest-three: 2-bit index of the dropped component + 3 x 10 bits
+    ///   varint  timestamp        unix ms
+    ///   string  labelKey, creatorId
+    /// Batch: byte (version | BatchFlag), varint count, then records without version/flags, GUID ids only,
+    /// timestamps as zigzag deltas from the previous record and strings back-referencing earlier ones.
+    /// String: varint v; 0 = null, odd = reference to string table entry v >> 1, even = (v >> 1) - 1 UTF-8 bytes.
+    /// </summary>
+    public sealed class AnchorCodec
+    {
+        public const byte FormatVersion = 1;
+        public const byte BatchFlag = 0x80;
+        public const float PositionResolution = 0.001f; // metres per quantisation step
+
+        private const byte TextIdFlag = 0x01;
+        private const int RotationBits = 10;
+        private const int RotationMax = (1 << RotationBits) - 1;
+        private const float RotationRange = 0.70710678f; // |component| <= 1/sqrt(2) once the largest is dropped
+        private const int MaxFixedRecordSize = 2 + 16 + 3 * 5 + 4 + 10;
+        private const int MaxInternedStrings = 4096;
+
+        public Vector3 RoomOrigin { get; set; }
+
+        // Per-batch string tables
+        private readonly Dictionary<string, int> encodeTable = new Dictionary<string, int>(StringComparer.Ordinal);
+        private string[] decodeTable = new string[64];
+        private int decodeTableCount;
+
+        // Decoded strings keyed by their UTF-8 bytes, so repeated labels/creators do not allocate
+        private readonly Dictionary<int, int> internHead = new Dictionary<int, int>();
+        private readonly List<byte[]> internBytes = new List<byte[]>();
+        private readonly List<string> internStrings = new List<string>();
+        private readonly List<int> internNext = new List<int>();
+
+        private byte[] scratch = new byte[128];
+
+        /// <summary>
+        /// Encode one anchor at <paramref name="offset"/>. Returns bytes written, or -1 if the buffer is too small.
+        /// </summary>
+        public int Encode(AnchorData anchor, byte[] buffer, int offset)
+        {
+            bool guidId = TryParseCanonicalId(anchor.id, out var id);
+            int required = MaxFixedRecordSize + MaxStringSize(anchor.labelKey) + MaxStringSize(anchor.creatorId) +
+                (guidId ? 0 : MaxStringSize(anchor.id));
+            if (buffer == null || offset < 0 || buffer.Length - offset < required) return -1;
+
+            int pos = offset;
+            buffer[pos++] = FormatVersion;
+            buffer[pos++] = guidId ? (byte)0 : TextIdFlag;
+            if (guidId) WriteGuid(buffer, ref pos, id);
+            else WriteString(buffer, ref pos, anchor.id, false);
+            WritePosition(buffer, ref pos, anchor.position);
+            WriteRotation(buffer, ref pos, anchor.rotation);
+            WriteVarint(buffer, ref pos, (ulong)Math.Max(0L, anchor.timestamp));
+            WriteString(buffer, ref pos, anchor.labelKey, false);
+            WriteString(buffer, ref pos, anchor.creatorId, false);
+            return pos - offset;
+        }
+
+        /// <summary>
+        /// Decode one record into <paramref name="target"/>. Returns false on truncated, unknown-version or malformed input.
+        /// </summary>
+        public bool TryDecode(byte[] buffer, int offset, int count, AnchorData target, out int bytesRead)
+        {
+            bytesRead = 0;
+            if (buffer == null || target == null || offset < 0 || count < 2 || offset + count > buffer.Length) return false;
+            int pos = offset;
+            int end = offset + count;
+            if (buffer[pos++] != FormatVersion) return false;
+            byte flags = buffer[pos++];
+
+            string id;
+            if ((flags & TextIdFlag) != 0)
+            {
+                if (!TryReadString(buffer, ref pos, end, false, out id) || id == null) return false;
+            }
+            else
+            {
+                if (!TryReadGuid(buffer, ref pos, end, out var guid)) return false;
+                id = guid.ToString("D");
+            }
+            if (!TryReadPosition(buffer, ref pos, end, out var position)) return false;
+            if (!TryReadRotation(buffer, ref pos, end, out var rotation)) return false;
+            if (!TryReadVarint(buffer, ref pos, end, out ulong timestamp)) return false;
+            if (!TryReadString(buffer, ref pos, end, false, out string labelKey)) return false;
+            if (!TryReadString(buffer, ref pos, end, false, out string creatorId)) return false;
+
+            target.id = id;
+            target.position = position;
+            target.rotation = rotation;
+            target.timestamp = (long)timestamp;
+            target.labelKey = labelKey;
+            target.creatorId = creatorId;
+            bytesRead = pos - offset;
+            return true;
+        }
+
+        /// <summary>
+        /// Base64 form of a single record for backends that only store text
+        /// </summary>
+        public string EncodeBase64(AnchorData anchor)
+        {
+            int required = MaxFixedRecordSize + MaxStringSize(anchor.labelKey) + MaxStringSize(anchor.creatorId) + MaxStringSize(anchor.id);
+            EnsureScratch(required);
+            int written = Encode(anchor, scratch, 0);
+            return written < 0 ? null : Convert.ToBase64String(scratch, 0, written);
+        }
+
+        public bool TryDecodeBase64(string base64, AnchorData target)
+        {
+            if (string.IsNullOrEmpty(base64)) return false;
+            EnsureScratch(base64.Length * 3 / 4 + 3);
+            if (!Convert.TryFromBase64String(base64, new Span<byte>(scratch), out int length)) return false;
+            return TryDecode(scratch, 0, length, target, out _);
+        }
+
+        /// <summary>
+        /// Encode <paramref name="count"/> records as one batch. Returns bytes written, or -1 if the buffer is too small.
+        /// </summary>
+        public int EncodeBatch(AnchorRecord[] records, int count, byte[] buffer, int offset)
+        {
+            if (records == null || buffer == null || offset < 0 || count < 0 || count > records.Length) return -1;
+            int pos = offset;
+            int limit = buffer.Length;
+            if (limit - pos < 1 + 5) return -1;
+            buffer[pos++] = FormatVersion | BatchFlag;
+            WriteVarint(buffer, ref pos, (ulong)count);
+
+            encodeTable.Clear();
+            long previousTimestamp = 0;
+            for (int i = 0; i < count; i++)
+            {
+                ref var record = ref records[i];
+                int required = MaxFixedRecordSize + MaxStringSize(record.labelKey) + MaxStringSize(record.creatorId);
+                if (limit - pos < required)
+                {
+                    encodeTable.Clear();
+                    return -1;
+                }
+                WriteGuid(buffer, ref pos, record.id);
+                WritePosition(buffer, ref pos, record.position);
+                WriteRotation(buffer, ref pos, record.rotation);
+                WriteVarint(buffer, ref pos, ZigZag(record.timestamp - previousTimestamp));
+                previousTimestamp = record.timestamp;
+                WriteString(buffer, ref pos, record.labelKey, true);
+                WriteString(buffer, ref pos, record.creatorId, true);
+            }
+            encodeTable.Clear();
+            return pos - offset;
+        }
+
+        /// <summary>
+        /// Decode a batch into <paramref name="output"/>. Returns the record count, or -1 if the input is malformed
+        /// or <paramref name="output"/> is too small (see <see cref="PeekBatchCount"/>).
+        /// </summary>
+        public int DecodeBatch(byte[] buffer, int offset, int count, AnchorRecord[] output)
+        {
+            if (buffer == null || output == null || offset < 0 || count < 1 || offset + count > buffer.Length) return -1;
+            int pos = offset;
+            int end = offset + count;
+            if (buffer[pos++] != (FormatVersion | BatchFlag)) return -1;
+            if (!TryReadVarint(buffer, ref pos, end, out ulong records) || records > (ulong)output.Length) return -1;
+
+            decodeTableCount = 0;
+            long timestamp = 0;
+            for (int i = 0; i < (int)records; i++)
+            {
+                ref var record = ref output[i];
+                if (!TryReadGuid(buffer, ref pos, end, out record.id) ||
+                    !TryReadPosition(buffer, ref pos, end, out record.position) ||
+                    !TryReadRotation(buffer, ref pos, end, out record.rotation) ||
+                    !TryReadVarint(buffer, ref pos, end, out ulong delta) ||
+                    !TryReadString(buffer, ref pos, end, true, out record.labelKey) ||
+                    !TryReadString(buffer, ref pos, end, true, out record.creatorId))
+                {
+                    ReleaseDecodeTable();
+                    return -1;
+                }
+                timestamp += UnZigZag(delta);
+                record.timestamp = timestamp;
+            }
+            ReleaseDecodeTable();
+            return (int)records;
+        }
+
+        /// <summary>
+        /// Whether <paramref name="id"/> is a GUID in the lower-case "D" form that decoding produces, so the 16-byte
+        /// form round-trips to the same string. Any other spelling (braces, upper case, "N") is kept as text.
+        /// </summary>
+        public static bool TryParseCanonicalId(string id, out Guid guid)
+        {
+            guid = Guid.Empty;
+            return id != null && id.Length == 36 && Guid.TryParseExact(id, "D", out guid) && guid.ToString("D") == id;
+        }
+
+        /// <summary>
+        /// Number of records in a batch header, or -1 if the header is not a batch of this version.
+        /// </summary>
+        public static int PeekBatchCount(byte[] buffer, int offset, int count)
+        {
+            if (buffer == null || offset < 0 || count < 2 || offset + count > buffer.Length) return -1;
+            if (buffer[offset] != (FormatVersion | BatchFlag)) return -1;
+            int pos = offset + 1;
+            if (!TryReadVarint(buffer, ref pos, offset + count, out ulong records) || records > int.MaxValue) return -1;
+            return (int)records;
+        }
+
+        private void EnsureScratch(int size)
+        {
+            if (scratch.Length < size) scratch = new byte[Math.Max(size, scratch.Length * 2)];
+        }
+
+        private void ReleaseDecodeTable()
+        {
+            // Drop references so the table does not pin strings evicted from the intern cache
+            Array.Clear(decodeTable, 0, decodeTableCount);
+            decodeTableCount = 0;
+        }
+
+        private static int MaxStringSize(string value)
+        {
+            return value == null ? 1 : 5 + Encoding.UTF8.GetByteCount(value);
+        }
+
+        private static void WriteGuid(byte[] buffer, ref int pos, Guid id)
+        {
+            id.TryWriteBytes(new Span<byte>(buffer, pos, 16));
+            pos += 16;
+        }
+
+        private static bool TryReadGuid(byte[] buffer, ref int pos, int end, out Guid id)
+        {
+            if (end - pos < 16)
+            {
+                id = Guid.Empty;
+                return false;
+            }
+            id = new Guid(new ReadOnlySpan<byte>(buffer, pos, 16));
+            pos += 16;
+            return true;
+        }
+
+        private void WritePosition(byte[] buffer, ref int pos, Vector3 position)
+        {
+            var origin = RoomOrigin;
+            WriteVarint(buffer, ref pos, ZigZag(Quantise(position.x - origin.x)));
+            WriteVarint(buffer, ref pos, ZigZag(Quantise(position.y - origin.y)));
+            WriteVarint(buffer, ref pos, ZigZag(Quantise(position.z - origin.z)));
+        }
+
+        private bool TryReadPosition(byte[] buffer, ref int pos, int end, out Vector3 position)
+        {
+            position = default;
+            if (!TryReadVarint(buffer, ref pos, end, out ulong x) ||
+                !TryReadVarint(buffer, ref pos, end, out ulong y) ||
+                !TryReadVarint(buffer, ref pos, end, out ulong z))
+            {
+                return false;
+            }
+            var origin = RoomOrigin;
+            position = new Vector3(
+                origin.x + UnZigZag(x) * PositionResolution,
+                origin.y + UnZigZag(y) * PositionResolution,
+                origin.z + UnZigZag(z) * PositionResolution);
+            return true;
+        }
+
+        private static long Quantise(float metres)
+        {
+            double steps = Math.Round(metres / (double)PositionResolution);
+            if (double.IsNaN(steps)) return 0;
+            return (long)Math.Max(int.MinValue, Math.Min(int.MaxValue, steps));
+        }
+
+        private static void WriteRotation(byte[] buffer, ref int pos, Quaternion rotation)
+        {
+            float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+            float magnitude = Mathf.Sqrt(x * x + y * y + z * z + w * w);
+            if (magnitude < 1e-6f || float.IsNaN(magnitude))
+            {
+                x = y = z = 0f;
+                w = 1f;
+            }
+            else
+            {
+                x /= magnitude; y /= magnitude; z /= magnitude; w /= magnitude;
+            }
+
+            // Drop the largest component; q and -q are the same rotation, so make it positive
+            int largest = 0;
+            float largestAbs = Mathf.Abs(x);
+            if (Mathf.Abs(y) > largestAbs) { largest = 1; largestAbs = Mathf.Abs(y); }
+            if (Mathf.Abs(z) > largestAbs) { largest = 2; largestAbs = Mathf.Abs(z); }
+            if (Mathf.Abs(w) > largestAbs) { largest = 3; }
+            float sign = (largest == 0 ? x : largest == 1 ? y : largest == 2 ? z : w) < 0f ? -1f : 1f;
+
+            uint packed = (uint)largest;
+            if (largest != 0) packed = (packed << RotationBits) | QuantiseComponent(x * sign);
+            if (largest != 1) packed = (packed << RotationBits) | QuantiseComponent(y * sign);
+            if (largest != 2) packed = (packed << RotationBits) | QuantiseComponent(z * sign);
+            if (largest != 3) packed = (packed << RotationBits) | QuantiseComponent(w * sign);
+
+            buffer[pos++] = (byte)packed;
+            buffer[pos++] = (byte)(packed >> 8);
+            buffer[pos++] = (byte)(packed >> 16);
+            buffer[pos++] = (byte)(packed >> 24);
+        }
+
+        private static bool TryReadRotation(byte[] buffer, ref int pos, int end, out Quaternion rotation)
+        {
+            rotation = Quaternion.identity;
+            if (end - pos < 4) return false;
+            uint packed = buffer[pos] | (uint)buffer[pos + 1] << 8 | (uint)buffer[pos + 2] << 16 | (uint)buffer[pos + 3] << 24;
+            pos += 4;
+
+            float c = DequantiseComponent(packed & RotationMax);
+            float b = DequantiseComponent((packed >> RotationBits) & RotationMax);
+            float a = DequantiseComponent((packed >> (2 * RotationBits)) & RotationMax);
+            int largest = (int)(packed >> (3 * RotationBits));
+            float d = Mathf.Sqrt(Mathf.Max(0f, 1f - a * a - b * b - c * c));
+            switch (largest)
+            {
+                case 0: rotation = new Quaternion(d, a, b, c); break;
+                case 1: rotation = new Quaternion(a, d, b, c); break;
+                case 2: rotation = new Quaternion(a, b, d, c); break;
+                default: rotation = new Quaternion(a, b, c, d); break;
+            }
+            return true;
+        }
+
+        private static uint QuantiseComponent(float value)
+        {
+            float normalised = (value + RotationRange) / (2f * RotationRange);
+            return (uint)Mathf.Clamp(Mathf.RoundToInt(normalised * RotationMax), 0, RotationMax);
+        }
+
+        private static float DequantiseComponent(uint value)
+        {
+            return value / (float)RotationMax * (2f * RotationRange) - RotationRange;
+        }
+
+        private void WriteString(byte[] buffer, ref int pos, string value, bool useTable)
+        {
+            if (value == null)
+            {
+                buffer[pos++] = 0;
+                return;
+            }
+            if (useTable)
+            {
+                if (encodeTable.TryGetValue(value, out int index))
+                {
+                    WriteVarint(buffer, ref pos, ((ulong)index << 1) | 1UL);
+                    return;
+                }
+                encodeTable[value] = encodeTable.Count;
+            }
+            int length = Encoding.UTF8.GetByteCount(value);
+            WriteVarint(buffer, ref pos, (ulong)(length + 1) << 1);
+            pos += Encoding.UTF8.GetBytes(value, 0, value.Length, buffer, pos);
+        }
+
+        private bool TryReadString(byte[] buffer, ref int pos, int end, bool useTable, out string value)
+        {
+            value = null;
+            if (!TryReadVarint(buffer, ref pos, end, out ulong header)) return false;
+            if (header == 0) return true;
+            if ((header & 1UL) != 0)
+            {
+                ulong index = header >> 1;
+                if (!useTable || index >= (ulong)decodeTableCount) return false;
+                value = decodeTable[(int)index];
+                return true;
+            }
+
+            ulong length = (header >> 1) - 1;
+            if (length > (ulong)(end - pos)) return false;
+            value = Intern(buffer, pos, (int)length);
+            pos += (int)length;
+            if (useTable)
+            {
+                if (decodeTableCount == decodeTable.Length) Array.Resize(ref decodeTable, decodeTableCount * 2);
+                decodeTable[decodeTableCount++] = value;
+            }
+            return true;
+        }
+
+        private string Intern(byte[] buffer, int offset, int length)
+        {
+            // FNV-1a over the raw bytes
+            int hash = unchecked((int)2166136261);
+            for (int i = 0; i < length; i++) hash = unchecked((hash ^ buffer[offset + i]) * 16777619);
+
+            if (internHead.TryGetValue(hash, out int head))
+            {
+                for (int e = head; e != -1; e = internNext[e])
+                {
+                    if (BytesEqual(internBytes[e], buffer, offset, length)) return internStrings[e];
+                }
+            }
+            else
+            {
+                head = -1;
+            }
+
+            if (internStrings.Count >= MaxInternedStrings)
+            {
+                internHead.Clear();
+                internBytes.Clear();
+                internStrings.Clear();
+                internNext.Clear();
+                head = -1;
+            }
+
+            var bytes = new byte[length];
+            Buffer.BlockCopy(buffer, offset, bytes, 0, length);
+            string value = Encoding.UTF8.GetString(buffer, offset, length);
+            internBytes.Add(bytes);
+            internStrings.Add(value);
+            internNext.Add(head);
+            internHead[hash] = internStrings.Count - 1;
+            return value;
+        }
+
+        private static bool BytesEqual(byte[] cached, byte[] buffer, int offset, int length)
+        {
+            if (cached.Length != length) return false;
+            for (int i = 0; i < length; i++)
+            {
+                if (cached[i] != buffer[offset + i]) return false;
+            }
+            return true;
+        }
+
+        private static void WriteVarint(byte[] buffer, ref int pos, ulong value)
+        {
+            while (value >= 0x80)
+            {
+                buffer[pos++] = (byte)(value | 0x80);
+                value >>= 7;
+            }
+            buffer[pos++] = (byte)value;
+        }
+
+        private static bool TryReadVarint(byte[] buffer, ref int pos, int end, out ulong value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (pos >= end) return false;
+                byte b = buffer[pos++];
+                value |= (ulong)(b & 0x7F) << shift;
+                if ((b & 0x80) == 0) return true;
+            }
+            return false; // more than 10 bytes
+        }
+
+        private static ulong ZigZag(long value) => (ulong)((value << 1) ^ (value >> 63));
+
+        private static long UnZigZag(ulong value) => (long)(value >> 1) ^ -(long)(value & 1);
+    }
+
+    /// <summary>
+    /// Value-type anchor used by the allocation-free batch path
+    /// </summary>
+    public struct AnchorRecord
+    {
+        public Guid id;
+        public Vector3 position;
+        public Quaternion rotation;
+        public string labelKey;
+        public string creatorId;
+        public long timestamp;
+
+        public static AnchorRecord FromAnchorData(AnchorData anchor)
+        {
+            Guid.TryParse(anchor.id, out var id);
+            return new AnchorRecord
+            {
+                id = id,
+                position = anchor.position,
+                rotation = anchor.rotation,
+                labelKey = anchor.labelKey,
+                creatorId = anchor.creatorId,
+                timestamp = anchor.timestamp
+            };
+        }
+
+        public AnchorData ToAnchorData()
+        {
+            return new AnchorData
+            {
+                id = id.ToString(),
+                position = position,
+                rotation = rotation,
+                labelKey = labelKey,
+                creatorId = creatorId,
+                timestamp = timestamp
+            };
+        }
+    }
+}
@@ -0,0 +1,186 @@
+using System;
+using System.Text;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Incremental parser for the Realtime Database REST event stream (text/event-stream) of a room's anchors.
+    /// Bytes can arrive in arbitrary chunks; complete "put"/"patch" events are applied as per-anchor callbacks.
+    /// Nodes passed to onAnchor are only valid for the duration of the callback.
+    /// </summary>
+    public sealed class AnchorEventStream
+    {
+        public string LastEventId { get; private set; }
+        public int RetryMilliseconds { get; private set; } = -1;
+        public int EventsReceived { get; private set; }
+        public long BytesReceived { get; private set; }
+        public string CloseReason { get; private set; }
+        public bool IsClosed => CloseReason != null;
+
+        private readonly Action<string, JsonNode> onAnchor;
+        private readonly Action<string> onAnchorRemoved;
+        private readonly JsonIndex json = new JsonIndex();
+        private readonly Decoder utf8 = Encoding.UTF8.GetDecoder();
+        private readonly StringBuilder line = new StringBuilder(256);
+        private readonly StringBuilder data = new StringBuilder(1024);
+        private char[] chars = new char[4096];
+        private string eventType;
+        private string pendingEventId;
+        private bool lastWasCarriageReturn;
+
+        public AnchorEventStream(Action<string, JsonNode> onAnchor, Action<string> onAnchorRemoved = null)
+        {
+            this.onAnchor = onAnchor;
+            this.onAnchorRemoved = onAnchorRemoved;
+        }
+
+        /// <summary>
+        /// Drop any partial event before reconnecting. LastEventId and the retry hint are kept for resume.
+        /// </summary>
+        public void Reset()
+        {
+            utf8.Reset();
+            line.Length = 0;
+            data.Length = 0;
+            eventType = null;
+            pendingEventId = null;
+            lastWasCarriageReturn = false;
+            EventsReceived = 0;
+            BytesReceived = 0;
+            CloseReason = null;
+        }
+
+        public void Feed(byte[] buffer, int offset, int count)
+        {
+            BytesReceived += count;
+            int maxChars = utf8.GetCharCount(buffer, offset, count, false); // includes bytes carried from the last chunk
+            if (chars.Length < maxChars) chars = new char[Math.Max(maxChars, chars.Length * 2)];
+            int charCount = utf8.GetChars(buffer, offset, count, chars, 0);
+
+            for (int i = 0; i < charCount; i++)
+            {
+                char c = chars[i];
+                if (c == '\n' && lastWasCarriageReturn)
+                {
+                    // Second half of a CRLF split across chunks or read in one go
+                    lastWasCarriageReturn = false;
+                    continue;
+                }
+                lastWasCarriageReturn = c == '\r';
+                if (c == '\r' || c == '\n')
+                {
+                    ProcessLine();
+                    line.Length = 0;
+                }
+                else
+                {
+                    line.Append(c);
+                }
+            }
+        }
+
+        private void ProcessLine()
+        {
+            if (line.Length == 0)
+            {
+                DispatchEvent();
+                return;
+            }
+            if (line[0] == ':') return; // comment
+
+            int colon = -1;
+            for (int i = 0; i < line.Length; i++)
+            {
+                if (line[i] == ':') { colon = i; break; }
+            }
+            string field = colon < 0 ? line.ToString() : line.ToString(0, colon);
+            int valueStart = colon < 0 ? line.Length : colon + 1;
+            if (valueStart < line.Length && line[valueStart] == ' ') valueStart++;
+
+            switch (field)
+            {
+                case "event":
+                    eventType = line.ToString(valueStart, line.Length - valueStart);
+                    break;
+                case "data":
+                    if (data.Length > 0) data.Append('\n');
+                    data.Append(line.ToString(valueStart, line.Length - valueStart));
+                    break;
+                case "id":
+                    pendingEventId = line.ToString(valueStart, line.Length - valueStart);
+                    break;
+                case "retry":
+                    if (int.TryParse(line.ToString(valueStart, line.Length - valueStart), out int retry) && retry >= 0)
+                    {
+                        RetryMilliseconds = retry;
+                    }
+                    break;
+            }
+        }
+
+        private void DispatchEvent()
+        {
+            string type = eventType ?? "message";
+            eventType = null;
+            if (pendingEventId != null)
+            {
+                LastEventId = pendingEventId;
+                pendingEventId = null;
+            }
+            if (data.Length == 0 && type == "message") return;
+
+            EventsReceived++;
+            switch (type)
+            {
+                case "put":
+                case "patch":
+                    ApplyChange(type == "patch");
+                    break;
+                case "cancel":
+                case "auth_revoked":
+                    // The server will not send more events on this connection
+                    CloseReason = type;
+                    break;
+            }
+            data.Length = 0;
+        }
+
+        private void ApplyChange(bool isPatch)
+        {
+            // { "path": "/", "data": ... } relative to the anchors node
+            if (!json.Load(data.ToString()) || !json.Root.TryGetField("path", out var pathNode))
+            {
+                json.Clear();
+                return;
+            }
+            json.Root.TryGetField("data", out var payload);
+            string path = pathNode.GetString() ?? string.Empty;
+
+            if (path == "/")
+            {
+                // Full snapshot (put) or a multi-anchor merge (patch): one child per anchor
+                var anchors = payload.GetObject();
+                while (anchors.MoveNext())
+                {
+                    ApplyAnchor(anchors.Key, anchors.Value);
+                }
+            }
+            else if (path.Length > 1)
+            {
+                int start = path[0] == '/' ? 1 : 0;
+                int slash = path.IndexOf('/', start);
+                // Field-level writes below an anchor do not change its identity; only whole-anchor writes matter
+                if (slash < 0 && !isPatch) ApplyAnchor(path.Substring(start), payload);
+            }
+            json.Clear();
+        }
+
+        private void ApplyAnchor(string id, JsonNode node)
+        {
+            if (string.IsNullOrEmpty(id)) return;
+            if (node.IsNull) onAnchorRemoved?.Invoke(id);
+            else onAnchor?.Invoke(id, node);
+        }
+    }
+}
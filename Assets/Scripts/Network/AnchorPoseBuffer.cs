@@ -0,0 +1,216 @@
+using System;
+using System.Collections.Generic;
+using UnityEngine;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Per-anchor jitter buffer for remote pose updates. Senders stamp updates in server time (see ClockSync); each
+    /// anchor is played back a delay behind now, interpolating between the two samples around that instant, so updates
+    /// arriving a few hundred ms apart and unevenly spaced still move a label smoothly instead of popping.
+    /// The delay follows each anchor's observed transit time and its variation (the adaptive playout of RTP receivers),
+    /// which also absorbs whatever clock offset is left between sender and receiver. Only live updates feed that estimate:
+    /// an anchor's first sample, replayed (cached or snapshot) state and transits beyond MaxTransitMs say nothing about
+    /// the network, and single outliers are clamped. Past the newest sample the pose holds rather than extrapolates, so
+    /// a stopped anchor never overshoots.
+    /// </summary>
+    public sealed class AnchorPoseBuffer
+    {
+        public const int DefaultCapacity = 8;
+
+        public long MinDelayMs { get; set; } = 100; // margin over transit and jitter
+        public long MaxStepMs { get; set; } = 500; // an update after a longer pause moves over at most this long
+        public long MaxTransitMs { get; set; } = 2000; // an older update is replayed state, not a live move
+        public long ResetAfterMs { get; set; } = 30000; // an anchor idle this long starts over, transit estimate included
+        public int Count => tracks.Count;
+
+        private const double Gain = 1.0 / 8.0;
+
+        private readonly int capacity;
+        private readonly Dictionary<string, Track> tracks = new Dictionary<string, Track>();
+        private readonly Stack<Track> pool = new Stack<Track>();
+
+        public AnchorPoseBuffer(int capacity = DefaultCapacity)
+        {
+            this.capacity = Math.Max(2, capacity);
+        }
+
+        /// <summary>
+        /// Adds a pose its sender stamped at <paramref name="timestamp"/>, received at <paramref name="now"/> (both server
+        /// time ms). Pass <paramref name="live"/> false for poses replayed from a cache or snapshot. Returns false for a
+        /// duplicate or for one older than the newest buffered sample.
+        /// </summary>
+        public bool Push(string id, long timestamp, Vector3 position, Quaternion rotation, long now, bool live = true)
+        {
+            if (!tracks.TryGetValue(id, out var track))
+            {
+                track = pool.Count > 0 ? pool.Pop() : new Track(capacity);
+                track.Reset();
+                tracks[id] = track;
+            }
+            else if (timestamp <= track.Newest.timestamp)
+            {
+                return false;
+            }
+            else if (timestamp - track.Newest.timestamp > ResetAfterMs)
+            {
+                track.Reset();
+            }
+
+            if (track.count > 0 && timestamp - track.Newest.timestamp > MaxStepMs)
+            {
+                // Hold the old pose until shortly before the new one rather than crawling across the whole pause
+                var held = track.Newest;
+                held.timestamp = timestamp - MaxStepMs;
+                track.Append(held);
+            }
+            long transit = now - timestamp;
+            if (live && track.count > 0 && Math.Abs(transit) <= MaxTransitMs) track.ObserveTransit(transit, MinDelayMs);
+            track.Append(new PoseSample { timestamp = timestamp, position = position, rotation = rotation });
+            return true;
+        }
+
+        /// <summary>
+        /// The pose to show at <paramref name="now"/> (server time ms). <paramref name="settled"/> is true once playback
+        /// has reached the newest sample; until another update arrives the pose no longer changes.
+        /// </summary>
+        public bool TrySample(string id, long now, out Vector3 position, out Quaternion rotation, out bool settled)
+        {
+            if (!tracks.TryGetValue(id, out var track))
+            {
+                position = default;
+                rotation = Quaternion.identity;
+                settled = true;
+                return false;
+            }
+
+            // Playback never runs backwards, even when the delay grows
+            long delay = (long)(track.transit + 4.0 * track.variation) + MinDelayMs;
+            long renderAt = Math.Max(track.renderedAt, now - delay);
+            track.renderedAt = renderAt;
+
+            var newest = track.Newest;
+            settled = renderAt >= newest.timestamp;
+            if (settled)
+            {
+                position = newest.position;
+                rotation = newest.rotation;
+                return true;
+            }
+
+            var from = track.At(0);
+            if (renderAt <= from.timestamp)
+            {
+                position = from.position;
+                rotation = from.rotation;
+                return true;
+            }
+            for (int i = 1; i < track.count; i++)
+            {
+                var to = track.At(i);
+                if (renderAt <= to.timestamp)
+                {
+                    float t = (float)(renderAt - from.timestamp) / (to.timestamp - from.timestamp);
+                    position = Vector3.Lerp(from.position, to.position, t);
+                    rotation = Quaternion.Slerp(from.rotation, to.rotation, t);
+                    return true;
+                }
+                from = to;
+            }
+            position = newest.position;
+            rotation = newest.rotation;
+            return true;
+        }
+
+        public bool Remove(string id)
+        {
+            if (!tracks.TryGetValue(id, out var track)) return false;
+            tracks.Remove(id);
+            pool.Push(track);
+            return true;
+        }
+
+        public void Clear()
+        {
+            foreach (var track in tracks.Values)
+            {
+                pool.Push(track);
+            }
+            tracks.Clear();
+        }
+
+        private struct PoseSample
+        {
+            public long timestamp;
+            public Vector3 position;
+            public Quaternion rotation;
+        }
+
+        /// <summary>
+        /// Ring of the newest samples in timestamp order, plus the anchor's transit estimate
+        /// </summary>
+        private sealed class Track
+        {
+            public int count;
+            public double transit; // 0 with no estimate yet: playback runs MinDelayMs behind
+            public double variation;
+            public bool hasTransit;
+            public long renderedAt;
+
+            private readonly PoseSample[] samples;
+            private int head;
+
+            public Track(int capacity)
+            {
+                samples = new PoseSample[capacity];
+            }
+
+            public PoseSample Newest => At(count - 1);
+
+            public PoseSample At(int index)
+            {
+                return samples[(head + index) % samples.Length];
+            }
+
+            public void Append(PoseSample sample)
+            {
+                if (count == samples.Length)
+                {
+                    head = (head + 1) % samples.Length;
+                    count--;
+                }
+                samples[(head + count) % samples.Length] = sample;
+                count++;
+            }
+
+            /// <summary>
+            /// Folds in one transit sample; a sample further from the estimate than four variations plus
+            /// <paramref name="margin"/> counts as that far, so one stalled update cannot stretch the delay for long.
+            /// </summary>
+            public void ObserveTransit(double sample, double margin)
+            {
+                if (!hasTransit)
+                {
+                    transit = sample;
+                    variation = 0;
+                    hasTransit = true;
+                    return;
+                }
+                double limit = 4.0 * variation + margin;
+                double deviation = Math.Max(-limit, Math.Min(limit, sample - transit));
+                transit += deviation * Gain;
+                variation += (Math.Abs(deviation) - variation) * Gain;
+            }
+
+            public void Reset()
+            {
+                count = 0;
+                head = 0;
+                transit = 0;
+                variation = 0;
+                hasTransit = false;
+                renderedAt = long.MinValue;
+            }
+        }
+    }
+}
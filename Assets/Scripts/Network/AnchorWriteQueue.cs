@@ -0,0 +1,164 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Outbound anchor writes waiting to be sent as multi-path PATCHes, one queue per room.
+    /// Writes to the same path coalesce (last value wins, every callback is kept). A room's batch is due once it
+    /// holds MaxBatchSize writes or its oldest write has waited FlushInterval; only one batch per room is in flight,
+    /// so writes to a room reach the server in order. Times are supplied by the caller.
+    /// </summary>
+    public sealed class AnchorWriteQueue
+    {
+        public int MaxBatchSize { get; set; }
+        public float FlushInterval { get; set; }
+        public AnchorWriteMetrics Metrics => metrics;
+        public int PendingCount { get; private set; }
+
+        private readonly Dictionary<string, RoomQueue> rooms = new Dictionary<string, RoomQueue>();
+        private readonly List<string> roomOrder = new List<string>();
+        private AnchorWriteMetrics metrics;
+
+        public AnchorWriteQueue(int maxBatchSize = 50, float flushInterval = 0.1f)
+        {
+            MaxBatchSize = Math.Max(1, maxBatchSize);
+            FlushInterval = Math.Max(0f, flushInterval);
+        }
+
+        /// <summary>
+        /// Queue a write of <paramref name="json"/> (null deletes) to rooms/{roomId}/{path}, e.g. "anchors/{id}".
+        /// </summary>
+        public void Enqueue(string roomId, string path, string json, float now, Action<bool> onComplete = null)
+        {
+            if (!rooms.TryGetValue(roomId, out var room))
+            {
+                room = new RoomQueue();
+                rooms[roomId] = room;
+                roomOrder.Add(roomId);
+            }
+
+            metrics.writesQueued++;
+            if (room.byPath.TryGetValue(path, out var pending))
+            {
+                pending.json = json;
+                if (onComplete != null) pending.callbacks.Add(onComplete);
+                metrics.writesCoalesced++;
+                return;
+            }
+
+            pending = new PendingAnchorWrite { roomId = roomId, path = path, json = json, enqueuedAt = now };
+            if (onComplete != null) pending.callbacks.Add(onComplete);
+            room.byPath[path] = pending;
+            room.order.Add(pending);
+            PendingCount++;
+        }
+
+        /// <summary>
+        /// Move the next due batch into <paramref name="batch"/>. Returns the room id, or null if nothing is due.
+        /// Call <see cref="Complete"/> with the result before that room can flush again.
+        /// </summary>
+        public string TakeDueBatch(float now, List<PendingAnchorWrite> batch, bool force = false)
+        {
+            batch.Clear();
+            foreach (var roomId in roomOrder)
+            {
+                var room = rooms[roomId];
+                if (room.inFlight || room.order.Count == 0) continue;
+                bool due = force || room.order.Count >= MaxBatchSize || now - room.order[0].enqueuedAt >= FlushInterval;
+                if (!due) continue;
+
+                int take = Math.Min(MaxBatchSize, room.order.Count);
+                for (int i = 0; i < take; i++)
+                {
+                    var pending = room.order[i];
+                    room.byPath.Remove(pending.path);
+                    batch.Add(pending);
+                }
+                room.order.RemoveRange(0, take);
+                room.inFlight = true;
+                PendingCount -= take;
+                metrics.requestsSent++;
+                metrics.writesSent += take;
+                return roomId;
+            }
+            return null;
+        }
+
+        /// <summary>
+        /// Report a batch result: every callback of every coalesced write receives it.
+        /// </summary>
+        public void Complete(string roomId, List<PendingAnchorWrite> batch, bool success)
+        {
+            if (rooms.TryGetValue(roomId, out var room)) room.inFlight = false;
+            if (!success) metrics.requestsFailed++;
+            foreach (var pending in batch)
+            {
+                foreach (var callback in pending.callbacks)
+                {
+                    callback(success);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Multi-path update body relative to rooms/{roomId}: { "anchors/id": value, "cells/3_-2/anchors/id": value, ... }
+        /// </summary>
+        public static string BuildPatchBody(List<PendingAnchorWrite> batch)
+        {
+            var sb = new StringBuilder(64 + batch.Count * 96);
+            sb.Append('{');
+            for (int i = 0; i < batch.Count; i++)
+            {
+                if (i > 0) sb.Append(',');
+                sb.Append('"');
+                foreach (char c in batch[i].path)
+                {
+                    if (c == '"' || c == '\\') sb.Append('\\');
+                    sb.Append(c);
+                }
+                sb.Append("\":").Append(batch[i].json ?? "null");
+            }
+            sb.Append('}');
+            return sb.ToString();
+        }
+
+        private sealed class RoomQueue
+        {
+            public readonly Dictionary<string, PendingAnchorWrite> byPath = new Dictionary<string, PendingAnchorWrite>();
+            public readonly List<PendingAnchorWrite> order = new List<PendingAnchorWrite>();
+            public bool inFlight;
+        }
+    }
+
+    /// <summary>
+    /// A queued anchor write after coalescing
+    /// </summary>
+    public class PendingAnchorWrite
+    {
+        public string roomId;
+        public string path;
+        public string json;
+        public float enqueuedAt;
+        public readonly List<Action<bool>> callbacks = new List<Action<bool>>(1);
+    }
+
+    /// <summary>
+    /// Counters for the outbound write path
+    /// </summary>
+    [Serializable]
+    public struct AnchorWriteMetrics
+    {
+        public int writesQueued;
+        public int writesCoalesced;
+        public int writesSent;
+        public int requestsSent;
+        public int requestsFailed;
+
+        /// <summary>
+        /// HTTP requests avoided compared with one request per queued write (excluding writes still pending)
+        /// </summary>
+        public int RequestsSaved => writesCoalesced + writesSent - requestsSent;
+    }
+}
@@ -0,0 +1,90 @@
+using System;
+using System.Diagnostics;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// NTP-style estimate of this device's offset from a reference clock (the Realtime Database server's), built from
+    /// request round trips that return the server's time. Of the last WindowSize samples the one with the shortest
+    /// round trip wins, as in NTP's clock filter: queueing delay is what breaks the symmetric-path assumption, and the
+    /// fastest exchange carried the least of it. Local time is monotonic from startup, so the OS stepping the device
+    /// clock does not move remote anchors.
+    /// </summary>
+    public sealed class ClockSync
+    {
+        public const int DefaultWindowSize = 8;
+
+        public bool HasEstimate => count > 0;
+        public long OffsetMs => offset; // reference minus local
+        public long RoundTripMs => roundTrip; // of the sample the offset came from
+        public int SampleCount => count;
+        public long LocalNow => localClock();
+        public long ReferenceNow => localClock() + offset;
+
+        private readonly Func<long> localClock;
+        private readonly long[] offsets;
+        private readonly long[] roundTrips;
+        private int next;
+        private int count;
+        private long offset;
+        private long roundTrip;
+
+        public ClockSync(int windowSize = DefaultWindowSize, Func<long> localClock = null)
+        {
+            windowSize = Math.Max(1, windowSize);
+            offsets = new long[windowSize];
+            roundTrips = new long[windowSize];
+            if (localClock == null)
+            {
+                long start = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
+                var elapsed = Stopwatch.StartNew();
+                localClock = () => start + elapsed.ElapsedMilliseconds;
+            }
+            this.localClock = localClock;
+        }
+
+        /// <summary>
+        /// One exchange: sent at local <paramref name="localSend"/>, stamped <paramref name="reference"/> by the server,
+        /// answered at local <paramref name="localReceive"/>. The server stamps and replies in one step, so NTP's t1 and
+        /// t2 coincide. Returns false for a sample that cannot be right (negative round trip, no server time).
+        /// </summary>
+        public bool AddSample(long localSend, long reference, long localReceive)
+        {
+            long rtt = localReceive - localSend;
+            if (rtt < 0 || reference <= 0) return false;
+
+            // ((t1 - t0) + (t2 - t3)) / 2
+            offsets[next] = reference - localSend - rtt / 2;
+            roundTrips[next] = rtt;
+            next = (next + 1) % offsets.Length;
+            if (count < offsets.Length) count++;
+
+            int best = -1;
+            for (int i = 0; i < count; i++)
+            {
+                if (best < 0 || roundTrips[i] < roundTrips[best]) best = i;
+            }
+            offset = offsets[best];
+            roundTrip = roundTrips[best];
+            return true;
+        }
+
+        public long ToReference(long local)
+        {
+            return local + offset;
+        }
+
+        public long ToLocal(long reference)
+        {
+            return reference - offset;
+        }
+
+        public void Reset()
+        {
+            next = 0;
+            count = 0;
+            offset = 0;
+            roundTrip = 0;
+        }
+    }
+}
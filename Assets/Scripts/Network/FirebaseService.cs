@@ -2,8 +2,9 @@ using UnityEngine;
 using System;
 using System.Collections.Generic;
 using System.Collections;
-using UnityEngine.Networking;
-using ARLinguaSphere.Core.ThirdParty;
+using System.IO;
+using System.Threading.Tasks;
+using ARLinguaSphere.Core;
 
 namespace ARLinguaSphere.Network
 {
@@ -19,15 +20,85 @@ namespace ARLinguaSphere.Network
 		public string emulatorHost = "127.0.0.1";
 		public int emulatorPort = 9000;
 		public float pollIntervalSeconds = 0.5f;
+		public int maxConnectionsPerHost = 4; // kept-alive REST connections; event streams hold their own
+		
+		[Header("Streaming")]
+		public bool useEventStream = true;
+		public float streamReconnectSeconds = 1f;
+		public float streamMaxReconnectSeconds = 30f;
+		public float streamIdleTimeoutSeconds = 75f; // server keep-alives arrive every ~30s
+		public int streamFailuresBeforePolling = 3;
+		public float pollFallbackSeconds = 60f;
+		
+		[Header("Write Batching")]
+		public float writeFlushIntervalMs = 100f; // latency bound: no queued write waits longer than this
+		public int writeMaxBatchSize = 50;
+		
+		[Header("Outbox")]
+		public bool useDurableOutbox = true;
+		public int maxRetries = 3; // failures before callers are told; the write itself stays queued
+		public int outboxBatchSize = 200;
+		
+		[Header("Room Snapshots")]
+		public bool persistRoomSnapshots = true;
+		public long highWaterMarkSlackMs = 5000; // overlap with the last resync, for writes committed out of server-time order
+		
+		[Header("Interest Management")]
+		public bool useSpatialCells = true; // anchors live under rooms/<id>/cells/<cell>/anchors
+		public float cellSize = 8f;
+		public float interestRadius = 16f;
+		public float interestHysteresis = 2f; // a cell is dropped only this far beyond the radius
+		
+		[Header("Operation Log")]
+		public bool useOpLog = true; // sync rooms as an op log plus compacted snapshot (RoomState CRDT) instead of anchor nodes
+		public int opLogCompactAfterOps = 200;
+		public long opLogSlackMs = 2000; // tail reads overlap the snapshot by this much server time
+		public float tombstoneRetentionDays = 30f;
+		
+		[Header("Clock Sync")]
+		public bool syncServerClock = true; // estimates ServerClock so peers share one time base
+		public int clockProbeBurst = 4; // probes on start, half a second apart, to fill the filter window
+		public float clockProbeIntervalSeconds = 30f;
 		
 		public bool IsInitialized { get; private set; }
-		private readonly Dictionary<string, HashSet<string>> roomSeenAnchors = new Dictionary<string, HashSet<string>>();
-		private readonly Dictionary<string, Coroutine> roomPollCoroutines = new Dictionary<string, Coroutine>();
+		public ClockSync ServerClock { get; } = new ClockSync();
+		public AnchorWriteMetrics WriteMetrics => writeQueue.Metrics;
+		public RestMetrics HttpMetrics => rest != null ? rest.Metrics : default;
+		private readonly Dictionary<string, RoomAnchorSnapshot> roomSnapshots = new Dictionary<string, RoomAnchorSnapshot>();
+		private readonly Dictionary<string, RoomSubscription> roomSubscriptions = new Dictionary<string, RoomSubscription>();
+		private readonly Dictionary<string, SpatialInterest> roomInterests = new Dictionary<string, SpatialInterest>();
+		private readonly Dictionary<string, string> anchorCells = new Dictionary<string, string>(); // "roomId/anchorId" -> cell last written or evicted
+		private readonly List<string> enteredCells = new List<string>();
+		private readonly List<string> exitedCells = new List<string>();
+		private readonly List<string> subscriptionKeys = new List<string>();
 		private string baseUrl;
+		private readonly JsonIndex anchorsJson = new JsonIndex();
+		private readonly AnchorCodec anchorCodec = new AnchorCodec();
+		private readonly AnchorCodec snapshotCodec = new AnchorCodec(); // origin-independent, for files on this device
+		private byte[] snapshotBuffer;
+		private Task snapshotSaveTask = Task.CompletedTask;
+		private readonly AnchorWriteQueue writeQueue = new AnchorWriteQueue();
+		private List<PendingAnchorWrite> nextWriteBatch = new List<PendingAnchorWrite>();
+		private DurableOutbox outbox;
+		private readonly List<OutboxEntry> readyEntries = new List<OutboxEntry>();
+		private readonly Dictionary<string, List<Action<bool>>> outboxCallbacks = new Dictionary<string, List<Action<bool>>>();
+		private readonly Dictionary<string, RoomOpLog> opLogs = new Dictionary<string, RoomOpLog>();
+		// A deleted anchor is overwritten rather than removed, so resyncs from a high-water mark see the deletion
+		private const string AnchorTombstone = "{\"deleted\":true,\"at\":{\".sv\":\"timestamp\"}}";
+		private HybridClock hybridClock; // runs on ServerClock, so op stamps and tombstone ages share the server's time base
+		private readonly string replicaId = Guid.NewGuid().ToString("N");
+		private RestClient rest;
+		private Coroutine clockCoroutine;
 		
 		public void Initialize()
 		{
 			baseUrl = BuildBaseUrl();
+			rest?.Dispose();
+			rest = new RestClient(maxConnectionsPerHost);
+			if (hybridClock == null) hybridClock = new HybridClock(() => ServerClock.ReferenceNow);
+			OpenOutbox();
+			if (clockCoroutine != null) StopCoroutine(clockCoroutine);
+			clockCoroutine = syncServerClock ? StartCoroutine(SyncServerClock()) : null;
 			IsInitialized = true;
 			Debug.Log($"FirebaseService: Initialized (REST) baseUrl={baseUrl}");
 		}
@@ -35,21 +106,227 @@ namespace ARLinguaSphere.Network
 		public void SetRoomAnchor(string roomId, AnchorData anchorData, Action<bool> onComplete = null)
 		{
 			if (!IsInitialized) { onComplete?.Invoke(false); return; }
-			StartCoroutine(PutJson($"{baseUrl}/rooms/{roomId}/anchors/{anchorData.id}.json", anchorData, onComplete));
+			string cell = useSpatialCells ? SpatialInterest.CellOf(anchorData.position, anchorCodec.RoomOrigin, cellSize) : null;
+			
+			// An anchor that moved into another cell is deleted from the cell it was cached under, or, when that
+			// cell's snapshot is no longer loaded, from the cell it was last written to or evicted from
+			foreach (var snapshot in roomSnapshots.Values)
+			{
+				if (snapshot.RoomId == roomId && snapshot.Cell != cell && snapshot.Contains(anchorData.id))
+				{
+					DeleteFromCell(roomId, snapshot.Cell, anchorData.id);
+					snapshot.Remove(anchorData.id);
+				}
+			}
+			string anchorKey = roomId + "/" + anchorData.id;
+			if (anchorCells.TryGetValue(anchorKey, out var previousCell) && previousCell != cell
+				&& !roomSnapshots.ContainsKey(SubscriptionKey(roomId, previousCell)))
+			{
+				DeleteFromCell(roomId, previousCell, anchorData.id);
+			}
+			if (cell != null) anchorCells[anchorKey] = cell;
+			if (useOpLog)
+			{
+				// Applied locally at once; the server echo merges as a no-op
+				AppendOp(roomId, cell, GetOpLog(roomId, cell).Upsert(anchorData), onComplete);
+				if (roomSnapshots.TryGetValue(SubscriptionKey(roomId, cell), out var mirror)) mirror.Add(anchorData);
+				return;
+			}
+			EnqueueWrite(roomId, AnchorPath(cell, anchorData.id), SerializeAnchor(anchorData), onComplete);
+		}
+		
+		/// <summary>
+		/// Replays the local snapshot of the room, then listens for anchors at or after its high-water mark
+		/// (or, with useOpLog, loads the server snapshot and follows the op log from there).
+		/// </summary>
+		public void ListenRoomAnchors(string roomId, Action<AnchorData> onAnchor, Action<AnchorData> onRemove = null)
+		{
+			if (!IsInitialized) return;
+			Subscribe(roomId, null, onAnchor, onRemove);
 		}
 		
-		public void ListenRoomAnchors(string roomId, Action<AnchorData> onAnchor)
+		/// <summary>
+		/// Subscribes to the grid cells within interestRadius of <paramref name="position"/> and unsubscribes from cells
+		/// left behind. Anchors of a dropped cell are passed to <paramref name="onEvict"/>. Call as the user moves.
+		/// </summary>
+		public void UpdateRoomInterest(string roomId, Vector3 position, Action<AnchorData> onAnchor, Action<AnchorData> onEvict,
+			Action<AnchorData> onRemove = null)
 		{
 			if (!IsInitialized) return;
-			if (!roomSeenAnchors.ContainsKey(roomId)) roomSeenAnchors[roomId] = new HashSet<string>();
-			if (roomPollCoroutines.ContainsKey(roomId)) return;
-			roomPollCoroutines[roomId] = StartCoroutine(PollAnchors(roomId, onAnchor));
+			if (!roomInterests.TryGetValue(roomId, out var interest))
+			{
+				interest = new SpatialInterest(cellSize, interestRadius, interestHysteresis) { Origin = anchorCodec.RoomOrigin };
+				roomInterests[roomId] = interest;
+			}
+			interest.Radius = interestRadius;
+			interest.Hysteresis = interestHysteresis;
+			
+			enteredCells.Clear();
+			exitedCells.Clear();
+			if (!interest.Update(position, enteredCells, exitedCells)) return;
+			foreach (var cell in exitedCells)
+			{
+				EvictCell(roomId, cell, onEvict);
+			}
+			foreach (var cell in enteredCells)
+			{
+				Subscribe(roomId, cell, onAnchor, onRemove);
+			}
+			Debug.Log($"FirebaseService: Room '{roomId}' interest +{enteredCells.Count}/-{exitedCells.Count} cells ({interest.Count} subscribed)");
+		}
+		
+		/// <summary>
+		/// Stops the room's listener and every cell subscription; snapshots are saved so a rejoin only fetches the delta.
+		/// </summary>
+		public void StopListeningRoomAnchors(string roomId)
+		{
+			if (roomId == null) return;
+			roomInterests.Remove(roomId);
+			subscriptionKeys.Clear();
+			foreach (var key in roomSubscriptions.Keys)
+			{
+				if (key == roomId || key.StartsWith(roomId + "/", StringComparison.Ordinal)) subscriptionKeys.Add(key);
+			}
+			foreach (var key in subscriptionKeys)
+			{
+				Unsubscribe(key);
+			}
+		}
+		
+		/// <summary>
+		/// Positions on the wire are quantised relative to this point; every peer in a room must use the same origin.
+		/// </summary>
+		public void SetRoomOrigin(Vector3 origin)
+		{
+			anchorCodec.RoomOrigin = origin;
+			foreach (var interest in roomInterests.Values)
+			{
+				interest.Origin = origin;
+			}
 		}
 		
 		public void RemoveRoomAnchor(string roomId, string anchorId, Action<bool> onComplete = null)
 		{
 			if (!IsInitialized) { onComplete?.Invoke(false); return; }
-			StartCoroutine(Delete($"{baseUrl}/rooms/{roomId}/anchors/{anchorId}.json", onComplete));
+			anchorCells.TryGetValue(roomId + "/" + anchorId, out var cell);
+			foreach (var snapshot in roomSnapshots.Values)
+			{
+				if (snapshot.RoomId == roomId && snapshot.Cell != null && snapshot.Contains(anchorId))
+				{
+					cell = snapshot.Cell;
+					break;
+				}
+			}
+			anchorCells.Remove(roomId + "/" + anchorId);
+			if (!useOpLog)
+			{
+				EnqueueWrite(roomId, AnchorPath(cell, anchorId), AnchorTombstone, onComplete);
+				return;
+			}
+			// A remove is an op too: it leaves a tombstone that outranks older concurrent upserts
+			AppendOp(roomId, cell, GetOpLog(roomId, cell).Remove(anchorId), onComplete);
+			if (roomSnapshots.TryGetValue(SubscriptionKey(roomId, cell), out var mirror)) mirror.Remove(anchorId);
+		}
+		
+		private void DeleteFromCell(string roomId, string cell, string anchorId)
+		{
+			if (!useOpLog)
+			{
+				EnqueueWrite(roomId, AnchorPath(cell, anchorId), AnchorTombstone, null);
+				return;
+			}
+			string key = SubscriptionKey(roomId, cell);
+			bool loaded = opLogs.ContainsKey(key);
+			AppendOp(roomId, cell, GetOpLog(roomId, cell).Remove(anchorId), null);
+			if (!loaded) opLogs.Remove(key); // a tombstone for a cell this device no longer follows
+		}
+		
+		private void Subscribe(string roomId, string cell, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
+		{
+			string key = SubscriptionKey(roomId, cell);
+			if (roomSubscriptions.ContainsKey(key)) return;
+			var snapshot = GetRoomSnapshot(roomId, cell);
+			foreach (var anchor in snapshot.Anchors)
+			{
+				onAnchor?.Invoke(anchor);
+			}
+			var subscription = new RoomSubscription();
+			roomSubscriptions[key] = subscription;
+			subscription.coroutine = StartCoroutine(useOpLog
+				? ListenOpLog(subscription, snapshot, onAnchor, onRemove)
+				: ListenAnchors(subscription, snapshot, onAnchor, onRemove));
+		}
+		
+		/// <summary>
+		/// Stops the listener and closes its event stream. A stopped coroutine is never disposed, so the stream it
+		/// holds is closed here rather than by the coroutine.
+		/// </summary>
+		private void Unsubscribe(string key)
+		{
+			if (!roomSubscriptions.TryGetValue(key, out var subscription)) return;
+			StopCoroutine(subscription.coroutine);
+			subscription.Close();
+			roomSubscriptions.Remove(key);
+			SaveRoomSnapshot(key);
+		}
+		
+		/// <summary>
+		/// Stop listening to a cell that left the interest set; its snapshot is saved and released from memory.
+		/// </summary>
+		private void EvictCell(string roomId, string cell, Action<AnchorData> onEvict)
+		{
+			string key = SubscriptionKey(roomId, cell);
+			Unsubscribe(key);
+			opLogs.Remove(key);
+			if (!roomSnapshots.TryGetValue(key, out var snapshot)) return;
+			roomSnapshots.Remove(key);
+			foreach (var anchor in snapshot.Anchors)
+			{
+				anchorCells[roomId + "/" + anchor.id] = cell;
+				onEvict?.Invoke(anchor);
+			}
+		}
+		
+		private static string SubscriptionKey(string roomId, string cell)
+		{
+			return cell == null ? roomId : roomId + "/" + cell;
+		}
+		
+		/// <summary>
+		/// Prefix of a subscription's data relative to rooms/{roomId}: "" for the whole room, "cells/{cell}/" per cell
+		/// </summary>
+		private static string SubscriptionPath(string cell)
+		{
+			return cell == null ? "" : "cells/" + cell + "/";
+		}
+		
+		/// <summary>
+		/// Anchor location relative to rooms/{roomId}
+		/// </summary>
+		private static string AnchorPath(string cell, string anchorId)
+		{
+			return SubscriptionPath(cell) + "anchors/" + anchorId;
+		}
+		
+		private RoomOpLog GetOpLog(string roomId, string cell)
+		{
+			string key = SubscriptionKey(roomId, cell);
+			if (opLogs.TryGetValue(key, out var log)) return log;
+			// Jittered threshold so replicas that see the same ops rarely compact at the same moment
+			int threshold = Mathf.Max(1, opLogCompactAfterOps);
+			log = new RoomOpLog(replicaId, hybridClock) { CompactAfterOps = threshold + UnityEngine.Random.Range(0, threshold / 4 + 1) };
+			opLogs[key] = log;
+			return log;
+		}
+		
+		/// <summary>
+		/// Appends an op at {path}ops/{opKey}; "at" is filled in with server time, which orders the log for tail reads.
+		/// </summary>
+		private void AppendOp(string roomId, string cell, RoomOp op, Action<bool> onComplete)
+		{
+			string data = Convert.ToBase64String(RoomOp.Encode(op, anchorCodec));
+			string json = "{\"data\":\"" + data + "\",\"at\":{\".sv\":\"timestamp\"}}";
+			EnqueueWrite(roomId, SubscriptionPath(cell) + "ops/" + RoomOpLog.OpKey(op), json, onComplete);
 		}
 
 		private string BuildBaseUrl()
@@ -61,101 +338,542 @@ namespace ARLinguaSphere.Network
 			return databaseUrl.TrimEnd('/');
 		}
 
-		private IEnumerator PutJson(string url, AnchorData data, Action<bool> onComplete)
-		{
-			string json = SerializeAnchor(data);
-			var request = new UnityWebRequest(url, UnityWebRequest.kHttpVerbPUT);
-			byte[] bodyRaw = System.Text.Encoding.UTF8.GetBytes(json);
-			request.uploadHandler = new UploadHandlerRaw(bodyRaw);
-			request.downloadHandler = new DownloadHandlerBuffer();
-			request.SetRequestHeader("Content-Type", "application/json");
-			yield return request.SendWebRequest();
-			bool ok = request.result == UnityWebRequest.Result.Success;
-			if (!ok) Debug.LogWarning($"FirebaseService: PUT failed {request.responseCode} {request.error}");
-			onComplete?.Invoke(ok);
+		/// <summary>
+		/// Make queued writes that are backing off eligible again, e.g. after reconnecting.
+		/// </summary>
+		public void RetryPendingWrites()
+		{
+			outbox?.RetryNow();
 		}
-
-		private IEnumerator Delete(string url, Action<bool> onComplete)
+		
+		private void OpenOutbox()
+		{
+			if (!useDurableOutbox || outbox != null) return;
+			try
+			{
+				outbox = DurableOutbox.Open(Path.Combine(Application.persistentDataPath, "outbox", "anchors.log"), maxRetries);
+				if (outbox.Count > 0) Debug.Log($"FirebaseService: Resuming {outbox.Count} pending anchor writes");
+			}
+			catch (Exception e)
+			{
+				Debug.LogWarning($"FirebaseService: Outbox unavailable, writes will not survive restarts: {e.Message}");
+				outbox = null;
+			}
+		}
+		
+		private void EnqueueWrite(string roomId, string path, string json, Action<bool> onComplete)
 		{
-			var request = UnityWebRequest.Delete(url);
-			yield return request.SendWebRequest();
-			bool ok = request.result == UnityWebRequest.Result.Success;
-			if (!ok) Debug.LogWarning($"FirebaseService: DELETE failed {request.responseCode} {request.error}");
-			onComplete?.Invoke(ok);
+			if (outbox == null)
+			{
+				writeQueue.Enqueue(roomId, path, json, Time.realtimeSinceStartup, onComplete);
+				return;
+			}
+			
+			// Key is "roomId/path"; a newer write to the same path supersedes the pending one
+			string key = roomId + "/" + path;
+			outbox.Enqueue(key, json);
+			if (onComplete == null) return;
+			if (!outboxCallbacks.TryGetValue(key, out var callbacks))
+			{
+				callbacks = new List<Action<bool>>();
+				outboxCallbacks[key] = callbacks;
+			}
+			callbacks.Add(onComplete);
+		}
+		
+		private void DrainOutbox()
+		{
+			readyEntries.Clear();
+			float now = Time.realtimeSinceStartup;
+			outbox.TakeReady(now, outboxBatchSize, readyEntries);
+			foreach (var entry in readyEntries)
+			{
+				int slash = entry.key.IndexOf('/');
+				string path = entry.key.Substring(slash + 1);
+				if (path.IndexOf('/') < 0) path = AnchorPath(null, path); // "roomId/anchorId" keys queued by older builds
+				var sent = entry;
+				writeQueue.Enqueue(entry.key.Substring(0, slash), path, entry.payload, now,
+					ok => OnOutboxWriteCompleted(sent, ok));
+			}
+		}
+		
+		private void OnOutboxWriteCompleted(OutboxEntry entry, bool success)
+		{
+			if (success)
+			{
+				if (outbox.Ack(entry)) InvokeOutboxCallbacks(entry.key, true);
+			}
+			else if (outbox.Fail(entry, Time.realtimeSinceStartup))
+			{
+				Debug.LogWarning($"FirebaseService: Write '{entry.key}' failed {maxRetries} times; still queued for retry");
+				InvokeOutboxCallbacks(entry.key, false);
+			}
+		}
+		
+		private void InvokeOutboxCallbacks(string key, bool success)
+		{
+			if (!outboxCallbacks.TryGetValue(key, out var callbacks)) return;
+			outboxCallbacks.Remove(key);
+			foreach (var callback in callbacks)
+			{
+				callback(success);
+			}
+		}
+		
+		private void Update()
+		{
+			if (!IsInitialized) return;
+			if (outbox != null && outbox.Count > 0) DrainOutbox();
+			if (writeQueue.PendingCount == 0) return;
+			writeQueue.MaxBatchSize = Mathf.Max(1, writeMaxBatchSize);
+			writeQueue.FlushInterval = writeFlushIntervalMs / 1000f;
+			string roomId;
+			while ((roomId = writeQueue.TakeDueBatch(Time.realtimeSinceStartup, nextWriteBatch)) != null)
+			{
+				StartCoroutine(PatchRoom(roomId, nextWriteBatch));
+				nextWriteBatch = new List<PendingAnchorWrite>();
+			}
+		}
+		
+		/// <summary>
+		/// Writes a server timestamp to clocks/&lt;replica&gt; and reads the resolved value back from the response: one
+		/// NTP-style exchange for ServerClock. The first probe pays for the connection handshake; the filter prefers the
+		/// faster ones that follow on the kept-alive connection.
+		/// </summary>
+		private IEnumerator SyncServerClock()
+		{
+			string url = $"{baseUrl}/clocks/{replicaId}.json";
+			for (int probes = 1; ; probes++)
+			{
+				long sent = ServerClock.LocalNow;
+				var probe = new RestRequest("PUT", url, "{\".sv\":\"timestamp\"}");
+				yield return rest.Send(probe);
+				long received = ServerClock.LocalNow;
+				if (probe.Success && long.TryParse(probe.Text, System.Globalization.NumberStyles.Integer, System.Globalization.CultureInfo.InvariantCulture, out long server))
+				{
+					ServerClock.AddSample(sent, server, received);
+				}
+				yield return new WaitForSeconds(probes < clockProbeBurst ? 0.5f : clockProbeIntervalSeconds);
+			}
+		}
+		
+		/// <summary>
+		/// One multi-path update carrying every coalesced write in the batch
+		/// </summary>
+		private IEnumerator PatchRoom(string roomId, List<PendingAnchorWrite> batch)
+		{
+			var request = new RestRequest("PATCH", $"{baseUrl}/rooms/{roomId}.json", AnchorWriteQueue.BuildPatchBody(batch));
+			yield return rest.Send(request);
+			if (!request.Success) Debug.LogWarning($"FirebaseService: PATCH of {batch.Count} writes failed {request.StatusCode} {request.Error}");
+			writeQueue.Complete(roomId, batch, request.Success);
 		}
 
-		private IEnumerator PollAnchors(string roomId, Action<AnchorData> onAnchor)
+		private IEnumerator ListenAnchors(RoomSubscription subscription, RoomAnchorSnapshot snapshot, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
+		{
+			return StreamChildren(subscription, () => BuildAnchorsQueryUrl(snapshot),
+				(id, node) => DeliverAnchor(snapshot, id, node, onAnchor, onRemove),
+				id => RemoveAnchor(snapshot, id, onRemove));
+		}
+		
+		/// <summary>
+		/// Loads the subscription's compacted snapshot, then streams ops appended since it was taken.
+		/// </summary>
+		private IEnumerator ListenOpLog(RoomSubscription subscription, RoomAnchorSnapshot mirror, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
 		{
+			var log = GetOpLog(mirror.RoomId, mirror.Cell);
+			string path = $"{baseUrl}/rooms/{mirror.RoomId}/{SubscriptionPath(mirror.Cell)}";
+			var request = new RestRequest("GET", path + "snapshot.json");
+			yield return rest.Send(request);
+			if (request.Success)
+			{
+				LoadServerSnapshot(log, mirror, request.Text, onAnchor, onRemove);
+			}
+			else
+			{
+				Debug.LogWarning($"FirebaseService: Room snapshot unavailable ({request.Error}), reading the whole op log");
+			}
+			yield return StreamChildren(subscription, () => BuildOpsQueryUrl(path, log),
+				(key, node) => DeliverOp(log, mirror, key, node, onAnchor, onRemove),
+				null); // pruned ops are already folded into the snapshot
+		}
+		
+		/// <summary>
+		/// Streams child changes, reconnecting with backoff. After repeated stream failures it polls for a while,
+		/// then tries streaming again. The open stream is kept on <paramref name="subscription"/> so Unsubscribe can close it.
+		/// </summary>
+		private IEnumerator StreamChildren(RoomSubscription subscription, Func<string> buildUrl, Action<string, JsonNode> onChild, Action<string> onRemoved)
+		{
+			var stream = new AnchorEventStream(onChild, onRemoved);
+			var buffer = new byte[16 * 1024];
+			int failures = 0;
+			float backoff = streamReconnectSeconds;
+			
 			while (true)
 			{
-				string url = $"{baseUrl}/rooms/{roomId}/anchors.json";
-				var request = UnityWebRequest.Get(url);
-				yield return request.SendWebRequest();
-				if (request.result == UnityWebRequest.Result.Success)
+				if (!useEventStream || failures >= streamFailuresBeforePolling)
+				{
+					if (useEventStream) Debug.LogWarning($"FirebaseService: Anchor stream unavailable, polling for {pollFallbackSeconds}s");
+					float resumeStreamingAt = Time.realtimeSinceStartup + pollFallbackSeconds;
+					while (!useEventStream || Time.realtimeSinceStartup < resumeStreamingAt)
+					{
+						yield return PollChildrenOnce(buildUrl(), onChild);
+						yield return new WaitForSeconds(pollIntervalSeconds);
+					}
+					failures = 0;
+					backoff = streamReconnectSeconds;
+				}
+				
+				stream.Reset();
+				var request = rest.OpenStream(buildUrl(), stream.LastEventId);
+				subscription.stream = request;
+				long lastBytes = 0;
+				float lastActivity = Time.realtimeSinceStartup;
+				while (!stream.IsClosed)
+				{
+					// Events are parsed here on the main thread; the connection only buffers bytes
+					bool done = request.IsDone;
+					int read;
+					while (!stream.IsClosed && (read = request.Read(buffer, 0, buffer.Length)) > 0)
+					{
+						stream.Feed(buffer, 0, read);
+					}
+					if (done) break;
+					if (stream.BytesReceived != lastBytes)
+					{
+						lastBytes = stream.BytesReceived;
+						lastActivity = Time.realtimeSinceStartup;
+					}
+					else if (Time.realtimeSinceStartup - lastActivity > streamIdleTimeoutSeconds)
+					{
+						Debug.LogWarning("FirebaseService: Anchor stream idle, reconnecting");
+						break;
+					}
+					yield return null;
+				}
+				if (stream.IsClosed) Debug.LogWarning($"FirebaseService: Anchor stream closed by server ({stream.CloseReason})");
+				else if (request.IsDone && request.Error != null)
+				{
+					Debug.LogWarning($"FirebaseService: Anchor stream failed {request.StatusCode} {request.Error}");
+				}
+				subscription.Close();
+				
+				// A connection that delivered events was healthy; only back off on repeated failures or cancels
+				if (stream.EventsReceived > 0 && !stream.IsClosed)
+				{
+					failures = 0;
+					backoff = streamReconnectSeconds;
+				}
+				else
+				{
+					failures++;
+				}
+				float wait = stream.RetryMilliseconds >= 0 ? Mathf.Max(backoff, stream.RetryMilliseconds / 1000f) : backoff;
+				backoff = Mathf.Min(backoff * 2f, streamMaxReconnectSeconds);
+				yield return new WaitForSeconds(wait * UnityEngine.Random.Range(0.8f, 1.2f));
+			}
+		}
+		
+		private IEnumerator PollChildrenOnce(string url, Action<string, JsonNode> onChild)
+		{
+			var request = new RestRequest("GET", url);
+			yield return rest.Send(request);
+			if (request.Success)
+			{
+				if (anchorsJson.Load(request.Text) && anchorsJson.Root.IsObject)
 				{
-					var json = request.downloadHandler.text;
-					var parsed = MiniJSON.Deserialize(json) as Dictionary<string, object>;
-					if (parsed != null)
+					var anchors = anchorsJson.Root.GetObject();
+					while (anchors.MoveNext())
 					{
-						var seen = roomSeenAnchors[roomId];
-						foreach (var kv in parsed)
-						{
-							string id = kv.Key;
-							if (!seen.Contains(id))
-							{
-								var anchor = DeserializeAnchor(id, kv.Value as Dictionary<string, object>);
-								if (anchor != null)
-								{
-									seen.Add(id);
-									onAnchor?.Invoke(anchor);
-								}
-							}
-						}
+						onChild(anchors.Key, anchors.Value);
 					}
 				}
-				yield return new WaitForSeconds(pollIntervalSeconds);
+				anchorsJson.Clear();
 			}
 		}
+		
+		private void DeliverAnchor(RoomAnchorSnapshot snapshot, string id, JsonNode node, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
+		{
+			if (node.TryGetField("at", out var at)) snapshot.Observe(at.GetInt64());
+			if (node.TryGetField("deleted", out _))
+			{
+				RemoveAnchor(snapshot, id, onRemove);
+				return;
+			}
+			// Already-seen versions are skipped without decoding their fields; a newer timestamp is a moved anchor
+			if (snapshot.TryGet(id, out var known) && (!node.TryGetField("timestamp", out var stamp) || stamp.GetInt64() <= known.timestamp)) return;
+			var anchor = DeserializeAnchor(id, node);
+			if (anchor == null) return;
+			snapshot.Add(anchor);
+			onAnchor?.Invoke(anchor);
+		}
+		
+		private static void RemoveAnchor(RoomAnchorSnapshot snapshot, string id, Action<AnchorData> onRemove)
+		{
+			if (!snapshot.TryGet(id, out var removed)) return;
+			snapshot.Remove(id);
+			onRemove?.Invoke(removed);
+		}
+		
+		private void LoadServerSnapshot(RoomOpLog log, RoomAnchorSnapshot mirror, string json, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
+		{
+			try
+			{
+				if (!anchorsJson.Load(json) || !anchorsJson.Root.IsObject) return; // "null": nothing compacted yet
+				var root = anchorsJson.Root;
+				if (!root.TryGetField("data", out var data)) return;
+				long through = root.TryGetField("through", out var throughNode) ? throughNode.GetInt64() : 0;
+				byte[] bytes = Convert.FromBase64String(data.GetString());
+				if (!log.LoadSnapshot(bytes, bytes.Length, through, anchorCodec, (op, change) => ReportChange(log, mirror, op, change, onAnchor, onRemove)))
+				{
+					Debug.LogWarning($"FirebaseService: Ignoring unreadable snapshot for '{SubscriptionKey(mirror.RoomId, mirror.Cell)}'");
+				}
+			}
+			catch (FormatException e)
+			{
+				Debug.LogWarning($"FirebaseService: Failed to parse room snapshot: {e.Message}");
+			}
+			finally
+			{
+				anchorsJson.Clear();
+			}
+		}
+		
+		private void DeliverOp(RoomOpLog log, RoomAnchorSnapshot mirror, string key, JsonNode node, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
+		{
+			if (!node.IsObject || !node.TryGetField("data", out var data)) return;
+			long appendedAt = node.TryGetField("at", out var at) ? at.GetInt64() : 0;
+			byte[] bytes;
+			try
+			{
+				bytes = Convert.FromBase64String(data.GetString());
+			}
+			catch (FormatException)
+			{
+				return;
+			}
+			if (!RoomOp.TryDecode(bytes, 0, bytes.Length, anchorCodec, out var op)) return;
+			ReportChange(log, mirror, op, log.ApplyRemote(key, appendedAt, op), onAnchor, onRemove);
+			if (log.ShouldCompact) CompactOpLog(mirror.RoomId, mirror.Cell, log);
+		}
+		
+		/// <summary>
+		/// Applies a merged op to the mirror and the app. The op log's state starts empty while the mirror's cached anchors
+		/// are already shown, so a remove (or snapshot tombstone) of a cached anchor the state never held still removes it.
+		/// </summary>
+		private static void ReportChange(RoomOpLog log, RoomAnchorSnapshot mirror, RoomOp op, RoomStateChange change, Action<AnchorData> onAnchor, Action<AnchorData> onRemove)
+		{
+			if (change == RoomStateChange.None && op.kind == RoomOpKind.Remove
+				&& mirror.Contains(op.anchorId) && !log.State.TryGetAnchor(op.anchorId, out _))
+			{
+				change = RoomStateChange.Removed;
+			}
+			if (change == RoomStateChange.Upserted)
+			{
+				mirror.Add(op.anchor);
+				onAnchor?.Invoke(op.anchor);
+			}
+			else if (change == RoomStateChange.Removed)
+			{
+				if (!mirror.TryGet(op.anchorId, out var removed)) removed = new AnchorData { id = op.anchorId };
+				mirror.Remove(op.anchorId);
+				onRemove?.Invoke(removed);
+			}
+		}
+		
+		/// <summary>
+		/// Folds the tail into a snapshot of the merged state. The snapshot write is conditional so a replica whose
+		/// stream lags never replaces one covering more of the log; only once it lands is the op generation folded
+		/// into the previous snapshot deleted.
+		/// </summary>
+		private void CompactOpLog(string roomId, string cell, RoomOpLog log)
+		{
+			long horizonMs = ServerClock.ReferenceNow - (long)(tombstoneRetentionDays * 86400000d);
+			log.State.PruneTombstones(horizonMs << HybridClock.CounterBits);
+			var prunable = new List<string>();
+			string data = Convert.ToBase64String(log.Compact(anchorCodec, prunable));
+			string body = "{\"data\":\"" + data + "\",\"through\":" + log.SnapshotThrough.ToString(System.Globalization.CultureInfo.InvariantCulture) + "}";
+			StartCoroutine(WriteSnapshot(roomId, cell, log.SnapshotThrough, body, prunable));
+		}
+		
+		private IEnumerator WriteSnapshot(string roomId, string cell, long through, string body, List<string> prunable)
+		{
+			string prefix = SubscriptionPath(cell);
+			string url = $"{baseUrl}/rooms/{roomId}/{prefix}snapshot.json";
+			var read = new RestRequest("GET", url);
+			read.SetRequestHeader("X-Firebase-ETag", "true");
+			yield return rest.Send(read);
+			if (!read.Success) yield break;
+			string etag = read.GetResponseHeader("ETag");
+			if (string.IsNullOrEmpty(etag) || ReadSnapshotThrough(read.Text) >= through) yield break;
+			
+			var write = new RestRequest("PUT", url, body);
+			write.SetRequestHeader("if-match", etag);
+			yield return rest.Send(write);
+			if (!write.Success)
+			{
+				// 412: another replica compacted first; its snapshot covers this one's ops or will after its next pass
+				if (write.StatusCode != 412) Debug.LogWarning($"FirebaseService: Snapshot write failed {write.StatusCode} {write.Error}");
+				yield break;
+			}
+			
+			foreach (var key in prunable)
+			{
+				EnqueueWrite(roomId, prefix + "ops/" + key, null, null);
+			}
+			Debug.Log($"FirebaseService: Compacted '{SubscriptionKey(roomId, cell)}' through {through}, pruned {prunable.Count} ops");
+		}
+		
+		private long ReadSnapshotThrough(string json)
+		{
+			try
+			{
+				if (!anchorsJson.Load(json) || !anchorsJson.Root.IsObject) return 0; // "null": nothing compacted yet
+				return anchorsJson.Root.TryGetField("through", out var through) ? through.GetInt64() : 0;
+			}
+			catch (FormatException)
+			{
+				return 0;
+			}
+			finally
+			{
+				anchorsJson.Clear();
+			}
+		}
+		
+		/// <summary>
+		/// Ops appended since the loaded snapshot (needs ".indexOn": "at"); the whole log if none was loaded.
+		/// </summary>
+		private string BuildOpsQueryUrl(string path, RoomOpLog log)
+		{
+			if (log.SnapshotThrough <= 0) return path + "ops.json";
+			long startAt = Math.Max(0L, log.SnapshotThrough - opLogSlackMs);
+			return $"{path}ops.json?orderBy=%22at%22&startAt={startAt}";
+		}
+		
+		/// <summary>
+		/// Whole room (or cell) on first sync; afterwards only writes and tombstones from the high-water mark on (needs ".indexOn": "at").
+		/// </summary>
+		private string BuildAnchorsQueryUrl(RoomAnchorSnapshot snapshot)
+		{
+			string url = snapshot.Cell == null
+				? $"{baseUrl}/rooms/{snapshot.RoomId}/anchors.json"
+				: $"{baseUrl}/rooms/{snapshot.RoomId}/cells/{snapshot.Cell}/anchors.json";
+			if (snapshot.HighWaterMark <= 0) return url;
+			return $"{url}?orderBy=%22at%22&startAt={snapshot.QueryStart(highWaterMarkSlackMs)}";
+		}
+		
+		private RoomAnchorSnapshot GetRoomSnapshot(string roomId, string cell)
+		{
+			string key = SubscriptionKey(roomId, cell);
+			if (roomSnapshots.TryGetValue(key, out var snapshot)) return snapshot;
+			snapshot = LoadRoomSnapshot(roomId, cell);
+			roomSnapshots[key] = snapshot;
+			return snapshot;
+		}
+		
+		/// <summary>
+		/// rooms/&lt;roomId&gt;.anchors for the whole room, rooms/&lt;roomId&gt;/&lt;cell&gt;.anchors per cell
+		/// </summary>
+		private string RoomSnapshotPath(string roomId, string cell)
+		{
+			foreach (char c in Path.GetInvalidFileNameChars())
+			{
+				roomId = roomId.Replace(c, '_');
+			}
+			string rooms = Path.Combine(Application.persistentDataPath, "rooms");
+			return cell == null ? Path.Combine(rooms, roomId + ".anchors") : Path.Combine(rooms, roomId, cell + ".anchors");
+		}
+		
+		private RoomAnchorSnapshot LoadRoomSnapshot(string roomId, string cell)
+		{
+			string path = RoomSnapshotPath(roomId, cell);
+			if (!persistRoomSnapshots || !File.Exists(path)) return new RoomAnchorSnapshot(roomId, cell);
+			try
+			{
+				byte[] data = File.ReadAllBytes(path);
+				var snapshot = RoomAnchorSnapshot.Decode(roomId, cell, data, data.Length, snapshotCodec);
+				Debug.Log($"FirebaseService: Loaded {snapshot.Count} cached anchors for room '{SubscriptionKey(roomId, cell)}'");
+				return snapshot;
+			}
+			catch (Exception e)
+			{
+				Debug.LogWarning($"FirebaseService: Failed to load room snapshot: {e.Message}");
+				return new RoomAnchorSnapshot(roomId, cell);
+			}
+		}
+		
+		private void SaveRoomSnapshot(string key)
+		{
+			if (!persistRoomSnapshots || !roomSnapshots.TryGetValue(key, out var snapshot) || !snapshot.IsDirty) return;
+			int length = snapshot.Encode(snapshotCodec, ref snapshotBuffer);
+			var data = new byte[length];
+			Buffer.BlockCopy(snapshotBuffer, 0, data, 0, length);
+			string path = RoomSnapshotPath(snapshot.RoomId, snapshot.Cell);
+			snapshot.MarkSaved();
+			
+			// Chained so two saves never race on the temp file
+			snapshotSaveTask = snapshotSaveTask.ContinueWith(_ =>
+			{
+				Directory.CreateDirectory(Path.GetDirectoryName(path));
+				string tempPath = path + ".tmp";
+				File.WriteAllBytes(tempPath, data);
+				if (File.Exists(path)) File.Delete(path);
+				File.Move(tempPath, path);
+			}, TaskScheduler.Default);
+			snapshotSaveTask.ContinueWith(t => Debug.LogWarning($"FirebaseService: Failed to save room snapshot: {t.Exception?.GetBaseException().Message}"),
+				TaskContinuationOptions.OnlyOnFaulted);
+		}
+		
+		private void OnApplicationPause(bool paused)
+		{
+			if (!paused) return;
+			foreach (var key in roomSnapshots.Keys)
+			{
+				SaveRoomSnapshot(key);
+			}
+		}
+		
+		private void OnDestroy()
+		{
+			OnApplicationPause(true);
+			foreach (var subscription in roomSubscriptions.Values)
+			{
+				subscription.Close();
+			}
+			outbox?.Dispose();
+			rest?.Dispose();
+		}
 
 		private string SerializeAnchor(AnchorData a)
 		{
-			// Minimal manual JSON to avoid extra deps
-			return "{" +
-				$"\"id\":\"{a.id}\"," +
-				$"\"labelKey\":\"{a.labelKey}\"," +
-				$"\"creatorId\":\"{a.creatorId}\"," +
-				$"\"timestamp\":{a.timestamp}," +
-				$"\"position\":{{\"x\":{a.position.x},\"y\":{a.position.y},\"z\":{a.position.z}}}," +
-				$"\"rotation\":{{\"x\":{a.rotation.x},\"y\":{a.rotation.y},\"z\":{a.rotation.z},\"w\":{a.rotation.w}}}" +
-			"}";
+			// Binary record as base64. timestamp stays a plain child for conflict checks; "at" is the server's write
+			// time, which incremental queries order and filter on.
+			string data = anchorCodec.EncodeBase64(a);
+			return "{\"data\":\"" + data + "\",\"timestamp\":" + a.timestamp.ToString(System.Globalization.CultureInfo.InvariantCulture)
+				+ ",\"at\":{\".sv\":\"timestamp\"}}";
 		}
 
-		private AnchorData DeserializeAnchor(string id, Dictionary<string, object> map)
+		private AnchorData DeserializeAnchor(string id, JsonNode node)
 		{
-			if (map == null) return null;
+			if (!node.IsObject) return null;
 			try
 			{
 				var a = new AnchorData();
 				a.id = id;
-				a.labelKey = map.ContainsKey("labelKey") ? map["labelKey"].ToString() : null;
-				a.creatorId = map.ContainsKey("creatorId") ? map["creatorId"].ToString() : null;
-				if (map.ContainsKey("timestamp")) a.timestamp = Convert.ToInt64(map["timestamp"]);
-				if (map.ContainsKey("position"))
+				if (node.TryGetField("data", out var data))
 				{
-					var p = map["position"] as Dictionary<string, object>;
-					a.position = new Vector3(
-						Convert.ToSingle(p["x"]),
-						Convert.ToSingle(p["y"]),
-						Convert.ToSingle(p["z"]) );
+					return anchorCodec.TryDecodeBase64(data.GetString(), a) ? a : null;
 				}
-				if (map.ContainsKey("rotation"))
+				
+				// Legacy JSON anchors written before the binary format
+				var fields = node.GetObject();
+				while (fields.MoveNext())
 				{
-					var r = map["rotation"] as Dictionary<string, object>;
-					a.rotation = new Quaternion(
-						Convert.ToSingle(r["x"]),
-						Convert.ToSingle(r["y"]),
-						Convert.ToSingle(r["z"]),
-						Convert.ToSingle(r["w"]) );
+					if (fields.KeyEquals("labelKey")) a.labelKey = fields.Value.GetString();
+					else if (fields.KeyEquals("creatorId")) a.creatorId = fields.Value.GetString();
+					else if (fields.KeyEquals("timestamp")) a.timestamp = fields.Value.GetInt64();
+					else if (fields.KeyEquals("position")) a.position = ReadVector3(fields.Value);
+					else if (fields.KeyEquals("rotation")) a.rotation = ReadQuaternion(fields.Value);
 				}
 				return a;
 			}
@@ -165,6 +883,48 @@ namespace ARLinguaSphere.Network
 				return null;
 			}
 		}
+
+		private static Vector3 ReadVector3(JsonNode node)
+		{
+			var v = Vector3.zero;
+			var fields = node.GetObject();
+			while (fields.MoveNext())
+			{
+				if (fields.KeyEquals("x")) v.x = fields.Value.GetSingle();
+				else if (fields.KeyEquals("y")) v.y = fields.Value.GetSingle();
+				else if (fields.KeyEquals("z")) v.z = fields.Value.GetSingle();
+			}
+			return v;
+		}
+
+		private static Quaternion ReadQuaternion(JsonNode node)
+		{
+			var q = Quaternion.identity;
+			var fields = node.GetObject();
+			while (fields.MoveNext())
+			{
+				if (fields.KeyEquals("x")) q.x = fields.Value.GetSingle();
+				else if (fields.KeyEquals("y")) q.y = fields.Value.GetSingle();
+				else if (fields.KeyEquals("z")) q.z = fields.Value.GetSingle();
+				else if (fields.KeyEquals("w")) q.w = fields.Value.GetSingle();
+			}
+			return q;
+		}
+		
+		/// <summary>
+		/// A room or cell listener and the event stream it currently has open
+		/// </summary>
+		private sealed class RoomSubscription
+		{
+			public Coroutine coroutine;
+			public RestStream stream;
+			
+			public void Close()
+			{
+				stream?.Dispose();
+				stream = null;
+			}
+		}
 	}
 }
 
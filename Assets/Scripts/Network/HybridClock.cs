@@ -0,0 +1,53 @@
+using System;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Hybrid logical clock: Unix milliseconds in the high 48 bits and a counter in the low 16.
+    /// Timestamps stay close to wall time but never go backwards and always exceed every remote timestamp observed,
+    /// so causally later edits order after earlier ones even between devices whose clocks disagree. Remote timestamps more
+    /// than MaxDriftMs ahead of the wall clock are not followed, so one replica with a skewed clock cannot drag every
+    /// other replica's clock ahead with it.
+    /// </summary>
+    public sealed class HybridClock
+    {
+        public const int CounterBits = 16;
+
+        public long Last => last;
+        public long MaxDriftMs { get; set; } = 60000;
+
+        private readonly Func<long> wallClock;
+        private long last;
+
+        public HybridClock(Func<long> wallClock = null)
+        {
+            this.wallClock = wallClock ?? (() => DateTimeOffset.UtcNow.ToUnixTimeMilliseconds());
+        }
+
+        /// <summary>
+        /// Timestamp for a local event.
+        /// </summary>
+        public long Now()
+        {
+            long physical = wallClock() << CounterBits;
+            last = physical > last ? physical : last + 1;
+            return last;
+        }
+
+        /// <summary>
+        /// Fold in a timestamp received from another replica. Returns false, leaving the clock alone, when it is more
+        /// than MaxDriftMs ahead of the wall clock.
+        /// </summary>
+        public bool Observe(long remote)
+        {
+            if (ToUnixMilliseconds(remote) - wallClock() > MaxDriftMs) return false;
+            if (remote > last) last = remote;
+            return true;
+        }
+
+        public static long ToUnixMilliseconds(long timestamp)
+        {
+            return timestamp >> CounterBits;
+        }
+    }
+}
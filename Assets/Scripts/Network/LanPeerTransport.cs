@@ -0,0 +1,415 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+using UnityEngine;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Local-network transport between co-located peers in the same room.
+    /// Peers find each other with UDP multicast beacons (room id + data port) and exchange messages over a unicast UDP
+    /// socket, one ReliableChannel per peer. Peers added by hand, and peers that found us that way, are sent the same
+    /// beacon over unicast instead. Every peer is dropped once it has been silent for PeerTimeoutSeconds. Sockets are
+    /// read on background threads; everything else, including delivery, happens in <see cref="Poll"/> on the caller's
+    /// thread, at the time the caller passes in.
+    /// </summary>
+    public sealed class LanPeerTransport : IDisposable
+    {
+        public const int DefaultDiscoveryPort = 47800;
+        public const string DefaultMulticastGroup = "239.255.42.99";
+
+        public string PeerId { get; }
+        public string RoomId { get; private set; }
+        public int DataPort { get; private set; }
+        public bool IsRunning => running;
+        public int PeerCount => peers.Count;
+        public float DiscoveryIntervalSeconds { get; set; } = 1f;
+        public float PeerTimeoutSeconds { get; set; } = 5f;
+
+        private static readonly byte[] BeaconMagic = { (byte)'A', (byte)'L', (byte)'S', (byte)'D' };
+        private const byte BeaconVersion = 1;
+
+        private readonly int discoveryPort;
+        private readonly IPAddress multicastGroup;
+        private readonly Guid peerGuid = Guid.NewGuid();
+        private readonly System.Random random = new System.Random();
+        private readonly Dictionary<string, Peer> peers = new Dictionary<string, Peer>();
+        private readonly Dictionary<IPEndPoint, Peer> peersByEndpoint = new Dictionary<IPEndPoint, Peer>();
+        private readonly ConcurrentQueue<Inbound> inbound = new ConcurrentQueue<Inbound>();
+        private readonly List<byte[]> outgoing = new List<byte[]>();
+        private readonly List<string> expired = new List<string>();
+        private UdpClient dataSocket;
+        private UdpClient discoverySocket;
+        private Thread dataThread;
+        private Thread discoveryThread;
+        private volatile bool running;
+        private float nextBeaconAt;
+        private bool beaconRequested;
+
+#if UNITY_ANDROID && !UNITY_EDITOR
+        private AndroidJavaObject multicastLock;
+#endif
+
+        public LanPeerTransport(int discoveryPort = DefaultDiscoveryPort, string multicastGroup = DefaultMulticastGroup)
+        {
+            this.discoveryPort = discoveryPort;
+            this.multicastGroup = IPAddress.Parse(multicastGroup);
+            PeerId = peerGuid.ToString("N");
+        }
+
+        /// <summary>
+        /// Open the data socket and, if <paramref name="discover"/>, join the multicast group and start beaconing for <paramref name="roomId"/>.
+        /// </summary>
+        public void Start(string roomId, bool discover = true)
+        {
+            if (IsRunning) Stop();
+            RoomId = roomId;
+            running = true;
+            dataSocket = new UdpClient(new IPEndPoint(IPAddress.Any, 0));
+            DataPort = ((IPEndPoint)dataSocket.Client.LocalEndPoint).Port;
+            dataThread = StartReceiveThread(dataSocket, false, "LanPeerData");
+
+            if (discover)
+            {
+                AcquireMulticastLock();
+                discoverySocket = new UdpClient { ExclusiveAddressUse = false };
+                discoverySocket.Client.SetSocketOption(SocketOptionLevel.Socket, SocketOptionName.ReuseAddress, true);
+                discoverySocket.Client.Bind(new IPEndPoint(IPAddress.Any, discoveryPort));
+                discoverySocket.JoinMulticastGroup(multicastGroup);
+                discoverySocket.MulticastLoopback = true; // several processes on one host can discover each other
+                discoveryThread = StartReceiveThread(discoverySocket, true, "LanPeerDiscovery");
+                beaconRequested = true;
+            }
+            Debug.Log($"LanPeerTransport: Started for room '{roomId}' on data port {DataPort}{(discover ? $", discovery {multicastGroup}:{discoveryPort}" : "")}");
+        }
+
+        public void Stop()
+        {
+            if (!running) return;
+            running = false;
+            dataSocket?.Close();
+            discoverySocket?.Close();
+            dataThread?.Join(500);
+            discoveryThread?.Join(500);
+            dataSocket = null;
+            discoverySocket = null;
+            dataThread = null;
+            discoveryThread = null;
+            ReleaseMulticastLock();
+            peers.Clear();
+            peersByEndpoint.Clear();
+            while (inbound.TryDequeue(out _)) { }
+            RoomId = null;
+        }
+
+        /// <summary>
+        /// Add a peer without discovery, e.g. on networks that drop multicast. It is sent unicast beacons, so it
+        /// learns about us too, and like any peer it times out once it stops answering.
+        /// </summary>
+        public void AddPeer(string peerId, IPEndPoint endpoint, float now)
+        {
+            var peer = GetOrAddPeer(peerId, endpoint, now);
+            peer.lastSeen = now;
+            peer.unicast = true;
+            beaconRequested = true;
+        }
+
+        /// <summary>
+        /// Send <paramref name="payload"/> reliably and in order to every current peer.
+        /// </summary>
+        public void Broadcast(byte[] payload, int offset, int count, float now)
+        {
+            if (!IsRunning) return;
+            foreach (var peer in peers.Values)
+            {
+                outgoing.Clear();
+                peer.channel.Send(payload, offset, count, now, outgoing);
+                Flush(peer);
+            }
+        }
+
+        /// <summary>
+        /// Process received datagrams, retransmit, beacon and expire silent peers. Payloads delivered in order per peer
+        /// are added to <paramref name="delivered"/>. Returns the number delivered.
+        /// </summary>
+        public int Poll(float now, List<byte[]> delivered)
+        {
+            if (!IsRunning) return 0;
+            int before = delivered.Count;
+            while (inbound.TryDequeue(out var packet))
+            {
+                if (packet.discovery || IsBeacon(packet.data))
+                {
+                    HandleBeacon(packet.from, packet.data, !packet.discovery, now);
+                }
+                else if (peersByEndpoint.TryGetValue(packet.from, out var peer))
+                {
+                    // Datagrams from endpoints not yet discovered are dropped; the sender retransmits
+                    outgoing.Clear();
+                    peer.channel.Receive(packet.data, packet.data.Length, now, delivered, outgoing);
+                    peer.lastSeen = now;
+                    Flush(peer);
+                }
+            }
+
+            expired.Clear();
+            foreach (var peer in peers.Values)
+            {
+                if (now - peer.lastSeen > PeerTimeoutSeconds)
+                {
+                    expired.Add(peer.id);
+                    continue;
+                }
+                outgoing.Clear();
+                peer.channel.Tick(now, outgoing);
+                Flush(peer);
+            }
+            foreach (var id in expired)
+            {
+                RemovePeer(id);
+            }
+
+            if (beaconRequested || now >= nextBeaconAt)
+            {
+                SendBeacons();
+                beaconRequested = false;
+                nextBeaconAt = now + DiscoveryIntervalSeconds;
+            }
+            return delivered.Count - before;
+        }
+
+        public void Dispose()
+        {
+            Stop();
+        }
+
+        private void HandleBeacon(IPEndPoint from, byte[] data, bool unicast, float now)
+        {
+            if (!TryReadBeacon(data, out var peerGuidRead, out int dataPort, out string roomId)) return;
+            if (peerGuidRead == peerGuid || roomId != RoomId) return;
+            string id = peerGuidRead.ToString("N");
+            bool known = peers.ContainsKey(id);
+            var peer = GetOrAddPeer(id, new IPEndPoint(from.Address, dataPort), now);
+            peer.lastSeen = now;
+            peer.unicast |= unicast; // it may not hear our multicast beacons, so answer it directly
+            if (!known)
+            {
+                // Answer straight away so the newcomer does not wait a full interval to learn about us
+                beaconRequested = true;
+                Debug.Log($"LanPeerTransport: Discovered peer {id} at {peer.endpoint}");
+            }
+        }
+
+        private Peer GetOrAddPeer(string id, IPEndPoint endpoint, float now)
+        {
+            if (peers.TryGetValue(id, out var peer))
+            {
+                if (!peer.endpoint.Equals(endpoint))
+                {
+                    peersByEndpoint.Remove(peer.endpoint);
+                    peer.endpoint = endpoint;
+                    peersByEndpoint[endpoint] = peer;
+                }
+                return peer;
+            }
+            peer = new Peer
+            {
+                id = id,
+                endpoint = endpoint,
+                channel = new ReliableChannel((uint)random.Next(1, int.MaxValue)),
+                lastSeen = now
+            };
+            peers[id] = peer;
+            peersByEndpoint[endpoint] = peer;
+            return peer;
+        }
+
+        private void RemovePeer(string id)
+        {
+            if (!peers.TryGetValue(id, out var peer)) return;
+            peers.Remove(id);
+            peersByEndpoint.Remove(peer.endpoint);
+            Debug.Log($"LanPeerTransport: Peer {id} timed out");
+        }
+
+        private void Flush(Peer peer)
+        {
+            foreach (var frame in outgoing)
+            {
+                try
+                {
+                    dataSocket.Send(frame, frame.Length, peer.endpoint);
+                }
+                catch (SocketException e)
+                {
+                    // Unreachable peers are retried by the channel and eventually time out
+                    Debug.LogWarning($"LanPeerTransport: Send to {peer.endpoint} failed: {e.SocketErrorCode}");
+                    break;
+                }
+            }
+            outgoing.Clear();
+        }
+
+        /// <summary>
+        /// Multicast our beacon if discovery is on, and send it to every unicast peer
+        /// </summary>
+        private void SendBeacons()
+        {
+            if (discoverySocket == null && !HasUnicastPeers()) return;
+            byte[] room = Encoding.UTF8.GetBytes(RoomId ?? string.Empty);
+            if (room.Length > 255) return;
+            var beacon = new byte[BeaconMagic.Length + 1 + 16 + 2 + 1 + room.Length];
+            int pos = 0;
+            Buffer.BlockCopy(BeaconMagic, 0, beacon, pos, BeaconMagic.Length);
+            pos += BeaconMagic.Length;
+            beacon[pos++] = BeaconVersion;
+            Buffer.BlockCopy(peerGuid.ToByteArray(), 0, beacon, pos, 16);
+            pos += 16;
+            beacon[pos++] = (byte)DataPort;
+            beacon[pos++] = (byte)(DataPort >> 8);
+            beacon[pos++] = (byte)room.Length;
+            Buffer.BlockCopy(room, 0, beacon, pos, room.Length);
+            if (discoverySocket != null) SendBeacon(discoverySocket, beacon, new IPEndPoint(multicastGroup, discoveryPort));
+            foreach (var peer in peers.Values)
+            {
+                if (peer.unicast) SendBeacon(dataSocket, beacon, peer.endpoint);
+            }
+        }
+
+        private static void SendBeacon(UdpClient socket, byte[] beacon, IPEndPoint to)
+        {
+            try
+            {
+                socket.Send(beacon, beacon.Length, to);
+            }
+            catch (SocketException e)
+            {
+                Debug.LogWarning($"LanPeerTransport: Beacon to {to} failed: {e.SocketErrorCode}");
+            }
+        }
+
+        private bool HasUnicastPeers()
+        {
+            foreach (var peer in peers.Values)
+            {
+                if (peer.unicast) return true;
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Whether a datagram on the data socket is a unicast beacon rather than a channel frame
+        /// </summary>
+        private static bool IsBeacon(byte[] data)
+        {
+            if (data.Length < BeaconMagic.Length) return false;
+            for (int i = 0; i < BeaconMagic.Length; i++)
+            {
+                if (data[i] != BeaconMagic[i]) return false;
+            }
+            return true;
+        }
+
+        private static bool TryReadBeacon(byte[] data, out Guid peer, out int dataPort, out string roomId)
+        {
+            peer = Guid.Empty;
+            dataPort = 0;
+            roomId = null;
+            int header = BeaconMagic.Length + 1 + 16 + 2 + 1;
+            if (data.Length < header || !IsBeacon(data)) return false;
+            int pos = BeaconMagic.Length;
+            if (data[pos++] != BeaconVersion) return false;
+            var guidBytes = new byte[16];
+            Buffer.BlockCopy(data, pos, guidBytes, 0, 16);
+            peer = new Guid(guidBytes);
+            pos += 16;
+            dataPort = data[pos] | data[pos + 1] << 8;
+            pos += 2;
+            int roomLength = data[pos++];
+            if (data.Length - pos < roomLength) return false;
+            roomId = Encoding.UTF8.GetString(data, pos, roomLength);
+            return true;
+        }
+
+        private Thread StartReceiveThread(UdpClient socket, bool discovery, string name)
+        {
+            var thread = new Thread(() => ReceiveLoop(socket, discovery)) { IsBackground = true, Name = name };
+            thread.Start();
+            return thread;
+        }
+
+        private void ReceiveLoop(UdpClient socket, bool discovery)
+        {
+            var any = new IPEndPoint(IPAddress.Any, 0);
+            while (true)
+            {
+                try
+                {
+                    var from = any;
+                    byte[] data = socket.Receive(ref from);
+                    inbound.Enqueue(new Inbound { from = from, data = data, discovery = discovery });
+                }
+                catch (ObjectDisposedException)
+                {
+                    return;
+                }
+                catch (SocketException)
+                {
+                    // Closed by Stop, or an ICMP port-unreachable from a departed peer (Windows reports those here)
+                    if (!running) return;
+                }
+            }
+        }
+
+        private void AcquireMulticastLock()
+        {
+#if UNITY_ANDROID && !UNITY_EDITOR
+            // Android filters multicast on Wi-Fi unless a lock is held (needs CHANGE_WIFI_MULTICAST_STATE)
+            try
+            {
+                using (var player = new AndroidJavaClass("com.unity3d.player.UnityPlayer"))
+                using (var activity = player.GetStatic<AndroidJavaObject>("currentActivity"))
+                using (var wifi = activity.Call<AndroidJavaObject>("getSystemService", "wifi"))
+                {
+                    multicastLock = wifi.Call<AndroidJavaObject>("createMulticastLock", "arlinguasphere-lan");
+                    multicastLock.Call("acquire");
+                }
+            }
+            catch (Exception e)
+            {
+                Debug.LogWarning($"LanPeerTransport: Multicast lock unavailable: {e.Message}");
+            }
+#endif
+        }
+
+        private void ReleaseMulticastLock()
+        {
+#if UNITY_ANDROID && !UNITY_EDITOR
+            if (multicastLock == null) return;
+            multicastLock.Call("release");
+            multicastLock.Dispose();
+            multicastLock = null;
+#endif
+        }
+
+        private struct Inbound
+        {
+            public IPEndPoint from;
+            public byte[] data;
+            public bool discovery;
+        }
+
+        private sealed class Peer
+        {
+            public string id;
+            public IPEndPoint endpoint;
+            public ReliableChannel channel;
+            public float lastSeen;
+            public bool unicast; // added with AddPeer or found by a unicast beacon: beaconed directly
+        }
+    }
+}
@@ -19,12 +19,35 @@ namespace ARLinguaSphere.Network
         [Header("Room Settings")]
         public string currentRoomId;
         public int maxRoomSize = 8;
+        public Vector3 roomOrigin = Vector3.zero; // anchor positions are quantised relative to this on the wire
+        
+        [Header("Interest Management")]
+        public bool useSpatialInterest = true; // only sync anchors in grid cells near the user
+        public float cellSize = 8f; // must match every peer in the room
+        public float interestRadius = 16f;
+        public Transform interestCenter; // defaults to the main camera
+        
+        [Header("LAN Peers")]
+        public bool useLanPeers = true; // co-located devices exchange anchors directly; Firebase still persists them
+        public int lanDiscoveryPort = LanPeerTransport.DefaultDiscoveryPort;
+        public string lanMulticastGroup = LanPeerTransport.DefaultMulticastGroup;
+        
+        [Header("Motion Smoothing")]
+        public bool smoothRemoteMotion = true; // remote pose updates play back through a jitter buffer instead of snapping
+        public float interpolationDelayMs = 100f; // margin over measured transit and jitter
+        public float maxMotionStepMs = 500f; // an update after a longer pause moves over at most this long
         
         private bool isInitialized = false;
         private bool isConnected = false;
         private bool isInRoom = false;
         private Coroutine syncCoroutine;
         private FirebaseService firebase;
+        private LanPeerTransport lan;
+        private readonly AnchorCodec lanCodec = new AnchorCodec();
+        private readonly byte[] lanSendBuffer = new byte[1024];
+        private readonly List<byte[]> lanDelivered = new List<byte[]>();
+        private readonly Dictionary<string, long> deliveredAnchors = new Dictionary<string, long>(); // id -> newest timestamp
+        private readonly AnchorPoseBuffer remotePoses = new AnchorPoseBuffer();
         
         // Events
         public event Action OnConnected;
@@ -32,6 +55,9 @@ namespace ARLinguaSphere.Network
         public event Action<string> OnRoomJoined;
         public event Action OnRoomLeft;
         public event Action<AnchorData> OnAnchorReceived;
+        public event Action<AnchorData> OnAnchorUpdated; // a newer pose for an anchor already received
+        public event Action<AnchorData> OnAnchorEvicted;
+        public event Action<AnchorData> OnAnchorRemoved;
         public event Action<string> OnNetworkError;
         
         public void Initialize()
@@ -54,7 +80,13 @@ namespace ARLinguaSphere.Network
                 var go = new GameObject("FirebaseService");
                 firebase = go.AddComponent<FirebaseService>();
             }
+            firebase.maxRetries = maxRetries;
+            firebase.useSpatialCells = useSpatialInterest;
+            firebase.cellSize = cellSize;
+            firebase.interestRadius = interestRadius;
             firebase.Initialize();
+            remotePoses.MinDelayMs = (long)interpolationDelayMs;
+            remotePoses.MaxStepMs = (long)maxMotionStepMs;
             Debug.Log("NetworkManager: Backend initialized (Firebase placeholder)");
         }
         
@@ -77,6 +109,7 @@ namespace ARLinguaSphere.Network
             yield return new WaitForSeconds(1f);
             
             isConnected = true;
+            firebase?.RetryPendingWrites();
             OnConnected?.Invoke();
             Debug.Log("NetworkManager: Connected to server");
         }
@@ -175,7 +208,9 @@ namespace ARLinguaSphere.Network
             // Stop syncing
             StopSyncing();
             
-            // TODO: Leave room in Firebase
+            // Stop the anchor listener; its local snapshot makes a later rejoin download only newer anchors
+            firebase?.StopListeningRoomAnchors(currentRoomId);
+            StopLanPeers();
             Debug.Log($"NetworkManager: Leaving room '{currentRoomId}'");
             
             isInRoom = false;
@@ -191,7 +226,17 @@ namespace ARLinguaSphere.Network
                 return;
             }
             
-            // Send anchor data to Firebase
+            // Stamped in server time so every peer orders and plays back updates on the same clock
+            anchorData.timestamp = ServerTimeMs;
+            deliveredAnchors[anchorData.id] = anchorData.timestamp;
+            
+            // Co-located peers get it directly; the Firebase write persists it and reaches everyone else
+            if (lan != null && lan.PeerCount > 0)
+            {
+                int length = lanCodec.Encode(anchorData, lanSendBuffer, 0);
+                if (length > 0) lan.Broadcast(lanSendBuffer, 0, length, Time.realtimeSinceStartup);
+            }
+            
             firebase?.SetRoomAnchor(currentRoomId, anchorData, success =>
             {
                 if (!success)
@@ -235,22 +280,114 @@ namespace ARLinguaSphere.Network
         
         private IEnumerator SyncLoop()
         {
+            Action<AnchorData> onAnchor = DeliverAnchor;
+            Action<AnchorData> onEvict = anchor =>
+            {
+                deliveredAnchors.Remove(anchor.id);
+                remotePoses.Remove(anchor.id);
+                OnAnchorEvicted?.Invoke(anchor);
+            };
+            Action<AnchorData> onRemove = anchor =>
+            {
+                deliveredAnchors.Remove(anchor.id);
+                remotePoses.Remove(anchor.id);
+                OnAnchorRemoved?.Invoke(anchor);
+            };
+            StartLanPeers();
+            
             // Attach listener once when entering room
             if (firebase != null && !string.IsNullOrEmpty(currentRoomId))
             {
-                firebase.ListenRoomAnchors(currentRoomId, (anchor) =>
-                {
-                    OnAnchorReceived?.Invoke(anchor);
-                });
+                firebase.SetRoomOrigin(roomOrigin);
+                if (!useSpatialInterest) firebase.ListenRoomAnchors(currentRoomId, onAnchor, onRemove);
             }
             
             while (isInRoom)
             {
-                // Placeholder: periodic heartbeat
+                // Follow the user: cells entering the radius are subscribed, cells left behind are evicted
+                if (useSpatialInterest && firebase != null)
+                {
+                    var center = interestCenter != null ? interestCenter : (Camera.main != null ? Camera.main.transform : null);
+                    if (center != null) firebase.UpdateRoomInterest(currentRoomId, center.position, onAnchor, onEvict, onRemove);
+                }
                 yield return new WaitForSeconds(syncInterval);
             }
         }
         
+        public void SetRoomOrigin(Vector3 origin)
+        {
+            roomOrigin = origin;
+            lanCodec.RoomOrigin = origin;
+            firebase?.SetRoomOrigin(origin);
+        }
+        
+        /// <summary>
+        /// Raises OnAnchorReceived once per anchor, whichever path (LAN peer or Firebase) delivers it first, then
+        /// OnAnchorUpdated for each newer version; the other path's copy of the same version is dropped.
+        /// </summary>
+        private void DeliverAnchor(AnchorData anchor)
+        {
+            if (anchor == null) return;
+            bool known = deliveredAnchors.TryGetValue(anchor.id, out long newest);
+            if (known && anchor.timestamp <= newest) return;
+            deliveredAnchors[anchor.id] = anchor.timestamp;
+            // A first delivery is usually cached or snapshot state, whose age says nothing about transit
+            if (smoothRemoteMotion) remotePoses.Push(anchor.id, anchor.timestamp, anchor.position, anchor.rotation, ServerTimeMs, live: known);
+            
+            if (known) OnAnchorUpdated?.Invoke(anchor);
+            else OnAnchorReceived?.Invoke(anchor);
+        }
+        
+        /// <summary>
+        /// Interpolated pose of a remote anchor for this frame. <paramref name="settled"/> turns true once playback has
+        /// caught up with the newest update. Returns false when smoothing is off or the anchor has no buffered updates.
+        /// </summary>
+        public bool TryGetAnchorPose(string anchorId, out Vector3 position, out Quaternion rotation, out bool settled)
+        {
+            return remotePoses.TrySample(anchorId, ServerTimeMs, out position, out rotation, out settled);
+        }
+        
+        private void StartLanPeers()
+        {
+            if (!useLanPeers || string.IsNullOrEmpty(currentRoomId)) return;
+            try
+            {
+                lanCodec.RoomOrigin = roomOrigin;
+                if (lan == null) lan = new LanPeerTransport(lanDiscoveryPort, lanMulticastGroup);
+                lan.Start(currentRoomId);
+            }
+            catch (Exception e)
+            {
+                Debug.LogWarning($"NetworkManager: LAN peers unavailable, using Firebase only: {e.Message}");
+                lan?.Stop();
+            }
+        }
+        
+        private void StopLanPeers()
+        {
+            lan?.Stop();
+            deliveredAnchors.Clear();
+            remotePoses.Clear();
+        }
+        
+        private void Update()
+        {
+            if (lan == null || !lan.IsRunning) return;
+            lanDelivered.Clear();
+            if (lan.Poll(Time.realtimeSinceStartup, lanDelivered) == 0) return;
+            foreach (var payload in lanDelivered)
+            {
+                var anchor = new AnchorData();
+                if (lanCodec.TryDecode(payload, 0, payload.Length, anchor, out _)) DeliverAnchor(anchor);
+            }
+        }
+        
+        public void SetInterestRadius(float radius)
+        {
+            interestRadius = Mathf.Max(0f, radius);
+            if (firebase != null) firebase.interestRadius = interestRadius;
+        }
+        
         private string GenerateRoomId()
         {
             return UnityEngine.Random.Range(100000, 999999).ToString();
@@ -259,10 +396,13 @@ namespace ARLinguaSphere.Network
         public bool IsConnected => isConnected;
         public bool IsInRoom => isInRoom;
         public string CurrentRoomId => currentRoomId;
+        public int LanPeerCount => lan != null ? lan.PeerCount : 0;
+        public long ServerTimeMs => firebase != null ? firebase.ServerClock.ReferenceNow : DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
         
         private void OnDestroy()
         {
             Disconnect();
+            lan?.Dispose();
         }
     }
     
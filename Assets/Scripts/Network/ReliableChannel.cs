@@ -0,0 +1,171 @@
+using System;
+using System.Collections.Generic;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Reliable, ordered message delivery to one peer over an unreliable datagram socket.
+    /// Data frames carry a sequence number and are retransmitted until cumulatively acknowledged; the receiver buffers
+    /// out-of-order frames and delivers in sequence. A random session id per sender lets a restarted peer start over at
+    /// sequence 1. The channel only builds and consumes frames; the caller owns the socket and the clock.
+    /// </summary>
+    public sealed class ReliableChannel
+    {
+        public const byte FrameData = 1;
+        public const byte FrameAck = 2;
+        public const int HeaderSize = 9; // type + session + sequence/ack
+
+        public float MinRetransmitSeconds { get; set; } = 0.03f;
+        public float MaxRetransmitSeconds { get; set; } = 1f;
+        public int ReceiveWindow { get; set; } = 256;
+        public float SmoothedRtt { get; private set; } = 0.05f;
+        public int UnackedCount => unacked.Count;
+        public int Retransmissions { get; private set; }
+
+        private readonly uint sendSession;
+        private uint nextSendSequence = 1;
+        private readonly SortedDictionary<uint, Outgoing> unacked = new SortedDictionary<uint, Outgoing>();
+        private readonly List<uint> acked = new List<uint>();
+
+        private uint receiveSession;
+        private uint nextExpected = 1;
+        private readonly Dictionary<uint, byte[]> outOfOrder = new Dictionary<uint, byte[]>();
+
+        public ReliableChannel(uint session)
+        {
+            sendSession = session == 0 ? 1u : session;
+        }
+
+        /// <summary>
+        /// Wrap <paramref name="payload"/> in a data frame, remember it for retransmission and add the frame to <paramref name="outgoing"/>.
+        /// </summary>
+        public void Send(byte[] payload, int offset, int count, float now, List<byte[]> outgoing)
+        {
+            uint sequence = nextSendSequence++;
+            var frame = new byte[HeaderSize + count];
+            WriteHeader(frame, FrameData, sendSession, sequence);
+            Buffer.BlockCopy(payload, offset, frame, HeaderSize, count);
+            unacked[sequence] = new Outgoing { frame = frame, firstSentAt = now, lastSentAt = now };
+            outgoing.Add(frame);
+        }
+
+        /// <summary>
+        /// Consume a frame from the peer. In-order payloads go to <paramref name="delivered"/>; acks go to <paramref name="outgoing"/>.
+        /// Returns false if the frame is not a channel frame.
+        /// </summary>
+        public bool Receive(byte[] frame, int count, float now, List<byte[]> delivered, List<byte[]> outgoing)
+        {
+            if (count < HeaderSize) return false;
+            byte type = frame[0];
+            uint session = ReadUInt32(frame, 1);
+            uint number = ReadUInt32(frame, 5);
+
+            if (type == FrameAck)
+            {
+                if (session == sendSession) OnAck(number, now);
+                return true;
+            }
+            if (type != FrameData) return false;
+
+            if (session != receiveSession)
+            {
+                // The peer restarted (or this is its first frame): sequence numbers begin again
+                receiveSession = session;
+                nextExpected = 1;
+                outOfOrder.Clear();
+            }
+
+            if (number == nextExpected)
+            {
+                delivered.Add(CopyPayload(frame, count));
+                nextExpected++;
+                while (outOfOrder.TryGetValue(nextExpected, out var buffered))
+                {
+                    outOfOrder.Remove(nextExpected);
+                    delivered.Add(buffered);
+                    nextExpected++;
+                }
+            }
+            else if (number > nextExpected && number - nextExpected < ReceiveWindow && !outOfOrder.ContainsKey(number))
+            {
+                outOfOrder[number] = CopyPayload(frame, count);
+            }
+
+            // Duplicates and gaps are acked too, so a lost ack cannot stall the sender
+            var ack = new byte[HeaderSize];
+            WriteHeader(ack, FrameAck, receiveSession, nextExpected - 1);
+            outgoing.Add(ack);
+            return true;
+        }
+
+        /// <summary>
+        /// Add frames whose retransmission timeout has elapsed to <paramref name="outgoing"/>.
+        /// </summary>
+        public void Tick(float now, List<byte[]> outgoing)
+        {
+            float timeout = RetransmitTimeout;
+            foreach (var pending in unacked.Values)
+            {
+                float wait = timeout * (1 << Math.Min(pending.retransmits, 5));
+                if (now - pending.lastSentAt < Math.Min(wait, MaxRetransmitSeconds)) continue;
+                pending.lastSentAt = now;
+                pending.retransmits++;
+                Retransmissions++;
+                outgoing.Add(pending.frame);
+            }
+        }
+
+        public float RetransmitTimeout => Math.Max(MinRetransmitSeconds, Math.Min(MaxRetransmitSeconds, SmoothedRtt * 2f));
+
+        private void OnAck(uint cumulative, float now)
+        {
+            acked.Clear();
+            foreach (var entry in unacked)
+            {
+                if (entry.Key > cumulative) break;
+                acked.Add(entry.Key);
+                // Karn's rule: only frames sent once give an unambiguous round-trip sample
+                if (entry.Value.retransmits == 0) SmoothedRtt += 0.125f * ((now - entry.Value.firstSentAt) - SmoothedRtt);
+            }
+            foreach (uint sequence in acked)
+            {
+                unacked.Remove(sequence);
+            }
+        }
+
+        private static byte[] CopyPayload(byte[] frame, int count)
+        {
+            var payload = new byte[count - HeaderSize];
+            Buffer.BlockCopy(frame, HeaderSize, payload, 0, payload.Length);
+            return payload;
+        }
+
+        private static void WriteHeader(byte[] frame, byte type, uint session, uint number)
+        {
+            frame[0] = type;
+            WriteUInt32(frame, 1, session);
+            WriteUInt32(frame, 5, number);
+        }
+
+        private static void WriteUInt32(byte[] buffer, int offset, uint value)
+        {
+            buffer[offset] = (byte)value;
+            buffer[offset + 1] = (byte)(value >> 8);
+            buffer[offset + 2] = (byte)(value >> 16);
+            buffer[offset + 3] = (byte)(value >> 24);
+        }
+
+        private static uint ReadUInt32(byte[] buffer, int offset)
+        {
+            return (uint)(buffer[offset] | buffer[offset + 1] << 8 | buffer[offset + 2] << 16 | buffer[offset + 3] << 24);
+        }
+
+        private sealed class Outgoing
+        {
+            public byte[] frame;
+            public float firstSentAt;
+            public float lastSentAt;
+            public int retransmits;
+        }
+    }
+}
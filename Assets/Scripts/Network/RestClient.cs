@@ -0,0 +1,845 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Net.Security;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+using UnityEngine;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Minimal HTTP/1.1 client for the REST traffic of FirebaseService. Connections are kept alive and pooled per host;
+    /// at most MaxConnectionsPerHost carry requests at once and further requests queue for the next free one, so steady
+    /// traffic pays one TCP/TLS handshake per pooled connection instead of one per request. Each connection owns its
+    /// request and response buffers and reuses them. Requests run on the thread pool; coroutines yield the RestRequest
+    /// to wait for it. Event streams get a connection of their own, outside the pool. Requests are not pipelined: a
+    /// connection carries one at a time, so a slow response never holds up the ones behind it and a dropped connection
+    /// leaves at most one request in doubt.
+    /// </summary>
+    public sealed class RestClient : IDisposable
+    {
+        public int MaxConnectionsPerHost { get; }
+        public float TimeoutSeconds { get; set; } = 30f;
+        public float IdleTimeoutSeconds { get; set; } = 50f; // idle longer than this and the server may have closed it
+        public RestMetrics Metrics => metrics;
+
+        private readonly Dictionary<string, HostPool> pools = new Dictionary<string, HostPool>();
+        private readonly object gate = new object();
+        private RestMetrics metrics;
+        private bool disposed;
+
+        public RestClient(int maxConnectionsPerHost = 4)
+        {
+            MaxConnectionsPerHost = Math.Max(1, maxConnectionsPerHost);
+        }
+
+        /// <summary>
+        /// Start a request; yield the returned request from a coroutine to wait for the response.
+        /// </summary>
+        public RestRequest Send(RestRequest request)
+        {
+            Interlocked.Increment(ref metrics.requests);
+            Task.Run(() => Execute(request));
+            return request;
+        }
+
+        /// <summary>
+        /// Open a text/event-stream GET on a dedicated connection, following redirects. Read the body as it arrives;
+        /// dispose to disconnect.
+        /// </summary>
+        public RestStream OpenStream(string url, string lastEventId = null)
+        {
+            var stream = new RestStream();
+            Interlocked.Increment(ref metrics.requests);
+            Task.Run(() => RunStream(stream, url, lastEventId));
+            return stream;
+        }
+
+        public void Dispose()
+        {
+            lock (gate)
+            {
+                disposed = true;
+                foreach (var pool in pools.Values)
+                {
+                    foreach (var connection in pool.idle)
+                    {
+                        connection.Abort();
+                    }
+                    pool.idle.Clear();
+                    while (pool.waiters.Count > 0)
+                    {
+                        pool.waiters.Dequeue().TrySetException(new ObjectDisposedException(nameof(RestClient)));
+                    }
+                }
+            }
+        }
+
+        private async Task Execute(RestRequest request)
+        {
+            try
+            {
+                var uri = new Uri(request.Url);
+                for (int attempt = 0; ; attempt++)
+                {
+                    var connection = await Acquire(uri);
+                    bool reused = connection.Requests > 0;
+                    bool keepAlive = false;
+                    try
+                    {
+                        connection.Arm(TimeoutSeconds);
+                        Interlocked.Add(ref metrics.bytesSent, await connection.Write(request));
+                        if (reused) Interlocked.Increment(ref metrics.requestsOnReusedConnections);
+                        keepAlive = await connection.ReadResponse(request);
+                        connection.Disarm();
+                        request.Complete(null);
+                        return;
+                    }
+                    catch (Exception e) when (e is IOException || e is SocketException || e is ObjectDisposedException)
+                    {
+                        keepAlive = false;
+                        if (connection.TimedOut)
+                        {
+                            request.Complete("Request timeout");
+                            return;
+                        }
+                        // A pooled connection the server closed while idle fails before any response; resend once
+                        if (reused && attempt == 0 && !request.ResponseStarted && request.Method != "POST")
+                        {
+                            Interlocked.Increment(ref metrics.retries);
+                            continue;
+                        }
+                        request.Complete(e.Message);
+                        return;
+                    }
+                    finally
+                    {
+                        Release(connection, keepAlive);
+                    }
+                }
+            }
+            catch (Exception e)
+            {
+                request.Complete(e.Message);
+            }
+        }
+
+        private async Task RunStream(RestStream target, string url, string lastEventId)
+        {
+            var request = new RestRequest("GET", url);
+            request.SetRequestHeader("Accept", "text/event-stream");
+            if (!string.IsNullOrEmpty(lastEventId)) request.SetRequestHeader("Last-Event-ID", lastEventId);
+            Connection connection = null;
+            try
+            {
+                for (int redirects = 0; ; redirects++)
+                {
+                    var uri = new Uri(request.Url);
+                    connection = await Connection.Open(uri, Key(uri), this);
+                    Interlocked.Increment(ref metrics.connectionsOpened);
+                    if (!target.Attach(connection)) return; // disposed while connecting
+                    Interlocked.Add(ref metrics.bytesSent, await connection.Write(request));
+                    await connection.ReadHead(request);
+                    target.StatusCode = request.StatusCode;
+
+                    string location = request.GetResponseHeader("Location");
+                    if (request.StatusCode >= 300 && request.StatusCode < 400 && location != null && redirects < 3)
+                    {
+                        // Streams may be redirected to the database's current host
+                        connection.Abort();
+                        request.Redirect(new Uri(uri, location).ToString());
+                        continue;
+                    }
+                    if (request.StatusCode != 200)
+                    {
+                        target.Complete("HTTP " + request.StatusCode);
+                        return;
+                    }
+                    await connection.CopyBody(target.Append);
+                    target.Complete(null);
+                    return;
+                }
+            }
+            catch (Exception e)
+            {
+                target.Complete(target.IsAborted ? null : e.Message);
+            }
+            finally
+            {
+                connection?.Abort();
+            }
+        }
+
+        private async Task<Connection> Acquire(Uri uri)
+        {
+            string key = Key(uri);
+            HostPool pool;
+            TaskCompletionSource<Connection> wait = null;
+            lock (gate)
+            {
+                if (disposed) throw new ObjectDisposedException(nameof(RestClient));
+                if (!pools.TryGetValue(key, out pool))
+                {
+                    pool = new HostPool();
+                    pools[key] = pool;
+                }
+                while (pool.idle.Count > 0)
+                {
+                    var idle = pool.idle.Pop();
+                    if (idle.IsUsable(IdleTimeoutSeconds)) return idle;
+                    idle.Abort();
+                    pool.open--;
+                }
+                if (pool.open < MaxConnectionsPerHost)
+                {
+                    pool.open++;
+                }
+                else
+                {
+                    wait = new TaskCompletionSource<Connection>(TaskCreationOptions.RunContinuationsAsynchronously);
+                    pool.waiters.Enqueue(wait);
+                }
+            }
+
+            if (wait != null)
+            {
+                // Either a kept-alive connection, or null: a slot freed up and this request opens its own
+                var handed = await wait.Task;
+                if (handed != null) return handed;
+            }
+            try
+            {
+                var connection = await Connection.Open(uri, key, this);
+                Interlocked.Increment(ref metrics.connectionsOpened);
+                return connection;
+            }
+            catch
+            {
+                lock (gate)
+                {
+                    FreeSlot(pool);
+                }
+                throw;
+            }
+        }
+
+        private void Release(Connection connection, bool keepAlive)
+        {
+            lock (gate)
+            {
+                var pool = pools[connection.Key];
+                if (keepAlive && !disposed)
+                {
+                    connection.MarkIdle();
+                    if (pool.waiters.Count > 0) pool.waiters.Dequeue().TrySetResult(connection);
+                    else pool.idle.Push(connection);
+                    return;
+                }
+                connection.Abort();
+                FreeSlot(pool);
+            }
+        }
+
+        private static void FreeSlot(HostPool pool)
+        {
+            if (pool.waiters.Count > 0) pool.waiters.Dequeue().TrySetResult(null); // the slot passes to the waiter
+            else pool.open--;
+        }
+
+        private static string Key(Uri uri)
+        {
+            return uri.GetLeftPart(UriPartial.Authority);
+        }
+
+        private void AddBytesReceived(int count)
+        {
+            Interlocked.Add(ref metrics.bytesReceived, count);
+        }
+
+        private sealed class HostPool
+        {
+            public readonly Stack<Connection> idle = new Stack<Connection>();
+            public readonly Queue<TaskCompletionSource<Connection>> waiters = new Queue<TaskCompletionSource<Connection>>();
+            public int open; // idle + in use + being opened
+        }
+
+        /// <summary>
+        /// One kept-alive socket (TLS for https) with its reusable buffers
+        /// </summary>
+        private sealed class Connection : IAbortable
+        {
+            public readonly string Key;
+            public int Requests { get; private set; }
+            public bool TimedOut { get; private set; }
+
+            private readonly TcpClient tcp;
+            private readonly Stream stream;
+            private readonly RestClient owner;
+            private readonly StringBuilder head = new StringBuilder(512);
+            private readonly byte[] readBuffer = new byte[16 * 1024];
+            private readonly Action<byte[], int, int> appendBody;
+            private readonly Timer timer;
+            private byte[] writeBuffer = new byte[4 * 1024];
+            private byte[] bodyBuffer = new byte[16 * 1024];
+            private int bodyLength;
+            private int readStart;
+            private int readEnd;
+            private long contentLength;
+            private bool chunked;
+            private bool closeAfterResponse;
+            private long idleSince;
+            private int armed;
+            private volatile bool aborted;
+
+            private Connection(string key, TcpClient tcp, Stream stream, RestClient owner)
+            {
+                Key = key;
+                this.tcp = tcp;
+                this.stream = stream;
+                this.owner = owner;
+                appendBody = AppendBody;
+                timer = new Timer(OnTimeout);
+            }
+
+            public static async Task<Connection> Open(Uri uri, string key, RestClient owner)
+            {
+                var tcp = new TcpClient { NoDelay = true };
+                try
+                {
+                    await tcp.ConnectAsync(uri.Host, uri.Port);
+                    Stream stream = tcp.GetStream();
+                    if (uri.Scheme == Uri.UriSchemeHttps)
+                    {
+                        var ssl = new SslStream(stream, false);
+                        await ssl.AuthenticateAsClientAsync(uri.Host);
+                        stream = ssl;
+                    }
+                    return new Connection(key, tcp, stream, owner);
+                }
+                catch
+                {
+                    tcp.Close();
+                    throw;
+                }
+            }
+
+            public bool IsUsable(float idleTimeoutSeconds)
+            {
+                if (aborted) return false;
+                if ((Stopwatch.GetTimestamp() - idleSince) / (double)Stopwatch.Frequency > idleTimeoutSeconds) return false;
+                try
+                {
+                    // Readable with nothing to read: the server closed its end
+                    return !(tcp.Client.Poll(0, SelectMode.SelectRead) && tcp.Client.Available == 0);
+                }
+                catch (Exception)
+                {
+                    return false;
+                }
+            }
+
+            public void MarkIdle()
+            {
+                idleSince = Stopwatch.GetTimestamp();
+            }
+
+            public void Arm(float seconds)
+            {
+                Interlocked.Exchange(ref armed, 1);
+                timer.Change((int)(seconds * 1000), Timeout.Infinite);
+            }
+
+            public void Disarm()
+            {
+                Interlocked.Exchange(ref armed, 0);
+                timer.Change(Timeout.Infinite, Timeout.Infinite);
+            }
+
+            private void OnTimeout(object state)
+            {
+                if (Interlocked.Exchange(ref armed, 0) == 0) return;
+                TimedOut = true;
+                Abort();
+            }
+
+            public void Abort()
+            {
+                if (aborted) return;
+                aborted = true;
+                timer.Dispose();
+                stream.Dispose();
+                tcp.Close();
+            }
+
+            /// <summary>
+            /// Serialize the request line, headers and body (UTF-8 text or raw bytes) into the connection's buffer and send
+            /// it in one write.
+            /// </summary>
+            public async Task<int> Write(RestRequest request)
+            {
+                var uri = new Uri(request.Url);
+                head.Length = 0;
+                head.Append(request.Method).Append(' ').Append(uri.PathAndQuery).Append(" HTTP/1.1\r\nHost: ").Append(uri.Host);
+                if (!uri.IsDefaultPort) head.Append(':').Append(uri.Port);
+                head.Append("\r\n");
+                request.AppendRequestHeaders(head);
+                bool hasBody = request.Body != null || request.BodyBytes != null;
+                int bodyBytes = request.BodyBytes != null ? request.BodyLength : request.Body != null ? Encoding.UTF8.GetByteCount(request.Body) : 0;
+                if (hasBody)
+                {
+                    head.Append("Content-Type: ").Append(request.ContentType).Append("\r\n");
+                }
+                if (hasBody || request.Method == "PUT" || request.Method == "PATCH" || request.Method == "POST")
+                {
+                    head.Append("Content-Length: ").Append(bodyBytes).Append("\r\n");
+                }
+                head.Append("\r\n");
+
+                int total = head.Length + bodyBytes;
+                if (writeBuffer.Length < total)
+                {
+                    int size = writeBuffer.Length;
+                    while (size < total) size *= 2;
+                    writeBuffer = new byte[size];
+                }
+                for (int i = 0; i < head.Length; i++)
+                {
+                    writeBuffer[i] = (byte)head[i];
+                }
+                if (request.BodyBytes != null) Buffer.BlockCopy(request.BodyBytes, 0, writeBuffer, head.Length, bodyBytes);
+                else if (bodyBytes > 0) Encoding.UTF8.GetBytes(request.Body, 0, request.Body.Length, writeBuffer, head.Length);
+                await stream.WriteAsync(writeBuffer, 0, total);
+                Requests++;
+                return total;
+            }
+
+            /// <summary>
+            /// Read status, headers and body into <paramref name="request"/>. Returns whether the connection can be reused.
+            /// </summary>
+            public async Task<bool> ReadResponse(RestRequest request)
+            {
+                await ReadHead(request);
+                bodyLength = 0;
+                bool bodyless = request.Method == "HEAD" || request.StatusCode == 204 || request.StatusCode == 304;
+                if (!bodyless) await CopyBody(appendBody);
+                request.SetResponseText(bodyLength > 0 ? Encoding.UTF8.GetString(bodyBuffer, 0, bodyLength) : string.Empty);
+                return !closeAfterResponse && (bodyless || chunked || contentLength >= 0);
+            }
+
+            public async Task ReadHead(RestRequest request)
+            {
+                while (true)
+                {
+                    int end;
+                    while ((end = HeaderEnd()) < 0)
+                    {
+                        if (!await Fill()) throw new IOException("Connection closed before the response");
+                        request.ResponseStarted = true;
+                    }
+
+                    contentLength = -1;
+                    chunked = false;
+                    closeAfterResponse = false;
+                    int lineStart = readStart;
+                    bool statusLine = true;
+                    for (int i = readStart; i <= end; i++)
+                    {
+                        if (i < end && readBuffer[i] != '\r') continue;
+                        string line = Encoding.ASCII.GetString(readBuffer, lineStart, i - lineStart);
+                        lineStart = i + 2;
+                        i++;
+                        if (statusLine)
+                        {
+                            // "HTTP/1.1 200 OK"
+                            statusLine = false;
+                            var parts = line.Split(' ');
+                            if (parts.Length < 2 || !int.TryParse(parts[1], out int status)) throw new IOException("Malformed status line");
+                            request.StatusCode = status;
+                            closeAfterResponse = parts[0] == "HTTP/1.0";
+                            request.ClearResponseHeaders();
+                            continue;
+                        }
+                        int colon = line.IndexOf(':');
+                        if (colon <= 0) continue;
+                        string name = line.Substring(0, colon).Trim();
+                        string value = line.Substring(colon + 1).Trim();
+                        request.SetResponseHeader(name, value);
+                        if (name.Equals("Content-Length", StringComparison.OrdinalIgnoreCase)) long.TryParse(value, out contentLength);
+                        else if (name.Equals("Transfer-Encoding", StringComparison.OrdinalIgnoreCase)) chunked = value.IndexOf("chunked", StringComparison.OrdinalIgnoreCase) >= 0;
+                        else if (name.Equals("Connection", StringComparison.OrdinalIgnoreCase)) closeAfterResponse |= value.Equals("close", StringComparison.OrdinalIgnoreCase);
+                    }
+                    readStart = end + 4;
+                    // Interim 1xx responses precede the real one
+                    if (request.StatusCode >= 200 || request.StatusCode < 100) return;
+                }
+            }
+
+            /// <summary>
+            /// Pass the body to <paramref name="sink"/> as it arrives, decoding chunked transfer encoding.
+            /// </summary>
+            public async Task CopyBody(Action<byte[], int, int> sink)
+            {
+                if (chunked)
+                {
+                    while (true)
+                    {
+                        long size = await ReadChunkSize();
+                        if (size == 0)
+                        {
+                            // Trailers end with an empty line
+                            while (await ReadLineLength() > 0) { }
+                            return;
+                        }
+                        await CopyExactly(size, sink);
+                        await ReadLineLength();
+                    }
+                }
+                if (contentLength >= 0)
+                {
+                    await CopyExactly(contentLength, sink);
+                    return;
+                }
+                // Neither length nor chunks: the body ends when the server closes
+                closeAfterResponse = true;
+                while (true)
+                {
+                    if (readStart == readEnd && !await Fill()) return;
+                    sink(readBuffer, readStart, readEnd - readStart);
+                    readStart = readEnd;
+                }
+            }
+
+            private async Task CopyExactly(long count, Action<byte[], int, int> sink)
+            {
+                while (count > 0)
+                {
+                    if (readStart == readEnd && !await Fill()) throw new IOException("Connection closed mid-body");
+                    int take = (int)Math.Min(count, readEnd - readStart);
+                    sink(readBuffer, readStart, take);
+                    readStart += take;
+                    count -= take;
+                }
+            }
+
+            private async Task<long> ReadChunkSize()
+            {
+                int end;
+                while ((end = LineEnd()) < 0)
+                {
+                    if (!await Fill()) throw new IOException("Connection closed mid-body");
+                }
+                long size = 0;
+                for (int i = readStart; i < end; i++)
+                {
+                    int digit = HexValue(readBuffer[i]);
+                    if (digit < 0) break; // chunk extensions after ';'
+                    size = size * 16 + digit;
+                }
+                readStart = end + 2;
+                return size;
+            }
+
+            private async Task<int> ReadLineLength()
+            {
+                int end;
+                while ((end = LineEnd()) < 0)
+                {
+                    if (!await Fill()) throw new IOException("Connection closed mid-body");
+                }
+                int length = end - readStart;
+                readStart = end + 2;
+                return length;
+            }
+
+            private static int HexValue(byte c)
+            {
+                if (c >= '0' && c <= '9') return c - '0';
+                if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+                if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+                return -1;
+            }
+
+            private int HeaderEnd()
+            {
+                for (int i = readStart; i + 3 < readEnd; i++)
+                {
+                    if (readBuffer[i] == '\r' && readBuffer[i + 1] == '\n' && readBuffer[i + 2] == '\r' && readBuffer[i + 3] == '\n') return i;
+                }
+                return -1;
+            }
+
+            private int LineEnd()
+            {
+                for (int i = readStart; i + 1 < readEnd; i++)
+                {
+                    if (readBuffer[i] == '\r' && readBuffer[i + 1] == '\n') return i;
+                }
+                return -1;
+            }
+
+            private async Task<bool> Fill()
+            {
+                if (readStart == readEnd)
+                {
+                    readStart = 0;
+                    readEnd = 0;
+                }
+                else if (readEnd == readBuffer.Length)
+                {
+                    if (readStart == 0) throw new IOException("Response header too large");
+                    Buffer.BlockCopy(readBuffer, readStart, readBuffer, 0, readEnd - readStart);
+                    readEnd -= readStart;
+                    readStart = 0;
+                }
+                int read = await stream.ReadAsync(readBuffer, readEnd, readBuffer.Length - readEnd);
+                if (read <= 0) return false;
+                readEnd += read;
+                owner.AddBytesReceived(read);
+                return true;
+            }
+
+            private void AppendBody(byte[] data, int offset, int count)
+            {
+                if (bodyLength + count > bodyBuffer.Length)
+                {
+                    int size = bodyBuffer.Length;
+                    while (size < bodyLength + count) size *= 2;
+                    Array.Resize(ref bodyBuffer, size);
+                }
+                Buffer.BlockCopy(data, offset, bodyBuffer, bodyLength, count);
+                bodyLength += count;
+            }
+        }
+
+        /// <summary>
+        /// What a RestStream needs from its connection, without exposing the connection type
+        /// </summary>
+        internal interface IAbortable
+        {
+            void Abort();
+        }
+    }
+
+    /// <summary>
+    /// A REST request: set it up, pass it to RestClient.Send and yield it from a coroutine; the response fields are
+    /// valid once IsDone.
+    /// </summary>
+    public sealed class RestRequest : CustomYieldInstruction
+    {
+        public string Method { get; }
+        public string Url { get; private set; }
+        public string Body { get; }
+        public byte[] BodyBytes { get; } // binary body, sent instead of Body
+        public int BodyLength { get; }
+        public string ContentType { get; } = "application/json; charset=utf-8";
+        public bool IsDone => done;
+        public long StatusCode { get; internal set; }
+        public string Text { get; private set; } // response body
+        public string Error { get; private set; } // transport failure, or "HTTP <status>" for non-2xx responses
+        public bool Success => done && Error == null;
+        public override bool keepWaiting => !done;
+
+        internal bool ResponseStarted { get; set; }
+
+        private readonly List<KeyValuePair<string, string>> requestHeaders = new List<KeyValuePair<string, string>>(2);
+        private readonly Dictionary<string, string> responseHeaders = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+        private readonly object waitGate = new object();
+        private volatile bool done;
+
+        public RestRequest(string method, string url, string body = null)
+        {
+            Method = method;
+            Url = url;
+            Body = body;
+        }
+
+        /// <summary>
+        /// A request with the first <paramref name="length"/> bytes of <paramref name="body"/> as its body. The array is
+        /// read when the request is written, so it must not change until IsDone.
+        /// </summary>
+        public RestRequest(string method, string url, byte[] body, int length, string contentType)
+        {
+            Method = method;
+            Url = url;
+            BodyBytes = body;
+            BodyLength = length;
+            ContentType = contentType;
+        }
+
+        /// <summary>
+        /// Block until the response is complete, for callers off the main thread. Returns false on timeout.
+        /// </summary>
+        public bool Wait(int millisecondsTimeout)
+        {
+            lock (waitGate)
+            {
+                while (!done)
+                {
+                    if (!Monitor.Wait(waitGate, millisecondsTimeout)) return done;
+                }
+            }
+            return true;
+        }
+
+        public void SetRequestHeader(string name, string value)
+        {
+            requestHeaders.Add(new KeyValuePair<string, string>(name, value));
+        }
+
+        public string GetResponseHeader(string name)
+        {
+            return responseHeaders.TryGetValue(name, out var value) ? value : null;
+        }
+
+        internal void AppendRequestHeaders(StringBuilder head)
+        {
+            foreach (var header in requestHeaders)
+            {
+                head.Append(header.Key).Append(": ").Append(header.Value).Append("\r\n");
+            }
+        }
+
+        internal void ClearResponseHeaders()
+        {
+            responseHeaders.Clear();
+        }
+
+        internal void SetResponseHeader(string name, string value)
+        {
+            responseHeaders[name] = value;
+        }
+
+        internal void SetResponseText(string text)
+        {
+            Text = text;
+        }
+
+        internal void Redirect(string url)
+        {
+            Url = url;
+        }
+
+        internal void Complete(string error)
+        {
+            if (error == null && (StatusCode < 200 || StatusCode >= 300)) error = "HTTP " + StatusCode;
+            Error = error;
+            done = true;
+            lock (waitGate)
+            {
+                Monitor.PulseAll(waitGate);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Body of a streaming response, buffered as it arrives for the main thread to Read
+    /// </summary>
+    public sealed class RestStream : IDisposable
+    {
+        public bool IsDone => done;
+        public bool IsAborted => aborted;
+        public long StatusCode { get; internal set; }
+        public string Error { get; private set; }
+        public long BytesReceived => Interlocked.Read(ref bytesReceived);
+
+        private readonly object gate = new object();
+        private byte[] buffer = new byte[16 * 1024];
+        private int start;
+        private int count;
+        private long bytesReceived;
+        private RestClient.IAbortable connection;
+        private volatile bool done;
+        private volatile bool aborted;
+
+        /// <summary>
+        /// Copy up to <paramref name="length"/> received bytes; 0 when nothing is waiting.
+        /// </summary>
+        public int Read(byte[] destination, int offset, int length)
+        {
+            lock (gate)
+            {
+                int take = Math.Min(length, count);
+                Buffer.BlockCopy(buffer, start, destination, offset, take);
+                start += take;
+                count -= take;
+                if (count == 0) start = 0;
+                return take;
+            }
+        }
+
+        public void Dispose()
+        {
+            RestClient.IAbortable open;
+            lock (gate)
+            {
+                aborted = true;
+                open = connection;
+                buffer = Array.Empty<byte>(); // nothing is read after disposal
+                start = 0;
+                count = 0;
+            }
+            open?.Abort();
+        }
+
+        internal bool Attach(RestClient.IAbortable open)
+        {
+            lock (gate)
+            {
+                if (aborted)
+                {
+                    open.Abort();
+                    return false;
+                }
+                connection = open;
+                return true;
+            }
+        }
+
+        internal void Append(byte[] data, int offset, int length)
+        {
+            lock (gate)
+            {
+                if (aborted) return;
+                if (start + count + length > buffer.Length)
+                {
+                    if (count + length > buffer.Length)
+                    {
+                        int size = buffer.Length;
+                        while (size < count + length) size *= 2;
+                        var grown = new byte[size];
+                        Buffer.BlockCopy(buffer, start, grown, 0, count);
+                        buffer = grown;
+                    }
+                    else
+                    {
+                        Buffer.BlockCopy(buffer, start, buffer, 0, count);
+                    }
+                    start = 0;
+                }
+                Buffer.BlockCopy(data, offset, buffer, start + count, length);
+                count += length;
+            }
+            Interlocked.Add(ref bytesReceived, length);
+        }
+
+        internal void Complete(string error)
+        {
+            Error = error;
+            done = true;
+        }
+    }
+
+    public struct RestMetrics
+    {
+        public long requests;
+        public long connectionsOpened; // TCP (and TLS) handshakes
+        public long requestsOnReusedConnections;
+        public long retries;
+        public long bytesSent;
+        public long bytesReceived;
+    }
+}
@@ -0,0 +1,124 @@
+using System;
+using System.Collections.Generic;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Local copy of a room's anchors (or of one grid cell of the room) plus the high-water mark: the newest server
+    /// write time ("at") seen, so one peer's fast clock cannot hide other peers' writes. Joining or resyncing only
+    /// needs writes at or after the mark, deletions included, because those are written as tombstones. The snapshot
+    /// persists as a small header holding the mark, followed by an AnchorCodec batch.
+    /// </summary>
+    public sealed class RoomAnchorSnapshot
+    {
+        public string RoomId { get; }
+        public string Cell { get; } // null for the whole room
+        public long HighWaterMark { get; private set; }
+        public bool IsDirty { get; private set; }
+        public int Count => anchors.Count;
+        public IEnumerable<AnchorData> Anchors => anchors.Values;
+
+        private const byte FileFormat = 2;
+        private const int HeaderBytes = 9; // format, then the high-water mark as a little-endian long
+
+        private readonly Dictionary<string, AnchorData> anchors = new Dictionary<string, AnchorData>();
+        private AnchorRecord[] records = new AnchorRecord[0];
+
+        public RoomAnchorSnapshot(string roomId, string cell = null)
+        {
+            RoomId = roomId;
+            Cell = cell;
+        }
+
+        public bool Contains(string id) => anchors.ContainsKey(id);
+
+        public bool TryGet(string id, out AnchorData anchor) => anchors.TryGetValue(id, out anchor);
+
+        public void Add(AnchorData anchor)
+        {
+            anchors[anchor.id] = anchor;
+            IsDirty = true;
+        }
+
+        /// <summary>
+        /// Note the server time of a delivered write or tombstone. The high-water mark only moves forward.
+        /// </summary>
+        public void Observe(long serverTime)
+        {
+            if (serverTime <= HighWaterMark) return;
+            HighWaterMark = serverTime;
+            IsDirty = true;
+        }
+
+        /// <summary>
+        /// Where an incremental query starts: <paramref name="slackMs"/> before the mark, so a write stamped just
+        /// before the newest one seen but committed after it is not missed. 0 until anything has been seen.
+        /// </summary>
+        public long QueryStart(long slackMs)
+        {
+            return HighWaterMark <= 0 ? 0 : Math.Max(0L, HighWaterMark - slackMs);
+        }
+
+        /// <summary>
+        /// Remove a deleted anchor. The high-water mark never moves back.
+        /// </summary>
+        public bool Remove(string id)
+        {
+            if (!anchors.Remove(id)) return false;
+            IsDirty = true;
+            return true;
+        }
+
+        public void MarkSaved()
+        {
+            IsDirty = false;
+        }
+
+        /// <summary>
+        /// Encode the high-water mark and every anchor with a GUID id. Returns the bytes written into <paramref name="buffer"/>.
+        /// </summary>
+        public int Encode(AnchorCodec codec, ref byte[] buffer)
+        {
+            if (records.Length < anchors.Count) records = new AnchorRecord[anchors.Count];
+            int count = 0;
+            foreach (var anchor in anchors.Values)
+            {
+                if (!AnchorCodec.TryParseCanonicalId(anchor.id, out _)) continue; // other ids only live in memory
+                records[count++] = AnchorRecord.FromAnchorData(anchor);
+            }
+
+            if (buffer == null || buffer.Length < 64) buffer = new byte[Math.Max(64, HeaderBytes + count * 48)];
+            int written;
+            while ((written = codec.EncodeBatch(records, count, buffer, HeaderBytes)) < 0)
+            {
+                buffer = new byte[buffer.Length * 2];
+            }
+            Array.Clear(records, 0, count);
+            buffer[0] = FileFormat;
+            ulong mark = (ulong)HighWaterMark;
+            for (int i = 0; i < 8; i++) buffer[1 + i] = (byte)(mark >> (8 * i));
+            return HeaderBytes + written;
+        }
+
+        public static RoomAnchorSnapshot Decode(string roomId, string cell, byte[] data, int length, AnchorCodec codec)
+        {
+            // Anything else (including files from before the header) is treated as no snapshot: a full fetch follows
+            var snapshot = new RoomAnchorSnapshot(roomId, cell);
+            if (data == null || length < HeaderBytes || data[0] != FileFormat) return snapshot;
+            int count = AnchorCodec.PeekBatchCount(data, HeaderBytes, length - HeaderBytes);
+            if (count < 0) return snapshot;
+
+            var decoded = new AnchorRecord[count];
+            if (count > 0 && codec.DecodeBatch(data, HeaderBytes, length - HeaderBytes, decoded) != count) return snapshot;
+            foreach (var record in decoded)
+            {
+                snapshot.Add(record.ToAnchorData());
+            }
+            ulong mark = 0;
+            for (int i = 0; i < 8; i++) mark |= (ulong)data[1 + i] << (8 * i);
+            snapshot.HighWaterMark = (long)mark;
+            snapshot.IsDirty = false;
+            return snapshot;
+        }
+    }
+}
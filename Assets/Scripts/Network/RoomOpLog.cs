@@ -0,0 +1,122 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// One replica's view of a room's operation log. Local edits become RoomOps stamped by a HybridClock; ops from the
+    /// server and compacted snapshots merge into a RoomState. Each op the server echoes back carries the server time it
+    /// was appended ("at"); once CompactAfterOps ops have accumulated past the loaded snapshot this replica can write a
+    /// new snapshot covering them, so a joiner loads one snapshot plus a short tail.
+    /// </summary>
+    public sealed class RoomOpLog
+    {
+        public RoomState State { get; } = new RoomState();
+        public string ReplicaId { get; }
+        public HybridClock Clock { get; }
+        public long SnapshotThrough { get; private set; } // server "at" of the newest op folded into the loaded snapshot
+        public int TailLength => tail.Count;
+        public int CompactAfterOps { get; set; } = 200;
+        public bool ShouldCompact => tail.Count >= CompactAfterOps;
+
+        private readonly Dictionary<string, long> tail = new Dictionary<string, long>(); // op key -> server "at"
+        private List<string> previousGeneration = new List<string>();
+        private readonly List<RoomOp> snapshotOps = new List<RoomOp>();
+
+        public RoomOpLog(string replicaId, HybridClock clock = null)
+        {
+            ReplicaId = replicaId;
+            Clock = clock ?? new HybridClock();
+        }
+
+        /// <summary>
+        /// Unique, clock-ordered database key for an op, e.g. "0001936f3c2a0000-3f2a...".
+        /// </summary>
+        public static string OpKey(RoomOp op)
+        {
+            return op.clock.ToString("x16", CultureInfo.InvariantCulture) + "-" + op.replica;
+        }
+
+        public RoomOp Upsert(AnchorData anchor)
+        {
+            var op = new RoomOp { kind = RoomOpKind.Upsert, anchorId = anchor.id, clock = Clock.Now(), replica = ReplicaId, anchor = anchor };
+            State.Apply(op);
+            return op;
+        }
+
+        public RoomOp Remove(string anchorId)
+        {
+            var op = new RoomOp { kind = RoomOpKind.Remove, anchorId = anchorId, clock = Clock.Now(), replica = ReplicaId };
+            State.Apply(op);
+            return op;
+        }
+
+        /// <summary>
+        /// Merge an op read from the log; <paramref name="appendedAt"/> is the server time it was appended. An op cannot
+        /// have been made after it was appended, so a clock more than Clock.MaxDriftMs past that is a skewed replica's and
+        /// is capped there. Every replica reads the same "at", so they all cap it alike and still converge.
+        /// </summary>
+        public RoomStateChange ApplyRemote(string key, long appendedAt, RoomOp op)
+        {
+            if (appendedAt > 0)
+            {
+                long bound = (appendedAt + Clock.MaxDriftMs) << HybridClock.CounterBits;
+                if (op.clock > bound) op.clock = bound;
+            }
+            Clock.Observe(op.clock);
+            if (appendedAt > SnapshotThrough) tail[key] = appendedAt;
+            return State.Apply(op);
+        }
+
+        /// <summary>
+        /// Merge a compacted snapshot covering ops appended up to <paramref name="through"/>. Changes are reported per op.
+        /// </summary>
+        public bool LoadSnapshot(byte[] data, int length, long through, AnchorCodec codec, Action<RoomOp, RoomStateChange> onChange = null)
+        {
+            snapshotOps.Clear();
+            if (!RoomState.TryDecodeSnapshot(data, 0, length, codec, snapshotOps)) return false;
+            foreach (var op in snapshotOps)
+            {
+                Clock.Observe(op.clock);
+                var change = State.Apply(op);
+                onChange?.Invoke(op, change);
+            }
+            snapshotOps.Clear();
+
+            if (through > SnapshotThrough)
+            {
+                SnapshotThrough = through;
+                var folded = new List<string>();
+                foreach (var entry in tail)
+                {
+                    if (entry.Value <= through) folded.Add(entry.Key);
+                }
+                foreach (var key in folded)
+                {
+                    tail.Remove(key);
+                }
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Snapshot of the whole state, advancing SnapshotThrough to the newest op seen. Keys of the ops folded into the
+        /// previous snapshot are added to <paramref name="prunable"/>: they can be deleted from the server in the same
+        /// write. The generation just folded is kept so a joiner that loaded the old snapshot can still read its tail.
+        /// </summary>
+        public byte[] Compact(AnchorCodec codec, List<string> prunable)
+        {
+            long through = SnapshotThrough;
+            foreach (var appendedAt in tail.Values)
+            {
+                if (appendedAt > through) through = appendedAt;
+            }
+            prunable.AddRange(previousGeneration);
+            previousGeneration = new List<string>(tail.Keys);
+            tail.Clear();
+            SnapshotThrough = through;
+            return State.EncodeSnapshot(codec);
+        }
+    }
+}
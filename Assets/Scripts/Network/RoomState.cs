@@ -0,0 +1,259 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Anchors of a room as an LWW-element-set CRDT. Every anchor id keeps the newest upsert and the newest remove,
+    /// each stamped with (HybridClock time, replica id); the anchor is present while its upsert is newer than its remove.
+    /// Applying ops is idempotent, commutative and associative, so replicas that have seen the same ops agree
+    /// regardless of delivery order or duplication. Removed anchors leave tombstones until pruned.
+    /// </summary>
+    public sealed class RoomState
+    {
+        public const byte SnapshotVersion = 1;
+
+        public int Count { get; private set; }
+        public int ElementCount => elements.Count;
+        public long MaxClock { get; private set; }
+
+        public IEnumerable<AnchorData> Anchors
+        {
+            get
+            {
+                foreach (var element in elements.Values)
+                {
+                    if (element.Visible) yield return element.value;
+                }
+            }
+        }
+
+        private readonly Dictionary<string, Element> elements = new Dictionary<string, Element>();
+
+        public bool TryGetAnchor(string id, out AnchorData anchor)
+        {
+            anchor = null;
+            if (id == null || !elements.TryGetValue(id, out var element) || !element.Visible) return false;
+            anchor = element.value;
+            return true;
+        }
+
+        /// <summary>
+        /// Merge one op. Returns Upserted when the anchor is present with a new value, Removed when it just disappeared,
+        /// None when the op was stale, a duplicate, or changed nothing visible.
+        /// </summary>
+        public RoomStateChange Apply(RoomOp op)
+        {
+            if (op == null || string.IsNullOrEmpty(op.anchorId)) return RoomStateChange.None;
+            if (op.kind != RoomOpKind.Upsert && op.kind != RoomOpKind.Remove) return RoomStateChange.None;
+            if (op.kind == RoomOpKind.Upsert && op.anchor == null) return RoomStateChange.None;
+            if (op.clock > MaxClock) MaxClock = op.clock;
+
+            if (!elements.TryGetValue(op.anchorId, out var element))
+            {
+                element = new Element();
+                elements[op.anchorId] = element;
+            }
+            bool wasVisible = element.Visible;
+
+            if (op.kind == RoomOpKind.Upsert)
+            {
+                if (Compare(op.clock, op.replica, element.addClock, element.addReplica) <= 0) return RoomStateChange.None;
+                element.value = op.anchor;
+                element.addClock = op.clock;
+                element.addReplica = op.replica;
+            }
+            else
+            {
+                if (Compare(op.clock, op.replica, element.removeClock, element.removeReplica) <= 0) return RoomStateChange.None;
+                element.removeClock = op.clock;
+                element.removeReplica = op.replica;
+            }
+
+            bool visible = element.Visible;
+            if (visible != wasVisible) Count += visible ? 1 : -1;
+            if (op.kind == RoomOpKind.Upsert) return visible ? RoomStateChange.Upserted : RoomStateChange.None;
+            return wasVisible && !visible ? RoomStateChange.Removed : RoomStateChange.None;
+        }
+
+        /// <summary>
+        /// Forget tombstones removed before <paramref name="clock"/>. An upsert older than that arriving afterwards would
+        /// resurrect its anchor, so the horizon should be far longer than any replica stays offline.
+        /// </summary>
+        public int PruneTombstones(long clock)
+        {
+            var pruned = new List<string>();
+            foreach (var element in elements)
+            {
+                if (!element.Value.Visible && element.Value.removeClock < clock) pruned.Add(element.Key);
+            }
+            foreach (var id in pruned)
+            {
+                elements.Remove(id);
+            }
+            return pruned.Count;
+        }
+
+        /// <summary>
+        /// The smallest op list that rebuilds this state: one upsert per present anchor, one remove per tombstone.
+        /// </summary>
+        public byte[] EncodeSnapshot(AnchorCodec codec)
+        {
+            using (var stream = new MemoryStream(64 + elements.Count * 64))
+            {
+                stream.WriteByte(SnapshotVersion);
+                stream.Write(BitConverter.GetBytes(elements.Count), 0, 4);
+                var op = new RoomOp();
+                foreach (var element in elements)
+                {
+                    // A present anchor's older remove cannot affect future merges, nor can a tombstone's older upsert
+                    bool visible = element.Value.Visible;
+                    op.kind = visible ? RoomOpKind.Upsert : RoomOpKind.Remove;
+                    op.anchorId = element.Key;
+                    op.clock = visible ? element.Value.addClock : element.Value.removeClock;
+                    op.replica = visible ? element.Value.addReplica : element.Value.removeReplica;
+                    op.anchor = visible ? element.Value.value : null;
+                    byte[] bytes = RoomOp.Encode(op, codec);
+                    stream.Write(BitConverter.GetBytes(bytes.Length), 0, 4);
+                    stream.Write(bytes, 0, bytes.Length);
+                }
+                return stream.ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Decode a snapshot into the ops that rebuild it; apply them to merge the snapshot into a state.
+        /// </summary>
+        public static bool TryDecodeSnapshot(byte[] data, int offset, int count, AnchorCodec codec, List<RoomOp> ops)
+        {
+            if (data == null || count < 5 || offset < 0 || offset + count > data.Length || data[offset] != SnapshotVersion) return false;
+            int end = offset + count;
+            int records = BitConverter.ToInt32(data, offset + 1);
+            int pos = offset + 5;
+            for (int i = 0; i < records; i++)
+            {
+                if (end - pos < 4) return false;
+                int length = BitConverter.ToInt32(data, pos);
+                pos += 4;
+                if (length < 0 || length > end - pos || !RoomOp.TryDecode(data, pos, length, codec, out var op)) return false;
+                ops.Add(op);
+                pos += length;
+            }
+            return true;
+        }
+
+        private static int Compare(long clockA, string replicaA, long clockB, string replicaB)
+        {
+            if (clockA != clockB) return clockA < clockB ? -1 : 1;
+            return string.CompareOrdinal(replicaA, replicaB);
+        }
+
+        private sealed class Element
+        {
+            public AnchorData value;
+            public long addClock;
+            public string addReplica;
+            public long removeClock;
+            public string removeReplica;
+
+            public bool Visible => addClock != 0 && Compare(addClock, addReplica, removeClock, removeReplica) > 0;
+        }
+    }
+
+    public enum RoomStateChange
+    {
+        None,
+        Upserted,
+        Removed
+    }
+
+    public enum RoomOpKind : byte
+    {
+        Upsert = 1,
+        Remove = 2
+    }
+
+    /// <summary>
+    /// One edit in a room's operation log
+    /// </summary>
+    public class RoomOp
+    {
+        public const byte FormatVersion = 1;
+
+        public RoomOpKind kind;
+        public string anchorId;
+        public long clock; // HybridClock timestamp
+        public string replica; // breaks ties between equal clocks
+        public AnchorData anchor; // null for removes
+
+        /// <summary>
+        /// Version, kind, int64 clock, length-prefixed replica id, then an AnchorCodec record (upsert) or the UTF-8 id (remove).
+        /// </summary>
+        public static byte[] Encode(RoomOp op, AnchorCodec codec)
+        {
+            byte[] replica = Encoding.UTF8.GetBytes(op.replica ?? string.Empty);
+            if (replica.Length > 255) throw new ArgumentException("Replica id too long", nameof(op));
+            byte[] body;
+            int bodyLength;
+            if (op.kind == RoomOpKind.Upsert)
+            {
+                body = new byte[128];
+                while ((bodyLength = codec.Encode(op.anchor, body, 0)) < 0)
+                {
+                    body = new byte[body.Length * 2];
+                }
+            }
+            else
+            {
+                body = Encoding.UTF8.GetBytes(op.anchorId);
+                bodyLength = body.Length;
+            }
+
+            var data = new byte[2 + 8 + 1 + replica.Length + bodyLength];
+            data[0] = FormatVersion;
+            data[1] = (byte)op.kind;
+            Buffer.BlockCopy(BitConverter.GetBytes(op.clock), 0, data, 2, 8);
+            data[10] = (byte)replica.Length;
+            Buffer.BlockCopy(replica, 0, data, 11, replica.Length);
+            Buffer.BlockCopy(body, 0, data, 11 + replica.Length, bodyLength);
+            return data;
+        }
+
+        public static bool TryDecode(byte[] data, int offset, int count, AnchorCodec codec, out RoomOp op)
+        {
+            op = null;
+            if (data == null || count < 11 || data[offset] != FormatVersion) return false;
+            var kind = (RoomOpKind)data[offset + 1];
+            int replicaLength = data[offset + 10];
+            int bodyOffset = offset + 11 + replicaLength;
+            int bodyLength = offset + count - bodyOffset;
+            if (bodyLength <= 0) return false;
+
+            var decoded = new RoomOp
+            {
+                kind = kind,
+                clock = BitConverter.ToInt64(data, offset + 2),
+                replica = Encoding.UTF8.GetString(data, offset + 11, replicaLength)
+            };
+            if (kind == RoomOpKind.Upsert)
+            {
+                var anchor = new AnchorData();
+                if (!codec.TryDecode(data, bodyOffset, bodyLength, anchor, out _)) return false;
+                decoded.anchor = anchor;
+                decoded.anchorId = anchor.id;
+            }
+            else if (kind == RoomOpKind.Remove)
+            {
+                decoded.anchorId = Encoding.UTF8.GetString(data, bodyOffset, bodyLength);
+            }
+            else
+            {
+                return false;
+            }
+            op = decoded;
+            return true;
+        }
+    }
+}
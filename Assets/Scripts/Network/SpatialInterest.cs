@@ -0,0 +1,123 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using UnityEngine;
+
+namespace ARLinguaSphere.Network
+{
+    /// <summary>
+    /// Set of horizontal grid cells (x/z, relative to the room origin) within Radius of a moving position.
+    /// A cell enters once any part of it is within Radius and only leaves beyond Radius + Hysteresis,
+    /// so walking along a cell edge does not resubscribe every frame.
+    /// </summary>
+    public sealed class SpatialInterest
+    {
+        public float CellSize { get; }
+        public float Radius { get; set; }
+        public float Hysteresis { get; set; }
+        public Vector3 Origin { get; set; }
+        public int Count => cells.Count;
+        public IEnumerable<string> Cells => cells.Values;
+
+        private readonly Dictionary<long, string> cells = new Dictionary<long, string>();
+        private readonly List<long> exiting = new List<long>();
+
+        public SpatialInterest(float cellSize, float radius, float hysteresis = 0f)
+        {
+            CellSize = Mathf.Max(0.01f, cellSize);
+            Radius = Mathf.Max(0f, radius);
+            Hysteresis = Mathf.Max(0f, hysteresis);
+        }
+
+        /// <summary>
+        /// Key of the cell holding <paramref name="worldPosition"/>, e.g. "3_-2". Every peer sharing the room origin
+        /// and cell size derives the same key.
+        /// </summary>
+        public string CellOf(Vector3 worldPosition)
+        {
+            return CellOf(worldPosition, Origin, CellSize);
+        }
+
+        public static string CellOf(Vector3 worldPosition, Vector3 origin, float cellSize)
+        {
+            var local = worldPosition - origin;
+            return CellKey(Mathf.FloorToInt(local.x / cellSize), Mathf.FloorToInt(local.z / cellSize));
+        }
+
+        public static string CellKey(int x, int z)
+        {
+            return x.ToString(CultureInfo.InvariantCulture) + "_" + z.ToString(CultureInfo.InvariantCulture);
+        }
+
+        /// <summary>
+        /// Move the centre to <paramref name="position"/>, adding cells that entered and cells that left to the lists.
+        /// Returns true if the set changed.
+        /// </summary>
+        public bool Update(Vector3 position, List<string> entered, List<string> exited)
+        {
+            var local = position - Origin;
+            float keep = Radius + Hysteresis;
+
+            exiting.Clear();
+            foreach (var cell in cells)
+            {
+                Unpack(cell.Key, out int x, out int z);
+                if (DistanceToCell(local.x, local.z, x, z) > keep) exiting.Add(cell.Key);
+            }
+            foreach (long packed in exiting)
+            {
+                exited.Add(cells[packed]);
+                cells.Remove(packed);
+            }
+
+            int minX = Mathf.FloorToInt((local.x - Radius) / CellSize);
+            int maxX = Mathf.FloorToInt((local.x + Radius) / CellSize);
+            int minZ = Mathf.FloorToInt((local.z - Radius) / CellSize);
+            int maxZ = Mathf.FloorToInt((local.z + Radius) / CellSize);
+            int added = 0;
+            for (int x = minX; x <= maxX; x++)
+            {
+                for (int z = minZ; z <= maxZ; z++)
+                {
+                    long packed = Pack(x, z);
+                    if (cells.ContainsKey(packed) || DistanceToCell(local.x, local.z, x, z) > Radius) continue;
+                    string key = CellKey(x, z);
+                    cells[packed] = key;
+                    entered.Add(key);
+                    added++;
+                }
+            }
+            return added > 0 || exiting.Count > 0;
+        }
+
+        /// <summary>
+        /// Drop every cell, adding them to <paramref name="exited"/>.
+        /// </summary>
+        public void Clear(List<string> exited)
+        {
+            exited.AddRange(cells.Values);
+            cells.Clear();
+        }
+
+        private float DistanceToCell(float px, float pz, int x, int z)
+        {
+            // Distance from the point to the nearest point of the cell's square
+            float minX = x * CellSize;
+            float minZ = z * CellSize;
+            float dx = Math.Max(Math.Max(minX - px, 0f), px - (minX + CellSize));
+            float dz = Math.Max(Math.Max(minZ - pz, 0f), pz - (minZ + CellSize));
+            return Mathf.Sqrt(dx * dx + dz * dz);
+        }
+
+        private static long Pack(int x, int z)
+        {
+            return ((long)x << 32) | (uint)z;
+        }
+
+        private static void Unpack(long packed, out int x, out int z)
+        {
+            x = (int)(packed >> 32);
+            z = (int)(packed & 0xFFFFFFFF);
+        }
+    }
+}
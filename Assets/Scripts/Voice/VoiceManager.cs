@@ -1,6 +1,8 @@
 using UnityEngine;
 using System;
 using System.Collections;
+using System.Collections.Generic;
+using ARLinguaSphere.Core;
 
 namespace ARLinguaSphere.Voice
 {
@@ -24,6 +26,9 @@ namespace ARLinguaSphere.Voice
         private bool isListening = false;
         private bool isSpeaking = false;
         private AndroidSpeechBridge androidBridge;
+        private LexiconIndex commandIndex; // phrases safe to match with a typo
+        private LexiconIndex exactCommandIndex; // destructive or easily confused keywords
+        private Dictionary<string, VoiceCommand> commandsByKey;
         
         // Events
         public event Action<string> OnSpeechRecognized;
@@ -190,45 +195,77 @@ namespace ARLinguaSphere.Voice
         public bool IsListening => isListening;
         public bool IsSpeaking => isSpeaking;
         
-        public void ProcessVoiceCommand(string command)
+        public VoiceCommand ProcessVoiceCommand(string command)
         {
             if (string.IsNullOrEmpty(command))
             {
-                return;
+                return VoiceCommand.None;
             }
             
-            command = command.ToLower().Trim();
+            EnsureCommandIndex();
             
-            // Process voice commands
-            if (command.Contains("what is this") || command.Contains("identify"))
-            {
-                // Trigger object identification
-                Debug.Log("VoiceManager: Processing 'identify' command");
-            }
-            else if (command.Contains("translate"))
+            // Fuzzy phrase match tolerates recogniser misspellings ("quizz me", "identifi"); keywords like
+            // "remove" only count when heard exactly, so "remote" never clears the labels
+            VoiceCommand result = VoiceCommand.None;
+            bool found = commandIndex.TryResolveInPhrase(command, out var match);
+            if ((!found || match.distance > 0) && exactCommandIndex.TryResolveInPhrase(command, out var exact))
             {
-                // Extract target language and trigger translation
-                Debug.Log("VoiceManager: Processing 'translate' command");
+                match = exact;
+                found = true;
             }
-            else if (command.Contains("quiz"))
+            if (found)
             {
-                // Trigger quiz mode
-                Debug.Log("VoiceManager: Processing 'quiz' command");
+                result = commandsByKey[match.key];
             }
-            else if (command.Contains("remove") || command.Contains("delete"))
+            
+            if (result == VoiceCommand.None)
             {
-                // Remove current label
-                Debug.Log("VoiceManager: Processing 'remove' command");
+                Debug.Log($"VoiceManager: Unknown command: {command}");
             }
-            else if (command.Contains("language") || command.Contains("change"))
+            else
             {
-                // Change language
-                Debug.Log("VoiceManager: Processing 'change language' command");
+                Debug.Log($"VoiceManager: Processing '{result}' command");
             }
-            else
+            return result;
+        }
+        
+        private void EnsureCommandIndex()
+        {
+            if (commandIndex != null) return;
+            
+            commandIndex = new LexiconIndex(1);
+            exactCommandIndex = new LexiconIndex(0);
+            commandsByKey = new Dictionary<string, VoiceCommand>();
+            AddCommand(commandIndex, VoiceCommand.Identify, "what is this", "identify");
+            AddCommand(commandIndex, VoiceCommand.Translate, "translate", "translate to");
+            AddCommand(commandIndex, VoiceCommand.Quiz, "quiz me", "test me");
+            AddCommand(commandIndex, VoiceCommand.ChangeLanguage, "change language", "switch language");
+            // One edit away from everyday words ("quit", "remote")
+            AddCommand(exactCommandIndex, VoiceCommand.Quiz, "quiz");
+            AddCommand(exactCommandIndex, VoiceCommand.Remove, "remove", "delete");
+        }
+        
+        private void AddCommand(LexiconIndex index, VoiceCommand command, params string[] phrases)
+        {
+            string key = command.ToString();
+            commandsByKey[key] = command;
+            foreach (var phrase in phrases)
             {
-                Debug.Log($"VoiceManager: Unknown command: {command}");
+                index.Add(phrase, key, null);
             }
         }
     }
+    
+    /// <summary>
+    /// Voice commands recognised by VoiceManager
+    /// </summary>
+    public enum VoiceCommand
+    {
+        None,
+        Identify,
+        Translate,
+        Quiz,
+        Remove,
+        ChangeLanguage
+    }
 }
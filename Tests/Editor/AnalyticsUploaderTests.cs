@@ -0,0 +1,240 @@
+using System;
+using System.IO;
+using System.Linq;
+using NUnit.Framework;
+using ARLinguaSphere.Analytics;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for AnalyticsUploader, against a local ingestion server
+    /// </summary>
+    public class AnalyticsUploaderTests
+    {
+        private const int Timeout = 10000;
+
+        private string directory;
+        private InteractionLog log;
+        private LocalIngestServer server;
+
+        [SetUp]
+        public void Setup()
+        {
+            directory = Path.Combine(Path.GetTempPath(), "als_upload_" + Guid.NewGuid().ToString("N"));
+            log = InteractionLog.Open(directory, segmentRecords: 512);
+            server = new LocalIngestServer();
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            server.Dispose();
+            log.Dispose();
+            Directory.Delete(directory, true);
+        }
+
+        [Test]
+        public void AnalyticsUploader_Backlog_ArrivesInOrderInBatchesUnderLimit()
+        {
+            // Arrange
+            Append(0, 3000);
+            using (var uploader = new AnalyticsUploader(log, server.Url, "user\"1", 1024))
+            {
+                // Act
+                uploader.Start();
+
+                // Assert
+                Assert.IsTrue(server.WaitForEvents(3000, Timeout));
+                CollectionAssert.AreEqual(Enumerable.Range(0, 3000).Select(i => (long)i), server.EventIds());
+                var batches = server.Batches;
+                Assert.Greater(batches.Count, 1);
+                Assert.IsTrue(batches.All(b => b.gzip && b.wireBytes <= 1024), "every batch within the limit");
+                Assert.IsTrue(batches.All(b => b.userId == "user\"1"));
+                WaitFor(() => uploader.Checkpoint == 3000);
+                Assert.AreEqual(3000, uploader.Metrics.events);
+            }
+        }
+
+        [Test]
+        public void AnalyticsUploader_FailedBatches_RetriedWithoutLossOrDuplicates()
+        {
+            // Arrange
+            Append(0, 200);
+            server.FailNext(503, "0");
+            server.FailNext(500);
+            server.FailNext(429, "0");
+            using (var uploader = new AnalyticsUploader(log, server.Url, "user1", 2048) { BaseBackoffSeconds = 0.01f })
+            {
+                // Act
+                uploader.Start();
+                Assert.IsTrue(server.WaitForEvents(200, Timeout));
+                Append(200, 50);
+                uploader.Wake();
+
+                // Assert
+                Assert.IsTrue(server.WaitForEvents(250, Timeout));
+                CollectionAssert.AreEqual(Enumerable.Range(0, 250).Select(i => (long)i), server.EventIds());
+                Assert.AreEqual(3, uploader.Metrics.failures);
+            }
+        }
+
+        [Test]
+        public void AnalyticsUploader_UploadWhileSegmentsSeal_SendsEveryInteractionOnce()
+        {
+            // Arrange
+            const int total = 6000;
+            using (var uploader = new AnalyticsUploader(log, server.Url, "user1") { IntervalSeconds = 0.01f })
+            {
+                uploader.Start();
+
+                // Act - every 512 appends seals a segment while the uploader is reading behind the writer
+                for (int first = 0; first < total; first += 100)
+                {
+                    Append(first, 100);
+                    uploader.Wake();
+                }
+
+                // Assert
+                Assert.IsTrue(server.WaitForEvents(total, Timeout));
+                WaitFor(() => uploader.Checkpoint == total);
+                CollectionAssert.AreEqual(Enumerable.Range(0, total).Select(i => (long)i), server.EventIds());
+            }
+        }
+
+        [Test]
+        public void AnalyticsUploader_MissingSegment_HoldsCheckpointBeforeGap()
+        {
+            // Arrange - the second of three sealed segments is lost from disk
+            Append(0, 1600);
+            log.Dispose();
+            File.Delete(Path.Combine(directory, "00000001.seg.gz"));
+            log = InteractionLog.Open(directory);
+            using (var uploader = new AnalyticsUploader(log, server.Url, "user1") { IntervalSeconds = 0.01f })
+            {
+                // Act
+                uploader.Start();
+
+                // Assert
+                Assert.IsTrue(server.WaitForEvents(512, Timeout));
+                System.Threading.Thread.Sleep(200);
+                CollectionAssert.AreEqual(Enumerable.Range(0, 512).Select(i => (long)i), server.EventIds());
+                Assert.AreEqual(512, uploader.Checkpoint);
+            }
+        }
+
+        [Test]
+        public void AnalyticsUploader_Restart_ResumesFromCheckpoint()
+        {
+            // Arrange
+            Append(0, 100);
+            using (var uploader = new AnalyticsUploader(log, server.Url, "user1"))
+            {
+                uploader.Start();
+                Assert.IsTrue(server.WaitForEvents(100, Timeout));
+                WaitFor(() => uploader.Checkpoint == 100);
+            }
+            Append(100, 20);
+
+            // Act
+            using (var uploader = new AnalyticsUploader(log, server.Url, "user1"))
+            {
+                Assert.AreEqual(100, uploader.Checkpoint);
+                uploader.Start();
+
+                // Assert
+                Assert.IsTrue(server.WaitForEvents(120, Timeout));
+                CollectionAssert.AreEqual(Enumerable.Range(0, 120).Select(i => (long)i), server.EventIds());
+            }
+        }
+
+        [Test]
+        public void AnalyticsUploader_DisposeWhileAwaitingResponse_AbandonsBatchAndReturnsPromptly()
+        {
+            // Arrange - the endpoint takes the batch but does not answer yet
+            Append(0, 100);
+            server.HoldResponses();
+            var uploader = new AnalyticsUploader(log, server.Url, "user1");
+            uploader.Start();
+            WaitFor(() => server.Requests == 1);
+
+            // Act
+            var timer = System.Diagnostics.Stopwatch.StartNew();
+            uploader.Dispose();
+            timer.Stop();
+            server.ReleaseResponses();
+
+            // Assert - the checkpoint did not move, so the next uploader sends the batch again
+            Assert.Less(timer.ElapsedMilliseconds, 2000);
+            Assert.AreEqual(0, uploader.Checkpoint);
+            using (var next = new AnalyticsUploader(log, server.Url, "user1"))
+            {
+                Assert.AreEqual(0, next.Checkpoint);
+                next.Start();
+                WaitFor(() => next.Checkpoint == 100);
+            }
+        }
+
+        [Test]
+        public void InteractionBatchEncoder_WarmBuffer_EncodesWithoutAllocating()
+        {
+            // Arrange
+            Append(0, 100);
+            log.Append(InteractionType.QuizAnswered, "café \"au\" lait\n", null, true, 0.5f, 1);
+            var records = new InteractionRecord[128];
+            int count = log.Read(0, records, out _);
+            var encoder = new InteractionBatchEncoder("user1");
+            Encode(encoder, records, count); // grow the buffer
+
+            // Act
+            long before = GC.GetAllocatedBytesForCurrentThread();
+            Encode(encoder, records, count);
+            long allocated = GC.GetAllocatedBytesForCurrentThread() - before;
+
+            // Assert
+            Assert.AreEqual(0, allocated);
+            string json = System.Text.Encoding.UTF8.GetString(encoder.Buffer, 0, encoder.Length);
+            var index = new JsonIndex();
+            Assert.IsTrue(index.Load(json));
+            Assert.IsTrue(index.Root.TryGetField("events", out var events));
+            var cursor = events.GetArray();
+            int parsed = 0;
+            JsonNode last = default;
+            while (cursor.MoveNext())
+            {
+                last = cursor.Current;
+                parsed++;
+            }
+            Assert.AreEqual(101, parsed);
+            Assert.IsTrue(last.TryGetField("label", out var label));
+            Assert.AreEqual("café \"au\" lait\n", label.GetString());
+            Assert.IsTrue(last.TryGetField("action", out var action));
+            Assert.AreEqual("QuizAnswered", action.GetString());
+        }
+
+        private void Append(int first, int count)
+        {
+            for (int i = first; i < first + count; i++)
+            {
+                log.Append(InteractionType.QuizAnswered, "word" + (i % 40), i % 2 == 0 ? "anchor" + (i % 7) : null, i % 3 != 0, 1.25f, 1700000000000L + i);
+            }
+        }
+
+        private void Encode(InteractionBatchEncoder encoder, InteractionRecord[] records, int count)
+        {
+            encoder.Begin();
+            for (int i = 0; i < count; i++)
+            {
+                encoder.Add(records[i], log);
+            }
+            encoder.End();
+        }
+
+        private static void WaitFor(Func<bool> condition)
+        {
+            var deadline = DateTime.UtcNow.AddMilliseconds(Timeout);
+            while (!condition() && DateTime.UtcNow < deadline) System.Threading.Thread.Sleep(10);
+            Assert.IsTrue(condition());
+        }
+    }
+}
@@ -0,0 +1,196 @@
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Network;
+using Is = UnityEngine.TestTools.Constraints.Is;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for AnchorCodec
+    /// </summary>
+    public class AnchorCodecTests
+    {
+        private const float PositionTolerance = AnchorCodec.PositionResolution * 0.5f + 1e-4f;
+        private const float RotationToleranceDegrees = 0.5f;
+
+        private AnchorCodec codec;
+        private System.Random random;
+
+        [SetUp]
+        public void Setup()
+        {
+            codec = new AnchorCodec { RoomOrigin = new Vector3(12.5f, -1f, 3f) };
+            random = new System.Random(1234);
+        }
+
+        [Test]
+        public void AnchorCodec_RoundTrip_Fuzz()
+        {
+            var buffer = new byte[512];
+            var decoded = new AnchorData();
+            for (int i = 0; i < 5000; i++)
+            {
+                // Arrange
+                var anchor = RandomAnchor(i);
+
+                // Act
+                int written = codec.Encode(anchor, buffer, 0);
+                bool ok = codec.TryDecode(buffer, 0, written, decoded, out int read);
+
+                // Assert
+                Assert.IsTrue(ok, $"iteration {i}");
+                Assert.AreEqual(written, read);
+                AssertEquivalent(anchor, decoded, i);
+            }
+        }
+
+        [Test]
+        public void AnchorCodec_Base64_RoundTripsNonGuidIdAndNullStrings()
+        {
+            // Arrange
+            var anchor = new AnchorData
+            {
+                id = "legacy-anchor-7",
+                position = new Vector3(1f, 2f, 3f),
+                rotation = Quaternion.Euler(10f, 200f, -30f),
+                labelKey = "café",
+                creatorId = null,
+                timestamp = 1700000000123
+            };
+            var decoded = new AnchorData();
+
+            // Act
+            string base64 = codec.EncodeBase64(anchor);
+            bool ok = codec.TryDecodeBase64(base64, decoded);
+
+            // Assert
+            Assert.IsTrue(ok);
+            AssertEquivalent(anchor, decoded, 0);
+        }
+
+        [Test]
+        public void AnchorCodec_NonCanonicalGuidIds_RoundTripVerbatim()
+        {
+            // Arrange - each parses as a GUID but would come back as "3f2504e0-4f89-11d3-9a0c-0305e82c3301"
+            var ids = new[]
+            {
+                "3F2504E0-4F89-11D3-9A0C-0305E82C3301",
+                "{3f2504e0-4f89-11d3-9a0c-0305e82c3301}",
+                "3f2504e04f8911d39a0c0305e82c3301",
+                "3f2504e0-4f89-11d3-9a0c-0305e82c3301"
+            };
+            var buffer = new byte[512];
+            var decoded = new AnchorData();
+
+            foreach (var id in ids)
+            {
+                var anchor = new AnchorData { id = id, rotation = Quaternion.identity, labelKey = "cup", timestamp = 1700000000000 };
+
+                // Act
+                int written = codec.Encode(anchor, buffer, 0);
+                bool ok = codec.TryDecode(buffer, 0, written, decoded, out _);
+
+                // Assert
+                Assert.IsTrue(ok, id);
+                Assert.AreEqual(id, decoded.id);
+            }
+            Assert.IsTrue(AnchorCodec.TryParseCanonicalId(ids[3], out _));
+            Assert.IsFalse(AnchorCodec.TryParseCanonicalId(ids[0], out _));
+        }
+
+        [Test]
+        public void AnchorCodec_CorruptInput_ReturnsFalseWithoutThrowing()
+        {
+            var buffer = new byte[512];
+            var decoded = new AnchorData();
+            for (int i = 0; i < 2000; i++)
+            {
+                // Arrange
+                int written = codec.Encode(RandomAnchor(i), buffer, 0);
+                int length = random.Next(0, written + 1);
+                if (random.Next(2) == 0) buffer[random.Next(written)] ^= (byte)(1 << random.Next(8));
+
+                // Act & Assert
+                Assert.DoesNotThrow(() => codec.TryDecode(buffer, 0, length, decoded, out _));
+                Assert.DoesNotThrow(() => codec.DecodeBatch(buffer, 0, length, new AnchorRecord[4]));
+            }
+            Assert.IsFalse(codec.TryDecodeBase64("not base64!", decoded));
+        }
+
+        [Test]
+        public void AnchorCodec_Batch_RoundTripsAndSharesStrings()
+        {
+            // Arrange
+            const int count = 4000;
+            var records = new AnchorRecord[count];
+            for (int i = 0; i < count; i++) records[i] = AnchorRecord.FromAnchorData(RandomAnchor(i));
+            var buffer = new byte[count * 64];
+            var output = new AnchorRecord[count];
+
+            // Act
+            int written = codec.EncodeBatch(records, count, buffer, 0);
+            int decoded = codec.DecodeBatch(buffer, 0, written, output);
+
+            // Assert
+            Assert.AreEqual(count, AnchorCodec.PeekBatchCount(buffer, 0, written));
+            Assert.AreEqual(count, decoded);
+            Assert.Less(written, count * 40, "labels and creators should be back-referenced");
+            for (int i = 0; i < count; i++)
+            {
+                Assert.AreEqual(records[i].id, output[i].id);
+                AssertEquivalent(records[i].ToAnchorData(), output[i].ToAnchorData(), i);
+            }
+            Assert.AreEqual(-1, codec.EncodeBatch(records, count, new byte[64], 0));
+            Assert.AreEqual(-1, codec.DecodeBatch(buffer, 0, written, new AnchorRecord[count - 1]));
+        }
+
+        [Test]
+        public void AnchorCodec_Batch_DoesNotAllocateAfterWarmUp()
+        {
+            // Arrange
+            const int count = 4000;
+            var records = new AnchorRecord[count];
+            for (int i = 0; i < count; i++) records[i] = AnchorRecord.FromAnchorData(RandomAnchor(i));
+            var buffer = new byte[count * 64];
+            var output = new AnchorRecord[count];
+            int written = codec.EncodeBatch(records, count, buffer, 0);
+            codec.DecodeBatch(buffer, 0, written, output);
+
+            // Act & Assert
+            Assert.That(() => codec.EncodeBatch(records, count, buffer, 0), Is.Not.AllocatingGCMemory());
+            Assert.That(() => codec.DecodeBatch(buffer, 0, written, output), Is.Not.AllocatingGCMemory());
+        }
+
+        private AnchorData RandomAnchor(int i)
+        {
+            var rotation = new Quaternion(
+                (float)(random.NextDouble() * 2 - 1),
+                (float)(random.NextDouble() * 2 - 1),
+                (float)(random.NextDouble() * 2 - 1),
+                (float)(random.NextDouble() * 2 - 1));
+            return new AnchorData
+            {
+                position = codec.RoomOrigin + new Vector3(
+                    (float)(random.NextDouble() * 100 - 50),
+                    (float)(random.NextDouble() * 10 - 5),
+                    (float)(random.NextDouble() * 100 - 50)),
+                rotation = i % 17 == 0 ? Quaternion.identity : Quaternion.Normalize(rotation),
+                labelKey = i % 23 == 0 ? null : "label_" + random.Next(40),
+                creatorId = "device_" + random.Next(6),
+                timestamp = 1700000000000L + random.Next(0, 1000000) * (i % 5 == 0 ? -1 : 1)
+            };
+        }
+
+        private static void AssertEquivalent(AnchorData expected, AnchorData actual, int iteration)
+        {
+            Assert.AreEqual(expected.id, actual.id, $"id {iteration}");
+            Assert.AreEqual(expected.labelKey, actual.labelKey, $"labelKey {iteration}");
+            Assert.AreEqual(expected.creatorId, actual.creatorId, $"creatorId {iteration}");
+            Assert.AreEqual(expected.timestamp, actual.timestamp, $"timestamp {iteration}");
+            Assert.AreEqual(expected.position.x, actual.position.x, PositionTolerance, $"x {iteration}");
+            Assert.AreEqual(expected.position.y, actual.position.y, PositionTolerance, $"y {iteration}");
+            Assert.AreEqual(expected.position.z, actual.position.z, PositionTolerance, $"z {iteration}");
+            Assert.Less(Quaternion.Angle(expected.rotation, actual.rotation), RotationToleranceDegrees, $"rotation {iteration}");
+        }
+    }
+}
@@ -0,0 +1,204 @@
+using System.Collections.Generic;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+using NUnit.Framework;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for AnchorEventStream, including a local stand-in for the Realtime Database event stream
+    /// </summary>
+    public class AnchorEventStreamTests
+    {
+        private List<string> received;
+        private List<string> removed;
+        private AnchorEventStream stream;
+
+        [SetUp]
+        public void Setup()
+        {
+            received = new List<string>();
+            removed = new List<string>();
+            stream = new AnchorEventStream((id, node) => received.Add(id), id => removed.Add(id));
+        }
+
+        [Test]
+        public void AnchorEventStream_Feed_HandlesArbitraryChunkBoundaries()
+        {
+            // Arrange: CRLF line endings, a comment and a multi-byte character split across chunks
+            string text =
+                ": connected\r\n" +
+                "event: put\r\nid: 1\r\ndata: {\"path\":\"/\",\"data\":{\"a1\":{\"data\":\"x\"},\"a2\":{\"data\":\"y\"}}}\r\n\r\n" +
+                "event: patch\r\nid: 2\r\ndata: {\"path\":\"/\",\"data\":{\"café\":{\"data\":\"z\"}}}\r\n\r\n" +
+                "event: put\r\nid: 3\r\ndata: {\"path\":\"/a1/timestamp\",\"data\":5}\r\n\r\n" +
+                "event: put\r\nid: 4\r\ndata: {\"path\":\"/a2\",\"data\":null}\r\n\r\n" +
+                "event: keep-alive\r\ndata: null\r\n\r\n";
+            byte[] bytes = Encoding.UTF8.GetBytes(text);
+
+            // Act
+            for (int i = 0; i < bytes.Length; i += 3)
+            {
+                stream.Feed(bytes, i, System.Math.Min(3, bytes.Length - i));
+            }
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "a1", "a2", "café" }, received);
+            CollectionAssert.AreEqual(new[] { "a2" }, removed);
+            Assert.AreEqual("4", stream.LastEventId);
+            Assert.IsFalse(stream.IsClosed);
+        }
+
+        [Test]
+        public void AnchorEventStream_Cancel_ClosesStream()
+        {
+            // Arrange
+            byte[] bytes = Encoding.UTF8.GetBytes("event: cancel\ndata: null\n\n");
+
+            // Act
+            stream.Feed(bytes, 0, bytes.Length);
+
+            // Assert
+            Assert.IsTrue(stream.IsClosed);
+            Assert.AreEqual("cancel", stream.CloseReason);
+        }
+
+        [Test]
+        public void AnchorEventStream_StandInServer_ResumesAfterDisconnect()
+        {
+            // Arrange
+            var codec = new AnchorCodec();
+            var events = new List<string>
+            {
+                Put("/", "{\"a1\":" + Anchor(codec, "a1") + ",\"a2\":" + Anchor(codec, "a2") + "}"),
+                Put("/a3", Anchor(codec, "a3")),
+                Patch("/", "{\"a4\":" + Anchor(codec, "a4") + "}"),
+                Put("/a1/timestamp", "1700000000999"),
+                Put("/a2", "null"),
+                Put("/a5", Anchor(codec, "a5"))
+            };
+            int connections = 0;
+
+            using (var server = new LocalEventStreamServer(events, dropAfter: 3))
+            {
+                // Act: read until the server has nothing left, reconnecting with Last-Event-ID like FirebaseService
+                while (connections < 3 && (stream.LastEventId == null || stream.LastEventId != events.Count.ToString()))
+                {
+                    connections++;
+                    stream.Reset();
+                    ReadStream(server.Url, stream);
+                }
+            }
+
+            // Assert
+            Assert.AreEqual(2, connections);
+            CollectionAssert.AreEqual(new[] { "a1", "a2", "a3", "a4", "a5" }, received);
+            CollectionAssert.AreEqual(new[] { "a2" }, removed);
+        }
+
+        private static string Put(string path, string data) => $"event: put\ndata: {{\"path\":\"{path}\",\"data\":{data}}}\n\n";
+
+        private static string Patch(string path, string data) => $"event: patch\ndata: {{\"path\":\"{path}\",\"data\":{data}}}\n\n";
+
+        private static string Anchor(AnchorCodec codec, string id)
+        {
+            var anchor = new AnchorData { id = id, labelKey = "cup", creatorId = "device" };
+            return $"{{\"data\":\"{codec.EncodeBase64(anchor)}\",\"timestamp\":{anchor.timestamp}}}";
+        }
+
+        private static void ReadStream(string url, AnchorEventStream target)
+        {
+            var request = (HttpWebRequest)WebRequest.Create(url);
+            request.Accept = "text/event-stream";
+            request.Timeout = 5000;
+            request.ReadWriteTimeout = 5000;
+            if (!string.IsNullOrEmpty(target.LastEventId)) request.Headers["Last-Event-ID"] = target.LastEventId;
+            using (var response = request.GetResponse())
+            using (var body = response.GetResponseStream())
+            {
+                // Small reads exercise partial lines the same way network chunks do
+                var buffer = new byte[7];
+                int read;
+                while ((read = body.Read(buffer, 0, buffer.Length)) > 0)
+                {
+                    target.Feed(buffer, 0, read);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Minimal text/event-stream server: replays numbered events after Last-Event-ID and drops the
+        /// first connection after a fixed number of events to force a reconnect.
+        /// </summary>
+        private sealed class LocalEventStreamServer : System.IDisposable
+        {
+            public string Url { get; }
+
+            private readonly HttpListener listener = new HttpListener();
+            private readonly List<string> events;
+            private readonly int dropAfter;
+            private readonly Thread thread;
+            private int connections;
+
+            public LocalEventStreamServer(List<string> events, int dropAfter)
+            {
+                this.events = events;
+                this.dropAfter = dropAfter;
+                var probe = new TcpListener(IPAddress.Loopback, 0);
+                probe.Start();
+                int port = ((IPEndPoint)probe.LocalEndpoint).Port;
+                probe.Stop();
+                Url = $"http://127.0.0.1:{port}/rooms/test/anchors.json";
+                listener.Prefixes.Add($"http://127.0.0.1:{port}/");
+                listener.Start();
+                thread = new Thread(Serve) { IsBackground = true };
+                thread.Start();
+            }
+
+            private void Serve()
+            {
+                while (listener.IsListening)
+                {
+                    HttpListenerContext context;
+                    try
+                    {
+                        context = listener.GetContext();
+                    }
+                    catch (HttpListenerException)
+                    {
+                        return;
+                    }
+                    catch (System.ObjectDisposedException)
+                    {
+                        return;
+                    }
+
+                    int first = int.TryParse(context.Request.Headers["Last-Event-ID"], out int lastId) ? lastId : 0;
+                    bool drop = connections++ == 0;
+                    context.Response.ContentType = "text/event-stream";
+                    context.Response.SendChunked = true;
+                    using (var writer = new StreamWriter(context.Response.OutputStream, new UTF8Encoding(false)))
+                    {
+                        for (int i = first; i < events.Count; i++)
+                        {
+                            if (drop && i == dropAfter) break;
+                            writer.Write($"id: {i + 1}\n");
+                            writer.Write(events[i]);
+                            writer.Flush();
+                        }
+                    }
+                    context.Response.Close();
+                }
+            }
+
+            public void Dispose()
+            {
+                listener.Close();
+                thread.Join(1000);
+            }
+        }
+    }
+}
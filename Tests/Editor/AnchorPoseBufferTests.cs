@@ -0,0 +1,171 @@
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for AnchorPoseBuffer
+    /// </summary>
+    public class AnchorPoseBufferTests
+    {
+        private AnchorPoseBuffer buffer;
+
+        [SetUp]
+        public void Setup()
+        {
+            // 50 ms transit, no jitter: playback runs 150 ms behind the receiver's server time
+            buffer = new AnchorPoseBuffer { MinDelayMs = 100, MaxStepMs = 500 };
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_BetweenUpdates_InterpolatesPose()
+        {
+            // Arrange
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+            buffer.Push("a", 1200, new Vector3(2f, 0f, 0f), Quaternion.Euler(0f, 90f, 0f), 1250);
+
+            // Act: plays back instant 1100, halfway between the updates
+            bool found = buffer.TrySample("a", 1250, out var position, out var rotation, out bool settled);
+
+            // Assert
+            Assert.IsTrue(found);
+            Assert.IsFalse(settled);
+            Assert.AreEqual(1f, position.x, 1e-4f);
+            Assert.AreEqual(45f, rotation.eulerAngles.y, 0.01f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_PastNewestUpdate_HoldsPoseAndSettles()
+        {
+            // Arrange
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+            buffer.Push("a", 1200, new Vector3(2f, 0f, 0f), Quaternion.identity, 1250);
+
+            // Act
+            buffer.TrySample("a", 2000, out var position, out _, out bool settled);
+
+            // Assert
+            Assert.IsTrue(settled);
+            Assert.AreEqual(2f, position.x, 1e-4f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_DuplicateOrOlderUpdate_IsDropped()
+        {
+            // Arrange
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+            buffer.Push("a", 1200, Vector3.one, Quaternion.identity, 1250);
+
+            // Act
+            bool duplicate = buffer.Push("a", 1200, Vector3.one, Quaternion.identity, 1260);
+            bool older = buffer.Push("a", 1100, Vector3.one * 5f, Quaternion.identity, 1270);
+
+            // Assert
+            Assert.IsFalse(duplicate);
+            Assert.IsFalse(older);
+            buffer.TrySample("a", 1250, out var position, out _, out _);
+            Assert.AreEqual(0.5f, position.x, 1e-4f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_UpdateAfterPause_MovesOverMaxStep()
+        {
+            // Arrange: idle for 10 s, then moved
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+            buffer.Push("a", 11000, new Vector3(4f, 0f, 0f), Quaternion.identity, 11050);
+
+            // Act: 10750 is halfway through the last 500 ms before the update
+            buffer.TrySample("a", 10900, out var position, out _, out _);
+
+            // Assert
+            Assert.AreEqual(2f, position.x, 0.05f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_Playback_NeverRunsBackwards()
+        {
+            // Arrange
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+            buffer.Push("a", 1200, new Vector3(2f, 0f, 0f), Quaternion.identity, 1250);
+            buffer.TrySample("a", 1250, out var before, out _, out _);
+
+            // Act: a late update raises the transit estimate and so the delay
+            buffer.Push("a", 1300, new Vector3(3f, 0f, 0f), Quaternion.identity, 1900);
+            buffer.TrySample("a", 1260, out var after, out _, out _);
+
+            // Assert
+            Assert.GreaterOrEqual(after.x, before.x);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_CachedAnchorThenLiveMoves_PlaysBackAtLiveDelay()
+        {
+            // Arrange: an anchor last written 20 s ago arrives from the cache, then moves live every 100 ms
+            const long start = 3600000;
+            buffer.Push("a", start - 20000, Vector3.zero, Quaternion.identity, start, live: false);
+            for (int i = 1; i <= 10; i++)
+            {
+                buffer.Push("a", start + i * 100, new Vector3(i, 0f, 0f), Quaternion.identity, start + i * 100 + 50);
+            }
+
+            // Act: 150 ms after the last move was stamped
+            buffer.TrySample("a", start + 1200, out var position, out _, out bool settled);
+
+            // Assert
+            Assert.IsTrue(settled);
+            Assert.AreEqual(10f, position.x, 1e-4f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_StalledUpdates_BarelyRaiseTheDelay()
+        {
+            // Arrange: steady 50 ms transits, then two updates that took 1.5 s
+            for (int i = 0; i < 10; i++)
+            {
+                buffer.Push("a", 1000 + i * 100, new Vector3(i, 0f, 0f), Quaternion.identity, 1050 + i * 100);
+            }
+            buffer.Push("a", 2000, new Vector3(10f, 0f, 0f), Quaternion.identity, 3500);
+            buffer.Push("a", 2100, new Vector3(11f, 0f, 0f), Quaternion.identity, 3600);
+
+            // Act
+            buffer.Push("a", 2200, new Vector3(12f, 0f, 0f), Quaternion.identity, 2250);
+            buffer.TrySample("a", 2550, out var position, out _, out bool settled);
+
+            // Assert: playback is a few hundred ms behind, not seconds
+            Assert.IsTrue(settled);
+            Assert.AreEqual(12f, position.x, 1e-4f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_UpdateAfterLongIdle_StartsTrackOver()
+        {
+            // Arrange
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+            buffer.Push("a", 1200, Vector3.one, Quaternion.identity, 1250);
+
+            // Act: a move a minute and a half later shows at once rather than crossing a held pose
+            buffer.Push("a", 100000, new Vector3(5f, 0f, 0f), Quaternion.identity, 100050);
+            buffer.TrySample("a", 100100, out var position, out _, out bool settled);
+
+            // Assert
+            Assert.IsTrue(settled);
+            Assert.AreEqual(5f, position.x, 1e-4f);
+        }
+
+        [Test]
+        public void AnchorPoseBuffer_RemovedAnchor_HasNoPose()
+        {
+            // Arrange
+            buffer.Push("a", 1000, Vector3.zero, Quaternion.identity, 1050);
+
+            // Act
+            bool removed = buffer.Remove("a");
+
+            // Assert
+            Assert.IsTrue(removed);
+            Assert.AreEqual(0, buffer.Count);
+            Assert.IsFalse(buffer.TrySample("a", 1100, out _, out _, out _));
+        }
+    }
+}
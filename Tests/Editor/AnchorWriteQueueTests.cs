@@ -0,0 +1,90 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for AnchorWriteQueue
+    /// </summary>
+    public class AnchorWriteQueueTests
+    {
+        private AnchorWriteQueue queue;
+        private List<PendingAnchorWrite> batch;
+
+        [SetUp]
+        public void Setup()
+        {
+            queue = new AnchorWriteQueue(maxBatchSize: 3, flushInterval: 0.1f);
+            batch = new List<PendingAnchorWrite>();
+        }
+
+        [Test]
+        public void AnchorWriteQueue_Enqueue_CoalescesSameAnchorAndKeepsCallbacks()
+        {
+            // Arrange
+            var results = new List<bool>();
+            queue.Enqueue("room", "a1", "{\"v\":1}", 0f, ok => results.Add(ok));
+            queue.Enqueue("room", "a1", "{\"v\":2}", 0.01f, ok => results.Add(ok));
+
+            // Act
+            string roomId = queue.TakeDueBatch(0.2f, batch);
+            queue.Complete(roomId, batch, true);
+
+            // Assert
+            Assert.AreEqual("room", roomId);
+            Assert.AreEqual(1, batch.Count);
+            Assert.AreEqual("{\"v\":2}", batch[0].json);
+            CollectionAssert.AreEqual(new[] { true, true }, results);
+            Assert.AreEqual(1, queue.Metrics.RequestsSaved);
+        }
+
+        [Test]
+        public void AnchorWriteQueue_TakeDueBatch_WaitsForLatencyBoundOrFullBatch()
+        {
+            // Arrange
+            queue.Enqueue("room", "a1", "1", 0f);
+            queue.Enqueue("room", "a2", "2", 0f);
+
+            // Act & Assert
+            Assert.IsNull(queue.TakeDueBatch(0.05f, batch));
+            queue.Enqueue("room", "a3", "3", 0.05f);
+            queue.Enqueue("room", "a4", "4", 0.05f);
+            Assert.AreEqual("room", queue.TakeDueBatch(0.05f, batch));
+            Assert.AreEqual(3, batch.Count);
+            Assert.AreEqual(1, queue.PendingCount);
+        }
+
+        [Test]
+        public void AnchorWriteQueue_TakeDueBatch_OneBatchInFlightPerRoom()
+        {
+            // Arrange
+            queue.Enqueue("room", "a1", "1", 0f);
+            string roomId = queue.TakeDueBatch(1f, batch);
+            queue.Enqueue("room", "a1", "2", 1f);
+
+            // Act & Assert
+            Assert.IsNull(queue.TakeDueBatch(2f, new List<PendingAnchorWrite>()));
+            queue.Complete(roomId, batch, false);
+            var retry = new List<PendingAnchorWrite>();
+            Assert.AreEqual("room", queue.TakeDueBatch(2f, retry));
+            Assert.AreEqual("2", retry[0].json);
+            Assert.AreEqual(1, queue.Metrics.requestsFailed);
+        }
+
+        [Test]
+        public void AnchorWriteQueue_BuildPatchBody_UsesMultiPathKeysAndNullForDeletes()
+        {
+            // Arrange
+            queue.Enqueue("room", "anchors/a1", "{\"timestamp\":1}", 0f);
+            queue.Enqueue("room", "cells/0_-1/anchors/a2", null, 0f);
+            queue.TakeDueBatch(1f, batch);
+
+            // Act
+            string body = AnchorWriteQueue.BuildPatchBody(batch);
+
+            // Assert
+            Assert.AreEqual("{\"anchors/a1\":{\"timestamp\":1},\"cells/0_-1/anchors/a2\":null}", body);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+using NUnit.Framework;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for ClockSync
+    /// </summary>
+    public class ClockSyncTests
+    {
+        [Test]
+        public void ClockSync_SymmetricExchange_RecoversOffset()
+        {
+            // Arrange: the server runs 5000 ms ahead, 40 ms each way
+            var clock = new ClockSync(localClock: () => 1000);
+
+            // Act
+            bool accepted = clock.AddSample(1000, 6040, 1080);
+
+            // Assert
+            Assert.IsTrue(accepted);
+            Assert.IsTrue(clock.HasEstimate);
+            Assert.AreEqual(5000, clock.OffsetMs);
+            Assert.AreEqual(80, clock.RoundTripMs);
+            Assert.AreEqual(6000, clock.ReferenceNow);
+            Assert.AreEqual(1000, clock.ToLocal(6000));
+        }
+
+        [Test]
+        public void ClockSync_QueuedExchanges_LoseToTheFastestInTheWindow()
+        {
+            // Arrange
+            var clock = new ClockSync(windowSize: 4, localClock: () => 0);
+
+            // Act: reply queued 300 ms on the way back, then a clean exchange, then another slow one
+            clock.AddSample(0, 5040, 380);
+            clock.AddSample(1000, 6020, 1040);
+            clock.AddSample(2000, 7020, 2400);
+
+            // Assert
+            Assert.AreEqual(3, clock.SampleCount);
+            Assert.AreEqual(5000, clock.OffsetMs);
+            Assert.AreEqual(40, clock.RoundTripMs);
+        }
+
+        [Test]
+        public void ClockSync_FastestSample_AgesOutOfTheWindow()
+        {
+            // Arrange
+            var clock = new ClockSync(windowSize: 2, localClock: () => 0);
+            clock.AddSample(0, 5010, 20);
+
+            // Act
+            clock.AddSample(1000, 6050, 1100);
+            clock.AddSample(2000, 7060, 2120);
+
+            // Assert
+            Assert.AreEqual(100, clock.RoundTripMs);
+            Assert.AreEqual(5000, clock.OffsetMs);
+        }
+
+        [Test]
+        public void ClockSync_ImpossibleSample_IsRejected()
+        {
+            // Arrange
+            var clock = new ClockSync(localClock: () => 0);
+
+            // Act & Assert
+            Assert.IsFalse(clock.AddSample(100, 5000, 50));
+            Assert.IsFalse(clock.AddSample(100, 0, 150));
+            Assert.IsFalse(clock.HasEstimate);
+            Assert.AreEqual(0, clock.OffsetMs);
+        }
+    }
+}
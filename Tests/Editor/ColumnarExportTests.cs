@@ -0,0 +1,137 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using NUnit.Framework;
+using ARLinguaSphere.Analytics;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for ColumnarExport and ColumnarExportReader
+    /// </summary>
+    public class ColumnarExportTests
+    {
+        private string directory;
+
+        [SetUp]
+        public void Setup()
+        {
+            directory = Path.Combine(Path.GetTempPath(), "als_export_" + System.Guid.NewGuid().ToString("N"));
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            Directory.Delete(directory, true);
+        }
+
+        [Test]
+        public void ColumnarExport_ManyBlocks_RoundTripsEveryColumn()
+        {
+            // Arrange
+            var random = new System.Random(11);
+            var expected = new List<(InteractionType action, string label, string anchor, bool success, float duration, long timestamp)>();
+            long timestamp = 1700000000000L;
+            using (var log = InteractionLog.Open(directory, segmentRecords: 1024))
+            {
+                for (int i = 0; i < 5000; i++)
+                {
+                    timestamp += random.Next(-50, 5000); // mostly increasing, sometimes not
+                    var row = ((InteractionType)random.Next(8), "word" + random.Next(200), random.Next(3) == 0 ? null : "anchor" + random.Next(50),
+                        random.Next(2) == 0, random.Next(4) == 0 ? 0f : (float)random.NextDouble() * 10f, timestamp);
+                    expected.Add(row);
+                    log.Append(row.Item1, row.Item2, row.Item3, row.Item4, row.Item5, row.Item6);
+                }
+
+                // Act
+                var output = new MemoryStream();
+                long exported = new ColumnarExport(blockRecords: 777).Export(log, output);
+
+                // Assert
+                Assert.AreEqual(5000, exported);
+                output.Position = 0;
+                var reader = new ColumnarExportReader(output);
+                Assert.AreEqual(5000, reader.RecordCount);
+                Assert.AreEqual(7, reader.BlockCount);
+                var buffer = new InteractionRecord[reader.BlockRecords];
+                int index = 0;
+                for (int block = 0; block < reader.BlockCount; block++)
+                {
+                    int count = reader.ReadBlock(block, buffer);
+                    for (int i = 0; i < count; i++, index++)
+                    {
+                        var record = buffer[i];
+                        var row = expected[index];
+                        Assert.AreEqual(index, record.position);
+                        Assert.AreEqual(row.action, record.action);
+                        Assert.AreEqual(row.label, reader.GetString(record.labelId));
+                        Assert.AreEqual(row.anchor, reader.GetString(record.anchorId));
+                        Assert.AreEqual(row.success, record.success);
+                        Assert.AreEqual(row.duration, record.duration);
+                        Assert.AreEqual(row.timestamp, record.timestamp);
+                    }
+                }
+                Assert.AreEqual(5000, index);
+                Assert.Less(output.Length, 5000 * 16, "well under the log's 24 bytes per record");
+            }
+        }
+
+        [Test]
+        public void ColumnarExport_FromPosition_ExportsOnlyTheTail()
+        {
+            // Arrange
+            using (var log = InteractionLog.Open(directory))
+            {
+                for (int i = 0; i < 100; i++)
+                {
+                    log.Append(InteractionType.QuizAnswered, "apple", null, true, 1f, i);
+                }
+
+                // Act
+                var output = new MemoryStream();
+                long exported = new ColumnarExport().Export(log, output, from: 60);
+
+                // Assert
+                output.Position = 0;
+                var reader = new ColumnarExportReader(output);
+                var buffer = new InteractionRecord[reader.BlockRecords];
+                int count = reader.ReadBlock(0, buffer);
+                Assert.AreEqual(40, exported);
+                Assert.AreEqual(40, count);
+                Assert.AreEqual(60, buffer[0].position);
+                Assert.AreEqual(99, buffer[39].timestamp);
+            }
+        }
+
+        /// <summary>
+        /// Export rate and size for a million interactions, streamed to a file. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void ColumnarExport_Benchmark_MillionRecords()
+        {
+            const int total = 1_000_000;
+            string path = Path.Combine(directory, "export.alsc");
+            using (var log = InteractionLog.Open(directory))
+            {
+                for (int i = 0; i < total; i++)
+                {
+                    log.Append(InteractionType.QuizAnswered, "word" + (i % 500), i % 4 == 0 ? "anchor" + (i % 37) : null, i % 3 != 0, 1.5f + i % 7, 1700000000000L + i * 1500L);
+                }
+
+                var timer = Stopwatch.StartNew();
+                long exported;
+                using (var file = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, 1 << 16))
+                {
+                    exported = new ColumnarExport().Export(log, file);
+                }
+                double seconds = timer.Elapsed.TotalSeconds;
+                long bytes = new FileInfo(path).Length;
+
+                UnityEngine.Debug.Log($"ColumnarExportTests: {total} records in {seconds * 1000:F0}ms ({total / seconds / 1e6:F2}M/s), " +
+                    $"{bytes / 1024} KiB ({(double)bytes / total:F2} B/record)");
+                Assert.AreEqual(total, exported);
+                Assert.Greater(total / seconds, 1e6);
+            }
+        }
+    }
+}
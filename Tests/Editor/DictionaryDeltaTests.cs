@@ -0,0 +1,114 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for DictionaryDelta and DictionaryOverlay
+    /// </summary>
+    public class DictionaryDeltaTests
+    {
+        private static int ApplyAll(DictionaryOverlay overlay, List<DictionaryPatch> patches)
+        {
+            int applied = 0;
+            foreach (var patch in patches)
+            {
+                if (overlay.Apply(patch)) applied++;
+            }
+            return applied;
+        }
+
+        [Test]
+        public void DictionaryDelta_Parse_RecordsSharingAVersion_NumberedInPublicationOrder()
+        {
+            // Arrange - out of order, and two records without "seq" share version 3
+            string json = "{\"version\":3,\"patches\":["
+                + "{\"key\":\"cat\",\"lang\":\"es\",\"value\":\"gato\",\"version\":3},"
+                + "{\"key\":\"dog\",\"lang\":\"es\",\"value\":\"perro\",\"version\":2},"
+                + "{\"key\":\"cup\",\"lang\":\"es\",\"value\":\"taza\",\"version\":3}]}";
+
+            // Act
+            var patches = DictionaryDelta.Parse(json);
+
+            // Assert
+            Assert.AreEqual(3, patches.Count);
+            Assert.AreEqual("dog", patches[0].key);
+            Assert.AreEqual("cat", patches[1].key);
+            Assert.AreEqual(1, patches[1].seq);
+            Assert.AreEqual("cup", patches[2].key);
+            Assert.AreEqual(2, patches[2].seq);
+        }
+
+        [Test]
+        public void DictionaryOverlay_SameVersionPatches_AllApplied()
+        {
+            // Arrange
+            var overlay = new DictionaryOverlay();
+            var patches = DictionaryDelta.Parse("{\"version\":5,\"patches\":["
+                + "{\"key\":\"cat\",\"lang\":\"es\",\"value\":\"gato\",\"version\":5,\"seq\":1},"
+                + "{\"key\":\"dog\",\"lang\":\"es\",\"value\":\"perro\",\"version\":5,\"seq\":2},"
+                + "{\"key\":\"cup\",\"lang\":\"fr\",\"value\":\"tasse\",\"version\":5,\"seq\":3}]}");
+
+            // Act
+            int applied = ApplyAll(overlay, patches);
+            int again = ApplyAll(overlay, patches);
+            var later = DictionaryDelta.Parse("{\"version\":5,\"patches\":["
+                + "{\"key\":\"bus\",\"lang\":\"es\",\"value\":\"autobús\",\"version\":5,\"seq\":4}]}");
+            int appliedLater = ApplyAll(overlay, later);
+
+            // Assert - a later record of the same version is not mistaken for a duplicate
+            Assert.AreEqual(3, applied);
+            Assert.AreEqual(0, again);
+            Assert.AreEqual(1, appliedLater);
+            Assert.AreEqual(5, overlay.Version);
+            Assert.AreEqual(4, overlay.Sequence);
+        }
+
+        [Test]
+        public void DictionaryOverlay_ReplayedCompactedLog_RestoresEveryPatch()
+        {
+            // Arrange
+            var overlay = new DictionaryOverlay();
+            ApplyAll(overlay, DictionaryDelta.Parse("{\"version\":7,\"patches\":["
+                + "{\"key\":\"cat\",\"lang\":\"es\",\"value\":\"gata\",\"version\":6},"
+                + "{\"key\":\"cat\",\"lang\":\"es\",\"value\":\"gato\",\"version\":7},"
+                + "{\"key\":\"dog\",\"lang\":\"es\",\"value\":\"perro\",\"version\":7},"
+                + "{\"key\":\"cup\",\"lang\":\"es\",\"value\":null,\"version\":7}]}"));
+            string log = DictionaryDelta.Serialize(overlay.Version, overlay.Snapshot());
+
+            // Act
+            var replayed = new DictionaryOverlay();
+            int applied = ApplyAll(replayed, DictionaryDelta.Parse(log));
+            var shard = new Dictionary<string, string> { { "cat", "x" }, { "cup", "taza" }, { "tree", "árbol" } };
+            replayed.ApplyTo("es", shard);
+
+            // Assert
+            Assert.AreEqual(3, applied);
+            Assert.AreEqual(overlay.Version, replayed.Version);
+            Assert.AreEqual(overlay.Sequence, replayed.Sequence);
+            Assert.AreEqual("gato", shard["cat"]);
+            Assert.AreEqual("perro", shard["dog"]);
+            Assert.IsFalse(shard.ContainsKey("cup"));
+            Assert.AreEqual("árbol", shard["tree"]);
+        }
+
+        [Test]
+        public void DictionaryOverlay_ApplyTo_OnlyTouchesItsLanguage()
+        {
+            // Arrange
+            var overlay = new DictionaryOverlay();
+            overlay.Apply(new DictionaryPatch { key = "cat", lang = "fr", value = "chat", version = 1, seq = 1 });
+            var spanish = new Dictionary<string, string> { { "cat", "gato" } };
+            var french = new Dictionary<string, string>();
+
+            // Act
+            overlay.ApplyTo("es", spanish);
+            overlay.ApplyTo("fr", french);
+
+            // Assert
+            Assert.AreEqual("gato", spanish["cat"]);
+            Assert.AreEqual("chat", french["cat"]);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+using System.Collections.Generic;
+using System.IO;
+using NUnit.Framework;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for DurableOutbox
+    /// </summary>
+    public class DurableOutboxTests
+    {
+        private string path;
+
+        [SetUp]
+        public void Setup()
+        {
+            path = Path.Combine(Path.GetTempPath(), "als_outbox_" + System.Guid.NewGuid().ToString("N"), "test.log");
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            Directory.Delete(Path.GetDirectoryName(path), true);
+        }
+
+        [Test]
+        public void DurableOutbox_Reopen_ReplaysPendingWritesInOrder()
+        {
+            // Arrange
+            using (var outbox = DurableOutbox.Open(path, 3))
+            {
+                outbox.Enqueue("room/a1", "{\"v\":1}");
+                outbox.Enqueue("room/a2", null);
+                outbox.Enqueue("room/a3", "{\"v\":3}");
+                var ready = new List<OutboxEntry>();
+                outbox.TakeReady(0f, 10, ready);
+                outbox.Ack(ready[2]);
+            }
+
+            // Act
+            var ids = new List<string>();
+            var payloads = new List<string>();
+            using (var reopened = DurableOutbox.Open(path, 3))
+            {
+                var ready = new List<OutboxEntry>();
+                reopened.TakeReady(0f, 10, ready);
+                foreach (var entry in ready)
+                {
+                    ids.Add(entry.key);
+                    payloads.Add(entry.payload);
+                }
+            }
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "room/a1", "room/a2" }, ids);
+            CollectionAssert.AreEqual(new[] { "{\"v\":1}", null }, payloads);
+        }
+
+        [Test]
+        public void DurableOutbox_Enqueue_SupersedesPendingWriteForSameKey()
+        {
+            using (var outbox = DurableOutbox.Open(path, 3))
+            {
+                // Arrange
+                outbox.Enqueue("room/a1", "old");
+                var inFlight = new List<OutboxEntry>();
+                outbox.TakeReady(0f, 10, inFlight);
+                outbox.Enqueue("room/a1", "new");
+
+                // Act & Assert: the newer write waits for the in-flight one, which no longer clears the key
+                var ready = new List<OutboxEntry>();
+                Assert.AreEqual(0, outbox.TakeReady(0f, 10, ready));
+                Assert.IsFalse(outbox.Ack(inFlight[0]));
+                Assert.AreEqual(1, outbox.TakeReady(0f, 10, ready));
+                Assert.AreEqual("new", ready[0].payload);
+                Assert.IsTrue(outbox.Ack(ready[0]));
+                Assert.AreEqual(0, outbox.Count);
+            }
+        }
+
+        [Test]
+        public void DurableOutbox_Fail_BacksOffAndReportsMaxRetriesOnce()
+        {
+            using (var outbox = DurableOutbox.Open(path, 2))
+            {
+                // Arrange
+                outbox.BaseBackoffSeconds = 1f;
+                outbox.Enqueue("k", "v");
+                var ready = new List<OutboxEntry>();
+                outbox.TakeReady(0f, 1, ready);
+
+                // Act & Assert
+                Assert.IsFalse(outbox.Fail(ready[0], 0f));
+                Assert.AreEqual(0, outbox.TakeReady(0.4f, 1, new List<OutboxEntry>()));
+                Assert.AreEqual(1, outbox.TakeReady(1f, 1, ready));
+                Assert.IsTrue(outbox.Fail(ready[1], 1f));
+                Assert.AreEqual(1, outbox.Count);
+            }
+        }
+
+        [Test]
+        public void DurableOutbox_Open_DropsTornTail()
+        {
+            // Arrange
+            using (var outbox = DurableOutbox.Open(path, 3))
+            {
+                outbox.Enqueue("k1", "v1");
+                outbox.Enqueue("k2", "v2");
+            }
+            long length = new FileInfo(path).Length;
+            using (var file = new FileStream(path, FileMode.Open))
+            {
+                file.SetLength(length - 3);
+            }
+
+            // Act
+            using (var reopened = DurableOutbox.Open(path, 3))
+            {
+                // Assert
+                Assert.AreEqual(1, reopened.Count);
+            }
+        }
+    }
+}
@@ -0,0 +1,238 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Gesture;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for HandMotionRecognizer
+    /// </summary>
+    public class HandMotionRecognizerTests
+    {
+        private const float FrameTime = 1f / 30f;
+
+        private static readonly Vector3[] Palm = HandPoseClassifier.ReferencePose(GestureType.OpenPalm);
+        private static readonly Vector3 PalmCenter = (Palm[0] + Palm[5] + Palm[9] + Palm[13] + Palm[17]) / 5f;
+
+        /// <summary>
+        /// An upright open hand centred at (x, y) in image coordinates, turned by <paramref name="roll"/> radians
+        /// </summary>
+        private static Vector3[] Hand(float x, float y, float roll, System.Random random)
+        {
+            var rotation = Quaternion.Euler(0f, 0f, 180f + roll * Mathf.Rad2Deg);
+            var keypoints = new Vector3[Palm.Length];
+            for (int i = 0; i < Palm.Length; i++)
+            {
+                var jitter = new Vector3((float)random.NextDouble() - 0.5f, (float)random.NextDouble() - 0.5f, 0f) * 0.006f;
+                keypoints[i] = new Vector3(x, y, 0f) + rotation * (Palm[i] - PalmCenter) * 0.15f + jitter;
+            }
+            return keypoints;
+        }
+
+        /// <summary>
+        /// Play <paramref name="path"/> (time to x, y, roll) for one hand, at 30 fps unless <paramref name="frameTime"/>
+        /// says otherwise; returns what was reported and when
+        /// </summary>
+        private static List<(GestureType gesture, float time)> Play(HandMotionRecognizer recognizer, float seconds, Func<float, Vector3> path,
+            int seed = 1, float frameTime = FrameTime)
+        {
+            var random = new System.Random(seed);
+            var reported = new List<(GestureType, float)>();
+            for (int frame = 0; frame * frameTime < seconds; frame++)
+            {
+                float time = frame * frameTime;
+                Vector3 pose = path(time);
+                if (recognizer.AddFrame(Hand(pose.x, pose.y, pose.z, random), true, time, 1f, out var gesture))
+                {
+                    reported.Add((gesture, time));
+                }
+            }
+            return reported;
+        }
+
+        private static float Ramp(float time, float from, float to)
+        {
+            return Mathf.Clamp01((time - from) / (to - from));
+        }
+
+        [Test]
+        public void HandMotionRecognizer_Swipe_ReportedOnceSoonAfterItEnds()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+
+            // Act - still, then 0.4 across the image in 0.27s, then still
+            var reported = Play(recognizer, 2.5f, t => new Vector3(0.3f + 0.4f * Ramp(t, 1f, 1.27f), 0.5f, 0f));
+
+            // Assert
+            Assert.AreEqual(1, reported.Count, string.Join(", ", reported));
+            Assert.AreEqual(GestureType.SwipeRight, reported[0].gesture);
+            Assert.That(reported[0].time, Is.InRange(1.27f, 1.27f + 0.25f));
+        }
+
+        [Test]
+        public void HandMotionRecognizer_Wave_ReportedInsteadOfItsSwipes()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+
+            // Act - two full side-to-side cycles at 2 Hz
+            var reported = Play(recognizer, 3f, t => new Vector3(t >= 0.5f && t < 1.5f ? 0.5f - 0.12f * Mathf.Cos(2f * Mathf.PI * 2f * (t - 0.5f)) : 0.38f, 0.5f, 0f));
+
+            // Assert
+            Assert.AreEqual(1, reported.Count, string.Join(", ", reported));
+            Assert.AreEqual(GestureType.Wave, reported[0].gesture);
+            Assert.That(reported[0].time, Is.InRange(1.5f, 1.5f + 0.25f));
+        }
+
+        [Test]
+        public void HandMotionRecognizer_SwipeThenReturnStroke_SwipeNotHeldByWave()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+
+            // Act - a swipe right, a short rest, then the hand brought back more slowly
+            var reported = Play(recognizer, 3f, t => new Vector3(0.3f + 0.4f * Ramp(t, 1f, 1.27f) - 0.4f * Ramp(t, 1.4f, 1.8f), 0.5f, 0f));
+
+            // Assert - the swipe is not kept waiting for a wave the return stroke only half makes
+            Assert.AreEqual(2, reported.Count, string.Join(", ", reported));
+            Assert.AreEqual(GestureType.SwipeRight, reported[0].gesture);
+            Assert.That(reported[0].time, Is.InRange(1.27f, 1.27f + 0.25f));
+            Assert.AreEqual(GestureType.SwipeLeft, reported[1].gesture);
+        }
+
+        [Test]
+        public void HandMotionRecognizer_SixtyFps_MatchesAsAtThirty()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+
+            // Act
+            var swipe = Play(recognizer, 2.5f, t => new Vector3(0.3f + 0.4f * Ramp(t, 1f, 1.27f), 0.5f, 0f), frameTime: 1f / 60f);
+            recognizer.Reset();
+            var wave = Play(recognizer, 3f, t => new Vector3(t >= 0.5f && t < 1.5f ? 0.5f - 0.12f * Mathf.Cos(2f * Mathf.PI * 2f * (t - 0.5f)) : 0.38f, 0.5f, 0f),
+                frameTime: 1f / 60f);
+
+            // Assert
+            Assert.AreEqual(1, swipe.Count, string.Join(", ", swipe));
+            Assert.AreEqual(GestureType.SwipeRight, swipe[0].gesture);
+            Assert.That(swipe[0].time, Is.InRange(1.27f, 1.27f + 0.25f));
+            Assert.AreEqual(1, wave.Count, string.Join(", ", wave));
+            Assert.AreEqual(GestureType.Wave, wave[0].gesture);
+            Assert.That(wave[0].time, Is.InRange(1.5f, 1.5f + 0.25f));
+        }
+
+        [Test]
+        public void HandMotionRecognizer_TurnedPalm_ReportsRotate()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+
+            // Act
+            var reported = Play(recognizer, 2.5f, t => new Vector3(0.5f, 0.5f, -1.5f * Ramp(t, 1f, 1.4f)));
+
+            // Assert
+            Assert.AreEqual(1, reported.Count, string.Join(", ", reported));
+            Assert.AreEqual(GestureType.HandRotate, reported[0].gesture);
+        }
+
+        [Test]
+        public void HandMotionRecognizer_StillOrDriftingHand_ReportsNothing()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+
+            // Act
+            var still = Play(recognizer, 5f, t => new Vector3(0.5f, 0.5f, 0f), seed: 2);
+            recognizer.Reset();
+            var drifting = Play(recognizer, 5f, t => new Vector3(0.3f + 0.05f * t, 0.5f - 0.03f * t, 0.1f * t), seed: 3);
+
+            // Assert
+            Assert.IsEmpty(still);
+            Assert.IsEmpty(drifting);
+            Assert.AreEqual(HandMotionRecognizer.FrameCapacity, recognizer.FrameCount(true));
+            Assert.AreEqual(0, recognizer.FrameCount(false));
+        }
+
+        [Test]
+        public void HandMotionRecognizer_TwoHands_TrackedSeparately()
+        {
+            // Arrange
+            var recognizer = new HandMotionRecognizer();
+            var random = new System.Random(4);
+            var reported = new List<(GestureType, bool)>();
+
+            // Act - the right hand swipes up while the left hand swipes down, frames interleaved
+            for (int frame = 0; frame < 75; frame++)
+            {
+                float time = frame * FrameTime;
+                float progress = Ramp(time, 1f, 1.27f);
+                if (recognizer.AddFrame(Hand(0.7f, 0.7f - 0.4f * progress, 0f, random), true, time, 1f, out var right)) reported.Add((right, true));
+                if (recognizer.AddFrame(Hand(0.3f, 0.3f + 0.4f * progress, 0f, random), false, time, 1f, out var left)) reported.Add((left, false));
+            }
+
+            // Assert
+            CollectionAssert.AreEquivalent(new[] { (GestureType.SwipeUp, true), (GestureType.SwipeDown, false) }, reported);
+        }
+
+        [Test]
+        public void HandMotionRecognizer_WideFrame_MeasuresSizeAndRollInSquareUnits()
+        {
+            // Arrange - a 16:9 frame: MediaPipe divides x by the width, so a turning hand looks squashed sideways
+            const float aspect = 16f / 9f;
+            var recognizer = new HandMotionRecognizer();
+            var random = new System.Random(6);
+            var frames = new List<HandFrame>();
+
+            // Act - a quarter turn at a steady rate, in the right half of the frame
+            for (int frame = 0; frame <= 15; frame++)
+            {
+                var keypoints = Hand(1.2f, 0.5f, frame * 0.1f, random);
+                for (int i = 0; i < keypoints.Length; i++)
+                {
+                    keypoints[i].x /= aspect;
+                    keypoints[i].z /= aspect;
+                }
+                recognizer.AddFrame(keypoints, true, frame * FrameTime, aspect, out _);
+                frames.Add(recognizer.GetFrame(true, 0));
+            }
+
+            // Assert - unstretched, the palm would look 44% shorter once turned sideways
+            foreach (var frame in frames)
+            {
+                Assert.AreEqual(frames[0].scale, frame.scale, frames[0].scale * 0.1f);
+                Assert.AreEqual(1.2f, frame.center.x, 0.01f);
+            }
+            Assert.AreEqual(1.5f, Mathf.Abs(frames[15].roll - frames[0].roll), 0.1f);
+        }
+
+        /// <summary>
+        /// Time per frame with the default templates. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void HandMotionRecognizer_Benchmark_PerFrame()
+        {
+            var recognizer = new HandMotionRecognizer();
+            var random = new System.Random(5);
+            var frames = new Vector3[300][];
+            for (int i = 0; i < frames.Length; i++)
+            {
+                frames[i] = Hand(0.5f + 0.12f * Mathf.Sin(i * 0.4f), 0.5f, 0.3f * Mathf.Sin(i * 0.1f), random);
+            }
+
+            const int iterations = 100000;
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < iterations; i++)
+            {
+                recognizer.AddFrame(frames[i % frames.Length], true, i * FrameTime, 1f, out _);
+            }
+            double microseconds = timer.Elapsed.TotalMilliseconds * 1000 / iterations;
+
+            UnityEngine.Debug.Log($"HandMotionRecognizerTests: {recognizer.TemplateCount} templates, {microseconds:F2}us per frame");
+            Assert.Less(microseconds, 50.0);
+        }
+    }
+}
@@ -0,0 +1,178 @@
+using System.Diagnostics;
+using System.IO;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Gesture;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for HandPoseClassifier
+    /// </summary>
+    public class HandPoseClassifierTests
+    {
+        private static readonly GestureType[] Poses = { GestureType.ThumbsUp, GestureType.OpenPalm, GestureType.PinchIn };
+
+        private static HandPoseClassifier CreateClassifier()
+        {
+            var classifier = new HandPoseClassifier();
+            foreach (var pose in Poses)
+            {
+                classifier.AddSample(pose.ToString(), HandPoseClassifier.ReferencePose(pose), true);
+            }
+            return classifier;
+        }
+
+        /// <summary>
+        /// The pose as a camera would see it: turned, scaled, moved, mirrored for a left hand and slightly jittered
+        /// </summary>
+        private static Vector3[] Place(Vector3[] pose, Quaternion rotation, float scale, Vector3 center, bool isRight, System.Random random)
+        {
+            var keypoints = new Vector3[pose.Length];
+            for (int i = 0; i < pose.Length; i++)
+            {
+                Vector3 point = pose[i];
+                if (!isRight) point.x = -point.x;
+                var jitter = new Vector3((float)random.NextDouble() - 0.5f, (float)random.NextDouble() - 0.5f, (float)random.NextDouble() - 0.5f) * 0.004f;
+                keypoints[i] = center + rotation * point * scale + jitter;
+            }
+            return keypoints;
+        }
+
+        [Test]
+        public void HandPoseClassifier_TransformedHands_MatchTheirReferencePose()
+        {
+            // Arrange
+            var classifier = CreateClassifier();
+            var random = new System.Random(3);
+
+            for (int trial = 0; trial < 50; trial++)
+            {
+                var expected = Poses[trial % Poses.Length];
+                bool isRight = trial % 2 == 0;
+                var rotation = Quaternion.Euler(random.Next(-60, 60), random.Next(-60, 60), random.Next(0, 360));
+                var keypoints = Place(HandPoseClassifier.ReferencePose(expected), rotation, 0.1f + (float)random.NextDouble() * 0.2f,
+                    new Vector3((float)random.NextDouble(), (float)random.NextDouble(), 0f), isRight, random);
+
+                // Act
+                bool classified = classifier.Classify(keypoints, isRight, out string gesture, out float similarity);
+
+                // Assert
+                Assert.IsTrue(classified, $"trial {trial}: {expected}");
+                Assert.AreEqual(expected.ToString(), gesture, $"trial {trial}");
+                Assert.Greater(similarity, 0.85f);
+            }
+        }
+
+        [Test]
+        public void HandPoseClassifier_NonSquareFrame_AspectUndoesShear()
+        {
+            // Arrange - a turned hand in a 16:9 frame, whose x is normalised by the width
+            const float aspect = 16f / 9f;
+            var random = new System.Random(5);
+            var hand = Place(HandPoseClassifier.ReferencePose(GestureType.OpenPalm), Quaternion.Euler(20f, -30f, 50f), 0.2f,
+                new Vector3(0.5f, 0.5f, 0f), true, random);
+            var normalised = new Vector3[hand.Length];
+            for (int i = 0; i < hand.Length; i++) normalised[i] = new Vector3(hand[i].x / aspect, hand[i].y, hand[i].z / aspect);
+            var expected = new float[HandPoseClassifier.FeatureLength];
+            var corrected = new float[HandPoseClassifier.FeatureLength];
+            var sheared = new float[HandPoseClassifier.FeatureLength];
+
+            // Act
+            HandPoseClassifier.ExtractFeatures(hand, true, 1f, expected, 0);
+            HandPoseClassifier.ExtractFeatures(normalised, true, aspect, corrected, 0);
+            HandPoseClassifier.ExtractFeatures(normalised, true, 1f, sheared, 0);
+
+            // Assert
+            float correctedError = 0f, shearedError = 0f;
+            for (int f = 0; f < expected.Length; f++)
+            {
+                correctedError = Mathf.Max(correctedError, Mathf.Abs(corrected[f] - expected[f]));
+                shearedError = Mathf.Max(shearedError, Mathf.Abs(sheared[f] - expected[f]));
+            }
+            Assert.Less(correctedError, 1e-4f);
+            Assert.Greater(shearedError, 0.05f);
+        }
+
+        [Test]
+        public void HandPoseClassifier_UnknownPose_IsRejected()
+        {
+            // Arrange - a fist: every finger curled and the thumb folded across them
+            var classifier = CreateClassifier();
+            var fist = HandPoseClassifier.ReferencePose(GestureType.ThumbsUp);
+            fist[2] = new Vector3(0.3f, 0.5f, 0.25f);
+            fist[3] = new Vector3(0.15f, 0.65f, 0.45f);
+            fist[4] = new Vector3(-0.05f, 0.7f, 0.5f);
+            var leftFist = new Vector3[fist.Length];
+            for (int i = 0; i < fist.Length; i++) leftFist[i] = new Vector3(-fist[i].x, fist[i].y, fist[i].z);
+
+            // Act
+            bool before = classifier.Classify(fist, true, out _, out _);
+            classifier.AddSample("Fist", fist, true);
+            bool after = classifier.Classify(leftFist, false, out string gesture, out _);
+
+            // Assert - recorded from a right hand, recognized on a left one too
+            Assert.IsFalse(before);
+            Assert.IsTrue(after);
+            Assert.AreEqual("Fist", gesture);
+            Assert.AreEqual(1, classifier.RemoveGesture("Fist"));
+            Assert.IsFalse(classifier.Classify(fist, true, out _, out _));
+        }
+
+        [Test]
+        public void HandPoseClassifier_WriteSamples_ReadBackIntoAnotherClassifier()
+        {
+            // Arrange
+            var source = CreateClassifier();
+            var pointing = HandPoseClassifier.ReferencePose(GestureType.ThumbsUp);
+            for (int i = 6; i <= 8; i++) pointing[i] = new Vector3(0.32f, 0.92f + (i - 5) * 0.3f, 0f);
+            source.AddSample("Point", pointing, true);
+            source.SetThreshold("Point", 0.9f);
+            var stream = new MemoryStream();
+
+            // Act
+            source.WriteSamples(new BinaryWriter(stream), from: Poses.Length);
+            stream.Position = 0;
+            var target = CreateClassifier();
+            int read = target.ReadSamples(new BinaryReader(stream));
+
+            // Assert
+            Assert.AreEqual(1, read);
+            Assert.AreEqual(Poses.Length + 1, target.SampleCount);
+            Assert.IsTrue(target.Classify(pointing, true, out string gesture, out _));
+            Assert.AreEqual("Point", gesture);
+        }
+
+        /// <summary>
+        /// Time per hand against a few hundred recorded samples. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void HandPoseClassifier_Benchmark_ClassifyPerHand()
+        {
+            var classifier = CreateClassifier();
+            var random = new System.Random(9);
+            for (int i = 0; i < 300; i++)
+            {
+                var pose = Poses[i % Poses.Length];
+                classifier.AddSample(pose.ToString(), Place(HandPoseClassifier.ReferencePose(pose), Quaternion.Euler(0f, 0f, random.Next(360)), 0.2f, Vector3.one * 0.5f, true, random), true);
+            }
+            var hands = new Vector3[64][];
+            for (int i = 0; i < hands.Length; i++)
+            {
+                hands[i] = Place(HandPoseClassifier.ReferencePose(Poses[i % Poses.Length]), Quaternion.Euler(random.Next(360), random.Next(360), random.Next(360)), 0.15f, Vector3.one * 0.5f, i % 2 == 0, random);
+            }
+
+            const int iterations = 20000;
+            for (int i = 0; i < 1000; i++) classifier.Classify(hands[i % hands.Length], i % 2 == 0, out _, out _);
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < iterations; i++)
+            {
+                classifier.Classify(hands[i % hands.Length], i % 2 == 0, out _, out _);
+            }
+            double microseconds = timer.Elapsed.TotalMilliseconds * 1000 / iterations;
+
+            UnityEngine.Debug.Log($"HandPoseClassifierTests: {classifier.SampleCount} samples, {microseconds:F2}us per hand");
+            Assert.Less(microseconds, 50.0);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+using NUnit.Framework;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for HybridClock and the drift bound RoomOpLog applies to remote ops
+    /// </summary>
+    public class HybridClockTests
+    {
+        private const long Start = 1_700_000_000_000;
+        private const long Hour = 3600000;
+
+        [Test]
+        public void HybridClock_Observe_FollowsRemoteTimesWithinTheDriftBound()
+        {
+            // Arrange
+            long wall = Start;
+            var clock = new HybridClock(() => wall);
+
+            // Act
+            bool near = clock.Observe((Start + 1000) << HybridClock.CounterBits);
+            bool skewed = clock.Observe((Start + Hour) << HybridClock.CounterBits);
+            long next = clock.Now();
+
+            // Assert
+            Assert.IsTrue(near);
+            Assert.IsFalse(skewed);
+            Assert.AreEqual(Start + 1000, HybridClock.ToUnixMilliseconds(next));
+        }
+
+        [Test]
+        public void RoomOpLog_ApplyRemote_CapsOpsStampedAheadOfTheServer()
+        {
+            // Arrange: a replica an hour fast upserts, another replica edits two minutes later without having seen it
+            long wall = Start;
+            var skewed = new RoomOpLog("skewed", new HybridClock(() => wall + Hour));
+            var honest = new RoomOpLog("honest", new HybridClock(() => wall));
+            var observer = new RoomOpLog("observer", new HybridClock(() => wall));
+            var first = skewed.Upsert(new AnchorData { id = "a1", labelKey = "cup" });
+            wall += 120000;
+            var second = honest.Upsert(new AnchorData { id = "a1", labelKey = "mug" });
+
+            // Act: the server appended them at their real times
+            observer.ApplyRemote(RoomOpLog.OpKey(first), Start, first);
+            observer.ApplyRemote(RoomOpLog.OpKey(second), Start + 120000, second);
+
+            // Assert
+            Assert.IsTrue(observer.State.TryGetAnchor("a1", out var anchor));
+            Assert.AreEqual("mug", anchor.labelKey);
+            Assert.Less(HybridClock.ToUnixMilliseconds(observer.Clock.Now()), Start + Hour);
+        }
+    }
+}
@@ -0,0 +1,225 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Threading.Tasks;
+using NUnit.Framework;
+using ARLinguaSphere.Analytics;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for InteractionLog
+    /// </summary>
+    public class InteractionLogTests
+    {
+        private string directory;
+
+        [SetUp]
+        public void Setup()
+        {
+            directory = Path.Combine(Path.GetTempPath(), "als_interactions_" + System.Guid.NewGuid().ToString("N"));
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            Directory.Delete(directory, true);
+        }
+
+        [Test]
+        public void InteractionLog_Reopen_ReadsRecordsBackWithStrings()
+        {
+            // Arrange
+            using (var log = InteractionLog.Open(directory))
+            {
+                log.Append(InteractionType.QuizAnswered, "apple", "anchor1", true, 2.5f, 1000);
+                log.Append(InteractionType.LabelPlaced, "car", null, false, 0f, 2000);
+                log.Append(InteractionType.QuizAnswered, "apple", "anchor1", false, 1.5f, 3000);
+            }
+
+            // Act
+            using (var reopened = InteractionLog.Open(directory))
+            {
+                var records = ReadAll(reopened);
+                int strings = reopened.StringCount;
+                long next = reopened.Append(InteractionType.VoiceCommand, "dog", null, true, 0f, 4000);
+
+                // Assert
+                Assert.AreEqual(3, records.Count);
+                Assert.AreEqual(3, strings); // apple, anchor1, car
+                Assert.AreEqual("apple", reopened.GetString(records[0].labelId));
+                Assert.AreEqual("anchor1", reopened.GetString(records[0].anchorId));
+                Assert.AreEqual(records[0].labelId, records[2].labelId);
+                Assert.AreEqual(InteractionType.QuizAnswered, records[0].action);
+                Assert.IsTrue(records[0].success);
+                Assert.AreEqual(2.5f, records[0].duration);
+                Assert.AreEqual(-1, records[1].anchorId);
+                Assert.IsNull(reopened.GetString(records[1].anchorId));
+                Assert.IsFalse(records[2].success);
+                Assert.AreEqual(3000, records[2].timestamp);
+                Assert.AreEqual(3, next);
+            }
+        }
+
+        [Test]
+        public void InteractionLog_FullSegments_RollCompressAndReadInOrder()
+        {
+            // Arrange
+            using (var log = InteractionLog.Open(directory, segmentRecords: 8))
+            {
+                for (int i = 0; i < 30; i++)
+                {
+                    log.Append(InteractionType.QuizAnswered, "w" + (i % 3), null, i % 2 == 0, i, i);
+                }
+            }
+
+            // Act
+            List<InteractionRecord> records;
+            using (var reopened = InteractionLog.Open(directory, segmentRecords: 1000))
+            {
+                records = ReadAll(reopened);
+                Assert.AreEqual(8, reopened.SegmentRecords);
+            }
+
+            // Assert
+            Assert.AreEqual(3, Directory.GetFiles(directory, "*.gz").Length);
+            CollectionAssert.AreEqual(Enumerable.Range(0, 30).Select(i => (long)i), records.Select(r => r.timestamp));
+            CollectionAssert.AreEqual(Enumerable.Range(0, 30).Select(i => (long)i), records.Select(r => r.position));
+        }
+
+        [Test]
+        public void InteractionLog_ConcurrentAppends_GetDistinctPositionsAndAllReadBack()
+        {
+            // Arrange
+            const int threads = 8;
+            const int perThread = 2000;
+            var positions = new long[threads * perThread];
+            List<InteractionRecord> records;
+
+            // Act
+            using (var log = InteractionLog.Open(directory, segmentRecords: 1024))
+            {
+                Parallel.For(0, threads, t =>
+                {
+                    for (int i = 0; i < perThread; i++)
+                    {
+                        positions[t * perThread + i] = log.Append(InteractionType.GesturePerformed, "thread" + t, null, true, 0f, t * perThread + i);
+                    }
+                });
+                records = ReadAll(log);
+            }
+
+            // Assert
+            CollectionAssert.AreEquivalent(Enumerable.Range(0, threads * perThread).Select(i => (long)i), positions);
+            Assert.AreEqual(threads * perThread, records.Count);
+            CollectionAssert.AreEquivalent(Enumerable.Range(0, threads * perThread).Select(i => (long)i), records.Select(r => r.timestamp));
+        }
+
+        [Test]
+        public void InteractionLog_ReadWhileSealing_NeverSkipsRecords()
+        {
+            // Arrange - small segments, so the reader keeps meeting ones that are being compressed
+            const int total = 20000;
+            var positions = new List<long>();
+
+            // Act
+            using (var log = InteractionLog.Open(directory, segmentRecords: 64))
+            {
+                var writer = Task.Run(() =>
+                {
+                    for (int i = 0; i < total; i++)
+                    {
+                        log.Append(InteractionType.QuizAnswered, "word", null, true, 0f, i);
+                    }
+                });
+                var buffer = new InteractionRecord[100];
+                long position = 0;
+                while (positions.Count < total)
+                {
+                    int count = log.Read(position, buffer, out position);
+                    for (int i = 0; i < count; i++)
+                    {
+                        positions.Add(buffer[i].position);
+                    }
+                    if (count == 0 && writer.IsCompleted && position >= log.EndPosition) break;
+                }
+                writer.Wait();
+            }
+
+            // Assert
+            CollectionAssert.AreEqual(Enumerable.Range(0, total).Select(i => (long)i), positions);
+        }
+
+        [Test]
+        public void InteractionLog_Clear_StartsAgainFromPositionZero()
+        {
+            // Arrange
+            using (var log = InteractionLog.Open(directory, segmentRecords: 4))
+            {
+                for (int i = 0; i < 10; i++)
+                {
+                    log.Append(InteractionType.LabelPlaced, "cup", null, true, 0f, i);
+                }
+
+                // Act
+                log.Clear();
+                long position = log.Append(InteractionType.LabelPlaced, "pen", null, true, 0f, 99);
+
+                // Assert
+                var records = ReadAll(log);
+                Assert.AreEqual(0, position);
+                Assert.AreEqual(1, records.Count);
+                Assert.AreEqual("pen", log.GetString(records[0].labelId));
+            }
+        }
+
+        /// <summary>
+        /// Startup replay cost: a year of heavy use (a million interactions over 500 words) read back from compressed
+        /// segments. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void InteractionLog_Benchmark_ReplayMillionRecords()
+        {
+            const int total = 1_000_000;
+            var timer = Stopwatch.StartNew();
+            using (var log = InteractionLog.Open(directory))
+            {
+                for (int i = 0; i < total; i++)
+                {
+                    log.Append(InteractionType.QuizAnswered, "word" + (i % 500), null, i % 3 != 0, 1.5f, i);
+                }
+            }
+            double writeMs = timer.Elapsed.TotalMilliseconds;
+            long bytes = new DirectoryInfo(directory).GetFiles().Sum(f => f.Length);
+
+            timer.Restart();
+            int read = 0;
+            using (var log = InteractionLog.Open(directory))
+            {
+                var batch = new InteractionRecord[1024];
+                long position = 0;
+                int n;
+                while ((n = log.Read(position, batch, out position)) > 0) read += n;
+            }
+            double readMs = timer.Elapsed.TotalMilliseconds;
+
+            UnityEngine.Debug.Log($"InteractionLogTests: {total} records - append {writeMs * 1000 / total:F2}us each, " +
+                $"{bytes / 1024} KiB on disk ({(double)bytes / total:F1} B/record), replay {readMs:F0}ms");
+            Assert.AreEqual(total, read);
+        }
+
+        private static List<InteractionRecord> ReadAll(InteractionLog log)
+        {
+            var records = new List<InteractionRecord>();
+            var batch = new InteractionRecord[5];
+            long position = 0;
+            int read;
+            while ((read = log.Read(position, batch, out position)) > 0)
+            {
+                for (int i = 0; i < read; i++) records.Add(batch[i]);
+            }
+            return records;
+        }
+    }
+}
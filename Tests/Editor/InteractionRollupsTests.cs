@@ -0,0 +1,114 @@
+using System;
+using System.Linq;
+using NUnit.Framework;
+using ARLinguaSphere.Analytics;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for InteractionRollups and QuantileSketch
+    /// </summary>
+    public class InteractionRollupsTests
+    {
+        private const long Day = InteractionRollups.Day;
+        private const long Start = 1700000000000L / Day * Day; // midnight UTC
+
+        [Test]
+        public void InteractionRollups_QueryWord_CountsOnlyTheWindow()
+        {
+            // Arrange - 10 misses a month ago, then 8 hits and 2 misses over the last week
+            var rollups = new InteractionRollups();
+            for (int i = 0; i < 10; i++) rollups.Record("apple", false, 3f, Start + i * 1000L);
+            long now = Start + 30 * Day;
+            for (int i = 0; i < 10; i++) rollups.Record("apple", i >= 2, 1f, now - i * (Day / 2));
+
+            // Act
+            var week = rollups.QueryWord("apple", 7 * Day, now);
+            var all = rollups.Query(40 * Day, now);
+
+            // Assert
+            Assert.AreEqual(10, week.count);
+            Assert.AreEqual(0.2f, week.ErrorRate, 1e-6f);
+            Assert.AreEqual(1f, week.MeanDuration, 1e-6f);
+            Assert.AreEqual(20, all.count);
+            Assert.AreEqual(0, rollups.QueryWord("car", 7 * Day, now).count);
+        }
+
+        [Test]
+        public void InteractionRollups_LongUse_OldBucketsAreLapped()
+        {
+            // Arrange
+            var rollups = new InteractionRollups(wordDays: 30);
+
+            // Act - one interaction a day for a year
+            for (int day = 0; day < 365; day++)
+            {
+                rollups.Record("apple", true, 0f, Start + day * Day);
+            }
+            long now = Start + 364 * Day;
+
+            // Assert
+            Assert.AreEqual(30, rollups.QueryWord("apple", 365 * Day, now).count);
+            Assert.AreEqual(90, rollups.Query(365 * Day, now).count);
+            Assert.AreEqual(2, rollups.Query(Day, now).count); // from the hour ring; both ends of the window are inclusive
+        }
+
+        [Test]
+        public void InteractionRollups_GapLongerThanSessionGap_StartsNewSession()
+        {
+            // Arrange
+            var rollups = new InteractionRollups();
+            rollups.Record("apple", true, 2f, Start);
+            rollups.Record("car", false, 4f, Start + 60_000);
+
+            // Act
+            long next = Start + 60_000 + rollups.SessionGapMs + 1;
+            rollups.Record("dog", true, 8f, next);
+
+            // Assert
+            Assert.AreEqual(next, rollups.SessionStart);
+            Assert.AreEqual(1, rollups.SessionTotals.count);
+            Assert.AreEqual(1, rollups.QuerySession(InteractionRollups.Hour, next).count);
+            Assert.AreEqual(0, rollups.QuerySession(InteractionRollups.Hour, next + rollups.SessionGapMs + 1).count);
+            Assert.AreEqual(8f, rollups.SessionResponseTimeQuantile(0.5), 8f * QuantileSketch.RelativeAccuracy);
+        }
+
+        [Test]
+        public void QuantileSketch_SkewedResponseTimes_WithinRelativeAccuracy()
+        {
+            // Arrange
+            var random = new Random(5);
+            var values = Enumerable.Range(0, 20000).Select(_ => (float)Math.Exp(random.NextDouble() * 4 - 1)).ToArray();
+            var sketch = new QuantileSketch();
+
+            // Act
+            foreach (var value in values) sketch.Add(value);
+
+            // Assert
+            Array.Sort(values);
+            foreach (double q in new[] { 0.1, 0.5, 0.9, 0.99 })
+            {
+                float exact = values[(int)Math.Floor(q * (values.Length - 1))];
+                Assert.AreEqual(exact, sketch.Quantile(q), exact * QuantileSketch.RelativeAccuracy, $"q={q}");
+            }
+        }
+
+        [Test]
+        public void InteractionRollups_ResponseTimeQuantile_MergesBucketsInWindow()
+        {
+            // Arrange
+            var rollups = new InteractionRollups();
+            long now = Start + 10 * Day;
+            for (int i = 1; i <= 100; i++)
+            {
+                rollups.Record("w" + (i % 7), true, i * 0.1f, now - i * InteractionRollups.Hour);
+            }
+
+            // Act
+            float median = rollups.ResponseTimeQuantile(0.5, 7 * Day, now);
+
+            // Assert - response times 0.1..10s spread over 100 hours
+            Assert.AreEqual(5f, median, 5f * QuantileSketch.RelativeAccuracy + 0.1f);
+        }
+    }
+}
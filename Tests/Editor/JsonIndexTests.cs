@@ -0,0 +1,222 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Text;
+using NUnit.Framework;
+using ARLinguaSphere.Core;
+using ARLinguaSphere.Core.ThirdParty;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for JsonIndex, plus an explicit benchmark against MiniJSON
+    /// </summary>
+    public class JsonIndexTests
+    {
+        private JsonIndex index;
+
+        [SetUp]
+        public void Setup()
+        {
+            index = new JsonIndex();
+        }
+
+        [Test]
+        public void JsonIndex_Load_ReadsNestedFields()
+        {
+            // Arrange
+            string json = "{\"a1\":{\"labelKey\":\"cup\",\"timestamp\":1700000000123,\"position\":{\"x\":1.5,\"y\":-2,\"z\":3e-1}}}";
+
+            // Act
+            bool loaded = index.Load(json);
+            index.Root.TryGetField("a1", out var anchor);
+            anchor.TryGetField("labelKey", out var label);
+            anchor.TryGetField("timestamp", out var timestamp);
+            anchor.TryGetField("position", out var position);
+            position.TryGetField("x", out var x);
+            position.TryGetField("y", out var y);
+            position.TryGetField("z", out var z);
+
+            // Assert
+            Assert.IsTrue(loaded);
+            Assert.AreEqual("cup", label.GetString());
+            Assert.AreEqual(1700000000123L, timestamp.GetInt64());
+            Assert.AreEqual(1.5f, x.GetSingle());
+            Assert.AreEqual(-2f, y.GetSingle());
+            Assert.AreEqual(0.3, z.GetDouble(), 1e-12);
+        }
+
+        [Test]
+        public void JsonIndex_GetString_DecodesEscapes()
+        {
+            // Arrange
+            index.Load("{\"k\":\"line\\nquote\\\" caf\\u00e9\",\"plain\":\"avión\"}");
+
+            // Act
+            index.Root.TryGetField("k", out var escaped);
+            index.Root.TryGetField("plain", out var plain);
+
+            // Assert
+            Assert.AreEqual("line\nquote\" café", escaped.GetString());
+            Assert.IsTrue(plain.StringEquals("avión"));
+        }
+
+        [Test]
+        public void JsonIndex_Cursors_IterateInDocumentOrder()
+        {
+            // Arrange
+            index.Load("{\"languages\":[\"en\",\"es\",{\"skip\":[1,2]},\"fr\"],\"version\":2,\"empty\":[]}");
+            var strings = new List<string>();
+
+            // Act
+            index.Root.TryGetField("languages", out var languages);
+            var cursor = languages.GetArray();
+            while (cursor.MoveNext())
+            {
+                if (cursor.Current.IsString) strings.Add(cursor.Current.GetString());
+            }
+            index.Root.TryGetField("version", out var version);
+            index.Root.TryGetField("empty", out var empty);
+            var emptyCursor = empty.GetArray();
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "en", "es", "fr" }, strings);
+            Assert.AreEqual(2, version.GetInt32());
+            Assert.IsFalse(emptyCursor.MoveNext());
+        }
+
+        [Test]
+        public void JsonIndex_Load_RejectsMalformedInput()
+        {
+            // Act & Assert
+            Assert.IsFalse(index.Load(""));
+            Assert.IsFalse(index.Load("{\"a\":[1,2}"));
+            Assert.IsFalse(index.Load("{\"a\":\"unterminated}"));
+            Assert.IsTrue(index.Load("null"));
+            Assert.IsTrue(index.Root.IsNull);
+        }
+
+        [Test]
+        public void JsonIndex_MatchesMiniJson_OnDictionaryShards()
+        {
+            foreach (var path in Directory.GetFiles(ShardDirectory, "*.json"))
+            {
+                if (Path.GetFileName(path) == "manifest.json") continue;
+
+                // Arrange
+                string json = File.ReadAllText(path, Encoding.UTF8);
+                var expected = MiniJSON.Deserialize(json) as Dictionary<string, object>;
+
+                // Act
+                Assert.IsTrue(index.Load(json), path);
+                var actual = new Dictionary<string, string>();
+                var entries = index.Root.GetObject();
+                while (entries.MoveNext()) actual[entries.Key] = entries.Value.GetString();
+
+                // Assert
+                Assert.AreEqual(expected.Count, actual.Count, path);
+                foreach (var kvp in expected) Assert.AreEqual(kvp.Value.ToString(), actual[kvp.Key], path);
+            }
+        }
+
+        /// <summary>
+        /// Field-by-field parse of the payloads the app actually reads: dictionary shards, a polled
+        /// room of anchors and the persisted analytics word stats. Run from the Test Runner on device builds.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void JsonIndex_Benchmark_AgainstMiniJson()
+        {
+            var payloads = new Dictionary<string, string>();
+            payloads["shard (es)"] = File.ReadAllText(Path.Combine(ShardDirectory, "es.json"), Encoding.UTF8);
+            payloads["manifest"] = File.ReadAllText(Path.Combine(ShardDirectory, "manifest.json"), Encoding.UTF8);
+            payloads["room anchors (200)"] = BuildRoomPayload(200);
+            payloads["word stats (80)"] = BuildWordStatsPayload(80);
+
+            const int iterations = 2000;
+            foreach (var payload in payloads)
+            {
+                // Warm up both paths so JIT cost is not measured
+                MiniJSON.Deserialize(payload.Value);
+                Walk(index, payload.Value);
+
+                var mini = Stopwatch.StartNew();
+                for (int i = 0; i < iterations; i++) MiniJSON.Deserialize(payload.Value);
+                mini.Stop();
+
+                var indexed = Stopwatch.StartNew();
+                double checksum = 0;
+                for (int i = 0; i < iterations; i++) checksum += Walk(index, payload.Value);
+                indexed.Stop();
+
+                UnityEngine.Debug.Log($"JsonIndexTests: {payload.Key} ({payload.Value.Length} chars) " +
+                    $"MiniJSON {mini.Elapsed.TotalMilliseconds * 1000 / iterations:F1}us, " +
+                    $"JsonIndex {indexed.Elapsed.TotalMilliseconds * 1000 / iterations:F1}us " +
+                    $"(x{mini.Elapsed.TotalMilliseconds / indexed.Elapsed.TotalMilliseconds:F1}) [checksum {checksum}]");
+            }
+            Assert.Pass();
+        }
+
+        private static string ShardDirectory => Path.Combine("Assets", "Resources", "Dictionary");
+
+        /// <summary>
+        /// Touch every scalar so the indexed path does the same decoding work the callers do
+        /// </summary>
+        private static double Walk(JsonIndex json, string text)
+        {
+            json.Load(text);
+            double sum = WalkNode(json.Root);
+            json.Clear();
+            return sum;
+        }
+
+        private static double WalkNode(JsonNode node)
+        {
+            double sum = 0;
+            if (node.IsObject)
+            {
+                var fields = node.GetObject();
+                while (fields.MoveNext()) sum += WalkNode(fields.Value);
+            }
+            else if (node.IsArray)
+            {
+                var items = node.GetArray();
+                while (items.MoveNext()) sum += WalkNode(items.Current);
+            }
+            else if (node.IsNumber)
+            {
+                sum += node.GetDouble();
+            }
+            else if (node.IsString)
+            {
+                sum += node.GetString().Length;
+            }
+            return sum;
+        }
+
+        private static string BuildRoomPayload(int anchors)
+        {
+            var random = new Random(7);
+            var sb = new StringBuilder("{");
+            for (int i = 0; i < anchors; i++)
+            {
+                if (i > 0) sb.Append(',');
+                sb.Append($"\"anchor_{i:D4}\":{{\"id\":\"anchor_{i:D4}\",\"labelKey\":\"label_{i % 40}\",\"creatorId\":\"user_{i % 5}\",\"timestamp\":{1700000000000L + i * 137},");
+                sb.Append(FormattableString.Invariant($"\"position\":{{\"x\":{random.NextDouble() * 10 - 5:R},\"y\":{random.NextDouble() * 2:R},\"z\":{random.NextDouble() * 10 - 5:R}}},"));
+                sb.Append(FormattableString.Invariant($"\"rotation\":{{\"x\":0,\"y\":{random.NextDouble():R},\"z\":0,\"w\":{random.NextDouble():R}}}}}"));
+            }
+            return sb.Append('}').ToString();
+        }
+
+        private static string BuildWordStatsPayload(int words)
+        {
+            var sb = new StringBuilder("{\"wordStats\":{");
+            for (int i = 0; i < words; i++)
+            {
+                if (i > 0) sb.Append(',');
+                sb.Append(FormattableString.Invariant($"\"word_{i}\":{{\"totalInteractions\":{i * 3},\"successfulInteractions\":{i * 2},\"averageResponseTime\":{1.25 + i * 0.01},\"difficultyLevel\":{1 + (i % 5) * 0.5},\"lastSeen\":{1700000000000L + i}}}"));
+            }
+            return sb.Append("}}").ToString();
+        }
+    }
+}
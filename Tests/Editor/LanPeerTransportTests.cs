@@ -0,0 +1,133 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Net;
+using System.Threading;
+using NUnit.Framework;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for LanPeerTransport over loopback
+    /// </summary>
+    public class LanPeerTransportTests
+    {
+        private LanPeerTransport a;
+        private LanPeerTransport b;
+
+        [SetUp]
+        public void Setup()
+        {
+            a = new LanPeerTransport();
+            b = new LanPeerTransport();
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            a.Dispose();
+            b.Dispose();
+        }
+
+        [Test]
+        public void LanPeerTransport_Broadcast_DeliversAnchorOverLoopbackWithoutRetransmission()
+        {
+            // Arrange - the transport's clock stays at 0, so the anchor can only arrive by its first transmission
+            const float now = 0f;
+            a.Start("room", discover: false);
+            b.Start("room", discover: false);
+            a.AddPeer(b.PeerId, new IPEndPoint(IPAddress.Loopback, b.DataPort), now);
+            b.AddPeer(a.PeerId, new IPEndPoint(IPAddress.Loopback, a.DataPort), now);
+            var codec = new AnchorCodec();
+            var buffer = new byte[256];
+            var sent = new AnchorData { labelKey = "cup", creatorId = "a" };
+            int length = codec.Encode(sent, buffer, 0);
+            var delivered = new List<byte[]>();
+
+            // Act
+            a.Broadcast(buffer, 0, length, now);
+            Pump(() => delivered.Count > 0, () =>
+            {
+                b.Poll(now, delivered);
+                a.Poll(now, new List<byte[]>());
+            });
+
+            // Assert
+            Assert.AreEqual(1, delivered.Count);
+            var received = new AnchorData();
+            Assert.IsTrue(codec.TryDecode(delivered[0], 0, delivered[0].Length, received, out _));
+            Assert.AreEqual(sent.id, received.id);
+            Assert.AreEqual("cup", received.labelKey);
+        }
+
+        [Test]
+        public void LanPeerTransport_ManualPeer_KeptAliveByUnicastBeaconsThenAgesOut()
+        {
+            // Arrange - only a knows b's address; b learns a's from a's unicast beacon
+            float now = 0f;
+            a.Start("room", discover: false);
+            b.Start("room", discover: false);
+            a.AddPeer(b.PeerId, new IPEndPoint(IPAddress.Loopback, b.DataPort), now);
+            var none = new List<byte[]>();
+
+            // Act - both run well past PeerTimeoutSeconds
+            for (; now < a.PeerTimeoutSeconds * 3; now += 0.5f)
+            {
+                a.Poll(now, none);
+                Pump(() => false, () => b.Poll(now, none), 20);
+                Pump(() => false, () => a.Poll(now, none), 20);
+            }
+            int aliveA = a.PeerCount;
+            int aliveB = b.PeerCount;
+            b.Stop();
+            float stoppedAt = now;
+            for (; now <= stoppedAt + a.PeerTimeoutSeconds + 0.5f; now += 0.5f) a.Poll(now, none);
+
+            // Assert
+            Assert.AreEqual(1, aliveA);
+            Assert.AreEqual(1, aliveB);
+            Assert.AreEqual(0, a.PeerCount);
+        }
+
+        [Test, Explicit("Needs multicast on the loopback interface")]
+        public void LanPeerTransport_Start_DiscoversPeersInSameRoomOnly()
+        {
+            // Arrange
+            var other = new LanPeerTransport();
+            a.Start("room");
+            b.Start("room");
+            other.Start("elsewhere");
+            var clock = Stopwatch.StartNew();
+
+            // Act
+            while ((a.PeerCount == 0 || b.PeerCount == 0) && clock.ElapsedMilliseconds < 3000)
+            {
+                float now = clock.ElapsedMilliseconds / 1000f;
+                a.Poll(now, new List<byte[]>());
+                b.Poll(now, new List<byte[]>());
+                other.Poll(now, new List<byte[]>());
+                Thread.Sleep(5);
+            }
+
+            // Assert
+            Assert.AreEqual(1, a.PeerCount);
+            Assert.AreEqual(1, b.PeerCount);
+            Assert.AreEqual(0, other.PeerCount);
+            other.Dispose();
+        }
+
+        /// <summary>
+        /// Run <paramref name="poll"/> until <paramref name="done"/> or <paramref name="milliseconds"/> of wall time
+        /// pass; only the sockets need real time, the transports' clock is the test's
+        /// </summary>
+        private static void Pump(System.Func<bool> done, System.Action poll, int milliseconds = 1000)
+        {
+            var wall = Stopwatch.StartNew();
+            while (!done() && wall.ElapsedMilliseconds < milliseconds)
+            {
+                poll();
+                Thread.Sleep(1);
+            }
+        }
+    }
+}
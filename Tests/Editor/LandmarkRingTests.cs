@@ -0,0 +1,143 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Gesture;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for LandmarkRing
+    /// </summary>
+    public class LandmarkRingTests
+    {
+        /// <summary>
+        /// 21 keypoints that all hold <paramref name="value"/>, so a torn record is easy to spot
+        /// </summary>
+        private static Vector3[] Uniform(float value)
+        {
+            var keypoints = new Vector3[21];
+            for (int i = 0; i < keypoints.Length; i++) keypoints[i] = new Vector3(value, value, value);
+            return keypoints;
+        }
+
+        [Test]
+        public void LandmarkRing_WrittenRecords_DrainedInOrder()
+        {
+            // Arrange
+            using (var ring = new LandmarkRing(4))
+            {
+                var pose = HandPoseClassifier.ReferencePose(GestureType.OpenPalm);
+                ring.Write(pose, true, 0.9f, 1500000000L);
+                ring.Write(Uniform(0.25f), false, 0.6f, 1533000000L, 0.5625f);
+                var received = new List<(Vector3[] keypoints, bool isRight, float confidence, double timestamp, float aspect)>();
+
+                // Act
+                int delivered = ring.Drain(l => received.Add(((Vector3[])l.keypoints.Clone(), l.isRight, l.confidence, l.timestamp, l.aspect)));
+                int again = ring.Drain(l => Assert.Fail("drained twice"));
+
+                // Assert
+                Assert.AreEqual(2, delivered);
+                Assert.AreEqual(0, again);
+                CollectionAssert.AreEqual(pose, received[0].keypoints);
+                Assert.IsTrue(received[0].isRight);
+                Assert.AreEqual(0.9f, received[0].confidence);
+                Assert.AreEqual(1.5, received[0].timestamp, 1e-9);
+                Assert.AreEqual(1f, received[0].aspect);
+                CollectionAssert.AreEqual(Uniform(0.25f), received[1].keypoints);
+                Assert.IsFalse(received[1].isRight);
+                Assert.AreEqual(1.533, received[1].timestamp, 1e-9);
+                Assert.AreEqual(0.5625f, received[1].aspect);
+                Assert.AreEqual(0, ring.Dropped);
+            }
+        }
+
+        [Test]
+        public void LandmarkRing_ProducerLapsConsumer_OldestDroppedAndCounted()
+        {
+            // Arrange
+            using (var ring = new LandmarkRing(4))
+            {
+                for (int i = 1; i <= 10; i++) ring.Write(Uniform(i), true, i, i);
+                var confidences = new List<float>();
+
+                // Act
+                ring.Drain(l => confidences.Add(l.confidence));
+
+                // Assert - only the latest Capacity records survive
+                CollectionAssert.AreEqual(new[] { 7f, 8f, 9f, 10f }, confidences);
+                Assert.AreEqual(6, ring.Dropped);
+                Assert.AreEqual(10, ring.LastSequence);
+            }
+        }
+
+        [Test]
+        public void LandmarkRing_ConcurrentProducer_NeverDeliversTornRecords()
+        {
+            // Arrange
+            const int records = 200000;
+            using (var ring = new LandmarkRing(8))
+            {
+                var producer = new Thread(() =>
+                {
+                    for (int i = 1; i <= records; i++) ring.Write(Uniform(i), (i & 1) == 1, i, i);
+                });
+                int delivered = 0;
+                float last = 0f;
+                int failures = 0;
+                void Check(HandLandmarks landmarks)
+                {
+                    float value = landmarks.confidence;
+                    bool consistent = value > last && landmarks.isRight == (((int)value & 1) == 1)
+                        && System.Math.Abs(landmarks.timestamp * 1e9 - value) < 0.5;
+                    foreach (var point in landmarks.keypoints)
+                    {
+                        consistent &= point.x == value && point.y == value && point.z == value;
+                    }
+                    if (!consistent) failures++;
+                    last = value;
+                    delivered++;
+                }
+
+                // Act
+                producer.Start();
+                while (producer.IsAlive) ring.Drain(Check);
+                producer.Join();
+                ring.Drain(Check);
+
+                // Assert
+                Assert.AreEqual(0, failures);
+                Assert.AreEqual(records, ring.LastSequence);
+                Assert.AreEqual(records, delivered + ring.Dropped);
+                Assert.AreEqual((float)records, last);
+            }
+        }
+
+        /// <summary>
+        /// Time to write and drain one record. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void LandmarkRing_Benchmark_WriteAndDrain()
+        {
+            using (var ring = new LandmarkRing(16))
+            {
+                var keypoints = HandPoseClassifier.ReferencePose(GestureType.ThumbsUp);
+                float sum = 0f;
+                System.Action<HandLandmarks> consume = l => sum += l.keypoints[8].y;
+
+                const int iterations = 200000;
+                var timer = Stopwatch.StartNew();
+                for (int i = 0; i < iterations; i++)
+                {
+                    ring.Write(keypoints, true, 0.9f, i);
+                    ring.Drain(consume);
+                }
+                double microseconds = timer.Elapsed.TotalMilliseconds * 1000 / iterations;
+
+                UnityEngine.Debug.Log($"LandmarkRingTests: {microseconds:F2}us per record ({sum:F0})");
+                Assert.Less(microseconds, 20.0);
+            }
+        }
+    }
+}
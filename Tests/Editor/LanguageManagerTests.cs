@@ -130,6 +130,18 @@ namespace ARLinguaSphere.Tests
             Assert.AreEqual("Prueba", result);
         }
         
+        [Test]
+        public void LanguageManager_ResolveLanguageCode_MatchesNamesNotCodeWords()
+        {
+            // Arrange
+            languageManager.Initialize();
+            
+            // Act & Assert - "it" is a word here, not Italian
+            Assert.AreEqual("es", languageManager.ResolveLanguageCode("translate it to spanish"));
+            Assert.AreEqual("es", languageManager.ResolveLanguageCode("ES"));
+            Assert.IsNull(languageManager.ResolveLanguageCode("translate it"));
+        }
+        
         [Test]
         public void LanguageManager_IsLanguageSupported_ReturnsCorrectResult()
         {
@@ -141,7 +153,7 @@ namespace ARLinguaSphere.Tests
             // Act & Assert
             Assert.IsTrue(languageManager.IsLanguageSupported("en"));
             Assert.IsTrue(languageManager.IsLanguageSupported("es"));
-            Assert.IsFalse(languageManager.IsLanguageSupported("fr"));
+            Assert.IsFalse(languageManager.IsLanguageSupported("tlh"));
         }
         
         [Test]
@@ -151,16 +163,107 @@ namespace ARLinguaSphere.Tests
             languageManager.Initialize();
             languageManager.AddCustomTranslation("test", "en", "Test");
             languageManager.AddCustomTranslation("test", "es", "Prueba");
-            languageManager.AddCustomTranslation("test", "fr", "Test");
+            languageManager.AddCustomTranslation("test", "eo", "Testo");
             
             // Act
             var availableLanguages = languageManager.GetAvailableLanguages();
             
-            // Assert
+            // Assert - the ten manifest languages plus the custom one
             Assert.Contains("en", availableLanguages);
             Assert.Contains("es", availableLanguages);
-            Assert.Contains("fr", availableLanguages);
-            Assert.AreEqual(3, availableLanguages.Count);
+            Assert.Contains("eo", availableLanguages);
+            Assert.AreEqual(11, availableLanguages.Count);
+        }
+        
+        [Test]
+        public void LanguageManager_GetAvailableLanguages_ListsManifestWithoutLoadingShards()
+        {
+            // Arrange
+            languageManager.Initialize();
+            
+            // Act
+            var availableLanguages = languageManager.GetAvailableLanguages();
+            
+            // Assert
+            CollectionAssert.AreEqual(new[] { "en", "es", "fr", "de", "it", "pt", "zh", "ja", "ko", "hi" }, availableLanguages);
+            Assert.AreEqual(1, languageManager.ResidentShardCount);
+        }
+        
+        [Test]
+        public void LanguageManager_Initialize_LoadsOnlyCurrentAndFallbackShards()
+        {
+            // Arrange
+            languageManager.currentLanguage = "es";
+            
+            // Act
+            languageManager.Initialize();
+            
+            // Assert
+            Assert.AreEqual(2, languageManager.ResidentShardCount);
+            Assert.IsTrue(languageManager.IsShardResident("en"));
+            Assert.IsTrue(languageManager.IsShardResident("es"));
+            Assert.IsFalse(languageManager.IsShardResident("fr"));
+        }
+        
+        [Test]
+        public void LanguageManager_GetTranslation_LoadsShardOnFirstUse()
+        {
+            // Arrange
+            languageManager.Initialize();
+            
+            // Act
+            string translation = languageManager.GetTranslation("person", "fr");
+            
+            // Assert
+            Assert.AreEqual("personne", translation);
+            Assert.IsTrue(languageManager.IsShardResident("fr"));
+            Assert.AreEqual(2, languageManager.ResidentShardCount);
+        }
+        
+        [Test]
+        public void LanguageManager_MaxResidentShards_EvictsLeastRecentlyUsed()
+        {
+            // Arrange
+            languageManager.maxResidentShards = 3;
+            languageManager.Initialize();
+            languageManager.GetTranslation("person", "es");
+            languageManager.GetTranslation("person", "fr");
+            
+            // Act - de pushes out es; touching fr again leaves de as the oldest for it to push out
+            languageManager.GetTranslation("person", "de");
+            languageManager.GetTranslation("person", "fr");
+            string italian = languageManager.GetTranslation("person", "it");
+            
+            // Assert - the current and fallback language (en) is never evicted
+            Assert.AreEqual("persona", italian);
+            Assert.AreEqual(3, languageManager.ResidentShardCount);
+            Assert.IsTrue(languageManager.IsShardResident("en"));
+            Assert.IsTrue(languageManager.IsShardResident("fr"));
+            Assert.IsTrue(languageManager.IsShardResident("it"));
+            Assert.IsFalse(languageManager.IsShardResident("es"));
+            Assert.IsFalse(languageManager.IsShardResident("de"));
+        }
+        
+        [Test]
+        public void LanguageManager_UnloadInactiveShards_KeepsCurrentAndFallbackAndReloadsOnUse()
+        {
+            // Arrange
+            languageManager.Initialize();
+            languageManager.SetCurrentLanguage("ja");
+            languageManager.GetTranslation("person", "fr");
+            languageManager.GetTranslation("person", "de");
+            
+            // Act - what the Application.lowMemory handler does
+            languageManager.UnloadInactiveShards();
+            int resident = languageManager.ResidentShardCount;
+            string french = languageManager.GetTranslation("person", "fr");
+            
+            // Assert
+            Assert.AreEqual(2, resident);
+            Assert.IsTrue(languageManager.IsShardResident("en"));
+            Assert.IsTrue(languageManager.IsShardResident("ja"));
+            Assert.AreEqual("personne", french);
+            Assert.IsTrue(languageManager.IsShardResident("fr"));
         }
         
         [Test]
@@ -0,0 +1,103 @@
+using NUnit.Framework;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for LexiconIndex
+    /// </summary>
+    public class LexiconIndexTests
+    {
+        private LexiconIndex index;
+
+        [SetUp]
+        public void Setup()
+        {
+            index = new LexiconIndex();
+            index.Add("apple", "apple", "en");
+            index.Add("manzana", "apple", "es");
+            index.Add("pomme", "apple", "fr");
+            index.Add("bicicleta", "bicycle", "es");
+            index.Add("bicicleta", "bicycle", "pt");
+            index.Add("bus", "bus", "en");
+            index.Add("bus", "bus", "fr");
+            index.Add("traffic light", "traffic light", "en");
+            index.Add("avión", "airplane", "es");
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolve_ExactWord_ReturnsKeyAndLanguage()
+        {
+            // Act
+            bool found = index.TryResolve("Manzana", out var match);
+
+            // Assert
+            Assert.IsTrue(found);
+            Assert.AreEqual("apple", match.key);
+            Assert.AreEqual("es", match.language);
+            Assert.AreEqual(0, match.distance);
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolve_Misspelling_ReturnsClosestKey()
+        {
+            // Act
+            bool found = index.TryResolve("bicicletta", out var match);
+
+            // Assert
+            Assert.IsTrue(found);
+            Assert.AreEqual("bicycle", match.key);
+            Assert.AreEqual(1, match.distance);
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolve_IgnoresDiacritics()
+        {
+            // Act
+            bool found = index.TryResolve("avion", out var match);
+
+            // Assert
+            Assert.IsTrue(found);
+            Assert.AreEqual("airplane", match.key);
+            Assert.AreEqual(0, match.distance);
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolve_ShortWords_RequireExactMatch()
+        {
+            // Act & Assert
+            Assert.IsFalse(index.TryResolve("bun", out _));
+            Assert.IsTrue(index.TryResolve("bus", out _));
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolve_PrefersRequestedLanguage()
+        {
+            // Act
+            index.TryResolve("bicicleta", out var defaultMatch);
+            index.TryResolve("bicicleta", out var preferredMatch, "pt");
+
+            // Assert
+            Assert.AreEqual("es", defaultMatch.language);
+            Assert.AreEqual("pt", preferredMatch.language);
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolveInPhrase_FindsMultiWordTerm()
+        {
+            // Act
+            bool found = index.TryResolveInPhrase("what is that traffic light?", out var match);
+
+            // Assert
+            Assert.IsTrue(found);
+            Assert.AreEqual("traffic light", match.key);
+        }
+
+        [Test]
+        public void LexiconIndex_TryResolveInPhrase_UnknownWords_ReturnsFalse()
+        {
+            // Act & Assert
+            Assert.IsFalse(index.TryResolveInPhrase("nothing to see here", out _));
+        }
+    }
+}
@@ -0,0 +1,171 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.Compression;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// In-process stand-in for an analytics ingestion endpoint: accepts gzipped (or plain) JSON batches on loopback,
+    /// records each accepted batch with its event ids and wire size, and can be scripted to answer the next requests
+    /// with error statuses and a Retry-After, or to hold responses back.
+    /// </summary>
+    public sealed class LocalIngestServer : IDisposable
+    {
+        public string Url { get; }
+        public int Requests => requests;
+        public IReadOnlyList<Batch> Batches
+        {
+            get
+            {
+                lock (batches) return batches.ToArray();
+            }
+        }
+
+        private readonly HttpListener listener = new HttpListener();
+        private readonly Thread thread;
+        private readonly List<Batch> batches = new List<Batch>();
+        private readonly ConcurrentQueue<KeyValuePair<int, string>> scripted = new ConcurrentQueue<KeyValuePair<int, string>>();
+        private readonly ManualResetEventSlim respond = new ManualResetEventSlim(true);
+        private int requests;
+
+        public LocalIngestServer()
+        {
+            var probe = new TcpListener(IPAddress.Loopback, 0);
+            probe.Start();
+            int port = ((IPEndPoint)probe.LocalEndpoint).Port;
+            probe.Stop();
+            Url = $"http://127.0.0.1:{port}/ingest";
+            listener.Prefixes.Add($"http://127.0.0.1:{port}/");
+            listener.Start();
+            thread = new Thread(Serve) { IsBackground = true };
+            thread.Start();
+        }
+
+        /// <summary>
+        /// Answer the next request with <paramref name="status"/> (and Retry-After, if given) instead of accepting it
+        /// </summary>
+        public void FailNext(int status, string retryAfter = null)
+        {
+            scripted.Enqueue(new KeyValuePair<int, string>(status, retryAfter));
+        }
+
+        /// <summary>
+        /// Read requests but do not answer them until ReleaseResponses
+        /// </summary>
+        public void HoldResponses()
+        {
+            respond.Reset();
+        }
+
+        public void ReleaseResponses()
+        {
+            respond.Set();
+        }
+
+        /// <summary>
+        /// Event ids of every accepted batch, in arrival order
+        /// </summary>
+        public List<long> EventIds()
+        {
+            var ids = new List<long>();
+            foreach (var batch in Batches)
+            {
+                ids.AddRange(batch.ids);
+            }
+            return ids;
+        }
+
+        /// <summary>
+        /// Block until at least <paramref name="count"/> events have been accepted. Returns false on timeout.
+        /// </summary>
+        public bool WaitForEvents(int count, int millisecondsTimeout)
+        {
+            var deadline = DateTime.UtcNow.AddMilliseconds(millisecondsTimeout);
+            while (EventIds().Count < count)
+            {
+                if (DateTime.UtcNow > deadline) return false;
+                Thread.Sleep(10);
+            }
+            return true;
+        }
+
+        public void Dispose()
+        {
+            respond.Set();
+            listener.Close();
+            thread.Join(1000);
+        }
+
+        private void Serve()
+        {
+            while (listener.IsListening)
+            {
+                HttpListenerContext context;
+                try
+                {
+                    context = listener.GetContext();
+                }
+                catch (HttpListenerException)
+                {
+                    return;
+                }
+                catch (ObjectDisposedException)
+                {
+                    return;
+                }
+
+                Interlocked.Increment(ref requests);
+                var raw = new MemoryStream();
+                context.Request.InputStream.CopyTo(raw);
+                respond.Wait();
+                if (scripted.TryDequeue(out var failure))
+                {
+                    context.Response.StatusCode = failure.Key;
+                    if (failure.Value != null) context.Response.AddHeader("Retry-After", failure.Value);
+                    context.Response.Close();
+                    continue;
+                }
+
+                var batch = new Batch { wireBytes = (int)raw.Length, gzip = context.Request.Headers["Content-Encoding"] == "gzip" };
+                raw.Position = 0;
+                Stream body = batch.gzip ? new GZipStream(raw, CompressionMode.Decompress) : (Stream)raw;
+                using (var reader = new StreamReader(body, Encoding.UTF8))
+                {
+                    batch.json = reader.ReadToEnd();
+                }
+                var index = new JsonIndex();
+                if (!index.Load(batch.json) || !index.Root.TryGetField("events", out var events))
+                {
+                    context.Response.StatusCode = 400;
+                    context.Response.Close();
+                    continue;
+                }
+                if (index.Root.TryGetField("userId", out var user)) batch.userId = user.GetString();
+                var cursor = events.GetArray();
+                while (cursor.MoveNext())
+                {
+                    if (cursor.Current.TryGetField("id", out var id)) batch.ids.Add(id.GetInt64());
+                }
+                lock (batches) batches.Add(batch);
+                context.Response.StatusCode = 200;
+                context.Response.Close();
+            }
+        }
+
+        public sealed class Batch
+        {
+            public string userId;
+            public string json; // decompressed body
+            public int wireBytes;
+            public bool gzip;
+            public readonly List<long> ids = new List<long>();
+        }
+    }
+}
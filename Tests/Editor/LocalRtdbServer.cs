@@ -0,0 +1,840 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Net;
+using System.Net.Sockets;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+using ARLinguaSphere.Core;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// In-process stand-in for the Realtime Database REST API, covering the subset the app uses: GET (orderBy/startAt
+    /// queries, ETags, text/event-stream listeners), PUT (with if-match), multi-path PATCH, POST push ids, DELETE and
+    /// {".sv":"timestamp"}. Serves plain HTTP/1.1 with keep-alive on loopback, adds configurable latency and loss,
+    /// and counts connections, requests and bytes on the wire.
+    /// </summary>
+    public sealed class LocalRtdbServer : IDisposable
+    {
+        public int LatencyMs { get; set; } // added before each request is handled and each stream event is sent
+        public int JitterMs { get; set; }
+        public double LossRate { get; set; } // chance a request goes unanswered or a stream connection is cut
+        public int Port { get; }
+        public string BaseUrl => "http://127.0.0.1:" + Port.ToString(CultureInfo.InvariantCulture);
+        public int Connections => connections;
+        public int Requests => requests;
+        public int Dropped => dropped;
+        public long BytesIn => Interlocked.Read(ref bytesIn);
+        public long BytesOut => Interlocked.Read(ref bytesOut);
+
+        private readonly TcpListener listener;
+        private readonly Node root = new Node();
+        private readonly object gate = new object();
+        private readonly List<StreamListener> streams = new List<StreamListener>();
+        private readonly System.Random random;
+        private readonly Stopwatch clock = Stopwatch.StartNew();
+        private readonly CancellationTokenSource shutdown = new CancellationTokenSource();
+        private readonly JsonIndex json = new JsonIndex(); // guarded by gate
+        private int connections;
+        private int requests;
+        private int dropped;
+        private long bytesIn;
+        private long bytesOut;
+        private long lastTimestamp;
+        private int pushCounter;
+
+        public LocalRtdbServer(int seed = 1)
+        {
+            random = new System.Random(seed);
+            listener = new TcpListener(IPAddress.Loopback, 0);
+            listener.Start();
+            Port = ((IPEndPoint)listener.LocalEndpoint).Port;
+            Task.Run(AcceptLoop);
+        }
+
+        public void Dispose()
+        {
+            shutdown.Cancel();
+            listener.Stop();
+            lock (gate)
+            {
+                foreach (var stream in streams)
+                {
+                    stream.Close();
+                }
+                streams.Clear();
+            }
+        }
+
+        /// <summary>
+        /// Current value at a database path (e.g. "rooms/r1/ops") as JSON, "null" if absent.
+        /// </summary>
+        public string Read(string path)
+        {
+            lock (gate)
+            {
+                var sb = new StringBuilder();
+                Serialize(Find(Split(path)), null, sb);
+                return sb.ToString();
+            }
+        }
+
+        public void ResetCounters()
+        {
+            Interlocked.Exchange(ref connections, 0);
+            Interlocked.Exchange(ref requests, 0);
+            Interlocked.Exchange(ref dropped, 0);
+            Interlocked.Exchange(ref bytesIn, 0);
+            Interlocked.Exchange(ref bytesOut, 0);
+        }
+
+        private async Task AcceptLoop()
+        {
+            while (!shutdown.IsCancellationRequested)
+            {
+                TcpClient client;
+                try
+                {
+                    client = await listener.AcceptTcpClientAsync();
+                }
+                catch (Exception) when (shutdown.IsCancellationRequested)
+                {
+                    return;
+                }
+                catch (SocketException)
+                {
+                    continue;
+                }
+                client.NoDelay = true;
+                Interlocked.Increment(ref connections);
+                _ = Task.Run(() => Serve(client));
+            }
+        }
+
+        private async Task Serve(TcpClient client)
+        {
+            using (client)
+            {
+                try
+                {
+                    var stream = client.GetStream();
+                    var reader = new RequestReader(stream, this);
+                    while (!shutdown.IsCancellationRequested)
+                    {
+                        var request = await reader.ReadAsync();
+                        if (request == null) return;
+                        Interlocked.Increment(ref requests);
+                        await Delay();
+                        if (Lose())
+                        {
+                            // Unanswered: the client sees its connection close mid-request
+                            Interlocked.Increment(ref dropped);
+                            return;
+                        }
+                        if (request.method == "GET" && request.Header("Accept").Contains("text/event-stream"))
+                        {
+                            await Listen(stream, request);
+                            return;
+                        }
+                        var response = Handle(request);
+                        await WriteResponse(stream, response, request.closeConnection);
+                        if (request.closeConnection) return;
+                    }
+                }
+                catch (IOException) { }
+                catch (ObjectDisposedException) { }
+                catch (SocketException) { }
+                catch (OperationCanceledException) { }
+            }
+        }
+
+        private Response Handle(Request request)
+        {
+            string[] path = request.path;
+            if (path == null) return new Response(400, "{\"error\":\"paths end in .json\"}");
+            lock (gate)
+            {
+                switch (request.method)
+                {
+                    case "GET":
+                    {
+                        var node = Find(path);
+                        var response = new Response(200, ToJson(node, request.query));
+                        if (request.Header("X-Firebase-ETag") == "true") response.etag = ETag(node);
+                        return response;
+                    }
+                    case "PUT":
+                    {
+                        string ifMatch = request.Header("if-match");
+                        if (ifMatch.Length > 0 && ifMatch != ETag(Find(path)))
+                        {
+                            return new Response(412, ToJson(Find(path), null)) { etag = ETag(Find(path)) };
+                        }
+                        if (!TryParse(request.body, out var value)) return BadBody();
+                        Set(path, value);
+                        Notify(new List<string[]> { path });
+                        return new Response(200, ToJson(value, null));
+                    }
+                    case "PATCH":
+                    {
+                        if (!json.Load(request.body) || !json.Root.IsObject) return BadBody();
+                        long now = Timestamp();
+                        var updates = new List<KeyValuePair<string[], Node>>();
+                        var fields = json.Root.GetObject();
+                        while (fields.MoveNext())
+                        {
+                            updates.Add(new KeyValuePair<string[], Node>(Concat(path, Split(fields.Key)), Build(fields.Value, now)));
+                        }
+                        json.Clear();
+                        var written = new List<string[]>(updates.Count);
+                        foreach (var update in updates)
+                        {
+                            Set(update.Key, update.Value);
+                            written.Add(update.Key);
+                        }
+                        Notify(written);
+                        return new Response(200, request.body);
+                    }
+                    case "POST":
+                    {
+                        if (!TryParse(request.body, out var value)) return BadBody();
+                        // Push ids sort by creation time, like the real ones
+                        string key = "-" + Timestamp().ToString("x12", CultureInfo.InvariantCulture) + (++pushCounter).ToString("x8", CultureInfo.InvariantCulture);
+                        var child = Concat(path, new[] { key });
+                        Set(child, value);
+                        Notify(new List<string[]> { child });
+                        return new Response(200, "{\"name\":\"" + key + "\"}");
+                    }
+                    case "DELETE":
+                        Set(path, null);
+                        Notify(new List<string[]> { path });
+                        return new Response(200, "null");
+                    default:
+                        return new Response(405, "{\"error\":\"method not allowed\"}");
+                }
+            }
+        }
+
+        private static Response BadBody()
+        {
+            return new Response(400, "{\"error\":\"invalid JSON body\"}");
+        }
+
+        /// <summary>
+        /// Streams a put of the current value, then every change below the path, until the client disconnects.
+        /// </summary>
+        private async Task Listen(NetworkStream stream, Request request)
+        {
+            var subscriber = new StreamListener(request.path, request.query, stream);
+            lock (gate)
+            {
+                // Registered under the same lock as the snapshot so no write falls between them
+                subscriber.Enqueue(Event("put", "/", ToJson(Find(request.path), request.query)), clock.ElapsedMilliseconds);
+                streams.Add(subscriber);
+            }
+            byte[] head = Encoding.ASCII.GetBytes("HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n");
+            await stream.WriteAsync(head, 0, head.Length, shutdown.Token);
+            Interlocked.Add(ref bytesOut, head.Length);
+            try
+            {
+                while (true)
+                {
+                    var item = await subscriber.Next(shutdown.Token);
+                    if (item.bytes == null) return;
+                    long wait = item.due - clock.ElapsedMilliseconds;
+                    if (wait > 0) await Task.Delay((int)wait, shutdown.Token);
+                    if (Lose())
+                    {
+                        Interlocked.Increment(ref dropped);
+                        return;
+                    }
+                    await stream.WriteAsync(item.bytes, 0, item.bytes.Length, shutdown.Token);
+                    Interlocked.Add(ref bytesOut, item.bytes.Length);
+                }
+            }
+            finally
+            {
+                lock (gate)
+                {
+                    streams.Remove(subscriber);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Queues events for listeners affected by writes at <paramref name="written"/>. Called under gate.
+        /// </summary>
+        private void Notify(List<string[]> written)
+        {
+            if (streams.Count == 0) return;
+            var children = new StringBuilder();
+            foreach (var stream in streams)
+            {
+                bool replaced = false;
+                int childCount = 0;
+                string singleChild = null;
+                children.Length = 0;
+                foreach (var path in written)
+                {
+                    if (IsPrefix(path, stream.path))
+                    {
+                        replaced = true; // written at or above the listener: resend everything
+                        break;
+                    }
+                    if (!IsPrefix(stream.path, path)) continue;
+                    string child = path[stream.path.Length];
+                    var node = Find(Concat(stream.path, new[] { child }));
+                    if (node != null && !Matches(child, node, stream.query)) continue;
+                    if (path.Length > stream.path.Length + 1)
+                    {
+                        // Below a child: a put at the deeper path
+                        var relative = new StringBuilder();
+                        for (int i = stream.path.Length; i < path.Length; i++) relative.Append('/').Append(path[i]);
+                        stream.Enqueue(Event("put", relative.ToString(), ToJson(Find(path), null)), Due(stream));
+                        continue;
+                    }
+                    if (childCount++ > 0) children.Append(',');
+                    Quote(child, children);
+                    children.Append(':');
+                    Serialize(node, null, children);
+                    singleChild = child;
+                }
+                if (replaced)
+                {
+                    stream.Enqueue(Event("put", "/", ToJson(Find(stream.path), stream.query)), Due(stream));
+                }
+                else if (childCount == 1)
+                {
+                    stream.Enqueue(Event("put", "/" + singleChild, ToJson(Find(Concat(stream.path, new[] { singleChild })), null)), Due(stream));
+                }
+                else if (childCount > 1)
+                {
+                    // A multi-path update arrives as one patch of the listener's children
+                    stream.Enqueue(Event("patch", "/", "{" + children + "}"), Due(stream));
+                }
+            }
+        }
+
+        private long Due(StreamListener stream)
+        {
+            long due = clock.ElapsedMilliseconds + LatencyMs + (JitterMs > 0 ? NextRandom(JitterMs) : 0);
+            // Events on one connection keep their order whatever the jitter
+            if (due < stream.lastDue) due = stream.lastDue;
+            stream.lastDue = due;
+            return due;
+        }
+
+        private static byte[] Event(string type, string path, string data)
+        {
+            var sb = new StringBuilder(64 + data.Length);
+            sb.Append("event: ").Append(type).Append("\ndata: {\"path\":");
+            Quote(path, sb);
+            sb.Append(",\"data\":").Append(data).Append("}\n\n");
+            return Encoding.UTF8.GetBytes(sb.ToString());
+        }
+
+        private async Task WriteResponse(NetworkStream stream, Response response, bool close)
+        {
+            byte[] body = Encoding.UTF8.GetBytes(response.body);
+            var head = new StringBuilder(160);
+            head.Append("HTTP/1.1 ").Append(response.status).Append(' ').Append(Reason(response.status)).Append("\r\n");
+            head.Append("Content-Type: application/json; charset=utf-8\r\n");
+            head.Append("Content-Length: ").Append(body.Length).Append("\r\n");
+            if (response.etag != null) head.Append("ETag: ").Append(response.etag).Append("\r\n");
+            if (close) head.Append("Connection: close\r\n");
+            head.Append("\r\n");
+            byte[] headBytes = Encoding.ASCII.GetBytes(head.ToString());
+            await stream.WriteAsync(headBytes, 0, headBytes.Length, shutdown.Token);
+            await stream.WriteAsync(body, 0, body.Length, shutdown.Token);
+            Interlocked.Add(ref bytesOut, headBytes.Length + body.Length);
+        }
+
+        private static string Reason(int status)
+        {
+            switch (status)
+            {
+                case 200: return "OK";
+                case 400: return "Bad Request";
+                case 405: return "Method Not Allowed";
+                case 411: return "Length Required";
+                case 412: return "Precondition Failed";
+                default: return "Error";
+            }
+        }
+
+        private async Task Delay()
+        {
+            int delay = LatencyMs + (JitterMs > 0 ? NextRandom(JitterMs) : 0);
+            if (delay > 0) await Task.Delay(delay, shutdown.Token);
+        }
+
+        private bool Lose()
+        {
+            if (LossRate <= 0) return false;
+            lock (random)
+            {
+                return random.NextDouble() < LossRate;
+            }
+        }
+
+        private int NextRandom(int max)
+        {
+            lock (random)
+            {
+                return random.Next(max + 1);
+            }
+        }
+
+        private long Timestamp()
+        {
+            long now = DateTimeOffset.UtcNow.ToUnixTimeMilliseconds();
+            if (now < lastTimestamp) now = lastTimestamp;
+            lastTimestamp = now;
+            return now;
+        }
+
+        #region Tree
+
+        private Node Find(string[] path)
+        {
+            var node = root;
+            foreach (var segment in path)
+            {
+                if (node.children == null || !node.children.TryGetValue(segment, out node)) return null;
+            }
+            return node;
+        }
+
+        /// <summary>
+        /// Replace the value at a path; null deletes it, and parents left empty disappear as in the real database.
+        /// </summary>
+        private void Set(string[] path, Node value)
+        {
+            if (path.Length == 0)
+            {
+                root.children = value?.children;
+                return;
+            }
+            var parents = new Node[path.Length];
+            var node = root;
+            for (int i = 0; i < path.Length - 1; i++)
+            {
+                parents[i] = node;
+                if (node.children == null)
+                {
+                    if (value == null) return;
+                    node.children = new SortedDictionary<string, Node>(StringComparer.Ordinal);
+                    node.value = null;
+                }
+                if (!node.children.TryGetValue(path[i], out var next))
+                {
+                    if (value == null) return;
+                    next = new Node();
+                    node.children[path[i]] = next;
+                }
+                node = next;
+            }
+            parents[path.Length - 1] = node;
+
+            string last = path[path.Length - 1];
+            if (value != null)
+            {
+                if (node.children == null)
+                {
+                    node.children = new SortedDictionary<string, Node>(StringComparer.Ordinal);
+                    node.value = null;
+                }
+                node.children[last] = value;
+                return;
+            }
+            node.children?.Remove(last);
+            for (int i = path.Length - 1; i > 0; i--)
+            {
+                var parent = parents[i];
+                if (parent.children != null && parent.children.Count > 0) break;
+                parents[i - 1].children?.Remove(path[i - 1]);
+            }
+        }
+
+        private bool TryParse(string body, out Node value)
+        {
+            value = null;
+            if (!json.Load(body)) return false;
+            value = Build(json.Root, Timestamp());
+            json.Clear();
+            return true;
+        }
+
+        private static Node Build(JsonNode source, long now)
+        {
+            switch (source.Kind)
+            {
+                case JsonKind.Object:
+                {
+                    if (source.TryGetField(".sv", out _)) return new Node { value = now.ToString(CultureInfo.InvariantCulture) };
+                    var node = new Node { children = new SortedDictionary<string, Node>(StringComparer.Ordinal) };
+                    var fields = source.GetObject();
+                    while (fields.MoveNext())
+                    {
+                        var child = Build(fields.Value, now);
+                        if (child != null) node.children[fields.Key] = child;
+                    }
+                    return node.children.Count > 0 ? node : null;
+                }
+                case JsonKind.Array:
+                {
+                    // Arrays are stored as objects keyed by index, as the real database does
+                    var node = new Node { children = new SortedDictionary<string, Node>(StringComparer.Ordinal) };
+                    var items = source.GetArray();
+                    int index = 0;
+                    while (items.MoveNext())
+                    {
+                        var child = Build(items.Current, now);
+                        if (child != null) node.children[index.ToString(CultureInfo.InvariantCulture)] = child;
+                        index++;
+                    }
+                    return node.children.Count > 0 ? node : null;
+                }
+                case JsonKind.String:
+                {
+                    var sb = new StringBuilder();
+                    Quote(source.GetString(), sb);
+                    return new Node { value = sb.ToString() };
+                }
+                case JsonKind.Number:
+                case JsonKind.True:
+                case JsonKind.False:
+                    return new Node { value = source.GetString() };
+                default:
+                    return null;
+            }
+        }
+
+        private static string ToJson(Node node, Query query)
+        {
+            var sb = new StringBuilder(256);
+            Serialize(node, query, sb);
+            return sb.ToString();
+        }
+
+        private static void Serialize(Node node, Query query, StringBuilder sb)
+        {
+            if (node == null)
+            {
+                sb.Append("null");
+                return;
+            }
+            if (node.children == null)
+            {
+                sb.Append(node.value);
+                return;
+            }
+            sb.Append('{');
+            bool first = true;
+            foreach (var child in node.children)
+            {
+                if (query != null && !Matches(child.Key, child.Value, query)) continue;
+                if (!first) sb.Append(',');
+                first = false;
+                Quote(child.Key, sb);
+                sb.Append(':');
+                Serialize(child.Value, null, sb);
+            }
+            sb.Append('}');
+        }
+
+        /// <summary>
+        /// Whether a child passes orderBy/startAt/endAt: by key for "$key", otherwise by the named child value.
+        /// </summary>
+        private static bool Matches(string key, Node child, Query query)
+        {
+            if (query == null || query.orderBy == null) return true;
+            string value;
+            if (query.orderBy == "$key")
+            {
+                var sb = new StringBuilder();
+                Quote(key, sb);
+                value = sb.ToString();
+            }
+            else
+            {
+                value = child.children != null && child.children.TryGetValue(query.orderBy, out var field) ? field.value : null;
+            }
+            if (query.startAt != null && (value == null || Compare(value, query.startAt) < 0)) return false;
+            if (query.endAt != null && (value == null || Compare(value, query.endAt) > 0)) return false;
+            return true;
+        }
+
+        /// <summary>
+        /// Orders raw JSON scalars: numbers numerically, strings ordinally, numbers before strings.
+        /// </summary>
+        private static int Compare(string a, string b)
+        {
+            bool aNumber = double.TryParse(a, NumberStyles.Float, CultureInfo.InvariantCulture, out double x);
+            bool bNumber = double.TryParse(b, NumberStyles.Float, CultureInfo.InvariantCulture, out double y);
+            if (aNumber && bNumber) return x.CompareTo(y);
+            if (aNumber != bNumber) return aNumber ? -1 : 1;
+            return string.CompareOrdinal(a, b);
+        }
+
+        private static string ETag(Node node)
+        {
+            // FNV-1a over the serialized value: equal content, equal tag
+            ulong hash = 14695981039346656037UL;
+            foreach (char c in ToJson(node, null))
+            {
+                hash = (hash ^ c) * 1099511628211UL;
+            }
+            return "\"" + hash.ToString("x16", CultureInfo.InvariantCulture) + "\"";
+        }
+
+        private static void Quote(string value, StringBuilder sb)
+        {
+            sb.Append('"');
+            foreach (char c in value)
+            {
+                switch (c)
+                {
+                    case '"': sb.Append("\\\""); break;
+                    case '\\': sb.Append("\\\\"); break;
+                    case '\n': sb.Append("\\n"); break;
+                    case '\r': sb.Append("\\r"); break;
+                    case '\t': sb.Append("\\t"); break;
+                    default:
+                        if (c < ' ') sb.Append("\\u").Append(((int)c).ToString("x4", CultureInfo.InvariantCulture));
+                        else sb.Append(c);
+                        break;
+                }
+            }
+            sb.Append('"');
+        }
+
+        private static bool IsPrefix(string[] prefix, string[] path)
+        {
+            if (prefix.Length > path.Length) return false;
+            for (int i = 0; i < prefix.Length; i++)
+            {
+                if (prefix[i] != path[i]) return false;
+            }
+            return true;
+        }
+
+        private static string[] Concat(string[] a, string[] b)
+        {
+            var result = new string[a.Length + b.Length];
+            Array.Copy(a, result, a.Length);
+            Array.Copy(b, 0, result, a.Length, b.Length);
+            return result;
+        }
+
+        private static string[] Split(string path)
+        {
+            return path.Split(new[] { '/' }, StringSplitOptions.RemoveEmptyEntries);
+        }
+
+        #endregion
+
+        private sealed class Node
+        {
+            public SortedDictionary<string, Node> children; // null for scalars
+            public string value; // raw JSON scalar
+        }
+
+        private sealed class Query
+        {
+            public string orderBy; // "$key" or a child name
+            public string startAt; // raw JSON scalar
+            public string endAt;
+        }
+
+        private sealed class Response
+        {
+            public readonly int status;
+            public readonly string body;
+            public string etag;
+
+            public Response(int status, string body)
+            {
+                this.status = status;
+                this.body = body;
+            }
+        }
+
+        private sealed class Request
+        {
+            public string method;
+            public string[] path; // null unless the target ends in .json
+            public Query query;
+            public string body;
+            public bool closeConnection;
+            public readonly Dictionary<string, string> headers = new Dictionary<string, string>(StringComparer.OrdinalIgnoreCase);
+
+            public string Header(string name)
+            {
+                return headers.TryGetValue(name, out var value) ? value : string.Empty;
+            }
+
+            public void ParseTarget(string target)
+            {
+                int question = target.IndexOf('?');
+                string path = Uri.UnescapeDataString(question < 0 ? target : target.Substring(0, question));
+                if (path.EndsWith(".json", StringComparison.Ordinal)) this.path = Split(path.Substring(0, path.Length - 5));
+                if (question < 0) return;
+
+                foreach (var pair in target.Substring(question + 1).Split('&'))
+                {
+                    int equals = pair.IndexOf('=');
+                    if (equals < 0) continue;
+                    string name = pair.Substring(0, equals);
+                    string value = Uri.UnescapeDataString(pair.Substring(equals + 1));
+                    if (query == null) query = new Query();
+                    switch (name)
+                    {
+                        case "orderBy": query.orderBy = value.Trim('"'); break;
+                        case "startAt": query.startAt = value; break;
+                        case "endAt": query.endAt = value; break;
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Reads keep-alive HTTP/1.1 requests (Content-Length bodies) off one connection
+        /// </summary>
+        private sealed class RequestReader
+        {
+            private readonly NetworkStream stream;
+            private readonly LocalRtdbServer server;
+            private byte[] buffer = new byte[16 * 1024];
+            private int start;
+            private int end;
+
+            public RequestReader(NetworkStream stream, LocalRtdbServer server)
+            {
+                this.stream = stream;
+                this.server = server;
+            }
+
+            public async Task<Request> ReadAsync()
+            {
+                int headerEnd;
+                while ((headerEnd = HeaderEnd()) < 0)
+                {
+                    if (!await Fill()) return null;
+                }
+                string head = Encoding.ASCII.GetString(buffer, start, headerEnd - start);
+                start = headerEnd + 4;
+
+                var lines = head.Split(new[] { "\r\n" }, StringSplitOptions.None);
+                var requestLine = lines[0].Split(' ');
+                if (requestLine.Length < 3) return null;
+                var request = new Request { method = requestLine[0] };
+                request.ParseTarget(requestLine[1]);
+                for (int i = 1; i < lines.Length; i++)
+                {
+                    int colon = lines[i].IndexOf(':');
+                    if (colon > 0) request.headers[lines[i].Substring(0, colon).Trim()] = lines[i].Substring(colon + 1).Trim();
+                }
+                request.closeConnection = request.Header("Connection").Equals("close", StringComparison.OrdinalIgnoreCase)
+                    || requestLine[2] == "HTTP/1.0";
+                if (request.Header("Transfer-Encoding").Length > 0) return null; // chunked uploads are not used by the app
+
+                int length = int.TryParse(request.Header("Content-Length"), out int parsed) ? parsed : 0;
+                if (length > 0 && request.Header("Expect").Equals("100-continue", StringComparison.OrdinalIgnoreCase) && end - start < length)
+                {
+                    byte[] proceed = Encoding.ASCII.GetBytes("HTTP/1.1 100 Continue\r\n\r\n");
+                    await stream.WriteAsync(proceed, 0, proceed.Length);
+                    Interlocked.Add(ref server.bytesOut, proceed.Length);
+                }
+                while (end - start < length)
+                {
+                    if (!await Fill()) return null;
+                }
+                request.body = Encoding.UTF8.GetString(buffer, start, length);
+                start += length;
+                return request;
+            }
+
+            private int HeaderEnd()
+            {
+                for (int i = start; i + 3 < end; i++)
+                {
+                    if (buffer[i] == '\r' && buffer[i + 1] == '\n' && buffer[i + 2] == '\r' && buffer[i + 3] == '\n') return i;
+                }
+                return -1;
+            }
+
+            private async Task<bool> Fill()
+            {
+                if (start > 0)
+                {
+                    Buffer.BlockCopy(buffer, start, buffer, 0, end - start);
+                    end -= start;
+                    start = 0;
+                }
+                if (end == buffer.Length) Array.Resize(ref buffer, buffer.Length * 2);
+                int read = await stream.ReadAsync(buffer, end, buffer.Length - end, server.shutdown.Token);
+                if (read <= 0) return false;
+                end += read;
+                Interlocked.Add(ref server.bytesIn, read);
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// One text/event-stream connection: its path, query and queue of timed events
+        /// </summary>
+        private sealed class StreamListener
+        {
+            public readonly string[] path;
+            public readonly Query query;
+            public long lastDue;
+
+            private readonly NetworkStream connection;
+            private readonly ConcurrentQueue<TimedEvent> queue = new ConcurrentQueue<TimedEvent>();
+            private readonly SemaphoreSlim signal = new SemaphoreSlim(0);
+            private volatile bool closed;
+
+            public StreamListener(string[] path, Query query, NetworkStream connection)
+            {
+                this.path = path;
+                this.query = query;
+                this.connection = connection;
+            }
+
+            public void Enqueue(byte[] bytes, long due)
+            {
+                queue.Enqueue(new TimedEvent { bytes = bytes, due = due });
+                signal.Release();
+            }
+
+            public async Task<TimedEvent> Next(CancellationToken token)
+            {
+                while (!closed)
+                {
+                    await signal.WaitAsync(token);
+                    if (queue.TryDequeue(out var item)) return item;
+                }
+                return default;
+            }
+
+            public void Close()
+            {
+                closed = true;
+                signal.Release();
+                connection.Close();
+            }
+        }
+
+        private struct TimedEvent
+        {
+            public byte[] bytes;
+            public long due;
+        }
+    }
+}
@@ -0,0 +1,150 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Net.Http;
+using System.Text;
+using NUnit.Framework;
+using ARLinguaSphere.Core;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for LocalRtdbServer, the Realtime Database stand-in used by the load and transport tests
+    /// </summary>
+    public class LocalRtdbServerTests
+    {
+        private LocalRtdbServer server;
+        private HttpClient http;
+
+        [SetUp]
+        public void Setup()
+        {
+            server = new LocalRtdbServer();
+            http = new HttpClient();
+            http.DefaultRequestHeaders.ExpectContinue = false;
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            http.Dispose();
+            server.Dispose();
+        }
+
+        [Test]
+        public void LocalRtdbServer_Patch_WritesEveryPathAndResolvesServerTimestamp()
+        {
+            // Arrange
+            string body = "{\"ops/k1\":{\"data\":\"AQ==\",\"at\":{\".sv\":\"timestamp\"}},\"cells/0_0/anchors/a\":{\"label\":\"cup\"}}";
+
+            // Act
+            var response = Send(new HttpMethod("PATCH"), "/rooms/r1.json", body);
+
+            // Assert
+            Assert.IsTrue(response.IsSuccessStatusCode);
+            var json = new JsonIndex();
+            Assert.IsTrue(json.Load(server.Read("rooms/r1")));
+            Assert.IsTrue(json.Root.TryGetField("ops", out var ops));
+            Assert.IsTrue(ops.TryGetField("k1", out var op));
+            Assert.IsTrue(op.TryGetField("at", out var at));
+            Assert.Greater(at.GetInt64(), 1_600_000_000_000L);
+            Assert.AreEqual("{\"anchors\":{\"a\":{\"label\":\"cup\"}}}", server.Read("rooms/r1/cells/0_0"));
+        }
+
+        [Test]
+        public void LocalRtdbServer_Get_OrderByStartAt_ReturnsOnlyMatchingChildren()
+        {
+            // Arrange
+            Send(HttpMethod.Put, "/rooms/r1/anchors.json", "{\"a\":{\"timestamp\":10},\"b\":{\"timestamp\":20},\"c\":{\"timestamp\":30}}");
+
+            // Act
+            string filtered = Get("/rooms/r1/anchors.json?orderBy=%22timestamp%22&startAt=20");
+            string byKey = Get("/rooms/r1/anchors.json?orderBy=%22$key%22&startAt=%22c%22");
+
+            // Assert
+            Assert.AreEqual("{\"b\":{\"timestamp\":20},\"c\":{\"timestamp\":30}}", filtered);
+            Assert.AreEqual("{\"c\":{\"timestamp\":30}}", byKey);
+        }
+
+        [Test]
+        public void LocalRtdbServer_PutWithStaleIfMatch_IsRejectedWith412()
+        {
+            // Arrange
+            var read = new HttpRequestMessage(HttpMethod.Get, server.BaseUrl + "/rooms/r1/snapshot.json");
+            read.Headers.Add("X-Firebase-ETag", "true");
+            string etag = string.Join("", http.SendAsync(read).GetAwaiter().GetResult().Headers.GetValues("ETag"));
+            Send(HttpMethod.Put, "/rooms/r1/snapshot.json", "{\"through\":5}");
+
+            // Act
+            var stale = new HttpRequestMessage(HttpMethod.Put, server.BaseUrl + "/rooms/r1/snapshot.json")
+            {
+                Content = new StringContent("{\"through\":3}", Encoding.UTF8, "application/json")
+            };
+            stale.Headers.TryAddWithoutValidation("if-match", etag);
+            var response = http.SendAsync(stale).GetAwaiter().GetResult();
+
+            // Assert
+            Assert.AreEqual(412, (int)response.StatusCode);
+            Assert.AreEqual("{\"through\":5}", server.Read("rooms/r1/snapshot"));
+        }
+
+        [Test]
+        public void LocalRtdbServer_EventStream_DeliversInitialPutThenMultiPathPatch()
+        {
+            // Arrange
+            Send(HttpMethod.Put, "/rooms/r1/anchors/a.json", "{\"label\":\"cup\"}");
+            var received = new List<string>();
+            var stream = new AnchorEventStream((id, node) => received.Add(id), id => received.Add("-" + id));
+            var request = new HttpRequestMessage(HttpMethod.Get, server.BaseUrl + "/rooms/r1/anchors.json");
+            request.Headers.Add("Accept", "text/event-stream");
+            var response = http.SendAsync(request, HttpCompletionOption.ResponseHeadersRead).GetAwaiter().GetResult();
+            Stream body = response.Content.ReadAsStreamAsync().GetAwaiter().GetResult();
+            var buffer = new byte[4096];
+
+            // Act
+            Send(new HttpMethod("PATCH"), "/rooms/r1.json", "{\"anchors/b\":{\"label\":\"pen\"},\"anchors/a\":null}");
+            var clock = Stopwatch.StartNew();
+            while (received.Count < 3 && clock.ElapsedMilliseconds < 2000)
+            {
+                int read = body.ReadAsync(buffer, 0, buffer.Length).GetAwaiter().GetResult();
+                if (read <= 0) break;
+                stream.Feed(buffer, 0, read);
+            }
+            response.Dispose();
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "a", "b", "-a" }, received);
+        }
+
+        [Test]
+        public void LocalRtdbServer_KeepAlive_ReusesOneConnectionForSequentialRequests()
+        {
+            // Act
+            for (int i = 0; i < 5; i++)
+            {
+                Send(HttpMethod.Put, "/rooms/r1/anchors/a" + i + ".json", "{\"label\":\"cup\"}");
+            }
+
+            // Assert
+            Assert.AreEqual(5, server.Requests);
+            Assert.AreEqual(1, server.Connections);
+        }
+
+        private HttpResponseMessage Send(HttpMethod method, string path, string body)
+        {
+            var request = new HttpRequestMessage(method, server.BaseUrl + path)
+            {
+                Content = new StringContent(body, Encoding.UTF8, "application/json")
+            };
+            var response = http.SendAsync(request).GetAwaiter().GetResult();
+            response.Content.ReadAsStringAsync().GetAwaiter().GetResult();
+            return response;
+        }
+
+        private string Get(string path)
+        {
+            return http.GetStringAsync(server.BaseUrl + path).GetAwaiter().GetResult();
+        }
+    }
+}
@@ -0,0 +1,115 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using NUnit.Framework;
+using ARLinguaSphere.Analytics;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for QuizCandidateIndex
+    /// </summary>
+    public class QuizCandidateIndexTests
+    {
+        [Test]
+        public void QuizCandidateIndex_RandomUpdatesAndRemovals_TopMatchesFullSort()
+        {
+            // Arrange
+            var random = new System.Random(7);
+            var index = new QuizCandidateIndex();
+            var expected = new Dictionary<string, float>();
+            var firstAdded = new Dictionary<string, int>();
+            int additions = 0;
+
+            // Act
+            for (int step = 0; step < 5000; step++)
+            {
+                string key = "w" + random.Next(300);
+                if (random.Next(10) == 0)
+                {
+                    Assert.AreEqual(expected.Remove(key), index.Remove(key));
+                    firstAdded.Remove(key);
+                    continue;
+                }
+                float score = random.Next(20) / 4f; // coarse, so ties are common
+                index.Update(key, score);
+                expected[key] = score;
+                if (!firstAdded.ContainsKey(key)) firstAdded[key] = additions++;
+            }
+            var top = new List<string>();
+            index.Top(25, top);
+
+            // Assert
+            var sorted = expected.Keys.OrderByDescending(k => expected[k]).ThenBy(k => firstAdded[k]).Take(25).ToList();
+            Assert.AreEqual(expected.Count, index.Count);
+            CollectionAssert.AreEqual(sorted, top);
+        }
+
+        [Test]
+        public void QuizCandidateIndex_ScoreDrops_WordLeavesTop()
+        {
+            // Arrange
+            var index = new QuizCandidateIndex();
+            index.Update("apple", 2f);
+            index.Update("car", 1f);
+            index.Update("dog", 0.5f);
+
+            // Act
+            index.Update("apple", 0f);
+            var top = new List<string>();
+            index.Top(2, top);
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "car", "dog" }, top);
+        }
+
+        [Test]
+        public void QuizCandidateIndex_AskForMoreThanCount_ReturnsAll()
+        {
+            // Arrange
+            var index = new QuizCandidateIndex();
+            index.Update("apple", 1f);
+            index.Update("car", float.NaN);
+
+            // Act
+            var top = new List<string>();
+            index.Top(5, top);
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "apple", "car" }, top);
+        }
+
+        /// <summary>
+        /// Per-answer update and per-quiz query cost with a 100k-word vocabulary. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void QuizCandidateIndex_Benchmark_LargeVocabulary()
+        {
+            const int words = 100_000;
+            const int operations = 100_000;
+            var random = new System.Random(1);
+            var keys = Enumerable.Range(0, words).Select(i => "word" + i).ToArray();
+            var index = new QuizCandidateIndex();
+            foreach (var key in keys) index.Update(key, (float)random.NextDouble());
+
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < operations; i++)
+            {
+                index.Update(keys[random.Next(words)], (float)random.NextDouble() * 3f);
+            }
+            double updateUs = timer.Elapsed.TotalMilliseconds * 1000 / operations;
+
+            var top = new List<string>(5);
+            timer.Restart();
+            for (int i = 0; i < operations; i++)
+            {
+                top.Clear();
+                index.Top(5, top);
+            }
+            double topUs = timer.Elapsed.TotalMilliseconds * 1000 / operations;
+
+            UnityEngine.Debug.Log($"QuizCandidateIndexTests: {words} words - update {updateUs:F2}us, top 5 {topUs:F2}us");
+            Assert.AreEqual(5, top.Count);
+        }
+    }
+}
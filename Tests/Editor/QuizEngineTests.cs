@@ -14,6 +14,7 @@ namespace ARLinguaSphere.Tests
         private GameObject analyticsObject;
         private QuizEngine quizEngine;
         private AnalyticsManager analyticsManager;
+        private string logDirectory;
         
         [SetUp]
         public void Setup()
@@ -26,6 +27,10 @@ namespace ARLinguaSphere.Tests
             quizEngine = testObject.AddComponent<QuizEngine>();
             analyticsManager = analyticsObject.AddComponent<AnalyticsManager>();
             
+            // Each test starts from an empty interaction log
+            logDirectory = System.IO.Path.Combine(System.IO.Path.GetTempPath(), "als_quiz_" + System.Guid.NewGuid().ToString("N"));
+            analyticsManager.localLogDirectory = logDirectory;
+            
             // Initialize
             analyticsManager.Initialize();
             quizEngine.Initialize(analyticsManager);
@@ -42,6 +47,14 @@ namespace ARLinguaSphere.Tests
             {
                 Object.DestroyImmediate(analyticsObject);
             }
+            try
+            {
+                System.IO.Directory.Delete(logDirectory, true);
+            }
+            catch (System.IO.IOException)
+            {
+                // Still mapped on platforms that lock mapped files; it lives in the temp directory
+            }
         }
         
         [Test]
@@ -190,5 +203,24 @@ namespace ARLinguaSphere.Tests
             Assert.IsNotNull(quizSet);
             Assert.Contains("hardword", quizSet);
         }
+        
+        [Test]
+        public void QuizEngine_GetNextQuizSet_DueWordsComeFirst()
+        {
+            // Arrange - A missed word is not due again for a while; a newly placed label is due at once
+            for (int i = 0; i < 6; i++)
+            {
+                quizEngine.RecordAnswer("hardword", false, 5.0f);
+            }
+            analyticsManager.LogInteraction("anchor1", "apple", InteractionType.LabelPlaced, true);
+            
+            // Act
+            var quizSet = quizEngine.GetNextQuizSet(2);
+            
+            // Assert
+            Assert.AreEqual(new List<string> { "apple", "hardword" }, quizSet);
+            Assert.IsTrue(analyticsManager.TryGetReviewCard("hardword", out var card));
+            Assert.AreEqual(6, card.reps);
+        }
     }
 }
\ No newline at end of file
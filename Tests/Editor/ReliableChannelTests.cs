@@ -0,0 +1,96 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for ReliableChannel
+    /// </summary>
+    public class ReliableChannelTests
+    {
+        private ReliableChannel sender;
+        private ReliableChannel receiver;
+        private List<byte[]> wire;
+        private List<byte[]> replies;
+        private List<byte[]> delivered;
+
+        [SetUp]
+        public void Setup()
+        {
+            sender = new ReliableChannel(11);
+            receiver = new ReliableChannel(22);
+            wire = new List<byte[]>();
+            replies = new List<byte[]>();
+            delivered = new List<byte[]>();
+        }
+
+        [Test]
+        public void ReliableChannel_Receive_DeliversInOrderDespiteReordering()
+        {
+            // Arrange
+            for (byte i = 0; i < 3; i++)
+            {
+                sender.Send(new[] { i }, 0, 1, 0f, wire);
+            }
+
+            // Act
+            foreach (int index in new[] { 2, 0, 1 })
+            {
+                receiver.Receive(wire[index], wire[index].Length, 0.01f, delivered, replies);
+            }
+            foreach (var ack in replies)
+            {
+                sender.Receive(ack, ack.Length, 0.02f, new List<byte[]>(), new List<byte[]>());
+            }
+
+            // Assert
+            Assert.AreEqual(3, delivered.Count);
+            for (byte i = 0; i < 3; i++)
+            {
+                Assert.AreEqual(i, delivered[i][0]);
+            }
+            Assert.AreEqual(0, sender.UnackedCount);
+        }
+
+        [Test]
+        public void ReliableChannel_Tick_RetransmitsLostFramesUntilAcked()
+        {
+            // Arrange: the first transmission is lost
+            sender.Send(new byte[] { 7 }, 0, 1, 0f, wire);
+            wire.Clear();
+
+            // Act
+            sender.Tick(0.01f, wire);
+            int beforeTimeout = wire.Count;
+            sender.Tick(sender.RetransmitTimeout + 0.001f, wire);
+            receiver.Receive(wire[0], wire[0].Length, 0.2f, delivered, replies);
+            receiver.Receive(wire[0], wire[0].Length, 0.2f, delivered, replies);
+            sender.Receive(replies[0], replies[0].Length, 0.2f, new List<byte[]>(), new List<byte[]>());
+
+            // Assert
+            Assert.AreEqual(0, beforeTimeout);
+            Assert.AreEqual(1, sender.Retransmissions);
+            Assert.AreEqual(1, delivered.Count, "duplicates are not delivered twice");
+            Assert.AreEqual(0, sender.UnackedCount);
+        }
+
+        [Test]
+        public void ReliableChannel_Receive_NewSessionRestartsSequence()
+        {
+            // Arrange
+            sender.Send(new byte[] { 1 }, 0, 1, 0f, wire);
+            receiver.Receive(wire[0], wire[0].Length, 0f, delivered, replies);
+            var restarted = new ReliableChannel(33);
+            wire.Clear();
+
+            // Act
+            restarted.Send(new byte[] { 2 }, 0, 1, 0f, wire);
+            receiver.Receive(wire[0], wire[0].Length, 0f, delivered, replies);
+
+            // Assert
+            Assert.AreEqual(2, delivered.Count);
+            Assert.AreEqual(2, delivered[1][0]);
+        }
+    }
+}
@@ -0,0 +1,207 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+using NUnit.Framework;
+using UnityEngine.Networking;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for RestClient against LocalRtdbServer
+    /// </summary>
+    public class RestClientTests
+    {
+        private LocalRtdbServer server;
+        private RestClient client;
+
+        [SetUp]
+        public void Setup()
+        {
+            server = new LocalRtdbServer();
+            client = new RestClient(maxConnectionsPerHost: 3);
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            client.Dispose();
+            server.Dispose();
+        }
+
+        [Test]
+        public void RestClient_SequentialRequests_ShareOneKeptAliveConnection()
+        {
+            // Act
+            for (int i = 0; i < 10; i++)
+            {
+                var request = Wait(client.Send(new RestRequest("PUT", $"{server.BaseUrl}/rooms/r1/anchors/a{i}.json", "{\"label\":\"cup\"}")));
+                Assert.IsTrue(request.Success, request.Error);
+            }
+
+            // Assert
+            Assert.AreEqual(1, server.Connections);
+            Assert.AreEqual(1, client.Metrics.connectionsOpened);
+            Assert.AreEqual(9, client.Metrics.requestsOnReusedConnections);
+            Assert.AreEqual(10, server.Requests);
+        }
+
+        [Test]
+        public void RestClient_ConcurrentRequests_AreBoundedByThePool()
+        {
+            // Arrange
+            server.LatencyMs = 30;
+            var requests = new List<RestRequest>();
+
+            // Act
+            for (int i = 0; i < 12; i++)
+            {
+                requests.Add(client.Send(new RestRequest("PATCH", $"{server.BaseUrl}/rooms/r1.json", "{\"anchors/a" + i + "\":{\"label\":\"cup\"}}")));
+            }
+            foreach (var request in requests)
+            {
+                Wait(request);
+            }
+
+            // Assert
+            foreach (var request in requests)
+            {
+                Assert.IsTrue(request.Success, request.Error);
+            }
+            Assert.LessOrEqual(server.Connections, 3);
+            Assert.AreEqual(12, server.Requests);
+        }
+
+        [Test]
+        public void RestClient_ConditionalPut_ExposesStatusAndResponseHeaders()
+        {
+            // Arrange
+            var read = new RestRequest("GET", $"{server.BaseUrl}/rooms/r1/snapshot.json");
+            read.SetRequestHeader("X-Firebase-ETag", "true");
+            Wait(client.Send(read));
+            Wait(client.Send(new RestRequest("PUT", $"{server.BaseUrl}/rooms/r1/snapshot.json", "{\"through\":5}")));
+
+            // Act
+            var stale = new RestRequest("PUT", $"{server.BaseUrl}/rooms/r1/snapshot.json", "{\"through\":3}");
+            stale.SetRequestHeader("if-match", read.GetResponseHeader("ETag"));
+            Wait(client.Send(stale));
+
+            // Assert
+            Assert.IsTrue(read.Success);
+            Assert.AreEqual("null", read.Text);
+            Assert.IsNotEmpty(read.GetResponseHeader("ETag"));
+            Assert.AreEqual(412, stale.StatusCode);
+            Assert.IsFalse(stale.Success);
+            Assert.AreEqual("{\"through\":5}", stale.Text);
+        }
+
+        [Test]
+        public void RestClient_OpenStream_BuffersEventsUntilRead()
+        {
+            // Arrange
+            var received = new List<string>();
+            var events = new AnchorEventStream((id, node) => received.Add(id));
+            var buffer = new byte[1024];
+
+            // Act
+            using (var stream = client.OpenStream($"{server.BaseUrl}/rooms/r1/anchors.json"))
+            {
+                Wait(client.Send(new RestRequest("PUT", $"{server.BaseUrl}/rooms/r1/anchors/a.json", "{\"label\":\"cup\"}")));
+                var clock = Stopwatch.StartNew();
+                while (received.Count == 0 && clock.ElapsedMilliseconds < 2000)
+                {
+                    int read = stream.Read(buffer, 0, buffer.Length);
+                    if (read > 0) events.Feed(buffer, 0, read);
+                    else Thread.Sleep(1);
+                }
+                Assert.AreEqual(200, stream.StatusCode);
+            }
+
+            // Assert
+            CollectionAssert.AreEqual(new[] { "a" }, received);
+        }
+
+        [Test]
+        public void RestClient_DisposedStream_StopsBufferingAndDisconnects()
+        {
+            // Arrange
+            var stream = client.OpenStream($"{server.BaseUrl}/rooms/r1/anchors.json");
+            var clock = Stopwatch.StartNew();
+            while (stream.BytesReceived == 0 && clock.ElapsedMilliseconds < 2000) Thread.Sleep(1);
+            long received = stream.BytesReceived;
+
+            // Act
+            stream.Dispose();
+            for (int i = 0; i < 5; i++)
+            {
+                Wait(client.Send(new RestRequest("PUT", $"{server.BaseUrl}/rooms/r1/anchors/a{i}.json", "{\"label\":\"cup\"}")));
+            }
+            Thread.Sleep(50);
+
+            // Assert - nothing is buffered for a stream no one will read
+            Assert.Greater(received, 0);
+            Assert.IsTrue(stream.IsAborted);
+            Assert.AreEqual(received, stream.BytesReceived);
+            Assert.AreEqual(0, stream.Read(new byte[1024], 0, 1024));
+        }
+
+        /// <summary>
+        /// Handshakes and main-thread allocations for the same PATCH traffic through a new UnityWebRequest per request
+        /// and through RestClient. Each connection counted is a TLS handshake against the real https endpoint. Run from
+        /// the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void RestClient_Benchmark_AgainstUnityWebRequest()
+        {
+            const int iterations = 200;
+            string url = $"{server.BaseUrl}/rooms/r1.json";
+
+            server.ResetCounters();
+            long allocated = GC.GetAllocatedBytesForCurrentThread();
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < iterations; i++)
+            {
+                using (var request = new UnityWebRequest(url, "PATCH"))
+                {
+                    request.uploadHandler = new UploadHandlerRaw(System.Text.Encoding.UTF8.GetBytes(Body(i)));
+                    request.downloadHandler = new DownloadHandlerBuffer();
+                    request.SetRequestHeader("Content-Type", "application/json");
+                    var operation = request.SendWebRequest();
+                    while (!operation.isDone) Thread.Sleep(0);
+                }
+            }
+            double unityMs = timer.Elapsed.TotalMilliseconds;
+            long unityAllocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+            int unityConnections = server.Connections;
+
+            server.ResetCounters();
+            allocated = GC.GetAllocatedBytesForCurrentThread();
+            timer.Restart();
+            for (int i = 0; i < iterations; i++)
+            {
+                Wait(client.Send(new RestRequest("PATCH", url, Body(i))));
+            }
+            double restMs = timer.Elapsed.TotalMilliseconds;
+            long restAllocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+            UnityEngine.Debug.Log($"RestClientTests: {iterations} PATCHes - UnityWebRequest {unityConnections} connections, " +
+                $"{unityAllocated / iterations} B/request main thread, {unityMs / iterations:F2}ms/request; " +
+                $"RestClient {server.Connections} connections, {restAllocated / iterations} B/request main thread, {restMs / iterations:F2}ms/request");
+            Assert.LessOrEqual(server.Connections, 1);
+        }
+
+        private static string Body(int i)
+        {
+            return "{\"anchors/a" + (i % 20) + "\":{\"data\":\"AQIDBAUGBwg=\",\"timestamp\":" + i + "}}";
+        }
+
+        private static RestRequest Wait(RestRequest request)
+        {
+            var clock = Stopwatch.StartNew();
+            while (!request.IsDone && clock.ElapsedMilliseconds < 5000) Thread.Sleep(0);
+            Assert.IsTrue(request.IsDone, "request timed out");
+            return request;
+        }
+    }
+}
@@ -0,0 +1,166 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using NUnit.Framework;
+using ARLinguaSphere.Analytics;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for ReviewScheduler
+    /// </summary>
+    public class ReviewSchedulerTests
+    {
+        private const long Day = 86400000L;
+        private const long Start = 1700000000000L;
+
+        [Test]
+        public void ReviewScheduler_GoodAnswers_IntervalsGrow()
+        {
+            // Arrange
+            var scheduler = new ReviewScheduler();
+            scheduler.Introduce("apple", Start);
+            long now = Start;
+            var intervals = new List<long>();
+
+            // Act
+            for (int i = 0; i < 4; i++)
+            {
+                scheduler.Review("apple", ReviewGrade.Good, now);
+                scheduler.TryGetCard("apple", out var card);
+                intervals.Add(card.due - now);
+                now = card.due;
+            }
+
+            // Assert
+            Assert.AreEqual(4 * Day, intervals[0]); // first Good: stability 3.7 days at 90% retention
+            for (int i = 1; i < intervals.Count; i++)
+            {
+                Assert.Greater(intervals[i], intervals[i - 1]);
+            }
+        }
+
+        [Test]
+        public void ReviewScheduler_Lapse_ComesBackSoonWithLowerStability()
+        {
+            // Arrange
+            var scheduler = new ReviewScheduler { RelearnDelaySeconds = 600f };
+            scheduler.Review("car", ReviewGrade.Good, Start);
+            scheduler.TryGetCard("car", out var before);
+
+            // Act
+            scheduler.Review("car", ReviewGrade.Again, before.due);
+            scheduler.TryGetCard("car", out var after);
+
+            // Assert
+            Assert.AreEqual(before.due + 600000, after.due);
+            Assert.Less(after.stability, before.stability);
+            Assert.Greater(after.difficulty, before.difficulty);
+            Assert.AreEqual(1, after.lapses);
+            Assert.AreEqual(2, after.reps);
+        }
+
+        [Test]
+        public void ReviewScheduler_GetDue_MostOverdueFirstAndOnlyDue()
+        {
+            // Arrange
+            var random = new System.Random(3);
+            var scheduler = new ReviewScheduler();
+            var due = new Dictionary<string, long>();
+            for (int i = 0; i < 2000; i++)
+            {
+                string key = "w" + random.Next(500);
+                long at = Start + random.Next(60) * Day / 2;
+                if (random.Next(3) == 0) scheduler.Introduce(key, at);
+                else scheduler.Review(key, (ReviewGrade)random.Next(1, 5), at);
+                scheduler.TryGetCard(key, out var card);
+                due[key] = card.due;
+            }
+            long now = Start + 20 * Day;
+
+            // Act
+            var results = new List<string>();
+            int count = scheduler.GetDue(now, 40, results);
+
+            // Assert
+            var expected = due.Where(p => p.Value <= now).OrderBy(p => p.Value).Select(p => p.Value).Take(40).ToList();
+            Assert.AreEqual(expected.Count, count);
+            CollectionAssert.AreEqual(expected, results.Select(k => due[k]).ToList());
+        }
+
+        [Test]
+        public void ReviewScheduler_EncodeLoad_RoundTripsCardsAndOrder()
+        {
+            // Arrange
+            var scheduler = new ReviewScheduler();
+            for (int i = 0; i < 300; i++)
+            {
+                scheduler.Review("word" + i, (ReviewGrade)(1 + i % 4), Start + i * 1000L);
+            }
+            scheduler.Introduce("naïve", Start);
+            byte[] buffer = null;
+
+            // Act
+            int length = scheduler.Encode(ref buffer, 1234);
+            var loaded = new ReviewScheduler();
+            bool ok = loaded.Load(buffer, length, out long through);
+
+            // Assert
+            Assert.IsTrue(ok);
+            Assert.AreEqual(1234, through);
+            Assert.AreEqual(301, loaded.Count);
+            Assert.IsFalse(loaded.IsDirty);
+            scheduler.TryGetCard("word7", out var original);
+            loaded.TryGetCard("word7", out var copy);
+            Assert.AreEqual(original, copy);
+            var a = new List<string>();
+            var b = new List<string>();
+            scheduler.GetDue(long.MaxValue, 301, a);
+            loaded.GetDue(long.MaxValue, 301, b);
+            CollectionAssert.AreEqual(a, b);
+            Assert.IsFalse(loaded.Load(buffer, length - 3, out _));
+            Assert.AreEqual(0, loaded.Count);
+        }
+
+        /// <summary>
+        /// Review and due-query cost with 100k cards, and snapshot size and load time. Run from the Test Runner.
+        /// </summary>
+        [Test, Explicit, Category("Performance")]
+        public void ReviewScheduler_Benchmark_HundredThousandCards()
+        {
+            const int cards = 100_000;
+            var random = new System.Random(1);
+            var keys = Enumerable.Range(0, cards).Select(i => "word" + i).ToArray();
+            var scheduler = new ReviewScheduler();
+            foreach (var key in keys) scheduler.Review(key, ReviewGrade.Good, Start - random.Next(30) * Day);
+
+            var timer = Stopwatch.StartNew();
+            for (int i = 0; i < cards; i++)
+            {
+                scheduler.Review(keys[random.Next(cards)], (ReviewGrade)random.Next(1, 5), Start + i * 1000L);
+            }
+            double reviewUs = timer.Elapsed.TotalMilliseconds * 1000 / cards;
+
+            var due = new List<string>(20);
+            timer.Restart();
+            for (int i = 0; i < 10000; i++)
+            {
+                due.Clear();
+                scheduler.GetDue(Start + Day, 20, due);
+            }
+            double dueUs = timer.Elapsed.TotalMilliseconds * 1000 / 10000;
+
+            byte[] buffer = null;
+            timer.Restart();
+            int length = scheduler.Encode(ref buffer, 0);
+            double encodeMs = timer.Elapsed.TotalMilliseconds;
+            timer.Restart();
+            new ReviewScheduler().Load(buffer, length, out _);
+            double loadMs = timer.Elapsed.TotalMilliseconds;
+
+            UnityEngine.Debug.Log($"ReviewSchedulerTests: {cards} cards - review {reviewUs:F2}us, 20 due {dueUs:F2}us, " +
+                $"snapshot {length / 1024} KiB encode {encodeMs:F1}ms load {loadMs:F1}ms");
+            Assert.AreEqual(20, due.Count);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+using System;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for RoomAnchorSnapshot
+    /// </summary>
+    public class RoomAnchorSnapshotTests
+    {
+        private static AnchorData Anchor(string id, long timestamp)
+        {
+            return new AnchorData
+            {
+                id = id,
+                position = new Vector3(1f, 0.5f, -2f),
+                rotation = Quaternion.identity,
+                labelKey = "cup",
+                creatorId = "peer",
+                timestamp = timestamp
+            };
+        }
+
+        [Test]
+        public void RoomAnchorSnapshot_Observe_OnlyAdvancesWithServerTime()
+        {
+            // Arrange - the peer's own clock runs far ahead of the server
+            var snapshot = new RoomAnchorSnapshot("room");
+            string id = Guid.NewGuid().ToString();
+
+            // Act
+            snapshot.Add(Anchor(id, 9999999999999));
+            long afterAdd = snapshot.HighWaterMark;
+            snapshot.Observe(1700000005000);
+            snapshot.Observe(1700000001000);
+            snapshot.Remove(id);
+
+            // Assert
+            Assert.AreEqual(0, afterAdd);
+            Assert.AreEqual(1700000005000, snapshot.HighWaterMark);
+            Assert.AreEqual(0, snapshot.Count);
+        }
+
+        [Test]
+        public void RoomAnchorSnapshot_QueryStart_AppliesSlackAndStartsAtZeroWhenEmpty()
+        {
+            // Arrange
+            var fresh = new RoomAnchorSnapshot("room");
+            var young = new RoomAnchorSnapshot("room");
+            var seen = new RoomAnchorSnapshot("room");
+            young.Observe(3000);
+            seen.Observe(1700000005000);
+
+            // Act / Assert
+            Assert.AreEqual(0, fresh.QueryStart(5000));
+            Assert.AreEqual(0, young.QueryStart(5000));
+            Assert.AreEqual(1700000000000, seen.QueryStart(5000));
+        }
+
+        [Test]
+        public void RoomAnchorSnapshot_EncodeDecode_KeepsMarkAndDropsRemovedAnchor()
+        {
+            // Arrange
+            var codec = new AnchorCodec();
+            var snapshot = new RoomAnchorSnapshot("room");
+            string kept = Guid.NewGuid().ToString();
+            string removed = Guid.NewGuid().ToString();
+            snapshot.Add(Anchor(kept, 1700000000000));
+            snapshot.Add(Anchor(removed, 1700000001000));
+            snapshot.Observe(1700000002000);
+            snapshot.Remove(removed);
+            snapshot.Observe(1700000003000); // the tombstone's write time
+            byte[] buffer = null;
+
+            // Act
+            int length = snapshot.Encode(codec, ref buffer);
+            var decoded = RoomAnchorSnapshot.Decode("room", null, buffer, length, codec);
+
+            // Assert
+            Assert.AreEqual(1700000003000, decoded.HighWaterMark);
+            Assert.AreEqual(1, decoded.Count);
+            Assert.IsTrue(decoded.Contains(kept));
+            Assert.IsFalse(decoded.Contains(removed));
+            Assert.IsFalse(decoded.IsDirty);
+        }
+
+        [Test]
+        public void RoomAnchorSnapshot_EmptyWithMark_RoundTripsMark()
+        {
+            // Arrange - every anchor was deleted, but the mark must survive so the next join stays incremental
+            var codec = new AnchorCodec();
+            var snapshot = new RoomAnchorSnapshot("room");
+            snapshot.Observe(1700000003000);
+            byte[] buffer = null;
+
+            // Act
+            int length = snapshot.Encode(codec, ref buffer);
+            var decoded = RoomAnchorSnapshot.Decode("room", null, buffer, length, codec);
+
+            // Assert
+            Assert.AreEqual(0, decoded.Count);
+            Assert.AreEqual(1700000003000, decoded.HighWaterMark);
+        }
+
+        [Test]
+        public void RoomAnchorSnapshot_FileWithoutHeader_DecodesAsEmpty()
+        {
+            // Arrange - a bare AnchorCodec batch, as written before the header existed
+            var codec = new AnchorCodec();
+            var records = new[] { AnchorRecord.FromAnchorData(Anchor(Guid.NewGuid().ToString(), 1700000000000)) };
+            var buffer = new byte[256];
+            int length = codec.EncodeBatch(records, 1, buffer, 0);
+
+            // Act
+            var decoded = RoomAnchorSnapshot.Decode("room", null, buffer, length, codec);
+
+            // Assert - treated as no snapshot, so the next fetch is a full one
+            Assert.AreEqual(0, decoded.Count);
+            Assert.AreEqual(0, decoded.HighWaterMark);
+            Assert.AreEqual(0, decoded.QueryStart(5000));
+        }
+    }
+}
@@ -0,0 +1,294 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Net;
+using System.Net.Http;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Core;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Load test of one room against LocalRtdbServer. Simulated clients speak FirebaseService's op-log wire protocol
+    /// (RoomOps in batched multi-path PATCHes, one event stream each) and every anchor's end-to-end propagation latency
+    /// is measured at every other client. Run from the Test Runner, or headless with
+    /// -batchmode -runTests -testPlatform EditMode -testCategory Performance.
+    /// </summary>
+    public class RoomLoadTests
+    {
+        private const int WriteIntervalMs = 20;
+        private const long SlackMs = 2000;
+        private int connectionLimit;
+
+        [SetUp]
+        public void Setup()
+        {
+            // Every client holds a stream open; do not let the default per-host limit queue their writes behind it
+            connectionLimit = ServicePointManager.DefaultConnectionLimit;
+            ServicePointManager.DefaultConnectionLimit = 64;
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            ServicePointManager.DefaultConnectionLimit = connectionLimit;
+        }
+
+        [TestCase(8, 250, 0, 0.0)]    // maxRoomSize on loopback: the README's "< 300ms local"
+        [TestCase(8, 250, 40, 0.0)]   // 40 ms each way
+        [TestCase(8, 250, 40, 0.01)]  // plus 1% of requests and stream events lost
+        [Explicit, Category("Performance")]
+        public void RoomLoad_Benchmark_PropagationLatency(int clients, int anchorsPerClient, int latencyMs, double lossRate)
+        {
+            using (var server = new LocalRtdbServer { LatencyMs = latencyMs, JitterMs = latencyMs / 4, LossRate = lossRate })
+            {
+                var clock = Stopwatch.StartNew();
+                var sentAt = new ConcurrentDictionary<string, double>();
+                var latencies = new ConcurrentBag<double>();
+                var room = new List<SimulatedRoomClient>();
+                for (int i = 0; i < clients; i++)
+                {
+                    room.Add(new SimulatedRoomClient(server.BaseUrl, "load", clock, sentAt, latencies));
+                }
+                Assert.IsTrue(SpinUntil(() => room.All(c => c.Connected), 10000), "clients connected");
+                server.ResetCounters();
+                var process = Process.GetCurrentProcess();
+                var cpuBefore = process.TotalProcessorTime;
+                double started = clock.Elapsed.TotalMilliseconds;
+
+                // Act
+                Task.WaitAll(room.Select(c => Task.Run(() => c.WriteAnchors(anchorsPerClient, WriteIntervalMs))).ToArray());
+                int total = clients * anchorsPerClient;
+                bool converged = SpinUntil(() => room.All(c => c.AnchorCount == total), 60000);
+                double elapsed = clock.Elapsed.TotalMilliseconds - started;
+                process.Refresh();
+                var cpu = process.TotalProcessorTime - cpuBefore;
+                foreach (var client in room)
+                {
+                    client.Dispose();
+                }
+
+                // Assert
+                Assert.IsTrue(converged, "every client received every anchor");
+                var sorted = latencies.OrderBy(l => l).ToArray();
+                Assert.AreEqual(total * (clients - 1), sorted.Length);
+                double clientCpu = room.Sum(c => c.CpuMilliseconds);
+                UnityEngine.Debug.Log($"RoomLoadTests: {clients} clients x {anchorsPerClient} anchors, latency {latencyMs}ms, loss {lossRate:P0} -> " +
+                    $"propagation p50 {Percentile(sorted, 0.5):F0}ms p95 {Percentile(sorted, 0.95):F0}ms p99 {Percentile(sorted, 0.99):F0}ms max {sorted[sorted.Length - 1]:F0}ms; " +
+                    $"wire {server.BytesIn / 1024} KiB up, {server.BytesOut / 1024} KiB down ({(server.BytesIn + server.BytesOut) / total} B/anchor), " +
+                    $"{server.Requests} requests, {server.Connections} connections, {server.Dropped} dropped, {room.Sum(c => c.Reconnects)} reconnects; " +
+                    $"client CPU {clientCpu:F0}ms ({clientCpu * 1000 / (total * clients):F1}us per anchor per client), process CPU {cpu.TotalMilliseconds:F0}ms over {elapsed:F0}ms");
+            }
+        }
+
+        private static bool SpinUntil(Func<bool> condition, int timeoutMs)
+        {
+            var clock = Stopwatch.StartNew();
+            while (!condition())
+            {
+                if (clock.ElapsedMilliseconds > timeoutMs) return false;
+                Thread.Sleep(5);
+            }
+            return true;
+        }
+
+        private static double Percentile(double[] sorted, double p)
+        {
+            int index = (int)Math.Ceiling(p * sorted.Length) - 1;
+            return sorted[Math.Max(0, Math.Min(sorted.Length - 1, index))];
+        }
+
+        /// <summary>
+        /// One user in the room: writes go through an AnchorWriteQueue as FirebaseService batches them (resent after a
+        /// failed request), reads come from an event stream on rooms/{id}/ops that resumes from the newest "at" seen.
+        /// </summary>
+        private sealed class SimulatedRoomClient : IDisposable
+        {
+            public bool Connected => connected;
+            public int Reconnects => reconnects;
+            public double CpuMilliseconds => cpu.Elapsed.TotalMilliseconds; // encode, batch, parse and merge work
+
+            public int AnchorCount
+            {
+                get
+                {
+                    lock (gate)
+                    {
+                        return log.State.Count;
+                    }
+                }
+            }
+
+            private readonly string baseUrl;
+            private readonly string roomId;
+            private readonly Stopwatch clock;
+            private readonly ConcurrentDictionary<string, double> sentAt;
+            private readonly ConcurrentBag<double> latencies;
+            private readonly object gate = new object();
+            private readonly HttpClient http = new HttpClient();
+            private readonly CancellationTokenSource stop = new CancellationTokenSource();
+            private readonly RoomOpLog log = new RoomOpLog(Guid.NewGuid().ToString("N"));
+            private readonly AnchorCodec codec = new AnchorCodec();
+            private readonly AnchorWriteQueue queue = new AnchorWriteQueue(50, 0.1f);
+            private readonly AnchorEventStream events;
+            private readonly Stopwatch cpu = new Stopwatch();
+            private volatile bool connected;
+            private int reconnects;
+            private long maxAt;
+
+            public SimulatedRoomClient(string baseUrl, string roomId, Stopwatch clock, ConcurrentDictionary<string, double> sentAt, ConcurrentBag<double> latencies)
+            {
+                this.baseUrl = baseUrl;
+                this.roomId = roomId;
+                this.clock = clock;
+                this.sentAt = sentAt;
+                this.latencies = latencies;
+                http.DefaultRequestHeaders.ExpectContinue = false;
+                events = new AnchorEventStream(OnOp);
+                Task.Run(StreamLoop);
+                Task.Run(FlushLoop);
+            }
+
+            public void WriteAnchors(int count, int intervalMs)
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    var anchor = new AnchorData { labelKey = "label" + i, creatorId = log.ReplicaId, position = new Vector3(i % 16, 0f, i / 16) };
+                    lock (gate)
+                    {
+                        cpu.Start();
+                        sentAt[anchor.id] = clock.Elapsed.TotalMilliseconds;
+                        var op = log.Upsert(anchor);
+                        string data = Convert.ToBase64String(RoomOp.Encode(op, codec));
+                        queue.Enqueue(roomId, "ops/" + RoomOpLog.OpKey(op), "{\"data\":\"" + data + "\",\"at\":{\".sv\":\"timestamp\"}}", Now);
+                        cpu.Stop();
+                    }
+                    Thread.Sleep(intervalMs);
+                }
+            }
+
+            public void Dispose()
+            {
+                stop.Cancel();
+                http.Dispose();
+            }
+
+            private float Now => (float)clock.Elapsed.TotalSeconds;
+
+            private async Task FlushLoop()
+            {
+                var batch = new List<PendingAnchorWrite>();
+                while (!stop.IsCancellationRequested)
+                {
+                    string body;
+                    lock (gate)
+                    {
+                        cpu.Start();
+                        body = queue.TakeDueBatch(Now, batch) != null ? AnchorWriteQueue.BuildPatchBody(batch) : null;
+                        cpu.Stop();
+                    }
+                    if (body == null)
+                    {
+                        await Task.Delay(5);
+                        continue;
+                    }
+
+                    bool ok = false;
+                    try
+                    {
+                        var request = new HttpRequestMessage(new HttpMethod("PATCH"), $"{baseUrl}/rooms/{roomId}.json")
+                        {
+                            Content = new StringContent(body, Encoding.UTF8, "application/json")
+                        };
+                        using (var response = await http.SendAsync(request, stop.Token))
+                        {
+                            ok = response.IsSuccessStatusCode;
+                        }
+                    }
+                    catch (HttpRequestException) { }
+                    catch (OperationCanceledException) { }
+                    catch (ObjectDisposedException) { return; }
+
+                    lock (gate)
+                    {
+                        queue.Complete(roomId, batch, ok);
+                        if (!ok)
+                        {
+                            // The outbox would resend; requeue and let the next batch carry them
+                            foreach (var pending in batch)
+                            {
+                                queue.Enqueue(pending.roomId, pending.path, pending.json, Now);
+                            }
+                        }
+                    }
+                }
+            }
+
+            private async Task StreamLoop()
+            {
+                var buffer = new byte[16 * 1024];
+                while (!stop.IsCancellationRequested)
+                {
+                    string url = $"{baseUrl}/rooms/{roomId}/ops.json";
+                    lock (gate)
+                    {
+                        if (maxAt > 0) url += "?orderBy=%22at%22&startAt=" + Math.Max(0, maxAt - SlackMs);
+                        events.Reset();
+                    }
+                    try
+                    {
+                        var request = new HttpRequestMessage(HttpMethod.Get, url);
+                        request.Headers.Add("Accept", "text/event-stream");
+                        using (var response = await http.SendAsync(request, HttpCompletionOption.ResponseHeadersRead, stop.Token))
+                        using (var body = await response.Content.ReadAsStreamAsync())
+                        {
+                            connected = true;
+                            int read;
+                            while ((read = await body.ReadAsync(buffer, 0, buffer.Length, stop.Token)) > 0)
+                            {
+                                lock (gate)
+                                {
+                                    cpu.Start();
+                                    events.Feed(buffer, 0, read);
+                                    cpu.Stop();
+                                }
+                            }
+                        }
+                    }
+                    catch (HttpRequestException) { }
+                    catch (IOException) { }
+                    catch (OperationCanceledException) { }
+                    catch (ObjectDisposedException) { return; }
+                    if (stop.IsCancellationRequested) return;
+                    Interlocked.Increment(ref reconnects);
+                    await Task.Delay(50);
+                }
+            }
+
+            /// <summary>
+            /// One op from the stream, called under gate
+            /// </summary>
+            private void OnOp(string key, JsonNode node)
+            {
+                if (!node.IsObject || !node.TryGetField("data", out var data)) return;
+                long at = node.TryGetField("at", out var atNode) ? atNode.GetInt64() : 0;
+                if (at > maxAt) maxAt = at;
+                byte[] bytes = Convert.FromBase64String(data.GetString());
+                if (!RoomOp.TryDecode(bytes, 0, bytes.Length, codec, out var op)) return;
+                // Own ops were applied when written, so only other users' anchors count as propagated
+                if (log.ApplyRemote(key, at, op) == RoomStateChange.Upserted && sentAt.TryGetValue(op.anchorId, out double sent))
+                {
+                    latencies.Add(clock.Elapsed.TotalMilliseconds - sent);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,204 @@
+using System.Collections.Generic;
+using System.Linq;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Simulation of N RoomOpLog replicas against an in-memory stand-in for the database. Each replica's stream lags
+    /// by a random amount and replays an overlap after "reconnecting", clocks are skewed, replicas edit concurrently
+    /// and compact as they go, and a late joiner reads one snapshot plus the tail.
+    /// </summary>
+    public class RoomOpLogSimulationTests
+    {
+        private const long SlackMs = 5;
+
+        [TestCase(2, 1000, 1)]
+        [TestCase(8, 2000, 7)]
+        [TestCase(8, 2000, 42)]
+        public void RoomOpLog_Simulation_ReplicasAndLateJoinerConverge(int clients, int steps, int seed)
+        {
+            // Arrange
+            var random = new System.Random(seed);
+            var codec = new AnchorCodec();
+            long wallClock = 1_700_000_000_000;
+            var server = new LocalRoomServer(() => wallClock);
+            var replicas = new List<VirtualClient>();
+            for (int i = 0; i < clients; i++)
+            {
+                long skew = random.Next(-5000, 5000);
+                var log = new RoomOpLog("replica" + i, new HybridClock(() => wallClock + skew)) { CompactAfterOps = 50 };
+                replicas.Add(new VirtualClient(log));
+            }
+
+            // Act
+            for (int step = 0; step < steps; step++)
+            {
+                wallClock += random.Next(0, 20);
+                var client = replicas[random.Next(clients)];
+                int action = random.Next(10);
+                if (action < 4)
+                {
+                    var anchor = new AnchorData { id = "a" + random.Next(40), labelKey = "label" + step, position = new Vector3(step % 7, 0f, step % 5) };
+                    server.Append(client.Log.Upsert(anchor), codec);
+                }
+                else if (action < 6)
+                {
+                    server.Append(client.Log.Remove("a" + random.Next(40)), codec);
+                }
+                else
+                {
+                    client.DeliverSome(random, codec, server);
+                }
+            }
+            foreach (var client in replicas)
+            {
+                client.DeliverAll(codec, server);
+            }
+            var joiner = new VirtualClient(new RoomOpLog("joiner"));
+            int tailRead = joiner.Join(server, codec);
+
+            // Assert
+            string expected = Describe(replicas[0].Log.State);
+            foreach (var client in replicas)
+            {
+                Assert.AreEqual(expected, Describe(client.Log.State), client.Log.ReplicaId);
+            }
+            Assert.AreEqual(expected, Describe(joiner.Log.State), "joiner");
+            Assert.Greater(server.Compactions, 0);
+            Assert.Less(tailRead, server.AppendCount, "a join reads the snapshot plus a tail, not the whole history");
+            Assert.Less(server.OpCount, server.AppendCount, "folded generations are pruned");
+        }
+
+        private static string Describe(RoomState state)
+        {
+            return string.Join(",", state.Anchors.OrderBy(a => a.id).Select(a => a.id + "=" + a.labelKey));
+        }
+
+        /// <summary>
+        /// Stand-in for rooms/{id}/ops and rooms/{id}/snapshot: assigns server "at" times and keeps the append order each stream replays
+        /// </summary>
+        private sealed class LocalRoomServer
+        {
+            public int AppendCount => history.Count;
+            public int Compactions { get; private set; }
+            public int RejectedSnapshots { get; private set; }
+            public int OpCount => ops.Count;
+            public List<StoredOp> History => history;
+
+            private readonly Dictionary<string, StoredOp> ops = new Dictionary<string, StoredOp>();
+            private readonly List<StoredOp> history = new List<StoredOp>(); // append order, as the stream delivers it
+            private byte[] snapshot;
+            private long snapshotThrough;
+            private readonly System.Func<long> clock;
+            private long serverTime;
+
+            public LocalRoomServer(System.Func<long> clock)
+            {
+                this.clock = clock;
+            }
+
+            public void Append(RoomOp op, AnchorCodec codec)
+            {
+                serverTime = System.Math.Max(serverTime + 1, clock());
+                var stored = new StoredOp { key = RoomOpLog.OpKey(op), at = serverTime, data = RoomOp.Encode(op, codec) };
+                ops[stored.key] = stored;
+                history.Add(stored);
+            }
+
+            /// <summary>
+            /// Conditional write: a snapshot never replaces one that covers more of the log
+            /// </summary>
+            public bool TryWriteSnapshot(byte[] data, long through, List<string> prune)
+            {
+                if (through <= snapshotThrough)
+                {
+                    RejectedSnapshots++;
+                    return false;
+                }
+                snapshot = data;
+                snapshotThrough = through;
+                foreach (var key in prune)
+                {
+                    ops.Remove(key);
+                }
+                Compactions++;
+                return true;
+            }
+
+            public byte[] ReadSnapshot(out long through)
+            {
+                through = snapshotThrough;
+                return snapshot;
+            }
+
+            public List<StoredOp> ReadTail(long startAt)
+            {
+                return ops.Values.Where(o => o.at >= startAt).OrderBy(o => o.at).ToList();
+            }
+        }
+
+        private sealed class VirtualClient
+        {
+            public RoomOpLog Log { get; }
+            private readonly List<string> prunable = new List<string>();
+            private int cursor; // next op of the server history this replica's stream delivers
+
+            public VirtualClient(RoomOpLog log)
+            {
+                Log = log;
+            }
+
+            public void DeliverSome(System.Random random, AnchorCodec codec, LocalRoomServer server)
+            {
+                int end = cursor + random.Next(server.History.Count - cursor + 1);
+                while (cursor < end)
+                {
+                    Deliver(server.History[cursor++], codec, server);
+                }
+                // Reconnecting replays an overlap, so some ops arrive twice
+                if (random.Next(5) == 0) cursor = System.Math.Max(0, cursor - random.Next(10));
+            }
+
+            public void DeliverAll(AnchorCodec codec, LocalRoomServer server)
+            {
+                while (cursor < server.History.Count)
+                {
+                    Deliver(server.History[cursor++], codec, server);
+                }
+            }
+
+            public int Join(LocalRoomServer server, AnchorCodec codec)
+            {
+                byte[] data = server.ReadSnapshot(out long through);
+                if (data != null) Assert.IsTrue(Log.LoadSnapshot(data, data.Length, through, codec));
+                var tail = server.ReadTail(System.Math.Max(0, Log.SnapshotThrough - SlackMs));
+                foreach (var stored in tail)
+                {
+                    Assert.IsTrue(RoomOp.TryDecode(stored.data, 0, stored.data.Length, codec, out var op));
+                    Log.ApplyRemote(stored.key, stored.at, op);
+                }
+                return tail.Count;
+            }
+
+            private void Deliver(StoredOp stored, AnchorCodec codec, LocalRoomServer server)
+            {
+                Assert.IsTrue(RoomOp.TryDecode(stored.data, 0, stored.data.Length, codec, out var op));
+                Log.ApplyRemote(stored.key, stored.at, op);
+                if (!Log.ShouldCompact) return;
+                prunable.Clear();
+                byte[] snapshot = Log.Compact(codec, prunable);
+                server.TryWriteSnapshot(snapshot, Log.SnapshotThrough, prunable);
+            }
+        }
+
+        private sealed class StoredOp
+        {
+            public string key;
+            public long at;
+            public byte[] data;
+        }
+    }
+}
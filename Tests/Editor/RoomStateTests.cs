@@ -0,0 +1,119 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for RoomState and RoomOp
+    /// </summary>
+    public class RoomStateTests
+    {
+        private AnchorCodec codec;
+
+        [SetUp]
+        public void Setup()
+        {
+            codec = new AnchorCodec();
+        }
+
+        [Test]
+        public void RoomState_Apply_ConvergesForAnyDeliveryOrder()
+        {
+            // Arrange: concurrent upserts from two replicas, then a remove that only saw the first
+            var ops = new List<RoomOp>
+            {
+                Upsert("a1", "cup", 100, "r1"),
+                Upsert("a1", "mug", 100, "r2"),
+                Remove("a1", 90, "r3"),
+                Upsert("a2", "pen", 50, "r1"),
+                Remove("a2", 60, "r2")
+            };
+            var forward = new RoomState();
+            var backward = new RoomState();
+
+            // Act
+            foreach (var op in ops) forward.Apply(op);
+            for (int i = ops.Count - 1; i >= 0; i--) backward.Apply(ops[i]);
+            backward.Apply(ops[0]); // duplicates change nothing
+
+            // Assert
+            Assert.IsTrue(forward.TryGetAnchor("a1", out var winner));
+            Assert.AreEqual("mug", winner.labelKey, "equal clocks are broken by replica id");
+            Assert.IsFalse(forward.TryGetAnchor("a2", out _));
+            Assert.IsTrue(backward.TryGetAnchor("a1", out var other));
+            Assert.AreEqual("mug", other.labelKey);
+            Assert.AreEqual(1, forward.Count);
+            Assert.AreEqual(1, backward.Count);
+        }
+
+        [Test]
+        public void RoomState_Apply_ReportsVisibleChangesOnly()
+        {
+            // Arrange
+            var state = new RoomState();
+
+            // Act & Assert
+            Assert.AreEqual(RoomStateChange.Upserted, state.Apply(Upsert("a1", "cup", 10, "r1")));
+            Assert.AreEqual(RoomStateChange.None, state.Apply(Upsert("a1", "old", 5, "r1")));
+            Assert.AreEqual(RoomStateChange.None, state.Apply(Remove("a1", 8, "r2")));
+            Assert.AreEqual(RoomStateChange.Removed, state.Apply(Remove("a1", 20, "r2")));
+            Assert.AreEqual(RoomStateChange.None, state.Apply(Upsert("a1", "late", 15, "r1")));
+            Assert.AreEqual(RoomStateChange.Upserted, state.Apply(Upsert("a1", "again", 30, "r1")));
+        }
+
+        [Test]
+        public void RoomState_EncodeSnapshot_RebuildsStateIncludingTombstones()
+        {
+            // Arrange
+            var state = new RoomState();
+            state.Apply(Upsert("a1", "cup", 10, "r1"));
+            state.Apply(Upsert("a2", "pen", 10, "r1"));
+            state.Apply(Remove("a2", 20, "r2"));
+
+            // Act
+            byte[] snapshot = state.EncodeSnapshot(codec);
+            var ops = new List<RoomOp>();
+            Assert.IsTrue(RoomState.TryDecodeSnapshot(snapshot, 0, snapshot.Length, codec, ops));
+            var rebuilt = new RoomState();
+            foreach (var op in ops) rebuilt.Apply(op);
+
+            // Assert
+            Assert.AreEqual(2, ops.Count);
+            Assert.AreEqual(1, rebuilt.Count);
+            Assert.IsTrue(rebuilt.TryGetAnchor("a1", out var anchor));
+            Assert.AreEqual("cup", anchor.labelKey);
+            Assert.AreEqual(RoomStateChange.None, rebuilt.Apply(Upsert("a2", "stale", 15, "r1")), "the tombstone survives the snapshot");
+        }
+
+        [Test]
+        public void RoomState_PruneTombstones_DropsOnlyOldRemovedElements()
+        {
+            // Arrange
+            var state = new RoomState();
+            state.Apply(Upsert("a1", "cup", 10, "r1"));
+            state.Apply(Remove("a1", 20, "r1"));
+            state.Apply(Upsert("a2", "pen", 10, "r1"));
+            state.Apply(Remove("a3", 40, "r1"));
+
+            // Act
+            int pruned = state.PruneTombstones(30);
+
+            // Assert
+            Assert.AreEqual(1, pruned);
+            Assert.AreEqual(2, state.ElementCount);
+        }
+
+        private static RoomOp Upsert(string id, string label, long clock, string replica)
+        {
+            var anchor = new AnchorData { id = id, labelKey = label, position = new Vector3(1f, 0f, 2f), rotation = Quaternion.identity };
+            return new RoomOp { kind = RoomOpKind.Upsert, anchorId = id, clock = clock, replica = replica, anchor = anchor };
+        }
+
+        private static RoomOp Remove(string id, long clock, string replica)
+        {
+            return new RoomOp { kind = RoomOpKind.Remove, anchorId = id, clock = clock, replica = replica };
+        }
+    }
+}
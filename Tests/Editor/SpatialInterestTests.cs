@@ -0,0 +1,71 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Network;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for SpatialInterest
+    /// </summary>
+    public class SpatialInterestTests
+    {
+        private List<string> entered;
+        private List<string> exited;
+
+        [SetUp]
+        public void Setup()
+        {
+            entered = new List<string>();
+            exited = new List<string>();
+        }
+
+        [Test]
+        public void SpatialInterest_CellOf_IsRelativeToOriginAndIgnoresHeight()
+        {
+            // Arrange
+            var interest = new SpatialInterest(10f, 5f) { Origin = new Vector3(100f, 0f, 100f) };
+
+            // Act & Assert
+            Assert.AreEqual("-1_1", interest.CellOf(new Vector3(95f, 3f, 112f)));
+            Assert.AreEqual("0_0", interest.CellOf(new Vector3(100f, -50f, 100f)));
+        }
+
+        [Test]
+        public void SpatialInterest_Update_SubscribesOnlyCellsWithinRadius()
+        {
+            // Arrange
+            var interest = new SpatialInterest(10f, 4f);
+
+            // Act
+            bool changed = interest.Update(new Vector3(5f, 0f, 5f), entered, exited);
+
+            // Assert
+            Assert.IsTrue(changed);
+            CollectionAssert.AreEqual(new[] { "0_0" }, entered);
+            Assert.AreEqual(1, interest.Count);
+        }
+
+        [Test]
+        public void SpatialInterest_Update_KeepsCellsWithinHysteresisAsUserMoves()
+        {
+            // Arrange
+            var interest = new SpatialInterest(10f, 4f, 2f);
+            interest.Update(new Vector3(5f, 0f, 5f), entered, exited);
+            entered.Clear();
+
+            // Act & Assert
+            Assert.IsTrue(interest.Update(new Vector3(13f, 0f, 5f), entered, exited));
+            CollectionAssert.AreEqual(new[] { "1_0" }, entered);
+            Assert.IsEmpty(exited);
+
+            Assert.IsFalse(interest.Update(new Vector3(15f, 0f, 5f), entered, exited));
+
+            entered.Clear();
+            Assert.IsTrue(interest.Update(new Vector3(17f, 0f, 5f), entered, exited));
+            CollectionAssert.AreEqual(new[] { "2_0" }, entered);
+            CollectionAssert.AreEqual(new[] { "0_0" }, exited);
+            CollectionAssert.AreEquivalent(new[] { "1_0", "2_0" }, interest.Cells);
+        }
+    }
+}
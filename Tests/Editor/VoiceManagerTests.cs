@@ -0,0 +1,51 @@
+using NUnit.Framework;
+using UnityEngine;
+using ARLinguaSphere.Voice;
+
+namespace ARLinguaSphere.Tests
+{
+    /// <summary>
+    /// Unit tests for VoiceManager command matching
+    /// </summary>
+    public class VoiceManagerTests
+    {
+        private GameObject testObject;
+        private VoiceManager voiceManager;
+        
+        [SetUp]
+        public void Setup()
+        {
+            testObject = new GameObject("TestVoiceManager");
+            voiceManager = testObject.AddComponent<VoiceManager>();
+        }
+        
+        [TearDown]
+        public void Teardown()
+        {
+            if (testObject != null)
+            {
+                Object.DestroyImmediate(testObject);
+            }
+        }
+        
+        [Test]
+        public void VoiceManager_ProcessVoiceCommand_ToleratesTyposInSafePhrases()
+        {
+            // Act & Assert
+            Assert.AreEqual(VoiceCommand.Quiz, voiceManager.ProcessVoiceCommand("quizz me"));
+            Assert.AreEqual(VoiceCommand.Identify, voiceManager.ProcessVoiceCommand("identifi"));
+            Assert.AreEqual(VoiceCommand.ChangeLanguage, voiceManager.ProcessVoiceCommand("change languag"));
+        }
+        
+        [Test]
+        public void VoiceManager_ProcessVoiceCommand_NearMissesOfKeywords_AreNotCommands()
+        {
+            // Act & Assert
+            Assert.AreEqual(VoiceCommand.None, voiceManager.ProcessVoiceCommand("where is the remote"));
+            Assert.AreEqual(VoiceCommand.None, voiceManager.ProcessVoiceCommand("quit"));
+            Assert.AreEqual(VoiceCommand.Remove, voiceManager.ProcessVoiceCommand("remove"));
+            Assert.AreEqual(VoiceCommand.Remove, voiceManager.ProcessVoiceCommand("delete them"));
+            Assert.AreEqual(VoiceCommand.Quiz, voiceManager.ProcessVoiceCommand("quiz"));
+        }
+    }
+}